@@ -1155,6 +1155,8 @@ DECL_EXP wxString *GetpPlugInLocation() { return &dummy_string; }
 DECL_EXP wxString GetPlugInPath(opencpn_plugin *pplugin) {
   return wxString("");
 }
+DECL_EXP void SetNMEASentenceIds(opencpn_plugin *pplugin,
+                                 const wxArrayString &ids) {}
 
 DECL_EXP int AddChartToDBInPlace(wxString &full_path, bool b_RefreshCanvas) {
   return 0;
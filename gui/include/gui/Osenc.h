@@ -394,6 +394,31 @@ private:
   bool m_ok;
 };
 
+//--------------------------------------------------------------------------
+//      Osenc_outstreamMemory definition
+//      Collects records in memory, to be copied to another stream later
+//--------------------------------------------------------------------------
+class Osenc_outstreamMemory : public Osenc_outstream {
+public:
+  Osenc_outstreamMemory() {}
+  ~Osenc_outstreamMemory() {}
+
+  bool Open(const wxString &ofileName) {
+    m_data.clear();
+    return true;
+  }
+
+  Osenc_outstream &Write(const void *buffer, size_t size);
+  void Close() {}
+  bool IsOk() { return true; }
+
+  const unsigned char *GetData() const { return m_data.data(); }
+  size_t GetSize() const { return m_data.size(); }
+
+private:
+  std::vector<unsigned char> m_data;
+};
+
 //--------------------------------------------------------------------------
 //      Osenc definition
 //--------------------------------------------------------------------------
@@ -485,8 +510,11 @@ private:
   void CreateSENCVectorEdgeTable(Osenc_outstream *stream, S57Reader *poReader);
   void CreateSENCConnNodeTable(Osenc_outstream *stream, S57Reader *poReader);
 
+  //  Encodes one feature from the feature itself and its prebuilt edge
+  //  vector index table, without touching the reader. Thread safe.
   bool CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
-                           int mode, S57Reader *poReader);
+                           int mode, const unsigned char *pvec_buffer,
+                           int nEdgeVectorRecords);
   bool WriteFIDRecord200(Osenc_outstream *stream, int nOBJL, int featureID,
                          int prim);
   bool WriteHeaderRecord200(Osenc_outstream *stream, int recordType,
@@ -495,12 +523,14 @@ private:
                             uint16_t value);
   bool WriteHeaderRecord200(Osenc_outstream *stream, int recordType,
                             uint32_t value);
-  bool CreateAreaFeatureGeometryRecord200(S57Reader *poReader,
-                                          OGRFeature *pFeature,
-                                          Osenc_outstream *stream);
-  bool CreateLineFeatureGeometryRecord200(S57Reader *poReader,
-                                          OGRFeature *pFeature,
-                                          Osenc_outstream *stream);
+  bool CreateAreaFeatureGeometryRecord200(OGRFeature *pFeature,
+                                          Osenc_outstream *stream,
+                                          const unsigned char *pvec_buffer,
+                                          int nEdgeVectorRecords);
+  bool CreateLineFeatureGeometryRecord200(OGRFeature *pFeature,
+                                          Osenc_outstream *stream,
+                                          const unsigned char *pvec_buffer,
+                                          int nEdgeVectorRecords);
   bool CreateMultiPointFeatureGeometryRecord200(OGRFeature *pFeature,
                                                 Osenc_outstream *stream);
 
@@ -541,6 +571,8 @@ private:
       m_ref_lon;  // Common reference point, derived from FullExtent
   std::unordered_map<int, int> m_vector_helper_hash;
   double m_LOD_meters;
+  int m_Nall;  // Lexical levels of the cell being created
+  int m_Aall;
   S57ClassRegistrar *m_poRegistrar;
   wxArrayString m_tmpup_array;
 
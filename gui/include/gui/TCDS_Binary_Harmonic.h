@@ -24,8 +24,12 @@
 #ifndef __TCDS_BINARY_HARMONIC_H__
 #define __TCDS_BINARY_HARMONIC_H__
 
+#include <string>
+#include <vector>
+
 #include <wx/string.h>
 
+#include "model/station_index.h"
 #include "TCDataFactory.h"
 #include "Station_Data.h"
 #include "IDX_entry.h"
@@ -42,6 +46,15 @@ public:
   TC_Error_Code LoadHarmonicData(IDX_entry *pIDX);
 
 private:
+  TC_Error_Code ScanStations(std::vector<StationIndexEntry> &entries,
+                             std::vector<std::string> &names);
+  void AddIndexEntry(const StationIndexEntry &entry, const char *name);
+  /** Open the file and build the constituent tables, once. */
+  TC_Error_Code LoadTables();
+  /** Constituents of reference station record i, read on first use. */
+  Station_Data *LoadStationData(int i);
+
+  wxString m_data_file_path;
   ArrayOfStationData m_msd_array;
 
   wxString m_last_reference_not_found;
@@ -0,0 +1,136 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  LRU list and byte accounting of open charts
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#ifndef __CHART_CACHE_H__
+#define __CHART_CACHE_H__
+
+#include <cstddef>
+#include <unordered_map>
+
+#include <wx/hashmap.h>
+#include <wx/string.h>
+
+/** Budget buckets, indexed by ChartFamilyEnum. Plugin and unknown charts
+ * share the CHART_FAMILY_UNKNOWN bucket. */
+#define CHART_CACHE_N_FAMILY 3
+
+class CacheEntry {
+public:
+  CacheEntry()
+      : pChart(0),
+        RecentTime(0),
+        dbIndex(-1),
+        b_in_use(false),
+        n_lock(0),
+        family(0),
+        bytes(0),
+        lru_prev(0),
+        lru_next(0) {}
+
+  wxString FullPath;
+  void *pChart;
+  int RecentTime;
+  int dbIndex;
+  bool b_in_use;
+  int n_lock;
+
+  int family;     ///< Budget bucket, see CHART_CACHE_N_FAMILY
+  size_t bytes;   ///< Resident cost at the last ChartCache::SetBytes()
+
+  CacheEntry *lru_prev;  ///< Next more recently used entry
+  CacheEntry *lru_next;  ///< Next less recently used entry
+};
+
+struct ChartCacheStats {
+  unsigned long hits;
+  unsigned long misses;
+  unsigned long evictions;
+  unsigned int count;
+  size_t bytes[CHART_CACHE_N_FAMILY];
+  size_t budget[CHART_CACHE_N_FAMILY];
+};
+
+WX_DECLARE_STRING_HASH_MAP(CacheEntry *, ChartCachePathHash);
+
+/**
+ * The open charts of a ChartDB, in an intrusive doubly linked LRU list
+ * with lookup by path and by database index. Insertion, removal, lookup
+ * and touching an entry are O(1). The resident byte cost of each entry is
+ * summed per chart family, so that eviction can work against a byte
+ * budget instead of the process memory footprint.
+ *
+ * The cache does not own the entries and is not locked; ChartDB does both.
+ */
+class ChartCache {
+public:
+  ChartCache();
+
+  /** Insert pce as the most recently used entry. */
+  void Add(CacheEntry *pce);
+  /** Unlink pce. The entry itself is not deleted. */
+  void Remove(CacheEntry *pce);
+  /** Mark pce as the most recently used entry and count a hit. */
+  void Touch(CacheEntry *pce);
+
+  CacheEntry *Find(const wxString &path) const;
+  CacheEntry *Find(int dbIndex) const;
+  CacheEntry *FindChart(const void *pChart) const;
+
+  /** The most recently used entry, follow lru_next to walk the list. */
+  CacheEntry *GetNewest() const { return m_head; }
+  /** The least recently used entry, follow lru_prev to walk the list. */
+  CacheEntry *GetOldest() const { return m_tail; }
+  unsigned int GetCount() const { return m_count; }
+
+  /** Record a new resident cost for pce. */
+  void SetBytes(CacheEntry *pce, size_t bytes);
+  size_t GetBytes(int family) const;
+
+  void SetBudget(int family, size_t bytes);
+  size_t GetBudget(int family) const;
+  bool IsOverBudget(int family, double factor = 1.0) const;
+
+  void CountMiss() { m_misses++; }
+  void CountEviction() { m_evictions++; }
+  ChartCacheStats GetStats() const;
+
+private:
+  void Link(CacheEntry *pce);
+  void Unlink(CacheEntry *pce);
+  static int Bucket(int family);
+
+  CacheEntry *m_head;
+  CacheEntry *m_tail;
+  unsigned int m_count;
+
+  ChartCachePathHash m_by_path;
+  std::unordered_map<int, CacheEntry *> m_by_index;
+  std::unordered_map<const void *, CacheEntry *> m_by_chart;
+
+  size_t m_bytes[CHART_CACHE_N_FAMILY];
+  size_t m_budget[CHART_CACHE_N_FAMILY];
+  unsigned long m_hits;
+  unsigned long m_misses;
+  unsigned long m_evictions;
+};
+
+#endif
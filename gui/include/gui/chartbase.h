@@ -159,6 +159,14 @@ public:
   virtual ChartDepthUnitType GetDepthUnitType(void) { return m_depth_unit_id; }
 
   virtual bool IsReadyToRender() { return bReadyToRender; }
+
+  /**
+   * Approximate heap memory held by this chart: decoded objects, line and
+   * pixel caches, vertex buffers. GL textures are owned and reported by
+   * the texture manager. Used by the ChartDB cache to enforce its budget.
+   */
+  virtual size_t GetResidentBytes() { return 0; }
+
   virtual bool RenderRegionViewOnDC(wxMemoryDC &dc, const ViewPort &VPoint,
                                     const OCPNRegion &Region) = 0;
 
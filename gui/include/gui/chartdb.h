@@ -34,6 +34,7 @@
 
 #include "chartbase.h"
 #include "chartdbs.h"
+#include "chart_cache.h"
 
 #define MAXSTACK 100
 
@@ -76,16 +77,6 @@ private:
   int DBIndex[MAXSTACK];
 };
 
-class CacheEntry {
-public:
-  wxString FullPath;
-  void *pChart;
-  int RecentTime;
-  int dbIndex;
-  bool b_in_use;
-  int n_lock;
-};
-
 // ----------------------------------------------------------------------------
 // Chart Database
 // ----------------------------------------------------------------------------
@@ -116,7 +107,10 @@ public:
                                        bool bLargest, ChartTypeEnum New_Type,
                                        ChartFamilyEnum New_Family_Fallback);
 
-  wxArrayPtrVoid *GetChartCache(void) { return pChartCache; }
+  ChartCacheStats GetCacheStats();
+  unsigned int GetCacheCount();
+  /** Set the resident byte budget of a ChartFamilyEnum, 0 for no limit. */
+  void SetCacheBudget(int family, size_t bytes);
   std::vector<int> GetCSArray(ChartStack *ps);
 
   int GetStackEntry(ChartStack *ps, wxString fp);
@@ -154,6 +148,7 @@ public:
 
   void ClearCacheInUseFlags(void);
   void PurgeCacheUnusedCharts(double factor);
+  bool DeleteOldestCacheChart();
 
   bool IsBusy() { return m_b_busy; }
   bool CheckExclusiveTileGroup(int canvasIndex);
@@ -171,13 +166,15 @@ private:
                                     Extent *pext);
   bool CheckPositionWithinChart(int index, float lat, float lon);
   ChartBase *OpenChartUsingCache(int dbindex, ChartInitFlag init_flag);
-  CacheEntry *FindOldestDeleteCandidate(bool blog);
-  void DeleteCacheEntry(int i, bool bDelTexture = false,
-                        const wxString &msg = wxEmptyString);
+  CacheEntry *FindOldestDeleteCandidate(bool blog, int family = -1);
   void DeleteCacheEntry(CacheEntry *pce, bool bDelTexture = false,
                         const wxString &msg = wxEmptyString);
+  size_t GetChartResidentBytes(ChartBase *pChart);
+  void UpdateCacheEntryBytes(CacheEntry *pce);
+  void PurgeCacheOverBudget(int family, double factor, bool bDelTexture,
+                            bool blog);
 
-  wxArrayPtrVoid *pChartCache;
+  ChartCache m_cache;
   int m_ticks;
 
   bool m_b_locked;
@@ -373,8 +373,25 @@ protected:
   bool m_b_busy;
 
 private:
+  /** A file found while scanning a chart directory. */
+  struct ScanCandidate {
+    wxString full_name;
+    wxString file_name;
+    wxString utf8_path;
+    bool matches = false;
+    bool prebuild = false;  // header to be read by the worker pool
+    bool prebuilt = false;  // entry is the worker result, possibly NULL
+    ChartTableEntry *entry = NULL;
+  };
+
   bool IsChartDirUsed(const wxString &theDir);
 
+  bool IsHeaderScanThreadSafe(const wxString &path,
+                              const ChartClassDescriptor &chart_desc) const;
+  void PrebuildChartTableEntries(std::vector<ScanCandidate> &candidates,
+                                 ChartClassDescriptor &chart_desc,
+                                 wxGenericProgressDialog *pprog);
+
   int SearchDirAndAddCharts(wxString &dir_name_base,
                             ChartClassDescriptor &chart_desc,
                             wxGenericProgressDialog *pprog);
@@ -178,6 +178,8 @@ public:
 
   double GetPPM() { return m_ppm_avg; }
 
+  virtual size_t GetResidentBytes();
+
 protected:
   //    Methods
 
@@ -207,6 +209,7 @@ protected:
   virtual wxBitmap *CreateThumbnail(int tnx, int tny, ColorScheme cs);
   virtual int BSBGetScanline(unsigned char *pLineBuf, int y, int xs, int xl,
                              int sub_samp);
+  size_t LineCacheRowBytes(const CachedLine *pt) const;
 
   bool GetViewUsingCache(wxRect &source, wxRect &dest, const OCPNRegion &Region,
                          ScaleTypeEnum scale_type);
@@ -262,6 +265,7 @@ protected:
   int *pline_table;  // pointer to Line offset table
 
   CachedLine *pLineCache;
+  size_t m_line_cache_bytes;  // sum of LineCacheRowBytes() of valid rows
 
   wxInputStream *ifs_hdr;
   wxInputStream *ifss_bitmap;
@@ -239,6 +239,9 @@ public:
                                  wxPoint2DDouble *r);
   bool GetCanvasPointPix(double rlat, double rlon, wxPoint *r);
   bool GetCanvasPointPixVP(ViewPort &vp, double rlat, double rlon, wxPoint *r);
+  /** Batch form of GetCanvasPointPix() for n points at once. */
+  void GetCanvasPointPix(int n, const double *rlat, const double *rlon,
+                         wxPoint *r);
 
   void GetCanvasPixPoint(double x, double y, double &lat, double &lon);
   void WarpPointerDeferred(int x, int y);
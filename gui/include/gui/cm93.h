@@ -467,6 +467,7 @@ public:
   void CloseandReopenCurrentSubchart(void);
 
   void InvalidateCache();
+  size_t GetResidentBytes();
 
 private:
   void UpdateRenderRegions(const ViewPort &VPoint);
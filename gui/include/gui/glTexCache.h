@@ -26,65 +26,28 @@
 #define __GLTEXTCACHE_H__
 
 #include <wx/glcanvas.h>
-#include <wx/ffile.h>
 #include <wx/timer.h>
 #include <stdint.h>
 
 #include "model/ocpn_types.h"
+#include "model/tex_cache_store.h"
 #include "color_types.h"
 #include "bbox.h"
 #include "viewport.h"
 
 class glTextureDescriptor;
 
-#define COMPRESSED_CACHE_MAGIC 0xf013  // change this when the format changes
-
 #define FACTORY_TIMER 10000
 
+/** Compressed textures of all raster charts, in the private data dir. */
+TexCacheStore *GetTexCacheStore();
+
 void HalfScaleChartBits(int width, int height, unsigned char *source,
                         unsigned char *target);
 
 class ChartBaseBSB;
 class ChartPlugInWrapper;
 
-struct CompressedCacheHeader {
-  uint32_t magic;
-  uint32_t format;
-  uint32_t chartdate;
-  uint32_t m_nentries;
-  uint32_t catalog_offset;
-  uint32_t chartfile_date;
-  uint32_t chartfile_size;
-};
-
-struct CatalogEntryKey {
-  int mip_level;
-  ColorScheme tcolorscheme;
-  int x;
-  int y;
-};
-
-struct CatalogEntryValue {
-  int texture_offset;
-  uint32_t compressed_size;
-};
-
-#define CATALOG_ENTRY_SERIAL_SIZE 6 * sizeof(uint32_t)
-
-class CatalogEntry {
-public:
-  CatalogEntry();
-  ~CatalogEntry();
-  CatalogEntry(int level, int x0, int y0, ColorScheme colorscheme);
-  int GetSerialSize();
-  void Serialize(unsigned char *);
-  void DeSerialize(unsigned char *);
-  CatalogEntryKey k;
-  CatalogEntryValue v;
-};
-
-WX_DEFINE_ARRAY(CatalogEntry *, ArrayOfCatalogEntries);
-
 class glTexTile {
 public:
   glTexTile() {
@@ -127,6 +90,7 @@ public:
   bool OnTimer();
   void AccumulateMemStatistics(int &map_size, int &comp_size,
                                int &compcomp_size);
+  size_t GetResidentBytes();
   void DeleteTexture(const wxRect &rect);
   void DeleteAllTextures(void);
   void DeleteSomeTextures(long target);
@@ -148,45 +112,25 @@ public:
   void GetCenter(double &lat, double &lon) { lat = m_clat, lon = m_clon; }
 
 private:
-  bool LoadCatalog(void);
-  bool LoadHeader(void);
-  bool WriteCatalogAndHeader();
-
-  bool UpdateCachePrecomp(unsigned char *data, int data_size,
-                          const wxRect &rect, int level,
-                          ColorScheme color_scheme, bool write_catalog = true);
+  TexCacheKey CacheKey(int level, const wxRect &rect,
+                       ColorScheme color_scheme) const;
   bool UpdateCacheLevel(const wxRect &rect, int level, ColorScheme color_scheme,
                         unsigned char *data, int size);
 
   void DeleteSingleTexture(glTextureDescriptor *ptd);
 
-  CatalogEntryValue *GetCacheEntryValue(int level, int x, int y,
-                                        ColorScheme color_scheme);
-  bool AddCacheEntryValue(const CatalogEntry &p);
   int ArrayIndex(int x, int y) const {
     return ((y / m_tex_dim) * m_stride) + (x / m_tex_dim);
   }
   void ArrayXY(wxRect *r, int index) const;
 
-  int n_catalog_entries;
-
-  CatalogEntryValue *m_cache[N_COLOR_SCHEMES][MAX_TEX_LEVEL];
-
   wxString m_ChartPath;
   wxString m_HashKey;
-  wxString m_CompressedCacheFilePath;
 
-  int m_catalog_offset;
-  bool m_hdrOK;
-  bool m_catalogOK;
   bool m_newCatalog;
 
-  bool m_catalogCorrupted;
-
-  wxFFile *m_fs;
-  uint32_t m_chart_date_binary;
-  uint32_t m_chartfile_date_binary;
-  uint32_t m_chartfile_size;
+  /** Chart file version in the shared texture store, see GetTexCacheStore() */
+  uint64_t m_chart_key;
 
   int m_stride;
   int m_ntex;
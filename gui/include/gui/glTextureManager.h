@@ -124,6 +124,8 @@ public:
   void ClearJobList();
   void ClearAllRasterTextures(void);
   bool PurgeChartTextures(ChartBase *pc, bool b_purge_factory = false);
+  /** Bytes held by the texture factory of pc, 0 if there is none. */
+  size_t GetChartTextureBytes(ChartBase *pc);
   bool TextureCrunch(double factor);
   bool FactoryCrunch(double factor);
   void BuildCompressedCache();
@@ -72,6 +72,7 @@ class wxGenericProgressDialog;
 class ocpnDC;
 class NavObjectCollection1;
 class NavObjectChanges;
+class StartupTasks;
 class TrackPoint;
 class RouteList;
 class canvasConfig;
@@ -143,6 +144,12 @@ public:
   int LoadMyConfig();
   void LoadS57Config();
   wxString FindNewestUsableBackup() const;
+  /**
+   * Find a usable navobj.xml, or recover it from a backup, and parse it.
+   * Does not touch the GUI or the config entries, may run on a worker.
+   */
+  bool ParseNavObjects();
+  /** Create the objects in navobj.xml, parsing it first if needed. */
   void LoadNavObjects();
   virtual void AddNewRoute(Route *pr);
   virtual void UpdateRoute(Route *pr);
@@ -175,6 +182,12 @@ public:
   virtual bool IsChangesFileDirty();
 
   bool LoadLayers(wxString &path);
+  /**
+   * Add tasks parsing the layer files under path on workers, and loading
+   * each layer in turn on the main thread once task after is done.
+   * Returns the id of the last task.
+   */
+  int AddLayerTasks(StartupTasks &tasks, const wxString &path, int after);
   int LoadMyConfigRaw(bool bAsTemplate = false);
 
   void CreateRotatingNavObjBackup();
@@ -184,6 +197,7 @@ public:
 
   NavObjectChanges *m_pNavObjectChangesSet;
   NavObjectCollection1 *m_pNavObjectInputSet;
+  bool m_bNavObjectsParsed;
 };
 
 void SwitchInlandEcdisMode(bool Switch);
@@ -39,6 +39,7 @@
 #include "model/comm_bridge.h"
 #include "model/local_api.h"
 #include "model/rest_server.h"
+#include "model/startup_tasks.h"
 #include "model/usb_watch_daemon.h"
 class Track;
 
@@ -76,6 +77,11 @@ public:
   RestServer m_rest_server;
   UsbWatchDaemon& m_usb_watcher;
 
+  /** Startup task graph and timings, lives until deferred init is done. */
+  StartupTasks m_startup;
+  /** Task parsing navobj.xml, picked up by the deferred init. */
+  int m_navobj_task;
+
   DECLARE_EVENT_TABLE()
 private:
 
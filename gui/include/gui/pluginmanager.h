@@ -231,6 +231,7 @@ public:
   void SetCanvasContextMenuItemViz(int item, bool viz, const char* name = "");
   void SetCanvasContextMenuItemGrey(int item, bool grey, const char* name = "");
 
+  /** Queue sentence, to be passed on in a batch from the event loop. */
   static void SendNMEASentenceToAllPlugIns(const wxString& sentence);
   void SendPositionFixToAllPlugIns(GenericPosDatEx* ppos);
   void SendActiveLegInfoToAllPlugIns(const ActiveLegDat* infos);
@@ -288,6 +289,9 @@ public:
       ChartPlugInWrapper* target, float zlat, float zlon, const ViewPort& vp);
 
 private:
+  static void PostNMEABatch();
+  static void SendNMEABatchToAllPlugIns();
+  static void UpdateNMEASubscriptions();
   bool CheckBlacklistedPlugin(wxString name, int major, int minor);
   bool CheckBlacklistedPlugin(opencpn_plugin* plugin);
 
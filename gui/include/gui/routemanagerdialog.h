@@ -31,6 +31,10 @@
 #include <wx/textctrl.h>
 #include <wx/checkbox.h>
 
+#include <functional>
+#include <vector>
+
+#include "model/list_index.h"
 #include "observable.h"
 
 #define NAME_COLUMN 2
@@ -46,6 +50,47 @@ class Track;
 class Layer;
 class RoutePoint;
 
+/**
+ * Virtual list control of the routes, tracks or waypoints in a ListIndex.
+ * Rows are formatted when drawn, so the control holds no copy of the
+ * objects and a change does not rebuild it.
+ */
+class NavObjectListCtrl : public wxListCtrl {
+public:
+  /** Text of a column of an object. */
+  using ColumnText = std::function<wxString(void *obj, long column)>;
+  /** Image of an object, -1 for none. */
+  using ItemImage = std::function<int(void *obj)>;
+  /** True if an object is shown in bold. */
+  using IsBold = std::function<bool(void *obj)>;
+
+  NavObjectListCtrl(wxWindow *parent, ColumnText text, ItemImage image,
+                    IsBold bold);
+
+  ListIndex &GetIndex() { return m_index; }
+
+  /** Object in row item, NULL if none. */
+  void *GetObject(long item) const;
+  /** Row of obj, -1 if it is not shown. */
+  long FindObject(const void *obj) const;
+  std::vector<void *> GetSelectedObjects() const;
+
+  /** Show the rows of the index after it changed, and select objects. */
+  void ShowRows(const std::vector<void *> &select);
+
+protected:
+  wxString OnGetItemText(long item, long column) const override;
+  int OnGetItemImage(long item) const override;
+  wxListItemAttr *OnGetItemAttr(long item) const override;
+
+private:
+  ListIndex m_index;
+  ColumnText m_text;
+  ItemImage m_image;
+  IsBold m_bold;
+  mutable wxListItemAttr m_bold_attr;
+};
+
 class RouteManagerDialog : public wxFrame {
   DECLARE_EVENT_TABLE()
 
@@ -90,6 +135,7 @@ private:
   void ToggleLayerContentsOnListing(Layer *layer);
   void ToggleLayerContentsNames(Layer *layer);
   void AddNewLayer(bool isPersistent);
+  void FilterList(NavObjectListCtrl *list, wxTextCtrl *filter);
 
   // event handlers
   void OnRteDeleteClick(wxCommandEvent &event);
@@ -161,9 +207,9 @@ private:
   wxPanel *m_pPanelTrk;
   wxPanel *m_pPanelWpt;
   wxPanel *m_pPanelLay;
-  wxListCtrl *m_pRouteListCtrl;
-  wxListCtrl *m_pTrkListCtrl;
-  wxListCtrl *m_pWptListCtrl;
+  NavObjectListCtrl *m_pRouteListCtrl;
+  NavObjectListCtrl *m_pTrkListCtrl;
+  NavObjectListCtrl *m_pWptListCtrl;
   wxListCtrl *m_pLayListCtrl;
   wxStaticText *m_stFilterWpt;
   wxTextCtrl *m_tFilterWpt;
@@ -254,6 +254,7 @@ public:
 
   virtual bool IsCacheValid() { return (pDIB != nullptr); }
   virtual void InvalidateCache();
+  virtual size_t GetResidentBytes();
   virtual bool RenderViewOnDC(wxMemoryDC &dc, const ViewPort &VPoint);
 
   virtual void ClearDepthContourArray(void);
@@ -387,6 +388,7 @@ private:
 
 
   int m_LineVBO_name;
+  size_t m_object_bytes;  // S57Obj and edge tables, computed once after load
 
   std::unordered_map<unsigned, VE_Element *> m_ve_hash;
   std::unordered_map<unsigned, VC_Element *> m_vc_hash;
@@ -27,6 +27,7 @@
 #define _TRACK_GUI_H
 
 #include <list>
+#include <vector>
 
 #include "bbox.h"
 #include "chcanv.h"
@@ -58,10 +59,12 @@ private:
                      std::list<std::list<wxPoint> > &pointlists, ViewPort &VP,
                      const LLBBox &box);
   void Finalize();
-  void Assemble(ChartCanvas *cc, std::list<std::list<wxPoint> > &pointlists,
-                const LLBBox &box, double scale, int &last, int level, int pos);
+  void Assemble(std::vector<int> &points, const LLBBox &box, double scale,
+                int &last, int level, int pos);
   void AddPointToList(ChartCanvas *cc,
                       std::list<std::list<wxPoint> > &pointlists, int n);
+  void AddPointToList(std::list<std::list<wxPoint> > &pointlists,
+                      const wxPoint &r);
   void AddPointToLists(ChartCanvas *cc,
                        std::list<std::list<wxPoint> > &pointlists, int &last,
                        int n);
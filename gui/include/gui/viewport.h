@@ -88,6 +88,9 @@ public:
   }
   void GetLLFromPix(const wxPoint2DDouble &p, double *lat, double *lon);
   wxPoint2DDouble GetDoublePixFromLL(double lat, double lon);
+  /** Project n points at once, same results as the single point version. */
+  void GetDoublePixFromLL(int n, const double *lat, const double *lon,
+                          wxPoint2DDouble *pix);
 
   LLRegion GetLLRegion(const OCPNRegion &region);
   OCPNRegion GetVPRegionIntersect(const OCPNRegion &region,
@@ -169,6 +172,8 @@ private:
 
   bool bValid;  // This VP is valid
 
+  void UpdateProjectionCache();
+
   double lat0_cache, cache0, cache1;
 };
 
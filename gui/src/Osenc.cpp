@@ -49,11 +49,20 @@
 #include "mygeom.h"
 #include "model/georef.h"
 #include "gui_lib.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <thread>
 
 extern s57RegistrarMgr *m_pRegistrarMan;
 extern wxString g_csv_locn;
 extern bool g_bGDAL_Debug;
+extern int g_nCPUCount;
+
+//  Record encoding threads in use by all the cells being built
+static std::mutex s_encodeThreadsMutex;
+static int s_encodeThreads = 0;
 
 bool chain_broken_mssage_shown = false;
 
@@ -176,6 +185,28 @@ void Osenc_outstreamFile::Init() {
   m_ok = false;
 }
 
+//--------------------------------------------------------------------------
+//      Osenc_outstreamMemory implementation
+//--------------------------------------------------------------------------
+Osenc_outstream &Osenc_outstreamMemory::Write(const void *buffer,
+                                              size_t size) {
+  const unsigned char *p = (const unsigned char *)buffer;
+  m_data.insert(m_data.end(), p, p + size);
+
+  return *this;
+}
+
+//  A feature on its way from the S57 reader to the SENC file. The reader
+//  dependent parts are done when the job is created, the records are
+//  encoded on a worker thread and written out in reading order.
+struct Osenc_FeatureJob {
+  OGRFeature *feature;
+  unsigned char *pvec_buffer;
+  int nEdgeVectorRecords;
+  Osenc_outstreamMemory stream;
+  bool done;
+};
+
 //--------------------------------------------------------------------------
 //      Osenc implementation
 //--------------------------------------------------------------------------
@@ -218,6 +249,8 @@ Osenc::~Osenc() {
 
 void Osenc::init(void) {
   m_LOD_meters = 0;
+  m_Nall = 0;
+  m_Aall = 0;
   m_poRegistrar = NULL;
   m_bPrivateRegistrar = false;
   m_senc_file_read_version = 0;
@@ -1475,6 +1508,9 @@ int Osenc::createSenc200(const wxString &FullPath000,
                          const wxString &SENCFileName, bool b_showProg) {
   lockCR.lock();
 
+  //  Times the whole build, ingest and updates included
+  wxStopWatch buildsw;
+
   m_FullPath000 = FullPath000;
 
   m_senc_file_create_version = 201;
@@ -1693,6 +1729,79 @@ int Osenc::createSenc200(const wxString &FullPath000,
   }
 #endif
 
+  //  The reader is used on this thread only. Record encoding, including
+  //  the polygon tessellation, is spread over worker threads, and the
+  //  results are written in reading order, so the SENC is the same as if
+  //  created serially.
+  m_Nall = poReader->GetNall();
+  m_Aall = poReader->GetAall();
+
+  //  The SENC manager builds several cells at once, so the threads are
+  //  shared out between them, leaving one CPU for reading. Every cell gets
+  //  at least one.
+  int nCPU = wxMax(1, wxThread::GetCPUCount());
+  if (g_nCPUCount > 0) nCPU = g_nCPUCount;
+  unsigned int nThreads;
+  {
+    std::lock_guard<std::mutex> lock(s_encodeThreadsMutex);
+    nThreads = wxMax(1, nCPU - 1 - s_encodeThreads);
+    s_encodeThreads += nThreads;
+  }
+  size_t maxJobs = 64 * nThreads;  //  Bounds the features held in memory
+
+  std::mutex jobMutex;
+  std::condition_variable workCond;
+  std::condition_variable doneCond;
+  std::deque<Osenc_FeatureJob *> workJobs;   //  Waiting for a worker
+  std::deque<Osenc_FeatureJob *> orderJobs;  //  Waiting to be written
+  bool bnoMoreJobs = false;
+
+  auto encodeJobs = [&]() {
+    std::unique_lock<std::mutex> lock(jobMutex);
+    while (true) {
+      workCond.wait(lock, [&] { return bnoMoreJobs || !workJobs.empty(); });
+      if (workJobs.empty()) return;
+      Osenc_FeatureJob *job = workJobs.front();
+      workJobs.pop_front();
+      lock.unlock();
+
+      CreateSENCRecord200(job->feature, &job->stream, 1, job->pvec_buffer,
+                          job->nEdgeVectorRecords);
+
+      lock.lock();
+      job->done = true;
+      doneCond.notify_all();
+    }
+  };
+
+  //  Write out finished jobs in order, waiting for the oldest ones until no
+  //  more than maxPending remain.
+  auto writeJobs = [&](size_t maxPending) {
+    while (!orderJobs.empty()) {
+      Osenc_FeatureJob *job = orderJobs.front();
+      {
+        std::unique_lock<std::mutex> lock(jobMutex);
+        if (!job->done) {
+          if (orderJobs.size() <= maxPending) return;
+          //  Let other cells go on while the workers catch up
+          lockCR.unlock();
+          doneCond.wait(lock, [job] { return job->done; });
+          lock.unlock();
+          lockCR.lock();
+        }
+      }
+      if (bcont) stream->Write(job->stream.GetData(), job->stream.GetSize());
+
+      orderJobs.pop_front();
+      delete job->feature;
+      free(job->pvec_buffer);
+      delete job;
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned int i = 0; i < nThreads; i++) workers.emplace_back(encodeJobs);
+
   //  Loop in the S57 reader, extracting Features one-by-one
   OGRFeature *objectDef;
 
@@ -1735,16 +1844,51 @@ int Osenc::createSenc200(const wxString &FullPath000,
         geoType = objectDef->GetGeometryRef()->getGeometryType();
 
       //      n.b  This next line causes skip of C_AGGR features w/o geometry
-      if (geoType != wkbUnknown) {  // Write only if has wkbGeometry
-        CreateSENCRecord200(objectDef, stream, 1, poReader);
+      if (geoType == wkbUnknown) {
+        delete objectDef;
+        continue;
       }
 
-      delete objectDef;
+      Osenc_FeatureJob *job = new Osenc_FeatureJob;
+      job->feature = objectDef;
+      job->pvec_buffer = NULL;
+      job->nEdgeVectorRecords = 0;
+      job->done = false;
+
+      //  The edge vector index table needs the reader, so is built here
+      bool bedges = geoType == wkbLineString;
+      if (geoType == wkbPolygon)
+        bedges = ((OGRPolygon *)objectDef->GetGeometryRef())
+                     ->getExteriorRing() != NULL;
+      if (bedges)
+        job->pvec_buffer = getObjectVectorIndexTable(poReader, objectDef,
+                                                     job->nEdgeVectorRecords);
+
+      {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        workJobs.push_back(job);
+      }
+      workCond.notify_one();
+      orderJobs.push_back(job);
 
+      writeJobs(maxJobs);
     } else
       break;
   }
 
+  //  Finish, or on abort just drain, the features still in flight
+  writeJobs(0);
+  {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    bnoMoreJobs = true;
+  }
+  workCond.notify_all();
+  for (auto &worker : workers) worker.join();
+  {
+    std::lock_guard<std::mutex> lock(s_encodeThreadsMutex);
+    s_encodeThreads -= nThreads;
+  }
+
   if (bcont) {
     //      Create and write the Vector Edge Table
     CreateSENCVectorEdgeTableRecord200(stream, poReader);
@@ -1778,8 +1922,18 @@ int Osenc::createSenc200(const wxString &FullPath000,
       errorMessage.Append(_T(" to "));
       errorMessage.Append(SENCfile.GetFullPath());
       ret_code = ERROR_SENCFILE_ABORT;
-    } else
+    } else {
       ret_code = SENC_NO_ERROR;
+
+      double secs = wxMax(buildsw.Time(), 1) / 1000.;
+      double mbytes = SENCfile.GetSize().ToDouble() / (1024. * 1024.);
+      int nfeatures = poReader->GetFeatureCount();
+      wxLogMessage(wxString::Format(
+          _T("   SENC built: %s, %d features, %.2f MB in %.3f s ")
+          _T("(%.0f features/s, %.2f MB/s)"),
+          SENCfile.GetFullName().c_str(), nfeatures, mbytes, secs,
+          nfeatures / secs, mbytes / secs));
+    }
   }
 
 #if wxUSE_PROGRESSDLG
@@ -2048,9 +2202,10 @@ bool Osenc::CreateMultiPointFeatureGeometryRecord200(OGRFeature *pFeature,
   return false;
 }
 
-bool Osenc::CreateLineFeatureGeometryRecord200(S57Reader *poReader,
-                                               OGRFeature *pFeature,
-                                               Osenc_outstream *stream) {
+bool Osenc::CreateLineFeatureGeometryRecord200(OGRFeature *pFeature,
+                                               Osenc_outstream *stream,
+                                               const unsigned char *pvec_buffer,
+                                               int nEdgeVectorRecords) {
   OGRGeometry *pGeo = pFeature->GetGeometryRef();
 
   int wkb_len = pGeo->WkbSize();
@@ -2124,10 +2279,6 @@ bool Osenc::CreateLineFeatureGeometryRecord200(S57Reader *poReader,
     latmin = fmin(lat, latmin);
   }
 
-  int nEdgeVectorRecords = 0;
-  unsigned char *pvec_buffer =
-      getObjectVectorIndexTable(poReader, pFeature, nEdgeVectorRecords);
-
 #if 0
 
     //    Capture the Vector Table geometry indices into a memory buffer
@@ -2232,16 +2383,16 @@ bool Osenc::CreateLineFeatureGeometryRecord200(S57Reader *poReader,
   if (!stream->Write(pvec_buffer, targetCount).IsOk()) return false;
 
   //  Free the buffers
-  free(pvec_buffer);
   free(psb_buffer);
   free(pwkb_buffer);
 
   return true;
 }
 
-bool Osenc::CreateAreaFeatureGeometryRecord200(S57Reader *poReader,
-                                               OGRFeature *pFeature,
-                                               Osenc_outstream *stream) {
+bool Osenc::CreateAreaFeatureGeometryRecord200(OGRFeature *pFeature,
+                                               Osenc_outstream *stream,
+                                               const unsigned char *pvec_buffer,
+                                               int nEdgeVectorRecords) {
   int error_code;
 
   PolyTessGeo *ppg = NULL;
@@ -2251,9 +2402,7 @@ bool Osenc::CreateAreaFeatureGeometryRecord200(S57Reader *poReader,
 
   if (!poly->getExteriorRing()) return false;
 
-  lockCR.unlock();
   ppg = new PolyTessGeo(poly, true, m_ref_lat, m_ref_lon, m_LOD_meters);
-  lockCR.lock();
 
   error_code = ppg->ErrorCode;
 
@@ -2323,10 +2472,6 @@ bool Osenc::CreateAreaFeatureGeometryRecord200(S57Reader *poReader,
 
   baseRecord.triprim_count = n_TriPrims;  //  Set the number of TriPrims
 
-  int nEdgeVectorRecords = 0;
-  unsigned char *pvec_buffer =
-      getObjectVectorIndexTable(poReader, pFeature, nEdgeVectorRecords);
-
 #if 0
      //  Create the Vector Edge Index table into a memory buffer
      //  This buffer will follow the triangle buffer in the output stream
@@ -2464,7 +2609,6 @@ bool Osenc::CreateAreaFeatureGeometryRecord200(S57Reader *poReader,
 
   delete ppg;
   free(contourPointCountArray);
-  free(pvec_buffer);
 
   return true;
 }
@@ -2821,7 +2965,8 @@ void Osenc::CreateSENCVectorConnectedTableRecord200(Osenc_outstream *stream,
 }
 
 bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
-                                int mode, S57Reader *poReader) {
+                                int mode, const unsigned char *pvec_buffer,
+                                int nEdgeVectorRecords) {
   // TODO
   //    if(pFeature->GetFID() == 207)
   //        int yyp = 4;
@@ -2874,6 +3019,8 @@ bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
   int payloadLength = 0;
   void *payloadBuffer = NULL;
   unsigned int payloadBufferLength = 0;
+  void *recordBuffer = NULL;
+  unsigned int recordBufferLength = 0;
 
   for (int iField = 0; iField < pFeature->GetFieldCount(); iField++) {
     if (pFeature->IsFieldSet(iField)) {
@@ -2882,7 +3029,6 @@ bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
         // const char *pType = OGRFieldDefn::GetFieldTypeName(
         // poFDefn->GetType() );
         const char *pAttrName = poFDefn->GetNameRef();
-        const char *pAttrVal = pFeature->GetFieldAsString(iField);
 
         //  Use the OCPN Registrar Manager to map attribute acronym to an
         //  identifier. The mapping is defined by the file
@@ -2997,7 +3143,7 @@ bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
                 (0 == strncmp("NINFOM", pAttrName, 6)) ||
                 (0 == strncmp("NPLDST", pAttrName, 6)) ||
                 (0 == strncmp("NTXTDS", pAttrName, 6))) {
-              if (poReader->GetNall() ==
+              if (m_Nall ==
                   2) {  // ENC is using UCS-2 / UTF-16 encoding
                 wxMBConvUTF16 conv;
                 wxString att_conv(pAttrVal, conv);
@@ -3007,14 +3153,14 @@ bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
                                  _T("|"));  // Replace  <new line> with special
                                             // break character
                 wxAttrValue = att_conv;
-              } else if (poReader->GetNall() ==
+              } else if (m_Nall ==
                          1) {  // ENC is using Lex level 1 (ISO 8859_1) encoding
                 wxCSConv conv(_T("iso8859-1"));
                 wxString att_conv(pAttrVal, conv);
                 wxAttrValue = att_conv;
               }
             } else {
-              if (poReader->GetAall() ==
+              if (m_Aall ==
                   1) {  // ENC is using Lex level 1 (ISO 8859_1) encoding for
                         // "General Text"
                 wxCSConv conv(_T("iso8859-1"));
@@ -3059,8 +3205,12 @@ bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
           int recordLength =
               sizeof(OSENC_Attribute_Record_Base) + payloadLength;
 
-          //  Get a reference to the class persistent buffer
-          unsigned char *pBuffer = getBuffer(recordLength);
+          //  A local buffer, the class persistent one is not thread safe
+          if (recordBufferLength < (unsigned int)recordLength) {
+            recordBuffer = realloc(recordBuffer, recordLength);
+            recordBufferLength = recordLength;
+          }
+          unsigned char *pBuffer = (unsigned char *)recordBuffer;
 
           OSENC_Attribute_Record *pRecord = (OSENC_Attribute_Record *)pBuffer;
           memset(pRecord, 0, sizeof(OSENC_Attribute_Record));
@@ -3074,6 +3224,7 @@ bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
           size_t targetCount = recordLength;
           if (!stream->Write(pBuffer, targetCount).IsOk()) {
             free(payloadBuffer);
+            free(recordBuffer);
             return false;
           }
         }
@@ -3098,8 +3249,11 @@ bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
         // Build the record
         int recordLength = sizeof(OSENC_Attribute_Record_Base) + payloadLength;
 
-        //  Get a reference to the class persistent buffer
-        unsigned char *pBuffer = getBuffer(recordLength);
+        if (recordBufferLength < (unsigned int)recordLength) {
+          recordBuffer = realloc(recordBuffer, recordLength);
+          recordBufferLength = recordLength;
+        }
+        unsigned char *pBuffer = (unsigned char *)recordBuffer;
 
         OSENC_Attribute_Record *pRecord = (OSENC_Attribute_Record *)pBuffer;
         memset(pRecord, 0, sizeof(OSENC_Attribute_Record));
@@ -3113,6 +3267,7 @@ bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
         size_t targetCount = recordLength;
         if (!stream->Write(pBuffer, targetCount).IsOk()) {
           free(payloadBuffer);
+          free(recordBuffer);
           return false;
         }
       }
@@ -3120,6 +3275,7 @@ bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
   }
 
   free(payloadBuffer);
+  free(recordBuffer);
 
 #if 0
     //    Special geometry cases
@@ -3153,7 +3309,8 @@ bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
     OGRwkbGeometryType gType = pGeo->getGeometryType();
     switch (gType) {
       case wkbLineString: {
-        if (!CreateLineFeatureGeometryRecord200(poReader, pFeature, stream))
+        if (!CreateLineFeatureGeometryRecord200(pFeature, stream, pvec_buffer,
+                                                nEdgeVectorRecords))
           return false;
 
         break;
@@ -3213,7 +3370,8 @@ bool Osenc::CreateSENCRecord200(OGRFeature *pFeature, Osenc_outstream *stream,
 #if 1
       //      Special case, polygons are handled separately
       case wkbPolygon: {
-        if (!CreateAreaFeatureGeometryRecord200(poReader, pFeature, stream))
+        if (!CreateAreaFeatureGeometryRecord200(pFeature, stream, pvec_buffer,
+                                                nEdgeVectorRecords))
           return false;
 
         break;
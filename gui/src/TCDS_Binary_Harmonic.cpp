@@ -21,9 +21,17 @@
  *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
  **************************************************************************/
 
+#include <string>
+#include <vector>
+
+#include <wx/filename.h>
+#include <wx/log.h>
+
 #include "TCDS_Binary_Harmonic.h"
 #include "tcmgr.h"
-#include <string>
+#include "OCPNPlatform.h"
+
+extern OCPNPlatform *g_Platform;
 /* Declarations for zoneinfo compatibility */
 
 /* Most of these entries are loaded from the tzdata.h include file. That
@@ -296,11 +304,13 @@ TCDS_Binary_Harmonic::TCDS_Binary_Harmonic() {
   m_cst_speeds = NULL;
   m_cst_nodes = NULL;
   m_cst_epochs = NULL;
+  m_work_buffer = NULL;
 
   num_IDX = 0;
   num_nodes = 0;
   num_csts = 0;
   num_epochs = 0;
+  m_first_year = 0;
 
   //  Build the units array
 }
@@ -317,8 +327,181 @@ TCDS_Binary_Harmonic::~TCDS_Binary_Harmonic()
   free(m_cst_speeds);
 }
 
+//  Station index sidecar, in the private data dir since the harmonics
+//  files may be installed read only
+static wxString StationIndexPath(const wxString &data_file_path) {
+  wxString dir = g_Platform->GetPrivateDataDir() +
+                 wxFileName::GetPathSeparator() + _T("tcdata_index");
+  if (!wxDirExists(dir)) wxFileName::Mkdir(dir, 0755, wxPATH_MKDIR_FULL);
+
+  wxCharBuffer buf = data_file_path.ToUTF8();
+  uint32_t hash = 2166136261u;  // FNV-1a
+  for (const char *c = buf.data(); *c; c++) {
+    hash ^= (unsigned char)*c;
+    hash *= 16777619u;
+  }
+  wxFileName fn(data_file_path);
+  return dir + wxFileName::GetPathSeparator() +
+         wxString::Format(_T("%s-%08x.stx"), fn.GetName().c_str(), hash);
+}
+
 TC_Error_Code TCDS_Binary_Harmonic::LoadData(const wxString &data_file_path) {
-  if (!open_tide_db(data_file_path.mb_str())) return TC_TCD_FILE_CORRUPT;
+  m_data_file_path = data_file_path;
+
+  wxFileName fn(data_file_path);
+  uint64_t source_size = fn.GetSize().GetValue();
+  int64_t source_time = fn.GetModificationTime().GetValue().GetValue();
+  wxString index_path = StationIndexPath(data_file_path);
+
+  //  The stations come from the index if it is current, and from a full
+  //  scan of the file otherwise. Constituents are read on first use.
+  StationIndex index;
+  if (index.Open(index_path.ToStdString(), source_size, source_time)) {
+    source_ident = wxString(index.GetIdent().c_str(), wxConvUTF8);
+    for (size_t i = 0; i < index.GetCount(); i++)
+      AddIndexEntry(index.GetEntry(i), index.GetName(i));
+    return TC_NO_ERROR;
+  }
+
+  std::vector<StationIndexEntry> entries;
+  std::vector<std::string> names;
+  TC_Error_Code err = ScanStations(entries, names);
+  if (err != TC_NO_ERROR) return err;
+
+  if (!StationIndex::Write(index_path.ToStdString(), source_size, source_time,
+                           std::string(source_ident.ToUTF8().data()),
+                           entries, names))
+    wxLogMessage(_T("Cannot write tide station index ") + index_path);
+
+  for (size_t i = 0; i < entries.size(); i++)
+    AddIndexEntry(entries[i], names[i].c_str());
+  return TC_NO_ERROR;
+}
+
+void TCDS_Binary_Harmonic::AddIndexEntry(const StationIndexEntry &e,
+                                         const char *name) {
+  num_IDX++;  // Keep counting entries for harmonic file stuff
+  IDX_entry *pIDX = new IDX_entry;
+  pIDX->source_data_type = SOURCE_TYPE_BINARY_HARMONIC;
+  pIDX->pDataSource = NULL;
+
+  pIDX->Valid15 = 0;
+
+  pIDX->pref_sta_data = NULL;  // no reference data yet
+  pIDX->IDX_Useable = 1;       // but assume data is OK
+  pIDX->IDX_tzname = NULL;
+
+  pIDX->IDX_lon = e.lon;
+  pIDX->IDX_lat = e.lat;
+  pIDX->IDX_time_zone = e.time_zone;
+
+  strncpy(pIDX->IDX_station_name, name, MAXNAMELEN - 1);
+  pIDX->IDX_station_name[MAXNAMELEN - 1] = '\0';
+  pIDX->current_depth = e.current_depth;
+
+  pIDX->IDX_flood_dir = e.flood_dir;
+  pIDX->IDX_ebb_dir = e.ebb_dir;
+  pIDX->IDX_type = e.type;
+
+  pIDX->IDX_ht_time_off = e.ht_time_off;
+  pIDX->IDX_ht_mpy = e.ht_mpy;
+  pIDX->IDX_ht_off = e.ht_off;
+  pIDX->IDX_lt_time_off = e.lt_time_off;
+  pIDX->IDX_lt_mpy = e.lt_mpy;
+  pIDX->IDX_lt_off = e.lt_off;
+  pIDX->IDX_ref_dbIndex = e.ref_index;
+  pIDX->have_offsets = e.have_offsets;
+
+  m_IDX_array.Add(pIDX);
+}
+
+TC_Error_Code TCDS_Binary_Harmonic::ScanStations(
+    std::vector<StationIndexEntry> &entries, std::vector<std::string> &names) {
+  TC_Error_Code err = LoadTables();
+  if (err != TC_NO_ERROR) return err;
+
+  DB_HEADER_PUBLIC hdr = get_tide_db_header();
+  entries.resize(hdr.number_of_records);
+  names.resize(hdr.number_of_records);
+
+  TIDE_RECORD *ptiderec = (TIDE_RECORD *)calloc(sizeof(TIDE_RECORD), 1);
+  for (unsigned int i = 0; i < hdr.number_of_records; i++) {
+    read_tide_record(i, ptiderec);
+
+    StationIndexEntry &e = entries[i];
+    memset(&e, 0, sizeof(e));
+    names[i] = ptiderec->header.name;
+
+    e.lon = ptiderec->header.longitude;
+    e.lat = ptiderec->header.latitude;
+
+    const char *tz = get_tzfile(ptiderec->header.tzfile);
+    change_time_zone((char *)tz);
+    if (tz_info) e.time_zone = -tz_info->tzi.Bias;
+
+    // Extract a "depth" value from name string, if present.
+    //  Name string will contain  "(depth xx ft)"
+    std::string name(ptiderec->header.name);
+    size_t n = name.find("depth");
+    if (n != std::string::npos) {
+      std::string d = name.substr(n);
+      std::string dp = d.substr(6);
+      size_t nd = dp.find_first_of(' ');
+      std::string sval = dp.substr(0, nd);
+      int depth = std::stoi(sval);
+      e.current_depth = depth;
+    }
+
+    e.flood_dir = ptiderec->max_direction;
+    e.ebb_dir = ptiderec->min_direction;
+
+    //    Establish Station Type
+    wxString caplin(ptiderec->header.name, wxConvUTF8);
+    caplin.MakeUpper();
+    bool current = caplin.Contains(_T("CURRENT"));
+
+    if (REFERENCE_STATION == ptiderec->header.record_type) {
+      e.type = current ? 'C' : 'T';
+
+      e.ht_time_off = e.lt_time_off = 0;
+      e.ht_mpy = e.lt_mpy = 1.0;
+      e.ht_off = e.lt_off = 0.0;
+      e.ref_index = i;
+      e.have_offsets = 0;
+    } else if (SUBORDINATE_STATION == ptiderec->header.record_type) {
+      e.type = current ? 'c' : 't';
+
+      int t1 = ptiderec->max_time_add;
+      double t1a = (double)(t1 / 100) + ((double)(t1 % 100)) / 60.;
+      t1a *= 60;  // Minutes
+      e.ht_time_off = t1a;
+      e.ht_mpy = ptiderec->max_level_multiply;
+      if (0. == e.ht_mpy) e.ht_mpy = 1.0;
+      e.ht_off = ptiderec->max_level_add;
+
+      t1 = ptiderec->min_time_add;
+      t1a = (double)(t1 / 100) + ((double)(t1 % 100)) / 60.;
+      t1a *= 60;  // Minutes
+      e.lt_time_off = t1a;
+      e.lt_mpy = ptiderec->min_level_multiply;
+      if (0. == e.lt_mpy) e.lt_mpy = 1.0;
+      e.lt_off = ptiderec->min_level_add;
+
+      e.ref_index = ptiderec->header.reference_station;
+
+      if (e.ht_time_off || e.ht_off != 0.0 || e.lt_off != 0.0 ||
+          e.ht_mpy != 1.0 || e.lt_mpy != 1.0)
+        e.have_offsets = 1;
+    }
+  }
+  free(ptiderec);
+  return TC_NO_ERROR;
+}
+
+TC_Error_Code TCDS_Binary_Harmonic::LoadTables() {
+  //  libtcd has one open database, shared by all binary sources
+  if (!open_tide_db(m_data_file_path.mb_str())) return TC_TCD_FILE_CORRUPT;
+  if (m_cst_speeds) return TC_NO_ERROR;
 
   // Build the tables of constituent data
 
@@ -326,11 +509,10 @@ TC_Error_Code TCDS_Binary_Harmonic::LoadData(const wxString &data_file_path) {
 
   source_ident = wxString(hdr.version, wxConvUTF8);
 
+  if (0 == hdr.constituents) return TC_GENERIC_ERROR;
+  if (0 == hdr.number_of_years) return TC_GENERIC_ERROR;
   num_csts = hdr.constituents;
-  if (0 == num_csts) return TC_GENERIC_ERROR;
-
   num_nodes = hdr.number_of_years;
-  if (0 == num_nodes) return TC_GENERIC_ERROR;
 
   //  Allocate a working buffer
   m_work_buffer = (double *)malloc(num_csts * sizeof(double));
@@ -369,175 +551,81 @@ TC_Error_Code TCDS_Binary_Harmonic::LoadData(const wxString &data_file_path) {
       m_cst_nodes[a][year] = get_node_factor(a, year);
   }
 
-  // now load and create the index
-
-  TIDE_RECORD *ptiderec = (TIDE_RECORD *)calloc(sizeof(TIDE_RECORD), 1);
-  for (unsigned int i = 0; i < hdr.number_of_records; i++) {
-    read_tide_record(i, ptiderec);
-
-    num_IDX++;  // Keep counting entries for harmonic file stuff
-    IDX_entry *pIDX = new IDX_entry;
-    pIDX->source_data_type = SOURCE_TYPE_BINARY_HARMONIC;
-    pIDX->pDataSource = NULL;
-
-    pIDX->Valid15 = 0;
-
-    pIDX->pref_sta_data = NULL;  // no reference data yet
-    pIDX->IDX_Useable = 1;       // but assume data is OK
-    pIDX->IDX_tzname = NULL;
-
-    pIDX->IDX_lon = ptiderec->header.longitude;
-    pIDX->IDX_lat = ptiderec->header.latitude;
-
-    const char *tz = get_tzfile(ptiderec->header.tzfile);
-    change_time_zone((char *)tz);
-    if (tz_info) pIDX->IDX_time_zone = -tz_info->tzi.Bias;
-
-    strncpy(pIDX->IDX_station_name, ptiderec->header.name, MAXNAMELEN);
-
-    // Extract a "depth" value from name string, if present.
-    //  Name string will contain  "(depth xx ft)"
-    std::string name(ptiderec->header.name);
-    size_t n = name.find("depth");
-    if (n != std::string::npos) {
-      std::string d = name.substr(n);
-      std::string dp = d.substr(6);
-      size_t nd = dp.find_first_of(' ');
-      std::string sval = dp.substr(0, nd);
-      int depth = std::stoi(sval);
-      pIDX->current_depth = depth;
-    }
-
-    pIDX->IDX_flood_dir = ptiderec->max_direction;
-    pIDX->IDX_ebb_dir = ptiderec->min_direction;
+  return TC_NO_ERROR;
+}
 
-    if (REFERENCE_STATION == ptiderec->header.record_type) {
-      //    Establish Station Type
-      wxString caplin(pIDX->IDX_station_name, wxConvUTF8);
-      caplin.MakeUpper();
-      if (caplin.Contains(_T("CURRENT")))
-        pIDX->IDX_type = 'C';
-      else
-        pIDX->IDX_type = 'T';
+Station_Data *TCDS_Binary_Harmonic::LoadStationData(int i) {
+  IDX_entry *pIDX = &m_IDX_array.Item(i);
+  if (pIDX->pref_sta_data) return pIDX->pref_sta_data;
 
-      int t1 = ptiderec->zone_offset;
-      double zone_offset = (double)(t1 / 100) + ((double)(t1 % 100)) / 60.;
-      //            pIDX->IDX_time_zone = t1a;
+  if (LoadTables() != TC_NO_ERROR) return NULL;
 
-      pIDX->IDX_ht_time_off = pIDX->IDX_lt_time_off = 0;
-      pIDX->IDX_ht_mpy = pIDX->IDX_lt_mpy = 1.0;
-      pIDX->IDX_ht_off = pIDX->IDX_lt_off = 0.0;
-      pIDX->IDX_ref_dbIndex = ptiderec->header.reference_station;  // will be -1
+  TIDE_RECORD *ptiderec = (TIDE_RECORD *)calloc(sizeof(TIDE_RECORD), 1);
+  if (read_tide_record(i, ptiderec) != i ||
+      REFERENCE_STATION != ptiderec->header.record_type) {
+    free(ptiderec);
+    return NULL;
+  }
 
-      //  build a Station_Data class, and add to member array
+  const char *tz = get_tzfile(ptiderec->header.tzfile);
+  change_time_zone((char *)tz);
 
-      Station_Data *psd = new Station_Data;
+  int t1 = ptiderec->zone_offset;
+  double zone_offset = (double)(t1 / 100) + ((double)(t1 % 100)) / 60.;
 
-      psd->amplitude = (double *)malloc(num_csts * sizeof(double));
-      psd->epoch = (double *)malloc(num_csts * sizeof(double));
-      psd->station_name = (char *)malloc(ONELINER_LENGTH);
+  //  build a Station_Data class, and add to member array
 
-      strncpy(psd->station_name, ptiderec->header.name, MAXNAMELEN);
-      psd->station_type = pIDX->IDX_type;
+  Station_Data *psd = new Station_Data;
 
-      // Get meridian, which is seconds difference from UTC, not figuring DST,
-      // so that New York is always (-300 * 60)
-      psd->meridian = -(tz_info->tzi.Bias * 60);
-      psd->zone_offset = zone_offset;
+  psd->amplitude = (double *)malloc(num_csts * sizeof(double));
+  psd->epoch = (double *)malloc(num_csts * sizeof(double));
+  psd->station_name = (char *)malloc(ONELINER_LENGTH);
 
-      // Get units
-      strncpy(psd->unit, get_level_units(ptiderec->level_units), 40 - 1);
-      psd->unit[40 - 1] = '\0';
+  strncpy(psd->station_name, ptiderec->header.name, MAXNAMELEN);
+  psd->station_type = pIDX->IDX_type;
 
-      psd->have_BOGUS = (findunit(psd->unit) != -1) &&
-                        (known_units[findunit(psd->unit)].type == BOGUS);
+  // Get meridian, which is seconds difference from UTC, not figuring DST,
+  // so that New York is always (-300 * 60)
+  psd->meridian = -(tz_info->tzi.Bias * 60);
+  psd->zone_offset = zone_offset;
 
-      int unit_c;
-      if (psd->have_BOGUS)
-        unit_c = findunit("knots");
-      else
-        unit_c = findunit(psd->unit);
-
-      if (unit_c != -1) {
-        strncpy(psd->units_conv, known_units[unit_c].name,
-                sizeof(psd->units_conv) - 1);
-        strncpy(psd->units_abbrv, known_units[unit_c].abbrv,
-                sizeof(psd->units_abbrv) - 1);
-      } else {
-        strncpy(psd->units_conv, psd->unit, 40 - 1);
-        psd->units_conv[40 - 1] = '\0';
-        strncpy(psd->units_abbrv, psd->unit, 20 - 1);
-        psd->units_abbrv[20 - 1] = '\0';
-      }
-
-      // Get constituents
-      for (int a = 0; a < num_csts; a++) {
-        psd->amplitude[a] = ptiderec->amplitude[a];
-        psd->epoch[a] = ptiderec->epoch[a] * M_PI / 180.;
-      }
-
-      psd->DATUM = ptiderec->datum_offset;
-
-      m_msd_array.Add(psd);  // add it to the member array
-      pIDX->pref_sta_data = psd;
-      pIDX->IDX_ref_dbIndex = i;
-      pIDX->have_offsets = 0;
-    } else if (SUBORDINATE_STATION == ptiderec->header.record_type) {
-      //    Establish Station Type
-      wxString caplin(pIDX->IDX_station_name, wxConvUTF8);
-      caplin.MakeUpper();
-      if (caplin.Contains(_T("CURRENT")))
-        pIDX->IDX_type = 'c';
-      else
-        pIDX->IDX_type = 't';
+  // Get units
+  strncpy(psd->unit, get_level_units(ptiderec->level_units), 40 - 1);
+  psd->unit[40 - 1] = '\0';
 
-      int t1 = ptiderec->max_time_add;
-      double t1a = (double)(t1 / 100) + ((double)(t1 % 100)) / 60.;
-      t1a *= 60;  // Minutes
-      pIDX->IDX_ht_time_off = t1a;
-      pIDX->IDX_ht_mpy = ptiderec->max_level_multiply;
-      if (0. == pIDX->IDX_ht_mpy) pIDX->IDX_ht_mpy = 1.0;
-      pIDX->IDX_ht_off = ptiderec->max_level_add;
+  psd->have_BOGUS = (findunit(psd->unit) != -1) &&
+                    (known_units[findunit(psd->unit)].type == BOGUS);
 
-      t1 = ptiderec->min_time_add;
-      t1a = (double)(t1 / 100) + ((double)(t1 % 100)) / 60.;
-      t1a *= 60;  // Minutes
-      pIDX->IDX_lt_time_off = t1a;
-      pIDX->IDX_lt_mpy = ptiderec->min_level_multiply;
-      if (0. == pIDX->IDX_lt_mpy) pIDX->IDX_lt_mpy = 1.0;
-      pIDX->IDX_lt_off = ptiderec->min_level_add;
-
-      pIDX->IDX_ref_dbIndex = ptiderec->header.reference_station;
-      //           strncpy(pIDX->IDX_reference_name, ptiderec->header.name,
-      //           MAXNAMELEN);
-
-      if (pIDX->IDX_ht_time_off || pIDX->IDX_ht_off != 0.0 ||
-          pIDX->IDX_lt_off != 0.0 || pIDX->IDX_ht_mpy != 1.0 ||
-          pIDX->IDX_lt_mpy != 1.0)
-        pIDX->have_offsets = 1;
-    }
+  int unit_c;
+  if (psd->have_BOGUS)
+    unit_c = findunit("knots");
+  else
+    unit_c = findunit(psd->unit);
 
-    m_IDX_array.Add(pIDX);
+  if (unit_c != -1) {
+    strncpy(psd->units_conv, known_units[unit_c].name,
+            sizeof(psd->units_conv) - 1);
+    strncpy(psd->units_abbrv, known_units[unit_c].abbrv,
+            sizeof(psd->units_abbrv) - 1);
+  } else {
+    strncpy(psd->units_conv, psd->unit, 40 - 1);
+    psd->units_conv[40 - 1] = '\0';
+    strncpy(psd->units_abbrv, psd->unit, 20 - 1);
+    psd->units_abbrv[20 - 1] = '\0';
   }
 
-  //  Mark the index entries individually with invariant harmonic constants
-  unsigned int max_index = GetMaxIndex();
-  for (unsigned int i = 0; i < max_index; i++) {
-    IDX_entry *pIDX = GetIndexEntry(i);
-    if (pIDX) {
-      pIDX->num_nodes = num_nodes;
-      pIDX->num_csts = num_csts;
-      pIDX->num_epochs = num_epochs;
-      pIDX->m_cst_speeds = m_cst_speeds;
-      pIDX->m_cst_nodes = m_cst_nodes;
-      pIDX->m_cst_epochs = m_cst_epochs;
-      pIDX->first_year = m_first_year;
-      pIDX->m_work_buffer = m_work_buffer;
-    }
+  // Get constituents
+  for (int a = 0; a < num_csts; a++) {
+    psd->amplitude[a] = ptiderec->amplitude[a];
+    psd->epoch[a] = ptiderec->epoch[a] * M_PI / 180.;
   }
+
+  psd->DATUM = ptiderec->datum_offset;
   free(ptiderec);
 
-  return TC_NO_ERROR;
+  m_msd_array.Add(psd);  // add it to the member array
+  pIDX->pref_sta_data = psd;
+  return psd;
 }
 
 IDX_entry *TCDS_Binary_Harmonic::GetIndexEntry(int n_index) {
@@ -547,16 +635,27 @@ IDX_entry *TCDS_Binary_Harmonic::GetIndexEntry(int n_index) {
 TC_Error_Code TCDS_Binary_Harmonic::LoadHarmonicData(IDX_entry *pIDX) {
   // Find the indicated Master station
   if (!strlen(pIDX->IDX_reference_name)) {
-    strncpy(pIDX->IDX_reference_name, get_station(pIDX->IDX_ref_dbIndex),
+    if (pIDX->IDX_ref_dbIndex < 0 || pIDX->IDX_ref_dbIndex >= num_IDX)
+      return TC_MASTER_HARMONICS_NOT_FOUND;
+
+    IDX_entry *pIDX_Ref = &m_IDX_array.Item(pIDX->IDX_ref_dbIndex);
+    Station_Data *pRefSta = LoadStationData(pIDX->IDX_ref_dbIndex);
+    if (!pRefSta) return TC_TCD_FILE_CORRUPT;
+
+    //  Mark the index entry with invariant harmonic constants
+    pIDX->num_nodes = num_nodes;
+    pIDX->num_csts = num_csts;
+    pIDX->num_epochs = num_epochs;
+    pIDX->m_cst_speeds = m_cst_speeds;
+    pIDX->m_cst_nodes = m_cst_nodes;
+    pIDX->m_cst_epochs = m_cst_epochs;
+    pIDX->first_year = m_first_year;
+    pIDX->m_work_buffer = m_work_buffer;
+
+    strncpy(pIDX->IDX_reference_name, pIDX_Ref->IDX_station_name,
             MAXNAMELEN - 1);
     pIDX->IDX_reference_name[MAXNAMELEN - 1] = '\0';
 
-    //        TIDE_RECORD *ptiderec = (TIDE_RECORD *)calloc(sizeof(TIDE_RECORD),
-    //        1); read_tide_record (pIDX->IDX_ref_dbIndex, ptiderec); free(
-    //        ptiderec );
-
-    IDX_entry *pIDX_Ref = &m_IDX_array.Item(pIDX->IDX_ref_dbIndex);
-    Station_Data *pRefSta = pIDX_Ref->pref_sta_data;
     pIDX->pref_sta_data = pRefSta;
     pIDX->station_tz_offset =
         -pRefSta->meridian + (pRefSta->zone_offset * 3600);
@@ -23,6 +23,7 @@
 
 #include <wx/log.h>
 #include <wx/filename.h>
+#include <wx/stopwatch.h>
 
 #include "TCDataSource.h"
 #include "TCDS_Ascii_Harmonic.h"
@@ -31,6 +32,8 @@
 #include <wx/arrimpl.cpp>
 WX_DEFINE_OBJARRAY(ArrayOfTCDSources);
 
+extern bool GetMemoryStatus(int *mem_total, int *mem_used);
+
 TCDataSource::TCDataSource() {
   m_pfactory = NULL;
   pTCDS_Ascii_Harmonic = NULL;
@@ -66,8 +69,16 @@ TC_Error_Code TCDataSource::LoadData(const wxString &data_file_path) {
 
   TC_Error_Code err_code;
   if (m_pfactory) {
+    wxStopWatch sw;
+    int mem_total, mem_before = 0, mem_after = 0;
+    GetMemoryStatus(&mem_total, &mem_before);
+
     err_code = m_pfactory->LoadData(data_file_path);
 
+    GetMemoryStatus(&mem_total, &mem_after);
+    wxLogMessage(_T("  %d stations loaded in %ld ms, memory used +%d kB"),
+                 GetMaxIndex(), sw.Time(), mem_after - mem_before);
+
     //  Mark the index entries individually with owner
     unsigned int max_index = GetMaxIndex();
     for (unsigned int i = 0; i < max_index; i++) {
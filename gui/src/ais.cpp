@@ -28,6 +28,9 @@
 #include <math.h>
 #include <time.h>
 
+#include <map>
+#include <vector>
+
 #ifdef __MINGW32__
 #undef IPV6STRICT  // mingw FTBS fix:  missing struct ip_mreq
 #include <windows.h>
@@ -60,6 +63,10 @@
 #include "ocpn_plugin.h"
 #include "styles.h"
 
+#ifdef ocpnUSE_GL
+#include "shaders.h"
+#endif
+
 extern MyFrame *gFrame;
 extern OCPNPlatform *g_Platform;
 
@@ -755,10 +762,24 @@ static void AISSetMetrics() {
       font->GetWeight(), false, font->GetFaceName());
 }
 
-static void AISDrawTarget(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
-                          ChartCanvas *cp) {
+//  Where and how large a target is drawn on a canvas
+struct AISTargetPlacement {
+  wxPoint TargetPoint;
+  wxPoint PredPoint;
+  float target_sog;
+  float theta;
+  float sin_theta;
+  float cos_theta;
+  bool b_hdgValid;
+  int targetscale;
+};
+
+//  Decide whether a target is drawn at all, and where. Updates the
+//  attenuation scale of the target on this canvas.
+static bool AISPlaceTarget(AisTargetData *td, ViewPort &vp, ChartCanvas *cp,
+                           AISTargetPlacement &place) {
   //      Target data must be valid
-  if (NULL == td) return;
+  if (NULL == td) return false;
 
   static bool firstTimeUse = true;
   //  First time AIS received
@@ -771,7 +792,7 @@ static void AISDrawTarget(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
   }
 
   //    Target is lost due to position report time-out, but still in Target List
-  if (td->b_lost) return;
+  if (td->b_lost) return false;
 
   //      Skip anchored/moored (interpreted as low speed) targets if requested
   //      unless the target is NUC or AtoN, in which case it is always
@@ -779,13 +800,13 @@ static void AISDrawTarget(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
   if ((g_bHideMoored) && (td->SOG <= g_ShowMoored_Kts) &&
       (td->NavStatus != NOT_UNDER_COMMAND) &&
       ((td->Class == AIS_CLASS_A) || (td->Class == AIS_CLASS_B)))
-    return;
+    return false;
 
   //      Target data position must have been valid once
-  if (!td->b_positionOnceValid) return;
+  if (!td->b_positionOnceValid) return false;
 
   // And we never draw ownship
-  if (td->b_OwnShip) return;
+  if (td->b_OwnShip) return false;
 
   //    If target's speed is unavailable, use zero for further calculations
   float target_sog = td->SOG;
@@ -832,7 +853,7 @@ static void AISDrawTarget(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
   }
 
   //    Do the draw if conditions indicate
-  if (!drawit) return;
+  if (!drawit) return false;
 
   GetCanvasPointPix(vp, cp, td->Lat, td->Lon, &TargetPoint);
   GetCanvasPointPix(vp, cp, pred_lat, pred_lon, &PredPoint);
@@ -883,20 +904,14 @@ static void AISDrawTarget(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
   // only need to compute this once;
   float sin_theta = sinf(theta), cos_theta = cosf(theta);
 
-  wxDash dash_long[2];
-  dash_long[0] = (int)(1.0 * gFrame->GetPrimaryCanvas()
-                                 ->GetPixPerMM());  // Long dash  <---------+
-  dash_long[1] =
-      (int)(0.5 * gFrame->GetPrimaryCanvas()->GetPixPerMM());  // Short gap |
-
   int targetscale = 100;
   int idxCC = 0;
   if (cp != NULL) {
     idxCC = cp->m_canvasIndex;
 
     if (idxCC > AIS_TARGETDATA_MAX_CANVAS - 1)
-      return;  // If more then n canvasses do not draw AIS anymore as we are
-               // running out of array index
+      return false;  // If more then n canvasses do not draw AIS anymore as
+                     // we are running out of array index
     if (cp->GetAttenAIS()) {
       if (td->NavStatus <= 15) {  // NavStatus > 15 is AtoN, and we don want
                                   // AtoN being counted for attenuation
@@ -914,6 +929,204 @@ static void AISDrawTarget(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
     }
   }
 
+  place.TargetPoint = TargetPoint;
+  place.PredPoint = PredPoint;
+  place.target_sog = target_sog;
+  place.theta = theta;
+  place.sin_theta = sin_theta;
+  place.cos_theta = cos_theta;
+  place.b_hdgValid = b_hdgValid;
+  place.targetscale = targetscale;
+  return true;
+}
+
+//  Fill colour of the target symbol
+static wxColour AISTargetColour(AisTargetData *td) {
+  // Default color is green
+  wxColour UINFG = GetGlobalColor(_T ( "UINFG" ));
+  wxColour colour = UINFG;
+
+  // Euro Inland targets render slightly differently, unless in InlandENC mode
+  if (td->b_isEuroInland && !g_bInlandEcdis)
+    colour = GetGlobalColor(_T ( "TEAL1" ));
+
+  // Target name comes from cache
+  if (td->b_nameFromCache) colour = GetGlobalColor(_T ( "GREEN5" ));
+
+  // and....
+  wxColour URED = GetGlobalColor(_T ( "URED" ));
+  if (!td->b_nameValid) colour = GetGlobalColor(_T ( "CHYLW" ));
+
+  if ((td->Class == AIS_DSC) &&
+      ((td->ShipType == 12) || (td->ShipType == 16)))  // distress(relayed)
+    colour = URED;
+
+  if (td->b_SarAircraftPosnReport) colour = UINFG;
+
+  if ((td->n_alert_state == AIS_ALERT_SET) && (td->bCPA_Valid)) colour = URED;
+
+  if ((td->n_alert_state == AIS_ALERT_NO_DIALOG_SET) && (td->bCPA_Valid) &&
+      (!td->b_isFollower))
+    colour = URED;
+
+  if (td->b_positionDoubtful) colour = GetGlobalColor(_T ( "UINFF" ));
+
+  return colour;
+}
+
+//  Navigational status as symbolized, with high speed craft told apart
+static int AISTargetNavStatus(AisTargetData *td) {
+  int navstatus = td->NavStatus;
+
+  // HSC usually have correct ShipType but navstatus == 0...
+  // Class B can have (HSC)ShipType but never navstatus.
+  if (((td->ShipType >= 40) && (td->ShipType < 50)) &&
+      (navstatus == UNDERWAY_USING_ENGINE || td->Class == AIS_CLASS_B))
+    navstatus = HSC;
+  return navstatus;
+}
+
+static void AISDrawTargetName(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
+                              wxPoint TargetPoint, int targetscale) {
+  if ((g_bShowAISName) && (targetscale > 75)) {
+    int true_scale_display = (int)(floor(vp.chart_scale / 100.) * 100);
+    if (true_scale_display <
+        g_Show_Target_Name_Scale) {  // from which scale to display name
+
+      wxString tgt_name = td->GetFullName();
+      tgt_name = tgt_name.substr(0, tgt_name.find(_T ( "Unknown" ), 0));
+
+      if (tgt_name != wxEmptyString) {
+        dc.SetFont(*AIS_NameFont);
+        dc.SetTextForeground(FontMgr::Get().GetFontColor(_("AIS Target Name")));
+
+        int w, h;
+        dc.GetTextExtent(_T("W"), &w, &h);
+        h *= g_Platform->GetDisplayDIPMult(gFrame);
+        w *= g_Platform->GetDisplayDIPMult(gFrame);
+
+        if ((td->COG > 90) && (td->COG < 180))
+          dc.DrawText(tgt_name, TargetPoint.x + w, TargetPoint.y - h);
+        else
+          dc.DrawText(tgt_name, TargetPoint.x + w,
+                      TargetPoint.y /*+ (0.5 * h)*/);
+
+      }  // If name do not empty
+    }    // if scale
+  }
+}
+
+//  Canvas points, colour and width of the target track, false if it is
+//  not shown
+static bool AISGetTargetTrack(AisTargetData *td, ViewPort &vp, ChartCanvas *cp,
+                              std::vector<wxPoint> &TrackPoints, wxColour &c,
+                              float &width) {
+  //  Check the Special MMSI Properties array
+  bool b_noshow = false;
+  bool b_forceshow = false;
+  for (unsigned int i = 0; i < g_MMSI_Props_Array.GetCount(); i++) {
+    if (td->MMSI == g_MMSI_Props_Array[i]->MMSI) {
+      MmsiProperties *props = g_MMSI_Props_Array[i];
+      if (TRACKTYPE_NEVER == props->TrackType) {
+        b_noshow = true;
+        break;
+      } else if (TRACKTYPE_ALWAYS == props->TrackType) {
+        b_forceshow = true;
+        break;
+      } else
+        break;
+    }
+  }
+
+  int TrackLength = td->m_ptrack.size();
+  if (!((!b_noshow && td->b_show_track) || b_forceshow) || (TrackLength < 2))
+    return false;
+
+  //  create vector of x-y points
+  TrackPoints.resize(TrackLength);
+  int TrackPointCount = 0;
+  for (const AISTargetTrackPoint &ptrack_point : td->m_ptrack) {
+    GetCanvasPointPix(vp, cp, ptrack_point.m_lat, ptrack_point.m_lon,
+                      &TrackPoints[TrackPointCount++]);
+  }
+
+  c = GetGlobalColor(_T ( "CHMGD" ));
+  width = 1.5 * AIS_nominal_line_width_pix;
+
+  // Check for any persistently tracked target
+  // Render persistently tracked targets slightly differently.
+  std::map<int, Track *>::iterator itt;
+  itt = g_pAIS->m_persistent_tracks.find(td->MMSI);
+  if (itt != g_pAIS->m_persistent_tracks.end()) {
+    auto *ptrack = itt->second;
+    if (ptrack->m_Colour == wxEmptyString) {
+      c = GetGlobalColor(_T ( "TEAL1" ));
+      width = 2.0 * AIS_nominal_line_width_pix;
+    } else {
+      for (unsigned int i = 0; i < sizeof(::GpxxColorNames) / sizeof(wxString);
+           i++) {
+        if (ptrack->m_Colour == ::GpxxColorNames[i]) {
+          c = ::GpxxColors[i];
+          width = 2.0 * AIS_nominal_line_width_pix;
+          break;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+static void AISDrawTargetTrack(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
+                               ChartCanvas *cp) {
+  //  Draw tracks if enabled
+  static std::vector<wxPoint> TrackPoints;
+  wxColour c;
+  float width;
+  if (!AISGetTargetTrack(td, vp, cp, TrackPoints, c, width)) return;
+
+  int TrackPointCount = TrackPoints.size();
+  dc.SetPen(wxPen(c, width));
+
+#ifdef ocpnUSE_GL
+#if !defined(USE_ANDROID_GLES2) && !defined(ocpnUSE_GLSL)
+
+  if (!dc.GetDC()) {
+    glLineWidth(2);
+    glColor3ub(c.Red(), c.Green(), c.Blue());
+    glBegin(GL_LINE_STRIP);
+
+    for (const wxPoint &point : TrackPoints) glVertex2i(point.x, point.y);
+
+    glEnd();
+  } else {
+    dc.DrawLines(TrackPointCount, TrackPoints.data());
+  }
+#else
+  dc.DrawLines(TrackPointCount, TrackPoints.data());
+#endif
+
+#else
+  if (dc.GetDC()) dc.StrokeLines(TrackPointCount, TrackPoints.data());
+
+#endif
+}
+
+static void AISDrawTarget(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
+                          ChartCanvas *cp, const AISTargetPlacement &place) {
+  wxPoint TargetPoint = place.TargetPoint;
+  wxPoint PredPoint = place.PredPoint;
+  float target_sog = place.target_sog;
+  float theta = place.theta;
+  float sin_theta = place.sin_theta, cos_theta = place.cos_theta;
+  bool b_hdgValid = place.b_hdgValid;
+  int targetscale = place.targetscale;
+
+  wxDash dash_long[2];
+  dash_long[0] = (int)(1.0 * gFrame->GetPrimaryCanvas()
+                                 ->GetPixPerMM());  // Long dash  <---------+
+  dash_long[1] =
+      (int)(0.5 * gFrame->GetPrimaryCanvas()->GetPixPerMM());  // Short gap |
+
   //  Draw the icon rotated to the COG
   wxPoint ais_real_size[6];
   bool bcan_draw_size = true;
@@ -1014,37 +1227,8 @@ static void AISDrawTarget(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
   wxColour UBLCK = GetGlobalColor(_T ( "UBLCK" ));
   dc.SetPen(wxPen(UBLCK));
 
-  // Default color is green
-  wxColour UINFG = GetGlobalColor(_T ( "UINFG" ));
-  wxBrush target_brush = wxBrush(UINFG);
-
-  // Euro Inland targets render slightly differently, unless in InlandENC mode
-  if (td->b_isEuroInland && !g_bInlandEcdis)
-    target_brush = wxBrush(GetGlobalColor(_T ( "TEAL1" )));
-
-  // Target name comes from cache
-  if (td->b_nameFromCache)
-    target_brush = wxBrush(GetGlobalColor(_T ( "GREEN5" )));
-
-  // and....
   wxColour URED = GetGlobalColor(_T ( "URED" ));
-  if (!td->b_nameValid) target_brush = wxBrush(GetGlobalColor(_T ( "CHYLW" )));
-
-  if ((td->Class == AIS_DSC) &&
-      ((td->ShipType == 12) || (td->ShipType == 16)))  // distress(relayed)
-    target_brush = wxBrush(URED);
-
-  if (td->b_SarAircraftPosnReport) target_brush = wxBrush(UINFG);
-
-  if ((td->n_alert_state == AIS_ALERT_SET) && (td->bCPA_Valid))
-    target_brush = wxBrush(URED);
-
-  if ((td->n_alert_state == AIS_ALERT_NO_DIALOG_SET) && (td->bCPA_Valid) &&
-      (!td->b_isFollower))
-    target_brush = wxBrush(URED);
-
-  if (td->b_positionDoubtful)
-    target_brush = wxBrush(GetGlobalColor(_T ( "UINFF" )));
+  wxBrush target_brush = wxBrush(AISTargetColour(td));
 
   wxPen target_outline_pen(UBLCK, AIS_width_target_outline);
 
@@ -1564,13 +1748,7 @@ static void AISDrawTarget(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
     }
 
     dc.SetBrush(wxBrush(GetGlobalColor(_T ( "SHIPS" ))));
-    int navstatus = td->NavStatus;
-
-    // HSC usually have correct ShipType but navstatus == 0...
-    // Class B can have (HSC)ShipType but never navstatus.
-    if (((td->ShipType >= 40) && (td->ShipType < 50)) &&
-        (navstatus == UNDERWAY_USING_ENGINE || td->Class == AIS_CLASS_B))
-      navstatus = HSC;
+    int navstatus = AISTargetNavStatus(td);
 
     if (targetscale > 90) {
       switch (navstatus) {
@@ -1706,120 +1884,282 @@ static void AISDrawTarget(AisTargetData *td, ocpnDC &dc, ViewPort &vp,
     }
   }
 
-  if ((g_bShowAISName) && (targetscale > 75)) {
-    int true_scale_display = (int)(floor(vp.chart_scale / 100.) * 100);
-    if (true_scale_display <
-        g_Show_Target_Name_Scale) {  // from which scale to display name
+  AISDrawTargetName(td, dc, vp, TargetPoint, targetscale);
+  AISDrawTargetTrack(td, dc, vp, cp);
+}
 
-      wxString tgt_name = td->GetFullName();
-      tgt_name = tgt_name.substr(0, tgt_name.find(_T ( "Unknown" ), 0));
+#if defined(USE_ANDROID_GLES2) || defined(ocpnUSE_GLSL)
+/**
+ * Plain vessel targets on a GL canvas, drawn together.
+ *
+ * GLES2 has no instanced drawing. The attributes of each target are
+ * collected instead, and expanded into the triangles of a few vertex
+ * arrays, one per layer and colour, when the batch is flushed. Some
+ * hundred targets so take a dozen draw calls rather than several each.
+ *
+ * Targets with more than a glyph, COG predictor, name and track go
+ * through AISDrawTarget().
+ */
+class AISGlyphBatch {
+public:
+  /** Queue the target, false if it must be drawn by AISDrawTarget(). */
+  bool Add(AisTargetData *td, const AISTargetPlacement &place, ViewPort &vp,
+           ChartCanvas *cp);
+  /** Draw the queued targets, on top of what was drawn before. */
+  void Flush(ocpnDC &dc, ViewPort &vp);
+
+private:
+  struct Instance {
+    AisTargetData *td;
+    wxPoint point;
+    float sin_theta;
+    float cos_theta;
+    int targetscale;
+    wxUint32 colour;
+    bool b_cog;  // clipped COG line and predictor circle
+    wxPoint cog[2];
+    wxPoint pred;
+    bool b_rot;  // rate of turn vector from cog[1]
+    wxPoint rot;
+  };
+
+  //  Back to front
+  enum {
+    kTrack,
+    kCogBase,
+    kCogLine,
+    kPredFill,
+    kPredOutline,
+    kGlyphFill,
+    kGlyphOutline,
+    kLayers
+  };
+  using Layer = std::map<wxUint32, std::vector<float>>;
+
+  static void AddTriangle(std::vector<float> &v, float x0, float y0, float x1,
+                          float y1, float x2, float y2);
+  static void AddLine(std::vector<float> &v, float x1, float y1, float x2,
+                      float y2, float width);
+
+  std::vector<Instance> m_instances;
+  std::vector<wxPoint> m_track;
+  Layer m_layers[kLayers];
+};
 
-      if (tgt_name != wxEmptyString) {
-        dc.SetFont(*AIS_NameFont);
-        dc.SetTextForeground(FontMgr::Get().GetFontColor(_("AIS Target Name")));
+bool AISGlyphBatch::Add(AisTargetData *td, const AISTargetPlacement &place,
+                        ViewPort &vp, ChartCanvas *cp) {
+  if (g_bInlandEcdis || g_bDrawAISSize) return false;
+  if ((td->Class != AIS_CLASS_A) && (td->Class != AIS_CLASS_B)) return false;
+  if (!td->b_active || td->b_isFollower || td->b_SarAircraftPosnReport)
+    return false;
+  if (td->blue_paddle && td->blue_paddle < 3) return false;
+
+  //  CPA and intercept lines
+  if (td->bCPA_Valid &&
+      ((td->n_alert_state == AIS_ALERT_SET) || td->b_show_AIS_CPA))
+    return false;
+
+  //  Highlight of an open alert or query dialog
+  auto alert_dlg_active =
+      dynamic_cast<AISTargetAlertDialog *>(g_pais_alert_dialog_active);
+  if (alert_dlg_active && alert_dlg_active->IsShown() &&
+      alert_dlg_active->Get_Dialog_MMSI() == td->MMSI)
+    return false;
+  if (g_pais_query_dialog_active && g_pais_query_dialog_active->IsShown() &&
+      g_pais_query_dialog_active->GetMMSI() == td->MMSI)
+    return false;
+
+  //  Realtime predicted position
+  if (g_bDrawAISRealtime && td->SOG > g_AIS_RealtPred_Kts && td->SOG < 102.2)
+    return false;
+
+  //  Navigational status symbols
+  if (place.targetscale > 90) {
+    switch (AISTargetNavStatus(td)) {
+      case MOORED:
+      case AT_ANCHOR:
+      case RESTRICTED_MANOEUVRABILITY:
+      case CONSTRAINED_BY_DRAFT:
+      case NOT_UNDER_COMMAND:
+      case FISHING:
+      case AGROUND:
+      case HSC:
+      case WIG:
+        return false;
+      default:
+        break;
+    }
+  }
 
-        int w, h;
-        dc.GetTextExtent(_T("W"), &w, &h);
-        h *= g_Platform->GetDisplayDIPMult(gFrame);
-        w *= g_Platform->GetDisplayDIPMult(gFrame);
+  Instance t;
+  t.td = td;
+  t.point = place.TargetPoint;
+  t.sin_theta = place.sin_theta;
+  t.cos_theta = place.cos_theta;
+  t.targetscale = place.targetscale;
+  t.colour = AISTargetColour(td).GetRGB();
+  t.b_cog = false;
+  t.b_rot = false;
+
+  if ((g_bShowCOG) && (place.target_sog > g_SOGminCOG_kts)) {
+    wxPoint TargetPoint = place.TargetPoint;
+    wxPoint PredPoint = place.PredPoint;
+    float l = sqrtf(powf((float)(PredPoint.x - TargetPoint.x), 2) +
+                    powf((float)(PredPoint.y - TargetPoint.y), 2));
 
-        if ((td->COG > 90) && (td->COG < 180))
-          dc.DrawText(tgt_name, TargetPoint.x + w, TargetPoint.y - h);
+    if (l > 24) {
+      //  Dashed, attenuated predictor
+      if (place.targetscale < 75) return false;
+
+      t.cog[0] = TargetPoint;
+      t.cog[1] = PredPoint;
+      ClipResult res = cohen_sutherland_line_clip_i(
+          &t.cog[0].x, &t.cog[0].y, &t.cog[1].x, &t.cog[1].y, 0, vp.pix_width,
+          0, vp.pix_height);
+      t.b_cog = res != Invisible;
+      t.pred = PredPoint;
+
+      //      RateOfTurn Vector
+      if ((td->ROTAIS != 0) && (td->ROTAIS != -128) && (!g_bShowScaled)) {
+        float theta2 = place.theta;
+        if (td->SOG >= g_SOGminCOG_kts) theta2 = td->COG * PI / 180. - PI / 2;
+        if (td->ROTAIS > 0)
+          theta2 += (float)PI / 2;
         else
-          dc.DrawText(tgt_name, TargetPoint.x + w,
-                      TargetPoint.y /*+ (0.5 * h)*/);
+          theta2 -= (float)PI / 2;
 
-      }  // If name do not empty
-    }    // if scale
+        float nv = 10;
+        t.b_rot = true;
+        t.rot = wxPoint((int)round(t.cog[1].x + (nv * cosf(theta2))),
+                        (int)round(t.cog[1].y + (nv * sinf(theta2))));
+      }
+    }
   }
 
-  //  Draw tracks if enabled
-  //  Check the Special MMSI Properties array
-  bool b_noshow = false;
-  bool b_forceshow = false;
-  for (unsigned int i = 0; i < g_MMSI_Props_Array.GetCount(); i++) {
-    if (td->MMSI == g_MMSI_Props_Array[i]->MMSI) {
-      MmsiProperties *props = g_MMSI_Props_Array[i];
-      if (TRACKTYPE_NEVER == props->TrackType) {
-        b_noshow = true;
-        break;
-      } else if (TRACKTYPE_ALWAYS == props->TrackType) {
-        b_forceshow = true;
-        break;
-      } else
-        break;
-    }
+  wxColour c;
+  float width;
+  if (AISGetTargetTrack(td, vp, cp, m_track, c, width)) {
+    std::vector<float> &v = m_layers[kTrack][c.GetRGB()];
+    for (size_t i = 1; i < m_track.size(); i++)
+      AddLine(v, m_track[i - 1].x, m_track[i - 1].y, m_track[i].x,
+              m_track[i].y, width);
   }
 
-  int TrackLength = td->m_ptrack.size();
-  if (((!b_noshow && td->b_show_track) || b_forceshow) && (TrackLength > 1)) {
-    //  create vector of x-y points
-    int TrackPointCount;
-    wxPoint *TrackPoints = 0;
-    TrackPoints = new wxPoint[TrackLength];
-    auto it = td->m_ptrack.begin();
-    for (TrackPointCount = 0;
-         it != td->m_ptrack.end() && (TrackPointCount < TrackLength);
-         TrackPointCount++, ++it) {
-      const AISTargetTrackPoint &ptrack_point = *it;
-      GetCanvasPointPix(vp, cp, ptrack_point.m_lat, ptrack_point.m_lon,
-                        &TrackPoints[TrackPointCount]);
-    }
+  m_instances.push_back(t);
+  return true;
+}
 
-    wxColour c = GetGlobalColor(_T ( "CHMGD" ));
-    dc.SetPen(wxPen(c, 1.5 * AIS_nominal_line_width_pix));
-
-    // Check for any persistently tracked target
-    // Render persistently tracked targets slightly differently.
-    std::map<int, Track *>::iterator itt;
-    itt = g_pAIS->m_persistent_tracks.find(td->MMSI);
-    if (itt != g_pAIS->m_persistent_tracks.end()) {
-      auto *ptrack = itt->second;
-      if (ptrack->m_Colour == wxEmptyString) {
-        c = GetGlobalColor(_T ( "TEAL1" ));
-        dc.SetPen(wxPen(c, 2.0 * AIS_nominal_line_width_pix));
-      } else {
-        for (unsigned int i = 0;
-             i < sizeof(::GpxxColorNames) / sizeof(wxString); i++) {
-          if (ptrack->m_Colour == ::GpxxColorNames[i]) {
-            c = ::GpxxColors[i];
-            dc.SetPen(wxPen(c, 2.0 * AIS_nominal_line_width_pix));
-            break;
-          }
-        }
-      }
-    }
+void AISGlyphBatch::AddTriangle(std::vector<float> &v, float x0, float y0,
+                                float x1, float y1, float x2, float y2) {
+  v.insert(v.end(), {x0, y0, x1, y1, x2, y2});
+}
 
-#ifdef ocpnUSE_GL
-#if !defined(USE_ANDROID_GLES2) && !defined(ocpnUSE_GLSL)
+void AISGlyphBatch::AddLine(std::vector<float> &v, float x1, float y1,
+                            float x2, float y2, float width) {
+  float dx = x2 - x1, dy = y2 - y1;
+  float l = sqrtf(dx * dx + dy * dy);
+  if (l == 0) return;
+  float nx = -dy / l * width / 2, ny = dx / l * width / 2;
+  AddTriangle(v, x1 + nx, y1 + ny, x2 + nx, y2 + ny, x1 - nx, y1 - ny);
+  AddTriangle(v, x1 - nx, y1 - ny, x2 + nx, y2 + ny, x2 - nx, y2 - ny);
+}
 
-    if (!dc.GetDC()) {
-      glLineWidth(2);
-      glColor3ub(c.Red(), c.Green(), c.Blue());
-      glBegin(GL_LINE_STRIP);
+void AISGlyphBatch::Flush(ocpnDC &dc, ViewPort &vp) {
+  if (m_instances.empty()) return;
 
-      for (TrackPointCount = 0; TrackPointCount < TrackLength;
-           TrackPointCount++)
-        glVertex2i(TrackPoints[TrackPointCount].x,
-                   TrackPoints[TrackPointCount].y);
+  wxUint32 black = GetGlobalColor(_T ( "UBLCK" )).GetRGB();
+  bool b_narrow = AIS_width_cogpredictor_base > 1;
 
-      glEnd();
-    } else {
-      dc.DrawLines(TrackPointCount, TrackPoints);
-    }
-#else
-    dc.DrawLines(TrackPointCount, TrackPoints);
-#endif
+  //  Unit circle of the predictor point
+  const int kSides = 12;
+  float circle[kSides + 1][2];
+  for (int i = 0; i <= kSides; i++) {
+    circle[i][0] = cosf(2 * PI * i / kSides);
+    circle[i][1] = sinf(2 * PI * i / kSides);
+  }
 
-#else
-    if (dc.GetDC()) dc.StrokeLines(TrackPointCount, TrackPoints);
+  for (const Instance &t : m_instances) {
+    if (t.b_cog) {
+      AddLine(m_layers[kCogBase][t.colour], t.cog[0].x, t.cog[0].y, t.cog[1].x,
+              t.cog[1].y, AIS_width_cogpredictor_base);
+      if (b_narrow)
+        AddLine(m_layers[kCogLine][black], t.cog[0].x, t.cog[0].y, t.cog[1].x,
+                t.cog[1].y, AIS_width_cogpredictor_line);
+
+      float r = AIS_intercept_bar_circle_diameter * AIS_user_scale_factor *
+                t.targetscale / 100;
+      std::vector<float> &fill = m_layers[kPredFill][t.colour];
+      std::vector<float> &outline = m_layers[kPredOutline][black];
+      for (int i = 0; i < kSides; i++) {
+        float x0 = t.pred.x + r * circle[i][0];
+        float y0 = t.pred.y + r * circle[i][1];
+        float x1 = t.pred.x + r * circle[i + 1][0];
+        float y1 = t.pred.y + r * circle[i + 1][1];
+        AddTriangle(fill, t.pred.x, t.pred.y, x0, y0, x1, y1);
+        AddLine(outline, x0, y0, x1, y1, AIS_width_cogpredictor_line);
+      }
+    }
+    if (t.b_rot) {
+      if (b_narrow)
+        AddLine(m_layers[kCogLine][black], t.cog[1].x, t.cog[1].y, t.rot.x,
+                t.rot.y, AIS_width_cogpredictor_line);
+      else
+        AddLine(m_layers[kCogBase][t.colour], t.cog[1].x, t.cog[1].y, t.rot.x,
+                t.rot.y, AIS_width_cogpredictor_base);
+    }
 
-#endif
+    //  The quad icon, rotated to the COG
+    float scale = t.targetscale / 100.;
+    float icon[4][2] = {{-8, -6}, {0, 24}, {8, -6}, {0, -6}};
+    //   AIS Class B targets are symbolized differently
+    if (t.td->Class == AIS_CLASS_B) icon[3][1] = 0;
+    for (auto &p : icon) {
+      float x = p[0] * scale, y = p[1] * scale;
+      p[0] = t.point.x +
+             AIS_scale_factor * (x * t.sin_theta + y * t.cos_theta);
+      p[1] = t.point.y +
+             AIS_scale_factor * (y * t.sin_theta - x * t.cos_theta);
+    }
+    std::vector<float> &fill = m_layers[kGlyphFill][t.colour];
+    AddTriangle(fill, icon[3][0], icon[3][1], icon[0][0], icon[0][1],
+                icon[1][0], icon[1][1]);
+    AddTriangle(fill, icon[3][0], icon[3][1], icon[1][0], icon[1][1],
+                icon[2][0], icon[2][1]);
+    std::vector<float> &outline = m_layers[kGlyphOutline][black];
+    for (int i = 0; i < 4; i++)
+      AddLine(outline, icon[i][0], icon[i][1], icon[(i + 1) % 4][0],
+              icon[(i + 1) % 4][1], AIS_width_target_outline);
+  }
 
-    delete[] TrackPoints;
+  GLShaderProgram *shader = pcolor_tri_shader_program[dc.m_canvasIndex];
+  shader->Bind();
+  for (Layer &layer : m_layers) {
+    for (auto &it : layer) {
+      std::vector<float> &v = it.second;
+      if (v.empty()) continue;
+
+      wxColour c;
+      c.SetRGB(it.first);
+      float colorv[4];
+      colorv[0] = c.Red() / float(256);
+      colorv[1] = c.Green() / float(256);
+      colorv[2] = c.Blue() / float(256);
+      colorv[3] = 1.0;
+      shader->SetUniform4fv("color", colorv);
+      shader->SetAttributePointerf("position", v.data());
+      glDrawArrays(GL_TRIANGLES, 0, v.size() / 2);
+
+      //  Keep the storage for the next frame
+      v.clear();
+    }
+  }
+  shader->UnBind();
 
-  }  // Draw tracks
+  for (const Instance &t : m_instances)
+    AISDrawTargetName(t.td, dc, vp, t.point, t.targetscale);
+  m_instances.clear();
 }
+#endif
 
 void AISDraw(ocpnDC &dc, ViewPort &vp, ChartCanvas *cp) {
   if (!g_pAIS) return;
@@ -1875,11 +2215,12 @@ void AISDraw(ocpnDC &dc, ViewPort &vp, ChartCanvas *cp) {
   // if yes add the importancefactor to a sorted list
   AISImportanceSwitchPoint = 0.0;
 
-  float *Array = new float[g_ShowScaled_Num];
-  for (int i = 0; i < g_ShowScaled_Num; i++) Array[i] = 0.0;
+  //  The g_ShowScaled_Num most important targets in view, kept between frames
+  static std::vector<float> Array;
+  Array.assign(g_ShowScaled_Num, 0.0);
 
   int LowestInd = 0;
-  if (cp != NULL) {
+  if (cp != NULL && !Array.empty()) {
     if (cp->GetAttenAIS()) {
       for (const auto &it : current_targets) {
         auto td = it.second;
@@ -1900,7 +2241,25 @@ void AISDraw(ocpnDC &dc, ViewPort &vp, ChartCanvas *cp) {
       }
     }
   }
-  delete[] Array;
+
+#if defined(USE_ANDROID_GLES2) || defined(ocpnUSE_GLSL)
+  static AISGlyphBatch glyph_batch;
+  AISGlyphBatch *batch = dc.GetDC() ? NULL : &glyph_batch;
+#endif
+
+  auto draw_target = [&](AisTargetData *td) {
+    AISTargetPlacement place;
+    if (!AISPlaceTarget(td, vp, cp, place)) return;
+#if defined(USE_ANDROID_GLES2) || defined(ocpnUSE_GLSL)
+    if (batch && batch->Add(td, place, vp, cp)) return;
+#endif
+    AISDrawTarget(td, dc, vp, cp, place);
+  };
+  auto end_pass = [&]() {
+#if defined(USE_ANDROID_GLES2) || defined(ocpnUSE_GLSL)
+    if (batch) batch->Flush(dc, vp);
+#endif
+  };
 
   //    Draw all targets in three pass loop, sorted on SOG, GPSGate & DSC on top
   //    This way, fast targets are not obscured by slow/stationary targets
@@ -1908,23 +2267,24 @@ void AISDraw(ocpnDC &dc, ViewPort &vp, ChartCanvas *cp) {
     auto td = it.second;
     if ((td->SOG < g_SOGminCOG_kts) &&
         !((td->Class == AIS_GPSG_BUDDY) || (td->Class == AIS_DSC))) {
-      AISDrawTarget(td.get(), dc, vp, cp);
+      draw_target(td.get());
     }
   }
+  end_pass();
 
   for (const auto &it : current_targets) {
     auto td = it.second;
     if ((td->SOG >= g_SOGminCOG_kts) &&
         !((td->Class == AIS_GPSG_BUDDY) || (td->Class == AIS_DSC))) {
-      AISDrawTarget(td.get(), dc, vp, cp);  // yes this is a doubling of code;(
-      if (td->importance > 0) AISDrawTarget(td.get(), dc, vp, cp);
+      draw_target(td.get());
     }
   }
+  end_pass();
 
   for (const auto &it : current_targets) {
     auto td = it.second;
     if ((td->Class == AIS_GPSG_BUDDY) || (td->Class == AIS_DSC))
-      AISDrawTarget(td.get(), dc, vp, cp);
+      draw_target(td.get());
   }
 }
 
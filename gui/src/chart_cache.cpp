@@ -0,0 +1,144 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  LRU list and byte accounting of open charts
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#include "chart_cache.h"
+
+ChartCache::ChartCache()
+    : m_head(0),
+      m_tail(0),
+      m_count(0),
+      m_hits(0),
+      m_misses(0),
+      m_evictions(0) {
+  for (int i = 0; i < CHART_CACHE_N_FAMILY; i++) {
+    m_bytes[i] = 0;
+    m_budget[i] = 0;
+  }
+}
+
+int ChartCache::Bucket(int family) {
+  if (family < 0 || family >= CHART_CACHE_N_FAMILY) return 0;
+  return family;
+}
+
+void ChartCache::Link(CacheEntry *pce) {
+  pce->lru_prev = 0;
+  pce->lru_next = m_head;
+  if (m_head) m_head->lru_prev = pce;
+  m_head = pce;
+  if (!m_tail) m_tail = pce;
+}
+
+void ChartCache::Unlink(CacheEntry *pce) {
+  if (pce->lru_prev)
+    pce->lru_prev->lru_next = pce->lru_next;
+  else
+    m_head = pce->lru_next;
+  if (pce->lru_next)
+    pce->lru_next->lru_prev = pce->lru_prev;
+  else
+    m_tail = pce->lru_prev;
+  pce->lru_prev = pce->lru_next = 0;
+}
+
+void ChartCache::Add(CacheEntry *pce) {
+  pce->family = Bucket(pce->family);
+  Link(pce);
+  m_count++;
+  m_bytes[pce->family] += pce->bytes;
+
+  m_by_path[pce->FullPath] = pce;
+  m_by_index[pce->dbIndex] = pce;
+  m_by_chart[pce->pChart] = pce;
+}
+
+void ChartCache::Remove(CacheEntry *pce) {
+  Unlink(pce);
+  m_count--;
+  m_bytes[pce->family] -= pce->bytes;
+
+  ChartCachePathHash::iterator ip = m_by_path.find(pce->FullPath);
+  if (ip != m_by_path.end() && ip->second == pce) m_by_path.erase(ip);
+  auto ii = m_by_index.find(pce->dbIndex);
+  if (ii != m_by_index.end() && ii->second == pce) m_by_index.erase(ii);
+  auto ic = m_by_chart.find(pce->pChart);
+  if (ic != m_by_chart.end() && ic->second == pce) m_by_chart.erase(ic);
+}
+
+void ChartCache::Touch(CacheEntry *pce) {
+  m_hits++;
+  if (pce == m_head) return;
+  Unlink(pce);
+  Link(pce);
+}
+
+CacheEntry *ChartCache::Find(const wxString &path) const {
+  ChartCachePathHash::const_iterator it = m_by_path.find(path);
+  return it == m_by_path.end() ? 0 : it->second;
+}
+
+CacheEntry *ChartCache::Find(int dbIndex) const {
+  auto it = m_by_index.find(dbIndex);
+  return it == m_by_index.end() ? 0 : it->second;
+}
+
+CacheEntry *ChartCache::FindChart(const void *pChart) const {
+  auto it = m_by_chart.find(pChart);
+  return it == m_by_chart.end() ? 0 : it->second;
+}
+
+void ChartCache::SetBytes(CacheEntry *pce, size_t bytes) {
+  m_bytes[pce->family] -= pce->bytes;
+  pce->bytes = bytes;
+  m_bytes[pce->family] += bytes;
+}
+
+size_t ChartCache::GetBytes(int family) const {
+  return m_bytes[Bucket(family)];
+}
+
+void ChartCache::SetBudget(int family, size_t bytes) {
+  m_budget[Bucket(family)] = bytes;
+}
+
+size_t ChartCache::GetBudget(int family) const {
+  return m_budget[Bucket(family)];
+}
+
+bool ChartCache::IsOverBudget(int family, double factor) const {
+  int b = Bucket(family);
+  if (!m_budget[b]) return false;  // no budget, no limit
+  return m_bytes[b] > m_budget[b] * factor;
+}
+
+ChartCacheStats ChartCache::GetStats() const {
+  ChartCacheStats stats;
+  stats.hits = m_hits;
+  stats.misses = m_misses;
+  stats.evictions = m_evictions;
+  stats.count = m_count;
+  for (int i = 0; i < CHART_CACHE_N_FAMILY; i++) {
+    stats.bytes[i] = m_bytes[i];
+    stats.budget[i] = m_budget[i];
+  }
+  return stats;
+}
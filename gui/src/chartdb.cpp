@@ -45,6 +45,7 @@
 #include "CanvasConfig.h"
 #include "ConfigMgr.h"
 #include "ocpn_frame.h"  //FIXME (dave) LoadS57
+#include "model/logger.h"
 #ifdef __OCPN__ANDROID__
  #include "androidUTIL.h"
 #endif
@@ -70,12 +71,15 @@ class s52plib;
 extern ThumbWin *pthumbwin;
 extern int g_nCacheLimit;
 extern int g_memCacheLimit;
+extern int g_mem_total;
+extern int g_chartCacheRasterMB;
+extern int g_chartCacheVectorMB;
+extern int g_chartCacheOtherMB;
 extern s52plib *ps52plib;
 extern ChartDB *ChartData;
 extern unsigned int g_canvasConfig;
 
 bool G_FloatPtInPolygon(MyFlPoint *rgpts, int wnumpts, float x, float y);
-bool GetMemoryStatus(int *mem_total, int *mem_used);
 
 // ============================================================================
 // ChartStack implementation
@@ -198,22 +202,35 @@ void ChartStack::AddChart(int db_add) {
 // ============================================================================
 
 ChartDB::ChartDB() {
-  pChartCache = new wxArrayPtrVoid;
-
   SetValid(false);  // until loaded or created
   UnLockCache();
 
   m_b_busy = false;
   m_ticks = 0;
 
+  //    Establish the byte budget of each chart family.
+  //    Unless configured, split the application memory target, or half of
+  //    the physical memory up to 1 GB, between raster and vector charts.
+  size_t target_kb = g_memCacheLimit;
+  if (!target_kb) target_kb = wxMin(g_mem_total / 2, 1024 * 1024);
+  size_t raster = g_chartCacheRasterMB ? (size_t)g_chartCacheRasterMB << 20
+                                       : target_kb * 1024 * 4 / 10;
+  size_t vector = g_chartCacheVectorMB ? (size_t)g_chartCacheVectorMB << 20
+                                       : target_kb * 1024 * 4 / 10;
+  size_t other = g_chartCacheOtherMB ? (size_t)g_chartCacheOtherMB << 20
+                                     : target_kb * 1024 * 2 / 10;
+  m_cache.SetBudget(CHART_FAMILY_RASTER, raster);
+  m_cache.SetBudget(CHART_FAMILY_VECTOR, vector);
+  m_cache.SetBudget(CHART_FAMILY_UNKNOWN, other);
+
   //    Report cache policy
-  if (g_memCacheLimit) {
-    wxString msg;
-    msg.Printf(_T("ChartDB Cache policy:  Application target is %d MBytes"),
-               g_memCacheLimit / 1024);
-    wxLogMessage(msg);
-  } else {
-    wxString msg;
+  wxString msg;
+  msg.Printf(
+      _T("ChartDB Cache policy:  Raster %d MBytes, Vector %d MBytes, ")
+      _T("Other %d MBytes"),
+      (int)(raster >> 20), (int)(vector >> 20), (int)(other >> 20));
+  wxLogMessage(msg);
+  if (g_nCacheLimit) {
     msg.Printf(_T("ChartDB Cache policy:  Max open chart limit is %d."),
                g_nCacheLimit);
     wxLogMessage(msg);
@@ -226,8 +243,6 @@ ChartDB::ChartDB() {
 ChartDB::~ChartDB() {
   //    Empty the cache
   PurgeCache();
-
-  delete pChartCache;
 }
 
 bool ChartDB::LoadBinary(const wxString &filename,
@@ -257,14 +272,42 @@ void ChartDB::DeleteCacheEntry(CacheEntry *pce, bool bDelTexture,
     g_glTextureManager->PurgeChartTextures(ch, bDelTexture);
 #endif
 
-  pChartCache->Remove(pce);
+  m_cache.Remove(pce);
   delete ch;
   delete pce;
 }
 
-void ChartDB::DeleteCacheEntry(int i, bool bDelTexture, const wxString &msg) {
-  CacheEntry *pce = (CacheEntry *)(pChartCache->Item(i));
-  if (pce) DeleteCacheEntry(pce, bDelTexture, msg);
+size_t ChartDB::GetChartResidentBytes(ChartBase *pChart) {
+  size_t bytes = pChart->GetResidentBytes();
+#ifdef ocpnUSE_GL
+  if (g_glTextureManager)
+    bytes += g_glTextureManager->GetChartTextureBytes(pChart);
+#endif
+  return bytes;
+}
+
+void ChartDB::UpdateCacheEntryBytes(CacheEntry *pce) {
+  m_cache.SetBytes(pce, GetChartResidentBytes((ChartBase *)pce->pChart));
+}
+
+//      Delete the least recently used charts of a family until its resident
+//      bytes are below {factor * budget}.  Cache mutex must be held.
+void ChartDB::PurgeCacheOverBudget(int family, double factor,
+                                   bool bDelTexture, bool blog) {
+  if (!m_cache.GetBudget(family)) return;
+
+  //    Resident sizes grow as charts are rendered, refresh them first
+  for (CacheEntry *pce = m_cache.GetNewest(); pce; pce = pce->lru_next)
+    if (pce->family == family) UpdateCacheEntryBytes(pce);
+
+  wxString msg(_T("Removing oldest chart from cache: "));
+  while (m_cache.IsOverBudget(family, factor)) {
+    CacheEntry *pce = FindOldestDeleteCandidate(blog, family);
+    if (pce == 0) break;  // no possible delete candidate
+
+    m_cache.CountEviction();
+    DeleteCacheEntry(pce, bDelTexture, msg);
+  }
 }
 
 void ChartDB::PurgeCache() {
@@ -272,11 +315,7 @@ void ChartDB::PurgeCache() {
   // wxLogMessage(_T("Chart cache purge"));
 
   if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
-    unsigned int nCache = pChartCache->GetCount();
-    for (unsigned int i = 0; i < nCache; i++) {
-      DeleteCacheEntry(0, true);
-    }
-    pChartCache->Clear();
+    while (CacheEntry *pce = m_cache.GetNewest()) DeleteCacheEntry(pce, true);
 
     m_cache_mutex.Unlock();
   }
@@ -287,20 +326,14 @@ void ChartDB::PurgeCachePlugins() {
   wxLogMessage(_T("Chart cache PlugIn purge"));
 
   if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
-    unsigned int nCache = pChartCache->GetCount();
-    unsigned int i = 0;
-    while (i < nCache) {
-      CacheEntry *pce = (CacheEntry *)(pChartCache->Item(i));
+    CacheEntry *pce = m_cache.GetNewest();
+    while (pce) {
+      CacheEntry *next = pce->lru_next;
       ChartBase *Ch = (ChartBase *)pce->pChart;
 
-      if (CHART_TYPE_PLUGIN == Ch->GetChartType()) {
-        DeleteCacheEntry(pce, true);
-
-        nCache = pChartCache->GetCount();  // restart the while loop
-        i = 0;
+      if (CHART_TYPE_PLUGIN == Ch->GetChartType()) DeleteCacheEntry(pce, true);
 
-      } else
-        i++;
+      pce = next;
     }
 
     m_cache_mutex.Unlock();
@@ -309,83 +342,69 @@ void ChartDB::PurgeCachePlugins() {
 
 void ChartDB::ClearCacheInUseFlags(void) {
   if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
-    unsigned int nCache = pChartCache->GetCount();
-    for (unsigned int i = 0; i < nCache; i++) {
-      CacheEntry *pce = (CacheEntry *)(pChartCache->Item(i));
+    for (CacheEntry *pce = m_cache.GetNewest(); pce; pce = pce->lru_next)
       pce->b_in_use = false;
-    }
     m_cache_mutex.Unlock();
   }
 }
 
-//      Try to purge and delete charts from the cache until the application
-//      memory used is until the application memory used is less than {factor *
-//      Limit} Purge charts on LRU policy
+//      Try to purge and delete charts from the cache until the resident
+//      bytes of each chart family are less than {factor * budget}, and the
+//      number of charts is less than {factor * Limit}.
+//      Purge charts on LRU policy
 void ChartDB::PurgeCacheUnusedCharts(double factor) {
-  //    Use memory limited cache policy, if defined....
-  if (g_memCacheLimit) {
-    if (wxMUTEX_NO_ERROR == m_cache_mutex.TryLock()) {
-      //    Check memory status to see if above limit
-      int mem_used;
-      GetMemoryStatus(0, &mem_used);
-      int mem_limit = g_memCacheLimit * factor;
-
-      int nl = pChartCache->GetCount();  // max loop count, by definition
-
-      wxString msg(_T("Purging unused chart from cache: "));
-      // printf("Try Purge count:  %d\n", nl);
-      while ((mem_used > mem_limit) && (nl > 0)) {
-        if (pChartCache->GetCount() < 2) {
-          nl = 0;
-          break;
-        }
+  if (wxMUTEX_NO_ERROR != m_cache_mutex.TryLock()) return;
 
-        CacheEntry *pce = FindOldestDeleteCandidate(false);
-        if (pce) {
-          // don't purge background spooler
-          DeleteCacheEntry(pce, false /*true*/, msg);
-          // printf("DCE, new count is:  %d\n", pChartCache->GetCount());
-        } else {
-          break;
-        }
+  // don't purge background spooler
+  for (int family = 0; family < CHART_CACHE_N_FAMILY; family++)
+    PurgeCacheOverBudget(family, factor, false, false);
 
-        GetMemoryStatus(0, &mem_used);
+  //    Also use chart count cache policy, if defined....
+  if (g_nCacheLimit) {
+    //    Check chart count to see if above limit
+    double fac10 = factor * 10;
+    unsigned int chart_limit = g_nCacheLimit * fac10 / 10;
 
-        nl--;
-      }
+    wxString msg(_T("Purging unused chart from cache: "));
+    while (m_cache.GetCount() > chart_limit) {
+      CacheEntry *pce = FindOldestDeleteCandidate(false);
+      if (!pce) break;
+
+      m_cache.CountEviction();
+      DeleteCacheEntry(pce, false /*true*/, msg);
     }
-    m_cache_mutex.Unlock();
   }
 
-  //    Else use chart count cache policy, if defined....
-  else if (g_nCacheLimit) {
-    if (wxMUTEX_NO_ERROR == m_cache_mutex.TryLock()) {
-      //    Check chart count to see if above limit
-      double fac10 = factor * 10;
-      int chart_limit = g_nCacheLimit * fac10 / 10;
-
-      int nl = pChartCache->GetCount();  // max loop count, by definition
-
-      wxString msg(_T("Purging unused chart from cache: "));
-      while ((nl > chart_limit) && (nl > 0)) {
-        if (pChartCache->GetCount() < 2) {
-          nl = 0;
-          break;
-        }
-
-        CacheEntry *pce = FindOldestDeleteCandidate(false);
-        if (pce) {
-          // don't purge background spooler
-          DeleteCacheEntry(pce, false /*true*/, msg);
-        } else {
-          break;
-        }
+  m_cache_mutex.Unlock();
+}
 
-        nl = pChartCache->GetCount();
-      }
+bool ChartDB::DeleteOldestCacheChart() {
+  bool retval = false;
+  if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
+    CacheEntry *pce = FindOldestDeleteCandidate(false);
+    if (pce) {
+      m_cache.CountEviction();
+      DeleteCacheEntry(pce);
+      retval = true;
     }
     m_cache_mutex.Unlock();
   }
+  return retval;
+}
+
+ChartCacheStats ChartDB::GetCacheStats() {
+  wxMutexLocker lock(m_cache_mutex);
+  return m_cache.GetStats();
+}
+
+unsigned int ChartDB::GetCacheCount() {
+  wxMutexLocker lock(m_cache_mutex);
+  return m_cache.GetCount();
+}
+
+void ChartDB::SetCacheBudget(int family, size_t bytes) {
+  wxMutexLocker lock(m_cache_mutex);
+  m_cache.SetBudget(family, bytes);
 }
 
 //-------------------------------------------------------------------------------------------------------
@@ -872,15 +891,10 @@ bool ChartDB::IsChartInCache(int dbindex) {
 
   //    Search the cache
   if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
-    unsigned int nCache = pChartCache->GetCount();
-    for (unsigned int i = 0; i < nCache; i++) {
-      CacheEntry *pce = (CacheEntry *)(pChartCache->Item(i));
-      if (pce->dbIndex == dbindex) {
-        if (pce->pChart != 0 && ((ChartBase *)pce->pChart)->IsReadyToRender())
-          bInCache = true;
-        break;
-      }
-    }
+    CacheEntry *pce = m_cache.Find(dbindex);
+    if (pce && pce->pChart != 0 &&
+        ((ChartBase *)pce->pChart)->IsReadyToRender())
+      bInCache = true;
     m_cache_mutex.Unlock();
   }
 
@@ -891,15 +905,10 @@ bool ChartDB::IsChartInCache(wxString path) {
   bool bInCache = false;
   if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
     //    Search the cache
-    unsigned int nCache = pChartCache->GetCount();
-    for (unsigned int i = 0; i < nCache; i++) {
-      CacheEntry *pce = (CacheEntry *)(pChartCache->Item(i));
-      if (pce->FullPath == path) {
-        if (pce->pChart != 0 && ((ChartBase *)pce->pChart)->IsReadyToRender())
-          bInCache = true;
-        break;
-      }
-    }
+    CacheEntry *pce = m_cache.Find(path);
+    if (pce && pce->pChart != 0 &&
+        ((ChartBase *)pce->pChart)->IsReadyToRender())
+      bInCache = true;
 
     m_cache_mutex.Unlock();
   }
@@ -908,16 +917,10 @@ bool ChartDB::IsChartInCache(wxString path) {
 
 bool ChartDB::IsChartLocked(int index) {
   if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
-    unsigned int nCache = pChartCache->GetCount();
-    for (unsigned int i = 0; i < nCache; i++) {
-      CacheEntry *pce = (CacheEntry *)(pChartCache->Item(i));
-      if (pce->dbIndex == index) {
-        bool ret = pce->n_lock > 0;
-        m_cache_mutex.Unlock();
-        return ret;
-      }
-    }
+    CacheEntry *pce = m_cache.Find(index);
+    bool ret = pce && pce->n_lock > 0;
     m_cache_mutex.Unlock();
+    return ret;
   }
 
   return false;
@@ -927,14 +930,10 @@ bool ChartDB::LockCacheChart(int index) {
   //    Search the cache
   bool ret = false;
   if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
-    unsigned int nCache = pChartCache->GetCount();
-    for (unsigned int i = 0; i < nCache; i++) {
-      CacheEntry *pce = (CacheEntry *)(pChartCache->Item(i));
-      if (pce->dbIndex == index) {
-        pce->n_lock++;
-        ret = true;
-        break;
-      }
+    CacheEntry *pce = m_cache.Find(index);
+    if (pce) {
+      pce->n_lock++;
+      ret = true;
     }
     m_cache_mutex.Unlock();
   }
@@ -944,14 +943,8 @@ bool ChartDB::LockCacheChart(int index) {
 void ChartDB::UnLockCacheChart(int index) {
   //    Search the cache
   if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
-    unsigned int nCache = pChartCache->GetCount();
-    for (unsigned int i = 0; i < nCache; i++) {
-      CacheEntry *pce = (CacheEntry *)(pChartCache->Item(i));
-      if (pce->dbIndex == index) {
-        if (pce->n_lock > 0) pce->n_lock--;
-        break;
-      }
-    }
+    CacheEntry *pce = m_cache.Find(index);
+    if (pce && pce->n_lock > 0) pce->n_lock--;
     m_cache_mutex.Unlock();
   }
 }
@@ -959,11 +952,8 @@ void ChartDB::UnLockCacheChart(int index) {
 void ChartDB::UnLockAllCacheCharts() {
   //    Walk the cache
   if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
-    unsigned int nCache = pChartCache->GetCount();
-    for (unsigned int i = 0; i < nCache; i++) {
-      CacheEntry *pce = (CacheEntry *)(pChartCache->Item(i));
+    for (CacheEntry *pce = m_cache.GetNewest(); pce; pce = pce->lru_next)
       if (pce->n_lock > 0) pce->n_lock--;
-    }
     m_cache_mutex.Unlock();
   }
 }
@@ -1000,39 +990,27 @@ ChartBase *ChartDB::OpenChartFromDBAndLock(wxString chart_path,
   return OpenChartFromDBAndLock(dbii, init_flag);
 }
 
-CacheEntry *ChartDB::FindOldestDeleteCandidate(bool blog) {
-  CacheEntry *pret = 0;
-
-  unsigned int nCache = pChartCache->GetCount();
+//      The least recently used entry which is neither locked nor the only
+//      chart of its kind, optionally restricted to one chart family.
+//      The LRU list is walked from its oldest end.
+CacheEntry *ChartDB::FindOldestDeleteCandidate(bool blog, int family) {
+  unsigned int nCache = m_cache.GetCount();
   if (nCache > 1) {
     if (blog) wxLogMessage(_T("Searching chart cache for oldest entry"));
-    int LRUTime = m_ticks;
-    int iOldest = 0;
-    for (unsigned int i = 0; i < nCache; i++) {
-      CacheEntry *pce = (CacheEntry *)(pChartCache->Item(i));
-      if (pce->RecentTime < LRUTime && !pce->n_lock) {
-        if (!isSingleChart((ChartBase *)(pce->pChart))) {
-          LRUTime = pce->RecentTime;
-          iOldest = i;
-        }
-      }
-    }
-    int dt = m_ticks - LRUTime;
-
-    CacheEntry *pce = (CacheEntry *)(pChartCache->Item(iOldest));
-    ChartBase *pDeleteCandidate = (ChartBase *)(pce->pChart);
+    for (CacheEntry *pce = m_cache.GetOldest(); pce; pce = pce->lru_prev) {
+      if (pce->n_lock) continue;
+      if (family >= 0 && pce->family != family) continue;
+      if (isSingleChart((ChartBase *)(pce->pChart))) continue;
 
-    if (!pce->n_lock && !isSingleChart(pDeleteCandidate)) {
       if (blog)
-        wxLogMessage(_T("Oldest unlocked cache index is %d, delta t is %d"),
-                     iOldest, dt);
-
-      pret = pce;
-    } else
-      wxLogMessage(_T("All chart in cache locked, size: %d"), nCache);
+        wxLogMessage(_T("Oldest unlocked cache entry, delta t is %d"),
+                     m_ticks - pce->RecentTime);
+      return pce;
+    }
+    wxLogMessage(_T("All chart in cache locked, size: %d"), nCache);
   }
 
-  return pret;
+  return 0;
 }
 
 ChartBase *ChartDB::OpenChartUsingCache(int dbindex, ChartInitFlag init_flag) {
@@ -1062,102 +1040,65 @@ ChartBase *ChartDB::OpenChartUsingCache(int dbindex, ChartInitFlag init_flag) {
   {
     wxMutexLocker lock(m_cache_mutex);
 
-    unsigned int nCache = pChartCache->GetCount();
     m_ticks++;
-    for (unsigned int i = 0; i < nCache; i++) {
-      pce = (CacheEntry *)(pChartCache->Item(i));
-      if (pce->FullPath == ChartFullPath) {
-        Ch = (ChartBase *)pce->pChart;
-        bInCache = true;
-        break;
-      }
+    pce = m_cache.Find(ChartFullPath);
+    if (pce) {
+      Ch = (ChartBase *)pce->pChart;
+      bInCache = true;
     }
 
     if (bInCache) {
-      wxString msg;
-      msg.Printf(_T("OpenChartUsingCache, IN cache: cache size: %d\n"),
-                 (int)pChartCache->GetCount());
-      //          wxLogMessage(msg);
       if (FULL_INIT == init_flag)  // asking for full init?
       {
         if (Ch->IsReadyToRender()) {
-          if (pce) {
-            pce->RecentTime = m_ticks;  // chart is OK
-            pce->b_in_use = true;
-          }
+          pce->RecentTime = m_ticks;  // chart is OK
+          pce->b_in_use = true;
+          m_cache.Touch(pce);
           return Ch;
         } else {
           if (pthumbwin && pthumbwin->pThumbChart == Ch)
             pthumbwin->pThumbChart = NULL;
           delete Ch;  // chart is not useable
           old_lock = pce->n_lock;
-          pChartCache->Remove(pce);  // so remove it
+          m_cache.Remove(pce);  // so remove it
           delete pce;
 
           bInCache = false;
         }
       } else  // assume if in cache, the chart can do thumbnails
       {
-        if (pce) {
-          pce->RecentTime = m_ticks;
-          pce->b_in_use = true;
-        }
+        pce->RecentTime = m_ticks;
+        pce->b_in_use = true;
+        m_cache.Touch(pce);
         return Ch;
       }
     }
 
     if (!bInCache)  // not in cache
     {
+      m_cache.CountMiss();
       m_b_busy = true;
       if (!m_b_locked) {
-        //    Use memory limited cache policy, if defined....
-        if (g_memCacheLimit) {
-          //    Check memory status to see if enough room to open another chart
-          int mem_used;
-          GetMemoryStatus(0, &mem_used);
-
-          wxString msg;
-          msg.Printf(
-              _T("OpenChartUsingCache, NOT in cache:   cache size: %d\n"),
-              (int)pChartCache->GetCount());
-          wxLogMessage(msg);
-          wxString msg1;
-          msg1.Printf(_T("   OpenChartUsingCache:  type %d  "), chart_type);
-          wxLogMessage(msg1 + ChartFullPath);
-
-          if ((mem_used > g_memCacheLimit * 8 / 10) &&
-              (pChartCache->GetCount() > 2)) {
-            wxString msg(_T("Removing oldest chart from cache: "));
-            while (1) {
-              CacheEntry *pce = FindOldestDeleteCandidate(true);
-              if (pce == 0) break;  // no possible delete candidate
-
-              // purge texture cache, really need memory here
-              DeleteCacheEntry(pce, true, msg);
-
-              GetMemoryStatus(0, &mem_used);
-              if ((mem_used < g_memCacheLimit * 8 / 10) ||
-                  (pChartCache->GetCount() <= 2))
-                break;
-
-            }  // while
-          }
-        }
-
-        else  // Use n chart cache policy, if memory-limit  policy is not used
-        {
-          //      Limit cache to n charts, tossing out the oldest when space is
-          //      needed
-          unsigned int nCache = pChartCache->GetCount();
-          if (nCache > (unsigned int)g_nCacheLimit && nCache > 2) {
-            wxString msg(_T("Removing oldest chart from cache: "));
-            while (nCache > (unsigned int)g_nCacheLimit) {
-              CacheEntry *pce = FindOldestDeleteCandidate(true);
-              if (pce == 0) break;
-
-              DeleteCacheEntry(pce, true, msg);
-              nCache--;
-            }
+        //    Make room for another chart of this family, leaving some
+        //    headroom in its byte budget.
+        //    Purge texture cache too, really need memory here
+        int family = chart_family;
+        if (family < 0 || family >= CHART_CACHE_N_FAMILY)
+          family = CHART_FAMILY_UNKNOWN;
+        PurgeCacheOverBudget(family, 0.8, true, true);
+
+        //      Limit cache to n charts, tossing out the oldest when space is
+        //      needed
+        unsigned int nCache = m_cache.GetCount();
+        if (g_nCacheLimit && nCache > (unsigned int)g_nCacheLimit &&
+            nCache > 2) {
+          wxString msg(_T("Removing oldest chart from cache: "));
+          while (m_cache.GetCount() > (unsigned int)g_nCacheLimit) {
+            CacheEntry *pce = FindOldestDeleteCandidate(true);
+            if (pce == 0) break;
+
+            m_cache.CountEviction();
+            DeleteCacheEntry(pce, true, msg);
           }
         }
       }
@@ -1166,7 +1107,6 @@ ChartBase *ChartDB::OpenChartUsingCache(int dbindex, ChartInitFlag init_flag) {
 
   if (!bInCache)  // not in cache
   {
-    wxLogMessage(_T("Creating new chart"));
 
     if (chart_type == CHART_TYPE_KAP)
       Ch = new ChartKAP();
@@ -1281,8 +1221,8 @@ ChartBase *ChartDB::OpenChartUsingCache(int dbindex, ChartInitFlag init_flag) {
       //    Vector charts need a PLIB for useful display....
       if ((chart_family != CHART_FAMILY_VECTOR) ||
           ((chart_family == CHART_FAMILY_VECTOR) && plib)) {
-        wxLogMessage(
-            wxString::Format(_T("Initializing Chart %s"), msg_fn.c_str()));
+        LOG_MESSAGE_LIMITED(20, "Initializing Chart %s",
+                            ChartFullPath.ToUTF8().data());
 
         ir = Ch->Init(ChartFullPath, init_flag);  // using the passed flag
         Ch->SetColorScheme(/*pParent->*/ GetColorScheme());
@@ -1306,9 +1246,11 @@ ChartBase *ChartDB::OpenChartUsingCache(int dbindex, ChartInitFlag init_flag) {
           //                              dbindex);
           pce->RecentTime = m_ticks;
           pce->n_lock = old_lock;
+          pce->family = chart_family;
+          pce->bytes = GetChartResidentBytes(Ch);
 
           if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
-            pChartCache->Add((void *)pce);
+            m_cache.Add(pce);
             m_cache_mutex.Unlock();
           } else {
             delete pce;
@@ -1436,13 +1378,7 @@ bool ChartDB::DeleteCacheChart(ChartBase *pDeleteCandidate) {
   if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
     if (!isSingleChart(pDeleteCandidate)) {
       // Find the chart in the cache
-      CacheEntry *pce = NULL;
-      for (unsigned int i = 0; i < pChartCache->GetCount(); i++) {
-        pce = (CacheEntry *)(pChartCache->Item(i));
-        if ((ChartBase *)(pce->pChart) == pDeleteCandidate) {
-          break;
-        }
-      }
+      CacheEntry *pce = m_cache.FindChart(pDeleteCandidate);
 
       if (pce) {
         if (pce->n_lock > 0) pce->n_lock--;
@@ -1463,13 +1399,10 @@ bool ChartDB::DeleteCacheChart(ChartBase *pDeleteCandidate) {
  */
 void ChartDB::ApplyColorSchemeToCachedCharts(ColorScheme cs) {
   ChartBase *Ch;
-  CacheEntry *pce;
-  //    Search the cache
+  //    Walk the cache
 
   if (wxMUTEX_NO_ERROR == m_cache_mutex.Lock()) {
-    unsigned int nCache = pChartCache->GetCount();
-    for (unsigned int i = 0; i < nCache; i++) {
-      pce = (CacheEntry *)(pChartCache->Item(i));
+    for (CacheEntry *pce = m_cache.GetNewest(); pce; pce = pce->lru_next) {
       Ch = (ChartBase *)pce->pChart;
       if (Ch) Ch->SetColorScheme(cs, true);
     }
@@ -36,6 +36,10 @@
 #include <wx/tokenzr.h>
 #include <wx/dir.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "chartdbs.h"
 #include "chartbase.h"
 #include "pluginmanager.h"
@@ -2075,11 +2079,14 @@ int ChartDatabase::SearchDirAndAddCharts(wxString &dir_name_base,
   int nFileProgressQuantum = wxMax(nFile / 100, 2);
   double rFileProgressRatio = 100.0 / wxMax(nFile, 1);
 
+  //    Name the candidate files, and find the ones whose header must be read
+  std::vector<ScanCandidate> candidates(nFile);
   for (int ifile = 0; ifile < nFile; ifile++) {
+    ScanCandidate &cand = candidates[ifile];
     wxFileName file(FileList[ifile]);
-    wxString full_name = file.GetFullPath();
-    wxString file_name = file.GetFullName();
-    wxString utf8_path = full_name;
+    cand.full_name = file.GetFullPath();
+    cand.file_name = file.GetFullName();
+    cand.utf8_path = cand.full_name;
 
 #ifdef __OCPN__ANDROID__
     // The full path (full_name) is the broken Android files system
@@ -2097,16 +2104,45 @@ int ChartDatabase::SearchDirAndAddCharts(wxString &dir_name_base,
       file_target.RemoveDir(0);
 
     wxString leftover_path = file_target.GetFullPath();
-    utf8_path =
+    cand.utf8_path =
         dir_name_base + leftover_path;  // reconstruct a fully utf-8 version
 #endif
 
     //    Validate the file name again, considering MSW's semi-random treatment
     //    of case....
     // TODO...something fishy here - may need to normalize saved name?
-    if (!file_name.Matches(lowerFileSpec) && !file_name.Matches(filespec) &&
-        !file_name.Matches(lowerFileSpecXZ) && !file_name.Matches(filespecXZ) &&
-        !b_found_cm93) {
+    const wxString &file_name = cand.file_name;
+    cand.matches =
+        file_name.Matches(lowerFileSpec) || file_name.Matches(filespec) ||
+        file_name.Matches(lowerFileSpecXZ) || file_name.Matches(filespecXZ) ||
+        b_found_cm93;
+
+    //    Headers are read off the calling thread only for chart classes whose
+    //    header init is self contained, and only if the chart is not known
+    //    to be up to date in the database already
+    if (cand.matches && IsHeaderScanThreadSafe(cand.full_name, chart_desc)) {
+      cand.prebuild = true;
+      ChartCollisionsHashMap::const_iterator collision_ptr =
+          collision_map.find(file_name);
+      if (bthis_dir_in_dB && collision_ptr != collision_map.end()) {
+        ChartTableEntry &entry = active_chartTable[collision_ptr->second];
+        if (cand.full_name.IsSameAs(entry.GetFullSystemPath()) &&
+            file.GetModificationTime().GetTicks() <= entry.GetFileTime())
+          cand.prebuild = false;
+      }
+    }
+  }
+
+  PrebuildChartTableEntries(candidates, chart_desc, pprog);
+
+  for (int ifile = 0; ifile < nFile; ifile++) {
+    ScanCandidate &cand = candidates[ifile];
+    wxFileName file(FileList[ifile]);
+    const wxString &full_name = cand.full_name;
+    const wxString &file_name = cand.file_name;
+    wxString &utf8_path = cand.utf8_path;
+
+    if (!cand.matches) {
       // wxLogMessage(_T("FileSpec test failed for:") + file_name);
       continue;
     }
@@ -2162,7 +2198,11 @@ int ChartDatabase::SearchDirAndAddCharts(wxString &dir_name_base,
       wxLogMessage(
           wxString::Format(_T("Loading chart data for %s"), msg_fn.c_str()));
     } else {
-      pnewChart = CreateChartTableEntry(full_name, utf8_path, chart_desc);
+      if (cand.prebuilt) {
+        pnewChart = cand.entry;
+        cand.entry = NULL;
+      } else
+        pnewChart = CreateChartTableEntry(full_name, utf8_path, chart_desc);
       if (!pnewChart) {
         bAddFinal = false;
         wxLogMessage(wxString::Format(
@@ -2224,11 +2264,62 @@ int ChartDatabase::SearchDirAndAddCharts(wxString &dir_name_base,
     }
   }
 
+  //    Headers read for charts that were found up to date after all
+  for (auto &cand : candidates) delete cand.entry;
+
   m_nentries = active_chartTable.GetCount();
 
   return nDirEntry;
 }
 
+bool ChartDatabase::IsHeaderScanThreadSafe(
+    const wxString &path, const ChartClassDescriptor &chart_desc) const {
+  //    S57 header init shares the class registrar and a recursion guard,
+  //    cm93 is a single directory and plugin charts may not be reentrant.
+  if (chart_desc.m_descriptor_type == PLUGIN_DESCRIPTOR) return false;
+
+  wxString ext = path.AfterLast('.').Upper();
+  if (ext == _T("XZ")) ext = path.BeforeLast('.').AfterLast('.').Upper();
+  return ext == _T("KAP") || ext == _T("GEO");
+}
+
+void ChartDatabase::PrebuildChartTableEntries(
+    std::vector<ScanCandidate> &candidates, ChartClassDescriptor &chart_desc,
+    wxGenericProgressDialog *pprog) {
+  std::vector<size_t> jobs;
+  for (size_t i = 0; i < candidates.size(); i++)
+    if (candidates[i].prebuild) jobs.push_back(i);
+  if (jobs.size() < 2) return;
+
+  unsigned n_threads = std::max(1u, std::thread::hardware_concurrency());
+  n_threads = std::min<size_t>(n_threads, jobs.size());
+  wxLogMessage(wxString::Format(_T("Reading %d chart headers on %d threads"),
+                                (int)jobs.size(), (int)n_threads));
+
+  std::atomic<size_t> next(0);
+  std::atomic<size_t> done(0);
+  size_t progress_quantum = std::max<size_t>(jobs.size() / 100, 1);
+  auto worker = [&](bool report) {
+    size_t job;
+    while ((job = next++) < jobs.size()) {
+      ScanCandidate &cand = candidates[jobs[job]];
+      cand.entry =
+          CreateChartTableEntry(cand.full_name, cand.utf8_path, chart_desc);
+      cand.prebuilt = true;
+      size_t n_done = ++done;
+      //    Only the calling thread may touch the progress dialog
+      if (report && pprog && (n_done % progress_quantum) == 0)
+        pprog->Update(static_cast<int>(n_done * 100 / jobs.size()),
+                      cand.utf8_path);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < n_threads; i++) threads.emplace_back(worker, false);
+  worker(true);
+  for (auto &t : threads) t.join();
+}
+
 bool ChartDatabase::AddChart(wxString &chartfilename,
                              ChartClassDescriptor &chart_desc,
                              wxGenericProgressDialog *pprog, int isearch,
@@ -1553,6 +1553,7 @@ ChartBaseBSB::ChartBaseBSB() {
   pPixCache = NULL;
 
   pLineCache = NULL;
+  m_line_cache_bytes = 0;
 
   m_bilinear_limit = 8;  // bilinear scaling only up to n
 
@@ -1634,6 +1635,7 @@ void ChartBaseBSB::FreeLineCacheRows(int start, int end) {
     for (int ylc = start; ylc < end; ylc++) {
       CachedLine *pt = &pLineCache[ylc];
       if (pt->bValid) {
+        m_line_cache_bytes -= LineCacheRowBytes(pt);
         free(pt->pTileOffset);
         free(pt->pPix);
         pt->bValid = false;
@@ -2029,6 +2031,7 @@ void ChartBaseBSB::InvalidateLineCache(void) {
     for (int ylc = 0; ylc < Size_Y; ylc++) {
       pt = &pLineCache[ylc];
       if (pt) {
+        if (pt->bValid) m_line_cache_bytes -= LineCacheRowBytes(pt);
         free(pt->pPix);
         pt->pPix = NULL;
         free(pt->pTileOffset);
@@ -3903,6 +3906,23 @@ inline void memset_short(unsigned char *dst, unsigned char cbyte, int count) {
 // this is chosen as it is also the opengl tile size so should work well
 #define TILE_SIZE 512
 
+size_t ChartBaseBSB::LineCacheRowBytes(const CachedLine *pt) const {
+#ifdef USE_OLD_CACHE
+  return Size_X;
+#else
+  return pt->size + sizeof(TileOffsetCache) * (Size_X / TILE_SIZE + 1);
+#endif
+}
+
+size_t ChartBaseBSB::GetResidentBytes() {
+  size_t bytes = m_line_cache_bytes;
+  if (pline_table) bytes += (Size_Y + 1) * sizeof(int);
+  if (pLineCache) bytes += Size_Y * sizeof(CachedLine);
+  if (pPixCache)
+    bytes += (size_t)pPixCache->GetLinePitch() * pPixCache->GetHeight();
+  return bytes;
+}
+
 //#define USE_OLD_CACHE  // removed this (and simplify code below) once the new
 //method is verified #define PRINT_TIMINGS  // enable for profiling
 
@@ -4131,6 +4151,7 @@ int ChartBaseBSB::BSBGetScanline(unsigned char *pLineBuf, int y, int xs, int xl,
 #endif
 
     pt->bValid = true;
+    if (pt != &cached_line) m_line_cache_bytes += LineCacheRowBytes(pt);
   }
 
   //          Line is valid, de-reference thru proper pallete directly to target
@@ -4315,6 +4315,28 @@ bool ChartCanvas::GetCanvasPointPixVP(ViewPort &vp, double rlat, double rlon,
   return true;
 }
 
+void ChartCanvas::GetCanvasPointPix(int n, const double *rlat,
+                                    const double *rlon, wxPoint *r) {
+  if (n <= 0) return;
+
+  //  A raster chart may supply its own georeferencing, point by point
+  if (!g_bopengl && m_singleChart &&
+      (m_singleChart->GetChartFamily() == CHART_FAMILY_RASTER)) {
+    for (int i = 0; i < n; i++) GetCanvasPointPix(rlat[i], rlon[i], &r[i]);
+    return;
+  }
+
+  std::vector<wxPoint2DDouble> p(n);
+  GetVP().GetDoublePixFromLL(n, rlat, rlon, &p[0]);
+  for (int i = 0; i < n; i++) {
+    if (!std::isnan(p[i].m_x) && (abs(p[i].m_x) < 1e6) &&
+        (abs(p[i].m_y) < 1e6))
+      r[i] = wxPoint(wxRound(p[i].m_x), wxRound(p[i].m_y));
+    else
+      r[i] = wxPoint(INVALID_COORD, INVALID_COORD);
+  }
+}
+
 void ChartCanvas::GetCanvasPixPoint(double x, double y, double &lat,
                                     double &lon) {
   // If the Current Chart is a raster chart, and the
@@ -8209,17 +8231,17 @@ bool ChartCanvas::MouseEventProcessObjects(wxMouseEvent &event) {
           pSelect->ModifySelectablePoint(new_cursor_lat, new_cursor_lon,
                                          m_pRoutePointEditTarget,
                                          SELTYPE_DRAGHANDLE);
-          m_pFoundPoint->m_slat =
-              m_pRoutePointEditTarget->m_lat;  // update the SelectList entry
-          m_pFoundPoint->m_slon = m_pRoutePointEditTarget->m_lon;
+          pSelect->ModifySelectablePoint(
+              m_pRoutePointEditTarget->m_lat, m_pRoutePointEditTarget->m_lon,
+              m_pFoundPoint);  // update the SelectList entry
         } else {
           m_pRoutePointEditTarget->m_lat =
               new_cursor_lat;  // update the RoutePoint entry
           m_pRoutePointEditTarget->m_lon = new_cursor_lon;
           m_pRoutePointEditTarget->m_wpBBox.Invalidate();
-          m_pFoundPoint->m_slat =
-              new_cursor_lat;  // update the SelectList entry
-          m_pFoundPoint->m_slon = new_cursor_lon;
+          pSelect->ModifySelectablePoint(
+              new_cursor_lat, new_cursor_lon,
+              m_pFoundPoint);  // update the SelectList entry
         }
 
         //    Update the MarkProperties Dialog, if currently shown
@@ -8309,16 +8331,17 @@ bool ChartCanvas::MouseEventProcessObjects(wxMouseEvent &event) {
           pSelect->ModifySelectablePoint(m_cursor_lat, m_cursor_lon,
                                          m_pRoutePointEditTarget,
                                          SELTYPE_DRAGHANDLE);
-          m_pFoundPoint->m_slat =
-              m_pRoutePointEditTarget->m_lat;  // update the SelectList entry
-          m_pFoundPoint->m_slon = m_pRoutePointEditTarget->m_lon;
+          pSelect->ModifySelectablePoint(
+              m_pRoutePointEditTarget->m_lat, m_pRoutePointEditTarget->m_lon,
+              m_pFoundPoint);  // update the SelectList entry
         } else {
           m_pRoutePointEditTarget->m_lat =
               m_cursor_lat;  // update the RoutePoint entry
           m_pRoutePointEditTarget->m_lon = m_cursor_lon;
           m_pRoutePointEditTarget->m_wpBBox.Invalidate();
-          m_pFoundPoint->m_slat = m_cursor_lat;  // update the SelectList entry
-          m_pFoundPoint->m_slon = m_cursor_lon;
+          pSelect->ModifySelectablePoint(
+              m_cursor_lat, m_cursor_lon,
+              m_pFoundPoint);  // update the SelectList entry
         }
 
         //    Update the MarkProperties Dialog, if currently shown
@@ -2074,6 +2074,7 @@ void cm93chart::SetVPParms(const ViewPort &vpt) {
       }
 
       AssembleLineGeometry();
+      m_object_bytes = 0;  // recount on the next GetResidentBytes()
 
       ClearDepthContourArray();
       BuildDepthContourArray();
@@ -5839,6 +5840,15 @@ void cm93compchart::InvalidateCache() {
   }
 }
 
+size_t cm93compchart::GetResidentBytes() {
+  size_t bytes = 0;
+  for (int i = 0; i < 8; i++) {
+    if (m_pcm93chart_array[i])
+      bytes += m_pcm93chart_array[i]->GetResidentBytes();
+  }
+  return bytes;
+}
+
 void cm93compchart::ForceEdgePriorityEvaluate(void) {
   for (int i = 0; i < 8; i++) {
     if (m_pcm93chart_array[i])
@@ -2158,6 +2158,7 @@ void glChartCanvas::GridDraw() {
       }
     }
 
+    m_gridfont.Flush();
     glDisable(GL_TEXTURE_2D);
     glDisable(GL_BLEND);
   }
@@ -2783,9 +2784,12 @@ void glChartCanvas::DrawCloseMessage(wxString msg) {
 
     glEnable(GL_BLEND);
 
+    wxColour black(0, 0, 0);
+    texfont.SetColor(black);
     glColor3ub(0, 0, 0);
     glEnable(GL_TEXTURE_2D);
     texfont.RenderString(msg, xp, yp);
+    texfont.Flush();
     glDisable(GL_TEXTURE_2D);
     glDisable(GL_BLEND);
   }
@@ -4540,6 +4544,7 @@ void glChartCanvas::Render() {
   if (g_b_needFinish) glFinish();
 
   SwapBuffers();
+  unsigned int text_draws = ps52plib ? ps52plib->TakeTextDrawCount() : 0;
   if (b_timeGL && g_bShowFPS) {
     if (n_render % 10) {
       glFinish();
@@ -4552,6 +4557,7 @@ void glChartCanvas::Render() {
                   if(g_gl_ms_per_frame > 0)
                       printf(" OpenGL frame time: %3.0f ms-->  %3.0fFPS\n",
                       g_gl_ms_per_frame, 1000./ g_gl_ms_per_frame);
+      wxLogDebug("OpenGL text draw calls: %u", text_draws);
     }
   }
 
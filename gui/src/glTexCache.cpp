@@ -114,75 +114,29 @@ extern int g_tile_size;
 
 extern bool GetMemoryStatus(int *mem_total, int *mem_used);
 
-extern wxString CompressedCachePath(wxString path);
 extern glTextureManager *g_glTextureManager;
 
-//      CatalogEntry implementation
-CatalogEntry::CatalogEntry() {}
-
-CatalogEntry::~CatalogEntry() {}
-
-CatalogEntry::CatalogEntry(int level, int x0, int y0, ColorScheme colorscheme) {
-  k.mip_level = level;
-  k.x = x0;
-  k.y = y0;
-  k.tcolorscheme = colorscheme;
-}
-
-int CatalogEntry::GetSerialSize() { return CATALOG_ENTRY_SERIAL_SIZE; }
-
-void CatalogEntry::Serialize(unsigned char *t) {
-  uint32_t *p = (uint32_t *)t;
-
-  *p++ = k.mip_level;
-  *p++ = k.x;
-  *p++ = k.y;
-  *p++ = k.tcolorscheme;
-  *p++ = v.texture_offset;
-  *p++ = v.compressed_size;
-}
-
-void CatalogEntry::DeSerialize(unsigned char *t) {
-  uint32_t *p = (uint32_t *)t;
-
-  k.mip_level = *p++;
-  k.x = *p++;
-  k.y = *p++;
-  k.tcolorscheme = (ColorScheme)*p++;
-  v.texture_offset = *p++;
-  v.compressed_size = *p++;
-}
-
 //      glTexFactory Implementation
 enum TextureDataType { COMPRESSED_BUFFER_OK, MAP_BUFFER_OK };
 
 glTexFactory::glTexFactory(ChartBase *chart, int raster_format) {
   //    m_pchart = chart;
-  n_catalog_entries = 0;
-  m_catalog_offset = sizeof(CompressedCacheHeader);
   wxDateTime ed = chart->GetEditionDate();
-  m_chart_date_binary = (uint32_t)ed.IsValid() ? ed.GetTicks() : 0;
-  m_chartfile_date_binary = ::wxFileModificationTime(chart->GetFullPath());
-  m_chartfile_size =
+  uint32_t chart_date = (uint32_t)ed.IsValid() ? ed.GetTicks() : 0;
+  uint32_t chartfile_date = ::wxFileModificationTime(chart->GetFullPath());
+  uint32_t chartfile_size =
       (uint32_t)wxFileName::GetSize(chart->GetFullPath()).GetLo();
   m_ChartPath = chart->GetFullPath();
 
-  m_CompressedCacheFilePath = CompressedCachePath(chart->GetFullPath());
-  m_hdrOK = false;
-  m_catalogOK = false;
+  //  Tiles of an older version of the chart are not found
+  m_chart_key = TexCacheStore::ChartKey(
+      std::string(m_ChartPath.ToUTF8().data()), chart_date, chartfile_date,
+      chartfile_size, g_raster_format);
   m_newCatalog = true;
 
-  m_catalogCorrupted = false;
-
-  m_fs = 0;
   m_LRUtime = 0;
   m_ntex = 0;
   m_tiles = NULL;
-  for (int i = 0; i < N_COLOR_SCHEMES; i++) {
-    for (int j = 0; j < MAX_TEX_LEVEL; j++) {
-      m_cache[i][j] = NULL;
-    }
-  }
   //  Initialize the TextureDescriptor array
   ChartBaseBSB *pBSBChart = dynamic_cast<ChartBaseBSB *>(chart);
 
@@ -205,21 +159,10 @@ glTexFactory::glTexFactory(ChartBase *chart, int raster_format) {
 }
 
 glTexFactory::~glTexFactory() {
-  delete m_fs;
-
   PurgeBackgroundCompressionPool();
   DeleteAllTextures();
   DeleteAllDescriptors();
 
-  for (int i = 0; i < N_COLOR_SCHEMES; i++) {
-    for (int j = 0; j < MAX_TEX_LEVEL; j++) {
-      CatalogEntryValue *v = m_cache[i][j];
-      if (v) {
-        free(v);
-      }
-    }
-  }
-
   free(m_td_array);  // array is empty
 
   if (m_tiles)
@@ -268,8 +211,8 @@ bool glTexFactory::OnTimer() {
                     if( ptd->compcomp_array[0] )
                         continue; // ok
 
-                    CatalogEntryValue *p = GetCacheEntryValue(0, x*dim, y*dim, ptd->m_colorscheme);
-                    if(!p)
+                    wxRect r(x*dim, y*dim, dim, dim);
+                    if(!GetTexCacheStore()->Contains(CacheKey(0, r, ptd->m_colorscheme)))
                         goto keeplines;
                 }
 
@@ -329,6 +272,21 @@ void glTexFactory::AccumulateMemStatistics(int &map_size, int &comp_size,
   }
 }
 
+//  Host side bitmaps plus texture memory uploaded to the GPU
+size_t glTexFactory::GetResidentBytes() {
+  size_t bytes = 0;
+  for (int i = 0; i < m_ntex; i++) {
+    glTextureDescriptor *ptd = m_td_array[i];
+    if (ptd) {
+      bytes += sizeof(glTextureDescriptor);
+      bytes += ptd->GetMapArrayAlloc() + ptd->GetCompArrayAlloc() +
+               ptd->GetCompCompArrayAlloc();
+      bytes += ptd->tex_mem_used;
+    }
+  }
+  return bytes;
+}
+
 void glTexFactory::DeleteTexture(const wxRect &rect) {
   //    Is this texture tile defined?
   int array_index = ArrayIndex(rect.x, rect.y);
@@ -424,23 +382,15 @@ void glTexFactory::ArrayXY(wxRect *r, int index) const {
   r->x = (index - ((r->y / m_tex_dim) * m_stride)) * m_tex_dim;
 }
 
-CatalogEntryValue *glTexFactory::GetCacheEntryValue(int level, int x, int y,
-                                                    ColorScheme color_scheme) {
-  if (level < 0 || level >= MAX_TEX_LEVEL) return 0;
-
-  //  Look in the cache
-  LoadCatalog();
-
-  CatalogEntryValue *v = m_cache[color_scheme][level];
-  if (v == 0) return 0;
-
-  int array_index = ArrayIndex(x, y);
-  if (array_index >= m_ntex) return 0;
-
-  CatalogEntryValue *r = &v[array_index];
-  if (r->compressed_size == 0) return 0;
-
-  return r;
+TexCacheKey glTexFactory::CacheKey(int level, const wxRect &rect,
+                                   ColorScheme color_scheme) const {
+  TexCacheKey key;
+  key.chart = m_chart_key;
+  key.x = rect.x;
+  key.y = rect.y;
+  key.level = level;
+  key.scheme = color_scheme;
+  return key;
 }
 
 bool glTexFactory::IsLevelInCache(int level, const wxRect &rect,
@@ -450,8 +400,7 @@ bool glTexFactory::IsLevelInCache(int level, const wxRect &rect,
   if (g_GLOptions.m_bTextureCompression &&
       g_GLOptions.m_bTextureCompressionCaching) {
     //  Search for the requested texture
-    if (GetCacheEntryValue(level, rect.x, rect.y, color_scheme) != 0)
-      b_ret = true;
+    b_ret = GetTexCacheStore()->Contains(CacheKey(level, rect, color_scheme));
   }
 
   return b_ret;
@@ -878,17 +827,11 @@ bool glTexFactory::UpdateCacheLevel(const wxRect &rect, int level,
                                     unsigned char *data, int size) {
   if (!g_GLOptions.m_bTextureCompressionCaching) return false;
 
-  if (!data) return false;
-
-  //  Search for the requested texture
-  //  Search the catalog for this particular texture
-  CatalogEntryValue *v =
-      GetCacheEntryValue(level, rect.x, rect.y, color_scheme);
-
-  //      This texture is already done
-  if (v != 0) return false;
+  if (!data || level < 0 || level >= MAX_TEX_LEVEL) return false;
 
-  return UpdateCachePrecomp(data, size, rect, level, color_scheme);
+  //  False if this texture is already done
+  return GetTexCacheStore()->Put(CacheKey(level, rect, color_scheme), data,
+                                 size);
 }
 
 bool glTexFactory::UpdateCacheAllLevels(const wxRect &rect,
@@ -902,9 +845,8 @@ bool glTexFactory::UpdateCacheAllLevels(const wxRect &rect,
   for (int level = 0; level < g_mipmap_max_level + 1; level++)
     work |= UpdateCacheLevel(rect, level, color_scheme, compcomp_array[level],
                              compcomp_size[level]);
-  if (work) {
-    WriteCatalogAndHeader();
-  }
+  //  New tiles are readable at once, and indexed in batches
+  if (work) GetTexCacheStore()->MaybeCommit();
 
   return work;
 }
@@ -922,28 +864,24 @@ int glTexFactory::GetTextureLevel(glTextureDescriptor *ptd, const wxRect &rect,
       ptd->comp_array[level] = cb;
       return COMPRESSED_BUFFER_OK;
     } else if (g_GLOptions.m_bTextureCompressionCaching) {
-      //  If cacheing compressed textures, look in the cache
-      //  Search for the requested texture
-      //  Search the catalog for this particular texture
-      CatalogEntryValue *p =
-          GetCacheEntryValue(level, rect.x, rect.y, color_scheme);
-
-      //      Requested texture level is found in the cache
-      //      so go load it
-      if (p != 0) {
-        int size = TextureTileSize(level, true);
-
-        if (m_fs->IsOpened()) {
-          m_fs->Seek(p->texture_offset);
-          ptd->comp_array[level] = (unsigned char *)malloc(size);
-          int max_compressed_size = LZ4_COMPRESSBOUND(g_tile_size);
-          char *compressed_data = (char *)malloc(p->compressed_size);
-          m_fs->Read(compressed_data, p->compressed_size);
-          LZ4_decompress_fast(compressed_data, (char *)ptd->comp_array[level],
-                              size);
-          free(compressed_data);
-        }
+      //  If cacheing compressed textures, look in the cache.
+      //  The tile is decompressed outside the store lock.
+      int size = TextureTileSize(level, true);
+      unsigned char *cb = 0;
+      GetTexCacheStore()->Read(
+          CacheKey(level, rect, color_scheme),
+          [&](const unsigned char *data, uint32_t data_size) {
+            cb = (unsigned char *)malloc(size);
+            if (LZ4_decompress_safe((const char *)data, (char *)cb, data_size,
+                                    size) != size) {
+              free(cb);
+              cb = 0;
+            }
+          });
 
+      if (cb) {
+        m_newCatalog = false;
+        ptd->comp_array[level] = cb;
         return COMPRESSED_BUFFER_OK;
       }
     }
@@ -956,211 +894,3 @@ int glTexFactory::GetTextureLevel(glTextureDescriptor *ptd, const wxRect &rect,
   return MAP_BUFFER_OK;
 }
 
-// return not used
-// false? never
-// true
-bool glTexFactory::LoadHeader(void) {
-  if (m_hdrOK) return true;
-
-  bool need_new = false;
-
-  if (wxFileName::FileExists(m_CompressedCacheFilePath)) {
-    m_fs = new wxFFile(m_CompressedCacheFilePath, _T("rb+"));
-    if (m_fs->IsOpened()) {
-      CompressedCacheHeader hdr;
-
-      //  Header is located at the end of the file
-      wxFileOffset hdr_offset = m_fs->Length() - sizeof(hdr);
-      hdr_offset = m_fs->Seek(hdr_offset);
-
-      if (sizeof(hdr) == m_fs->Read(&hdr, sizeof(hdr))) {
-        if (hdr.magic != COMPRESSED_CACHE_MAGIC ||
-            hdr.chartdate != m_chart_date_binary ||
-            hdr.chartfile_date != m_chartfile_date_binary ||
-            hdr.chartfile_size != m_chartfile_size ||
-            hdr.format != g_raster_format) {
-          //  Bad header signature
-          delete m_fs;
-          need_new = true;
-        } else {  // good header
-          n_catalog_entries = hdr.m_nentries;
-          m_catalog_offset = hdr.catalog_offset;
-        }
-      } else {  // file exists, and is empty
-        n_catalog_entries = 0;
-        m_catalog_offset = 0;
-        WriteCatalogAndHeader();
-      }
-    }  // is open
-
-    else {  // some problem opening file, probably permissions on Win7
-      delete m_fs;
-      need_new = true;
-      wxRemoveFile(m_CompressedCacheFilePath);
-    }
-
-  }  // exists
-
-  else {  // File does not exist
-    wxFileName fn(m_CompressedCacheFilePath);
-    if (!fn.DirExists()) fn.Mkdir();
-    need_new = true;
-  }
-
-  if (need_new) {
-    //  Create new file, with empty catalog, and correct header
-    m_fs = new wxFFile(m_CompressedCacheFilePath, _T("wb"));
-    n_catalog_entries = 0;
-    m_catalog_offset = 0;
-    WriteCatalogAndHeader();
-    delete m_fs;
-
-    m_fs = new wxFFile(m_CompressedCacheFilePath, _T("rb+"));
-  }
-  m_hdrOK = true;
-  return true;
-}
-
-bool glTexFactory::AddCacheEntryValue(const CatalogEntry &p) {
-  if ((int)p.k.tcolorscheme < 0 || p.k.tcolorscheme >= N_COLOR_SCHEMES)
-    return false;
-
-  if (p.k.mip_level < 0 || p.k.mip_level >= MAX_TEX_LEVEL) return false;
-
-  int array_index = ArrayIndex(p.k.x, p.k.y);
-  if (array_index < 0 || array_index >= m_ntex) return false;
-
-  if (m_cache[p.k.tcolorscheme][p.k.mip_level] == 0)
-    m_cache[p.k.tcolorscheme][p.k.mip_level] =
-        (CatalogEntryValue *)calloc(m_ntex, sizeof(CatalogEntryValue));
-
-  CatalogEntryValue *v = m_cache[p.k.tcolorscheme][p.k.mip_level];
-  CatalogEntryValue *r = &v[array_index];
-  *r = p.v;
-  return true;
-}
-
-bool glTexFactory::LoadCatalog(void) {
-  m_newCatalog = false;
-  if (m_catalogOK) return true;
-
-  if (!LoadHeader()) return false;
-
-  if (n_catalog_entries == 0) {
-    // new empty header
-    m_catalogOK = true;
-    m_newCatalog = true;
-    return true;
-  }
-
-  m_fs->Seek(m_catalog_offset);
-
-  CatalogEntry ps;
-  int buf_size = ps.GetSerialSize();
-  unsigned char *buf = (unsigned char *)malloc(buf_size);
-
-  CatalogEntry p;
-  bool bad = false;
-  for (int i = 0; i < n_catalog_entries; i++) {
-    m_fs->Read(buf, buf_size);
-    p.DeSerialize(buf);
-    if (!AddCacheEntryValue(p)) bad = true;
-  }
-
-  free(buf);
-  if (bad && !m_catalogCorrupted) {
-    wxLogMessage(_T("Bad cache catalog %s %s"), m_ChartPath.c_str(),
-                 m_CompressedCacheFilePath.c_str());
-    m_catalogCorrupted = true;
-  }
-  m_catalogOK = true;
-  return true;
-}
-
-bool glTexFactory::WriteCatalogAndHeader() {
-  if (m_fs && m_fs->IsOpened()) {
-    m_fs->Seek(m_catalog_offset);
-
-    CatalogEntry ps;
-    int buf_size = ps.GetSerialSize();
-    unsigned char buf[CATALOG_ENTRY_SERIAL_SIZE];  // MSVC requires constant
-                                                   // stack array size...
-    int new_n_catalog_entries = 0;
-    CatalogEntry p;
-    wxRect rect;
-    for (int i = 0; i < N_COLOR_SCHEMES; i++) {
-      p.k.tcolorscheme = (ColorScheme)i;
-      for (int j = 0; j < MAX_TEX_LEVEL; j++) {
-        CatalogEntryValue *v = m_cache[i][j];
-        if (!v) continue;
-        p.k.mip_level = j;
-        for (int k = 0; k < m_ntex; k++) {
-          ArrayXY(&rect, k);
-          p.k.y = rect.y;
-          p.k.x = rect.x;
-          CatalogEntryValue *r = &v[k];
-          if (r->compressed_size == 0) continue;
-          p.v = *r;
-          new_n_catalog_entries++;
-          p.Serialize(buf);
-          m_fs->Write(buf, buf_size);
-        }
-      }
-    }
-
-    n_catalog_entries = new_n_catalog_entries;
-    //   Write header at file end
-    CompressedCacheHeader hdr;
-    hdr.magic = COMPRESSED_CACHE_MAGIC;
-    hdr.format = g_raster_format;
-    hdr.m_nentries = n_catalog_entries;
-    hdr.catalog_offset = m_catalog_offset;
-    hdr.chartdate = m_chart_date_binary;
-    hdr.chartfile_date = m_chartfile_date_binary;
-    hdr.chartfile_size = m_chartfile_size;
-
-    m_fs->Write(&hdr, sizeof(hdr));
-    m_fs->Flush();
-
-    return true;
-  } else
-    return false;
-}
-
-bool glTexFactory::UpdateCachePrecomp(unsigned char *data, int data_size,
-                                      const wxRect &rect, int level,
-                                      ColorScheme color_scheme,
-                                      bool write_catalog) {
-  if (level < 0 || level >= MAX_TEX_LEVEL) return false;  // XXX BUG
-
-  //  Search the catalog for this particular texture
-  if (GetCacheEntryValue(level, rect.x, rect.y, color_scheme) != 0)
-    return false;
-
-  // Make sure the file exists
-  wxASSERT(m_fs != 0);
-
-  if (!m_fs->IsOpened()) return false;
-
-  //      Create a new catalog entry
-  CatalogEntry p(level, rect.x, rect.y, color_scheme);
-
-  //      Write the compressed data to disk
-  p.v.texture_offset = m_catalog_offset;
-
-  p.v.compressed_size = data_size;
-  AddCacheEntryValue(p);
-  n_catalog_entries++;
-
-  //      We write the new data at the current catalog offset, overwriting the
-  //      old catalog
-  m_fs->Seek(m_catalog_offset);
-  m_fs->Write(data, data_size);
-
-  //      Write the catalog and Header (which follows the catalog at the end of
-  //      the file
-  m_catalog_offset += data_size;
-  if (write_catalog) WriteCatalogAndHeader();
-
-  return true;
-}
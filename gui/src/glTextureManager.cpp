@@ -25,6 +25,7 @@
  */
 
 #include <wx/wxprec.h>
+#include <wx/dir.h>
 #include <wx/progdlg.h>
 #include <wx/wx.h>
 #include <wx/thread.h>
@@ -52,6 +53,7 @@
 #include "gui_lib.h"
 #include "ocpn_frame.h"
 #include "model/own_ship.h"
+#include "model/tex_cache_store.h"
 
 #ifndef GL_ETC1_RGB8_OES
 #define GL_ETC1_RGB8_OES 0x8D64
@@ -91,34 +93,35 @@ bool g_throttle_squish;
 
 glTextureManager *g_glTextureManager;
 
-#include "ssl/sha1.h"
+static bool IsLegacyCacheFile(const wxString &name) {
+  //  Per chart files were named by the sha1 of the chart path
+  if (name.length() != 40) return false;
+  for (size_t i = 0; i < name.length(); i++)
+    if (!wxIsxdigit(name[i])) return false;
+  return true;
+}
 
-wxString CompressedCachePath(wxString path) {
-#if defined(__WXMSW__)
-  int colon = path.find(':', 0);
-  if (colon != wxNOT_FOUND) path.Remove(colon, 1);
-#endif
+static TexCacheStore *OpenTexCacheStore() {
+  wxString path = g_Platform->GetPrivateDataDir() +
+                  wxFileName::GetPathSeparator() + _T("raster_texture_cache");
+  if (!wxDirExists(path)) wxFileName::Mkdir(path, 0755, wxPATH_MKDIR_FULL);
 
-  /* replace path separators with ! */
-  wxChar separator = wxFileName::GetPathSeparator();
-  for (unsigned int pos = 0; pos < path.size(); pos = path.find(separator, pos))
-    path.replace(pos, 1, _T("!"));
-
-  //  Obfuscate the compressed chart file name, to (slightly) protect some
-  //  encrypted raster chart data.
-  wxCharBuffer buf = path.ToUTF8();
-  unsigned char sha1_out[20];
-  sha1((unsigned char *)buf.data(), strlen(buf.data()), sha1_out);
-
-  wxString sha1;
-  for (unsigned int i = 0; i < 20; i++) {
-    wxString s;
-    s.Printf(_T("%02X"), sha1_out[i]);
-    sha1 += s;
+  wxArrayString files;
+  wxDir::GetAllFiles(path, &files, wxEmptyString, wxDIR_FILES);
+  for (unsigned int i = 0; i < files.GetCount(); i++) {
+    if (IsLegacyCacheFile(wxFileName(files[i]).GetFullName()))
+      wxRemoveFile(files[i]);
   }
 
-  return g_Platform->GetPrivateDataDir() + separator +
-         _T("raster_texture_cache") + separator + sha1;
+  TexCacheStore *store = new TexCacheStore();
+  if (!store->Open(path.ToStdString()))
+    wxLogMessage(_T("Cannot open raster texture cache in ") + path);
+  return store;
+}
+
+TexCacheStore *GetTexCacheStore() {
+  static TexCacheStore *store = OpenTexCacheStore();
+  return store;
 }
 
 int g_mipmap_max_level = 4;
@@ -754,6 +757,7 @@ glTextureManager::~glTextureManager() {
     delete hash.second;
   }
   m_chart_texfactory_hash.clear();
+  GetTexCacheStore()->Commit();
 }
 
 #define NBAR_LENGTH 40
@@ -1182,6 +1186,13 @@ void glTextureManager::ClearAllRasterTextures(void) {
     wxLogMessage(_T("Texture memory use calculation error\n"));
 }
 
+size_t glTextureManager::GetChartTextureBytes(ChartBase *pc) {
+  ChartPathHashTexfactType::iterator ittf =
+      m_chart_texfactory_hash.find(pc->GetHashKey());
+  if (ittf == m_chart_texfactory_hash.end() || !ittf->second) return 0;
+  return ittf->second->GetResidentBytes();
+}
+
 bool glTextureManager::PurgeChartTextures(ChartBase *pc, bool b_purge_factory) {
   //    Look for the texture factory for this chart
   ChartPathHashTexfactType::iterator ittf =
@@ -1356,12 +1367,6 @@ void glTextureManager::BuildCompressedCache() {
       if (chart_type != CHART_TYPE_KAP) continue;
     }
 
-    wxString CompressedCacheFilePath =
-        CompressedCachePath(ChartData->GetDBChartFileName(i));
-    wxFileName fn(CompressedCacheFilePath);
-    //        if(fn.FileExists()) /* skip if file exists */
-    //            continue;
-
     idx_sorted_by_distance.Add(i);
 
     count++;
@@ -1487,7 +1492,6 @@ void glTextureManager::BuildCompressedCache() {
 
   for (m_jcnt = 0; m_jcnt < ct_array.GetCount(); m_jcnt++) {
     wxString filename = ct_array[m_jcnt].chart_path;
-    wxString CompressedCacheFilePath = CompressedCachePath(filename);
     double distance = ct_array[m_jcnt].distance;
 
     ChartBase *pchart = ChartData->OpenChartFromDBAndLock(filename, FULL_INIT);
@@ -274,6 +274,14 @@ wxPoint2DDouble GetDoublePixFromLL(ViewPort &vp, double lat, double lon) {
   return p;
 }
 
+//  Whole contours at a time, through the viewport's batch projection
+static void GetDoublePixFromLL(ViewPort &vp, int n, const double *lat,
+                               const double *lon, wxPoint2DDouble *pix) {
+  vp.GetDoublePixFromLL(n, lat, lon, pix);
+  for (int i = 0; i < n; i++)
+    pix[i].m_x -= vp.rv_rect.x, pix[i].m_y -= vp.rv_rect.y;
+}
+
 void GshhsPolyCell::DrawPolygonFilled(ocpnDC &pnt, contour_list *p, double dx,
                                       ViewPort &vp, wxColor const &color) {
   if (!p->size()) /* size of 0 is very common, and setting the brush is
@@ -289,6 +297,9 @@ void GshhsPolyCell::DrawPolygonFilled(ocpnDC &pnt, contour_list *p, double dx,
 
   pnt.SetBrush(color);
 
+  std::vector<double> lats, lons;
+  std::vector<wxPoint2DDouble> pix;
+
   for (c = 0; c < p->size(); c++) {
     if (!p->at(c).size()) continue;
 
@@ -297,9 +308,17 @@ void GshhsPolyCell::DrawPolygonFilled(ocpnDC &pnt, contour_list *p, double dx,
     contour &cp = p->at(c);
     pointCount = 0;
 
+    lats.resize(cp.size());
+    lons.resize(cp.size());
+    pix.resize(cp.size());
+    for (v = 0; v < cp.size(); v++) {
+      lats[v] = cp[v].y;
+      lons[v] = cp[v].x + dx;
+    }
+    GetDoublePixFromLL(vp, cp.size(), &lats[0], &lons[0], &pix[0]);
+
     for (v = 0; v < p->at(c).size(); v++) {
-      wxRealPoint &ccp = cp.at(v);
-      wxPoint2DDouble q = GetDoublePixFromLL(vp, ccp.y, ccp.x + dx);
+      const wxPoint2DDouble &q = pix[v];
       if (std::isnan(q.m_x)) {
         pointCount = 0;
         break;
@@ -553,11 +572,17 @@ void GshhsPolyCell::DrawPolygonFilledGL(ocpnDC &pnt, contour_list *p, float_2Dpt
 #endif
   } else {
     float *pvt = new float[2 * (*pvc)];
+    std::vector<double> lats(*pvc), lons(*pvc);
+    std::vector<wxPoint2DDouble> pix(*pvc);
     for (int i = 0; i < *pvc; i++) {
       float_2Dpt *pc = *pv + i;
-      wxPoint2DDouble q = vp.GetDoublePixFromLL(pc->y, pc->x);
-      pvt[i * 2] = q.m_x;
-      pvt[(i * 2) + 1] = q.m_y;
+      lats[i] = pc->y;
+      lons[i] = pc->x;
+    }
+    if (*pvc > 0) vp.GetDoublePixFromLL(*pvc, &lats[0], &lons[0], &pix[0]);
+    for (int i = 0; i < *pvc; i++) {
+      pvt[i * 2] = pix[i].m_x;
+      pvt[(i * 2) + 1] = pix[i].m_y;
     }
 
     GLShaderProgram *shader = pcolor_tri_shader_program[pnt.m_canvasIndex];
@@ -1346,16 +1371,21 @@ int GshhsReader::GSHHS_scaledPoints(GshhsPolygon *pol, wxPoint *pts,
 
   if (p1.m_x == p2.m_x && p1.m_y == p2.m_y) return 0;
 
-  double x, y;
-  std::vector<GshhsPoint *>::iterator itp;
+  size_t n = pol->lsPoints.size();
+  if (!n) return 0;
+  std::vector<double> lats(n), lons(n);
+  std::vector<wxPoint2DDouble> pix(n);
+  for (size_t i = 0; i < n; i++) {
+    lons[i] = pol->lsPoints[i]->lon + declon;
+    lats[i] = pol->lsPoints[i]->lat;
+  }
+  GetDoublePixFromLL(vp, n, &lats[0], &lons[0], &pix[0]);
+
   int xx, yy, oxx = 0, oyy = 0;
   int j = 0;
 
-  for (itp = (pol->lsPoints).begin(); itp != (pol->lsPoints).end(); itp++) {
-    x = (*itp)->lon + declon;
-    y = (*itp)->lat;
-    wxPoint2DDouble p = GetDoublePixFromLL(vp, y, x);
-    xx = p.m_x, yy = p.m_y;
+  for (size_t i = 0; i < n; i++) {
+    xx = pix[i].m_x, yy = pix[i].m_y;
     if (j == 0 || (oxx != xx || oyy != yy)) {  // Remove close points
       oxx = xx;
       oyy = yy;
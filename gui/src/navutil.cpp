@@ -34,6 +34,8 @@
 #include <time.h>
 #include <locale>
 #include <list>
+#include <memory>
+#include <vector>
 
 
 #ifndef WX_PRECOMP
@@ -69,6 +71,7 @@
 #include "model/route.h"
 #include "model/routeman.h"
 #include "model/select.h"
+#include "model/startup_tasks.h"
 #include "model/track.h"
 
 #include "ais.h"
@@ -195,6 +198,9 @@ extern double g_TrackIntervalSeconds;
 
 extern int g_nCacheLimit;
 extern int g_memCacheLimit;
+extern int g_chartCacheRasterMB;
+extern int g_chartCacheVectorMB;
+extern int g_chartCacheOtherMB;
 
 extern bool g_bGDAL_Debug;
 extern bool g_bDebugCM93;
@@ -401,6 +407,7 @@ MyConfig::MyConfig(const wxString &LocalFileName)
   m_sNavObjSetChangesFile = m_sNavObjSetFile + _T ( ".changes" );
 
   m_pNavObjectInputSet = NULL;
+  m_bNavObjectsParsed = false;
   m_pNavObjectChangesSet = NavObjectChanges::getInstance();
 }
 
@@ -757,6 +764,11 @@ int MyConfig::LoadMyConfigRaw(bool bAsTemplate) {
   if (mem_limit > 0)
     g_memCacheLimit = mem_limit * 1024;  // convert from MBytes to kBytes
 
+  //  Resident byte budget of the chart cache, per chart family
+  Read(_T ( "ChartCacheRasterMB" ), &g_chartCacheRasterMB);
+  Read(_T ( "ChartCacheVectorMB" ), &g_chartCacheVectorMB);
+  Read(_T ( "ChartCacheOtherMB" ), &g_chartCacheOtherMB);
+
   Read(_T ( "UseModernUI5" ), &g_useMUI);
 
   Read(_T( "NCPUCount" ), &g_nCPUCount);
@@ -1673,14 +1685,10 @@ wxString MyConfig::FindNewestUsableBackup() const {
   return newest_backup;
 }
 
-void MyConfig::LoadNavObjects() {
-  //      next thing to do is read tracks, etc from the NavObject XML file,
-  wxLogMessage(_T("Loading navobjects from navobj.xml"));
-
+bool MyConfig::ParseNavObjects() {
   if (NULL == m_pNavObjectInputSet)
     m_pNavObjectInputSet = new NavObjectCollection1();
 
-  int wpt_dups = 0;
   wxString newest_backup;
   if (::wxFileExists(m_sNavObjSetFile)) {
     if (wxFileName::GetSize(m_sNavObjSetFile) < 461) { // Empty navobj.xml file with just the gpx tag is 461 bytes, so anything smaller is obvious sign of a fatal crash while saving it last time, replace it with latest backup if available
@@ -1700,11 +1708,11 @@ void MyConfig::LoadNavObjects() {
       wxLogMessage("No navobjects.xml file or usable backup exist, will create a new one.");
     }
   }
-  bool success = false;
+  m_bNavObjectsParsed = false;
   // We did all we could to have an usable navobj.xml file in scenarios where it did not exist or was clearly corrupted, let's try to load it
   if(::wxFileExists(m_sNavObjSetFile) && m_pNavObjectInputSet->load_file(m_sNavObjSetFile.fn_str()).status == pugi::xml_parse_status::status_ok) {
     CreateRotatingNavObjBackup(); // We only create backups when data is good, there is no point in saving something we can't even load
-    success = m_pNavObjectInputSet->LoadAllGPXObjects(false, wpt_dups);
+    m_bNavObjectsParsed = true;
   } else {
     // It was still not valid after all our efforts and did not load as XML, let's rename it to a corrupted file and try to recover from a backup on last time
     wxString corrupted_file = m_sNavObjSetFile + wxDateTime::Now().Format(".corrupted.%Y-%m-%d-%H-%M-%S");
@@ -1716,13 +1724,26 @@ void MyConfig::LoadNavObjects() {
     }
     m_pNavObjectInputSet->reset();
     if (wxFileExists(newest_backup) && m_pNavObjectInputSet->load_file(newest_backup.fn_str()).status == pugi::xml_parse_status::status_ok) {
-      success = m_pNavObjectInputSet->LoadAllGPXObjects(false, wpt_dups);
-      wxLogMessage("We do have a healthy backup " + newest_backup +  " and did load it.");
+      m_bNavObjectsParsed = true;
+      wxLogMessage("We do have a healthy backup " + newest_backup +  " and will load it.");
     } else {
       wxLogMessage("No usable backup found, a new navobj.xml file will be created.");
       m_pNavObjectInputSet->reset();
     }
   }
+  return m_bNavObjectsParsed;
+}
+
+void MyConfig::LoadNavObjects() {
+  //      next thing to do is read tracks, etc from the NavObject XML file,
+  wxLogMessage(_T("Loading navobjects from navobj.xml"));
+
+  if (NULL == m_pNavObjectInputSet) ParseNavObjects();
+
+  int wpt_dups = 0;
+  bool success = false;
+  if (m_bNavObjectsParsed)
+    success = m_pNavObjectInputSet->LoadAllGPXObjects(false, wpt_dups);
   if (success) {
     wxLogMessage(_T("Done loading navobjects, %d duplicate waypoints ignored"),
                wpt_dups);
@@ -1730,6 +1751,8 @@ void MyConfig::LoadNavObjects() {
     wxLogMessage(_T("Failed to load navobjects, creating a new navobj.xml file."));
   }
   delete m_pNavObjectInputSet;
+  m_pNavObjectInputSet = NULL;
+  m_bNavObjectsParsed = false;
 
   if (::wxFileExists(m_sNavObjSetChangesFile)) {
     if (ReloadPendingChanges(m_sNavObjSetChangesFile)) {
@@ -1743,9 +1766,17 @@ void MyConfig::LoadNavObjects() {
 }
 
 bool MyConfig::LoadLayers(wxString &path) {
+  //  Without workers, the tasks run in sequence on this thread
+  StartupTasks tasks;
+  tasks.Wait(AddLayerTasks(tasks, path, -1));
+
+  return true;
+}
+
+int MyConfig::AddLayerTasks(StartupTasks &tasks, const wxString &path,
+                            int after) {
   wxArrayString file_array;
   wxDir dir;
-  Layer *l;
   dir.Open(path);
   if (dir.IsOpened()) {
     wxString filename;
@@ -1769,68 +1800,93 @@ bool MyConfig::LoadLayers(wxString &path) {
       }
 
       if (file_array.GetCount()) {
-        l = new Layer();
-        l->m_LayerID = ++g_LayerIdx;
-        l->m_LayerFileName = file_array[0];
+        wxString layer_name;
         if (file_array.GetCount() <= 1)
-          wxFileName::SplitPath(file_array[0], NULL, NULL, &(l->m_LayerName),
-                                NULL, NULL);
+          wxFileName::SplitPath(file_array[0], NULL, NULL, &layer_name, NULL,
+                                NULL);
         else
-          wxFileName::SplitPath(filename, NULL, NULL, &(l->m_LayerName), NULL,
+          wxFileName::SplitPath(filename, NULL, NULL, &layer_name, NULL,
                                 NULL);
 
-        bool bLayerViz = g_bShowLayers;
+        //  Parse the files of the layer in parallel
+        auto sets = std::make_shared<std::vector<NavObjectCollection1 *>>(
+            file_array.GetCount(), nullptr);
+        std::vector<int> deps;
+        if (after >= 0) deps.push_back(after);
+        for (unsigned int i = 0; i < file_array.GetCount(); i++) {
+          wxString file_path = file_array[i];
+          std::string task_name("Parse layer file ");
+          task_name += file_path.ToStdString();
+          deps.push_back(tasks.Add(task_name, [sets, i, file_path]() {
+            if (!::wxFileExists(file_path)) return;
+            NavObjectCollection1 *pSet = new NavObjectCollection1;
+            if (pSet->load_file(file_path.fn_str()).status != pugi::xml_parse_status::status_ok) {
+              wxLogMessage("Error loading GPX file " + file_path);
+              pSet->reset();
+            }
+            (*sets)[i] = pSet;
+          }));
+        }
 
-        if (g_VisibleLayers.Contains(l->m_LayerName)) bLayerViz = true;
-        if (g_InvisibleLayers.Contains(l->m_LayerName)) bLayerViz = false;
+        //  Then create the layer and its objects on the main thread
+        std::string task_name("Layer ");
+        task_name += layer_name.ToStdString();
+        after = tasks.Add(task_name, [sets, file_array, layer_name]() {
+          Layer *l = new Layer();
+          l->m_LayerID = ++g_LayerIdx;
+          l->m_LayerFileName = file_array[0];
+          l->m_LayerName = layer_name;
 
-        l->m_bHasVisibleNames = wxCHK_UNDETERMINED;
-        if (g_VisiNameinLayers.Contains(l->m_LayerName))
-          l->m_bHasVisibleNames = wxCHK_CHECKED;
-        if (g_InVisiNameinLayers.Contains(l->m_LayerName))
-          l->m_bHasVisibleNames = wxCHK_UNCHECKED;
+          bool bLayerViz = g_bShowLayers;
 
-        l->m_bIsVisibleOnChart = bLayerViz;
+          if (g_VisibleLayers.Contains(l->m_LayerName)) bLayerViz = true;
+          if (g_InvisibleLayers.Contains(l->m_LayerName)) bLayerViz = false;
 
-        wxString laymsg;
-        laymsg.Printf(wxT("New layer %d: %s"), l->m_LayerID,
-                      l->m_LayerName.c_str());
-        wxLogMessage(laymsg);
+          l->m_bHasVisibleNames = wxCHK_UNDETERMINED;
+          if (g_VisiNameinLayers.Contains(l->m_LayerName))
+            l->m_bHasVisibleNames = wxCHK_CHECKED;
+          if (g_InVisiNameinLayers.Contains(l->m_LayerName))
+            l->m_bHasVisibleNames = wxCHK_UNCHECKED;
 
-        pLayerList->Insert(l);
+          l->m_bIsVisibleOnChart = bLayerViz;
 
-        //  Load the entire file array as a single layer
+          wxString laymsg;
+          laymsg.Printf(wxT("New layer %d: %s"), l->m_LayerID,
+                        l->m_LayerName.c_str());
+          wxLogMessage(laymsg);
 
-        for (unsigned int i = 0; i < file_array.GetCount(); i++) {
-          wxString file_path = file_array[i];
+          pLayerList->Insert(l);
 
-          if (::wxFileExists(file_path)) {
-            NavObjectCollection1 *pSet = new NavObjectCollection1;
-            if (pSet->load_file(file_path.fn_str()).status != pugi::xml_parse_status::status_ok) {
-              wxLogMessage("Error loading GPX file " + file_path);
-              pSet->reset();
-            }
-            long nItems = pSet->LoadAllGPXObjectsAsLayer(
-                l->m_LayerID, bLayerViz, l->m_bHasVisibleNames);
-            l->m_NoOfItems += nItems;
-            l->m_LayerType = _("Persistent");
+          //  Load the entire file array as a single layer
+
+          for (unsigned int i = 0; i < file_array.GetCount(); i++) {
+            NavObjectCollection1 *pSet = (*sets)[i];
+            if (pSet) {
+              long nItems = pSet->LoadAllGPXObjectsAsLayer(
+                  l->m_LayerID, bLayerViz, l->m_bHasVisibleNames);
+              l->m_NoOfItems += nItems;
+              l->m_LayerType = _("Persistent");
 
-            wxString objmsg;
-            objmsg.Printf(wxT("Loaded GPX file %s with %ld items."),
-                          file_path.c_str(), nItems);
-            wxLogMessage(objmsg);
+              wxString objmsg;
+              objmsg.Printf(wxT("Loaded GPX file %s with %ld items."),
+                            file_array[i].c_str(), nItems);
+              wxLogMessage(objmsg);
 
-            delete pSet;
+              delete pSet;
+              (*sets)[i] = nullptr;
+            }
           }
-        }
+        }, deps, StartupTasks::Where::kMain);
       }
 
       cont = dir.GetNext(&filename);
     }
   }
-  g_bLayersLoaded = true;
 
-  return true;
+  std::vector<int> deps;
+  if (after >= 0) deps.push_back(after);
+  return tasks.Add("Layers loaded", []() { g_bLayersLoaded = true; }, deps,
+                   StartupTasks::Where::kMain);
 }
 
 bool MyConfig::LoadChartDirArray(ArrayOfCDI &ChartDirArray) {
@@ -471,6 +471,9 @@ bool g_bUseGLL = true;
 
 int g_nCacheLimit;
 int g_memCacheLimit;
+int g_chartCacheRasterMB;
+int g_chartCacheVectorMB;
+int g_chartCacheOtherMB;
 bool g_bGDAL_Debug;
 
 bool g_bCourseUp;
@@ -975,6 +978,7 @@ MyApp::MyApp()
       RouteCtxFactory(),
       g_bportable),
       m_usb_watcher(UsbWatchDaemon::GetInstance()),
+      m_navobj_task(-1),
       m_exitcode(-2)
 {
 #ifdef __linux__
@@ -1269,6 +1273,7 @@ bool MyApp::OnInit() {
   }
 
   //      Open/Create the Config Object
+  int config_stage = m_startup.Begin("Configuration");
   pConfig = g_Platform->GetConfigObject();
   InitBaseConfig(pConfig);
   pConfig->LoadMyConfig();
@@ -1488,7 +1493,79 @@ bool MyApp::OnInit() {
   }
 
   gpIDXn = 0;
+  m_startup.End(config_stage);
 
+  //   Build the initial chart dir array
+  ArrayOfCDI ChartDirArray;
+  pConfig->LoadChartDirArray(ChartDirArray);
+
+  //  Windows installer may have left hints regarding the initial chart dir
+  //  selection
+#ifdef __WXMSW__
+  if (g_bFirstRun && (ChartDirArray.GetCount() == 0)) {
+    int ndirs = 0;
+
+    wxRegKey RegKey(wxString(_T("HKEY_LOCAL_MACHINE\\SOFTWARE\\OpenCPN")));
+    if (RegKey.Exists()) {
+      wxLogMessage(
+          _("Retrieving initial Chart Directory set from Windows Registry"));
+      wxString dirs;
+      RegKey.QueryValue(wxString(_T("ChartDirs")), dirs);
+
+      wxStringTokenizer tkz(dirs, _T(";"));
+      while (tkz.HasMoreTokens()) {
+        wxString token = tkz.GetNextToken();
+
+        ChartDirInfo cdi;
+        cdi.fullpath = token.Trim();
+        cdi.magic_number = _T("");
+
+        ChartDirArray.Add(cdi);
+        ndirs++;
+      }
+    }
+
+    if (g_bportable) {
+      ChartDirInfo cdi;
+      cdi.fullpath = _T("charts");
+      cdi.fullpath.Prepend(g_Platform->GetSharedDataDir());
+      cdi.magic_number = _T("");
+      ChartDirArray.Add(cdi);
+      ndirs++;
+    }
+
+    if (ndirs) pConfig->UpdateChartDirs(ChartDirArray);
+  }
+#endif
+
+  //    If the ChartDirArray is empty at this point, any existing chart database
+  //    file must be declared invalid, So it is best to simply delete it if
+  //    present.
+  //    TODO  There is a possibility of recreating the dir list from the
+  //    database itself......
+
+  if (!ChartDirArray.GetCount())
+    if (::wxFileExists(ChartListFileName)) ::wxRemoveFile(ChartListFileName);
+
+  //      Read the current chart list Data file while the frame is built.
+  //      The chart class descriptors need the main thread, so only the
+  //      file is read on a worker.
+  ChartDB *chart_db = new ChartDB();
+  bool chart_db_ok = true;
+  int chart_db_task = -1;
+  if (g_NeedDBUpdate == 0) {
+    chart_db_task = m_startup.Add(
+        "Chart database", [chart_db, &chart_db_ok, ChartDirArray]() mutable {
+          chart_db_ok = chart_db->LoadBinary(ChartListFileName, ChartDirArray);
+        });
+  }
+  //      navobj.xml is parsed in the meantime too, the objects are created
+  //      later on in MyFrame::OnInitTimer()
+  m_navobj_task = m_startup.Add("Parse navobj.xml",
+                                []() { pConfig->ParseNavObjects(); });
+  m_startup.Start();
+
+  int frame_stage = m_startup.Begin("Main frame");
   g_Platform->Initialize_2();
 
   //  Set up the frame initial visual parameters
@@ -1649,64 +1726,12 @@ bool MyApp::OnInit() {
 
   //  Yield to pick up the OnSize() calls that result from Maximize()
   Yield();
+  m_startup.End(frame_stage);
 
-  //   Build the initial chart dir array
-  ArrayOfCDI ChartDirArray;
-  pConfig->LoadChartDirArray(ChartDirArray);
-
-  //  Windows installer may have left hints regarding the initial chart dir
-  //  selection
-#ifdef __WXMSW__
-  if (g_bFirstRun && (ChartDirArray.GetCount() == 0)) {
-    int ndirs = 0;
-
-    wxRegKey RegKey(wxString(_T("HKEY_LOCAL_MACHINE\\SOFTWARE\\OpenCPN")));
-    if (RegKey.Exists()) {
-      wxLogMessage(
-          _("Retrieving initial Chart Directory set from Windows Registry"));
-      wxString dirs;
-      RegKey.QueryValue(wxString(_T("ChartDirs")), dirs);
-
-      wxStringTokenizer tkz(dirs, _T(";"));
-      while (tkz.HasMoreTokens()) {
-        wxString token = tkz.GetNextToken();
-
-        ChartDirInfo cdi;
-        cdi.fullpath = token.Trim();
-        cdi.magic_number = _T("");
-
-        ChartDirArray.Add(cdi);
-        ndirs++;
-      }
-    }
-
-    if (g_bportable) {
-      ChartDirInfo cdi;
-      cdi.fullpath = _T("charts");
-      cdi.fullpath.Prepend(g_Platform->GetSharedDataDir());
-      cdi.magic_number = _T("");
-      ChartDirArray.Add(cdi);
-      ndirs++;
-    }
-
-    if (ndirs) pConfig->UpdateChartDirs(ChartDirArray);
-  }
-#endif
-
-  //    If the ChartDirArray is empty at this point, any existing chart database
-  //    file must be declared invalid, So it is best to simply delete it if
-  //    present.
-  //    TODO  There is a possibility of recreating the dir list from the
-  //    database itself......
-
-  if (!ChartDirArray.GetCount())
-    if (::wxFileExists(ChartListFileName)) ::wxRemoveFile(ChartListFileName);
-
-  //      Try to load the current chart list Data file
-  ChartData = new ChartDB();
-  if (g_NeedDBUpdate == 0 && !ChartData->LoadBinary(ChartListFileName, ChartDirArray)) {
-    g_NeedDBUpdate = 1;
-  }
+  //      Pick up the chart list Data file read while the frame was built
+  m_startup.Wait(chart_db_task);
+  ChartData = chart_db;
+  if (!chart_db_ok) g_NeedDBUpdate = 1;
 
   //  Verify any saved chart database startup index
   if (g_restore_dbindex >= 0) {
@@ -4714,40 +4714,49 @@ void MyFrame::OnInitTimer(wxTimerEvent &event) {
       }
 
       // Load the waypoints. Both of these routines are very slow to execute
-      // which is why they have been to defered until here
-      auto colour_func = [](wxString c) { return GetGlobalColor(c); };
-      pWayPointMan = new WayPointman(colour_func);
-      WayPointmanGui(*pWayPointMan).SetColorScheme(global_color_scheme,
-                                                   g_Platform->GetDisplayDPmm());
-      // Reload the ownship icon from UserIcons, if present
-      for (unsigned int i = 0; i < g_canvasArray.GetCount(); i++) {
-        ChartCanvas *cc = g_canvasArray.Item(i);
-        if (cc) {
-          if (cc->SetUserOwnship()) cc->SetColorScheme(global_color_scheme);
+      // which is why they have been to defered until here. navobj.xml and
+      // the layer files are parsed on worker threads, while the objects
+      // are created here in turn.
+      StartupTasks &startup = wxGetApp().m_startup;
+      int waypointman = startup.Add("Waypoint manager", [&]() {
+        auto colour_func = [](wxString c) { return GetGlobalColor(c); };
+        pWayPointMan = new WayPointman(colour_func);
+        WayPointmanGui(*pWayPointMan).SetColorScheme(global_color_scheme,
+                                                     g_Platform->GetDisplayDPmm());
+        // Reload the ownship icon from UserIcons, if present
+        for (unsigned int i = 0; i < g_canvasArray.GetCount(); i++) {
+          ChartCanvas *cc = g_canvasArray.Item(i);
+          if (cc) {
+            if (cc->SetUserOwnship()) cc->SetColorScheme(global_color_scheme);
+          }
         }
-      }
+      }, {}, StartupTasks::Where::kMain);
 
-      pConfig->LoadNavObjects();
-      //    Re-enable anchor watches if set in config file
-      if (!g_AW1GUID.IsEmpty()) {
-        pAnchorWatchPoint1 = pWayPointMan->FindRoutePointByGUID(g_AW1GUID);
-      }
-      if (!g_AW2GUID.IsEmpty()) {
-        pAnchorWatchPoint2 = pWayPointMan->FindRoutePointByGUID(g_AW2GUID);
-      }
+      int navobj = startup.Add("Navigation objects", [&]() {
+        pConfig->LoadNavObjects();
+        //    Re-enable anchor watches if set in config file
+        if (!g_AW1GUID.IsEmpty()) {
+          pAnchorWatchPoint1 = pWayPointMan->FindRoutePointByGUID(g_AW1GUID);
+        }
+        if (!g_AW2GUID.IsEmpty()) {
+          pAnchorWatchPoint2 = pWayPointMan->FindRoutePointByGUID(g_AW2GUID);
+        }
+      }, {waypointman, wxGetApp().m_navobj_task}, StartupTasks::Where::kMain);
 
       // Import Layer-wise any .gpx files from /layers directory
       wxString layerdir = g_Platform->GetPrivateDataDir();
       appendOSDirSlash(&layerdir);
       layerdir.Append(_T("layers"));
 
+      int last = navobj;
       if (wxDir::Exists(layerdir)) {
         wxString laymsg;
         laymsg.Printf(wxT("Getting .gpx layer files from: %s"),
                       layerdir.c_str());
         wxLogMessage(laymsg);
-        pConfig->LoadLayers(layerdir);
+        last = pConfig->AddLayerTasks(startup, layerdir, navobj);
       }
+      startup.Wait(last);
 
       break;
     }
@@ -4770,7 +4779,9 @@ void MyFrame::OnInitTimer(wxTimerEvent &event) {
       if (m_initializing) break;
       m_initializing = true;
       AbstractPlatform::ShowBusySpinner();
+      int plugins_stage = wxGetApp().m_startup.Begin("Plugins");
       PluginLoader::getInstance()->LoadAllPlugIns(true);
+      wxGetApp().m_startup.End(plugins_stage);
       AbstractPlatform::HideBusySpinner();
       //            RequestNewToolbars();
       RequestNewMasterToolbar();
@@ -4976,6 +4987,11 @@ void MyFrame::OnInitTimer(wxTimerEvent &event) {
 
       SendSizeEvent();
 
+      wxGetApp().m_startup.Stop();
+      wxLogMessage(_T("Startup timing, start and duration:"));
+      for (const auto &line : wxGetApp().m_startup.Report())
+        wxLogMessage(wxString(line));
+
       break;
     }
   }  // switch
@@ -5279,55 +5295,21 @@ void MyFrame::OnMemFootTimer(wxTimerEvent &event) {
   if (memsize > (g_MemFootMB * 1000)) {
     ChartCanvas *cc = GetPrimaryCanvas();
     if (ChartData && cc) {
-      //    Get a local copy of the cache info
-      wxArrayPtrVoid *pCache = ChartData->GetChartCache();
-      unsigned int nCache = pCache->GetCount();
-      CacheEntry *pcea = new CacheEntry[nCache];
-
-      for (unsigned int i = 0; i < nCache; i++) {
-        CacheEntry *pce = (CacheEntry *)(pCache->Item(i));
-        pcea[i] = *pce;  // ChartBase *Ch = (ChartBase *)pce->pChart;
-      }
+      //    Free up some chart cache entries, oldest first, until the memory
+      //    footprint target is realized
 
-      if (nCache > 1) {
-        //    Bubble Sort the local cache entry array
-        bool b_cont = true;
-        while (b_cont) {
-          b_cont = false;
-          for (unsigned int i = 0; i < nCache - 1; i++) {
-            if (pcea[i].RecentTime > pcea[i + 1].RecentTime) {
-              CacheEntry tmp = pcea[i];
-              pcea[i] = pcea[i + 1];
-              pcea[i + 1] = tmp;
-              b_cont = true;
-              break;
-            }
-          }
-        }
+      //    How many can be deleted?
+      unsigned int minimum_cache = 1;
+      if (cc->GetQuiltMode()) minimum_cache = cc->GetQuiltChartCount();
 
-        //    Free up some chart cache entries until the memory footprint target
-        //    is realized
+      while ((memsize > (g_MemFootMB * 1000)) &&
+             (ChartData->GetCacheCount() > minimum_cache)) {
+        int memsizeb = memsize;
 
-        unsigned int idelete = 0;  // starting at top. which is oldest
-        unsigned int idelete_max = pCache->GetCount();
-
-        //    How many can be deleted?
-        unsigned int minimum_cache = 1;
-        if (cc->GetQuiltMode()) minimum_cache = cc->GetQuiltChartCount();
-
-        while ((memsize > (g_MemFootMB * 1000)) &&
-               (pCache->GetCount() > minimum_cache) &&
-               (idelete < idelete_max)) {
-          int memsizeb = memsize;
-
-          ChartData->DeleteCacheChart((ChartBase *)pcea[idelete].pChart);
-          idelete++;
-          memsize = GetApplicationMemoryUse();
-          printf("delete, before: %d  after: %d\n", memsizeb, memsize);
-        }
+        if (!ChartData->DeleteOldestCacheChart()) break;
+        memsize = GetApplicationMemoryUse();
+        printf("delete, before: %d  after: %d\n", memsizeb, memsize);
       }
-
-      delete[] pcea;
     }
   }
 
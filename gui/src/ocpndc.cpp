@@ -1643,6 +1643,7 @@ void ocpnDC::DrawText(const wxString &text, wxCoord x, wxCoord y, float angle) {
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         m_texfont.RenderString(text, x, y, angle);
+        m_texfont.Flush();
 
         glDisable(GL_TEXTURE_2D);
         glDisable(GL_BLEND);
@@ -111,6 +111,7 @@
 
 #ifdef ocpnUSE_GL
 #include "glChartCanvas.h"
+#include "glTexCache.h"
 extern GLuint g_raster_format;
 #endif
 
@@ -9236,6 +9237,7 @@ void OpenGLOptionsDlg::OnButtonClear(wxCommandEvent& event) {
   if (g_bopengl && g_glTextureManager) {
     ::wxBeginBusyCursor();
     g_glTextureManager->ClearAllRasterTextures();
+    GetTexCacheStore()->Clear();
 
     wxString path = g_Platform->GetPrivateDataDir();
     appendOSDirSlash(&path);
@@ -9247,6 +9249,7 @@ void OpenGLOptionsDlg::OnButtonClear(wxCommandEvent& event) {
       for (unsigned int i = 0; i < files.GetCount(); i++)
         ::wxRemoveFile(files[i]);
     }
+    GetTexCacheStore()->Open(path.ToStdString());
 
     m_cacheSize->SetLabel(_("Size: ") + GetTextureCacheSize());
     ::wxEndBusyCursor();
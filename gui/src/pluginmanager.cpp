@@ -64,6 +64,7 @@
 #include <wx/hashset.h>
 #include <wx/hashmap.h>
 #include <wx/jsonval.h>
+#include <wx/jsonreader.h>
 #include <wx/uri.h>
 #include <wx/zipstrm.h>
 #include <wx/zstream.h>
@@ -84,6 +85,8 @@ typedef __LA_INT64_T la_int64_t;  //  "older" libarchive versions support
 #include <gelf.h>
 #endif
 
+#include "rapidjson/document.h"
+
 #include "config.h"
 
 #include "model/ais_target_data.h"
@@ -93,6 +96,7 @@ typedef __LA_INT64_T la_int64_t;  //  "older" libarchive versions support
 #include "model/comm_drv_n2k.h"
 #include "model/comm_drv_registry.h"
 #include "model/comm_navmsg_bus.h"
+#include "model/comm_util.h"
 #include "model/comm_vars.h"
 #include "model/config_vars.h"
 #include "model/downloader.h"
@@ -102,6 +106,7 @@ typedef __LA_INT64_T la_int64_t;  //  "older" libarchive versions support
 #include "model/multiplexer.h"
 #include "model/nav_object_database.h"
 #include "model/navutil_base.h"
+#include "model/nmea_subscriptions.h"
 #include "model/ocpn_utils.h"
 #include "model/plugin_cache.h"
 #include "model/plugin_handler.h"
@@ -1016,14 +1021,12 @@ void PlugInManager::HandleN0183(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
 void PlugInManager::HandleSignalK(std::shared_ptr<const SignalkMsg> sK_msg) {
   g_ownshipMMSI_SK = sK_msg->context_self;
 
-  wxJSONReader jsonReader;
+  // Reuse the document shared by all listeners of the message.
+  auto doc = sK_msg->GetDocument();
+  if (doc->HasParseError()) return;
   wxJSONValue root;
-
-  std::string msgTerminated = sK_msg->raw_message;
-  ;
-
-  int errors = jsonReader.Parse(msgTerminated, &root);
-  if (errors == 0) SendJSONMessageToAllPlugins(wxT("OCPN_CORE_SIGNALK"), root);
+  SignalkToJson(*doc, root);
+  SendJSONMessageToAllPlugins(wxT("OCPN_CORE_SIGNALK"), root);
 }
 
 /**
@@ -1141,6 +1144,7 @@ bool PlugInManager::CallLateInit(void) {
       case 116:
       case 117:
       case 118:
+      case 119:
         ProcessLateInit(pic);
         break;
     }
@@ -1207,7 +1211,8 @@ void PlugInManager::SendVectorChartObjectInfo(const wxString& chart,
           case 115:
           case 116:
           case 117:
-          case 118: {
+          case 118:
+          case 119: {
             opencpn_plugin_112* ppi =
                 dynamic_cast<opencpn_plugin_112*>(pic->m_pplugin);
             if (ppi)
@@ -1420,7 +1425,8 @@ bool PlugInManager::RenderAllCanvasOverlayPlugIns(ocpnDC& dc,
                 ppi116->RenderOverlayMultiCanvas(*pdc, &pivp, canvasIndex);
               break;
             }
-            case 118: {
+            case 118:
+            case 119: {
               if (priority <= 0) {
                 opencpn_plugin_18* ppi =
                     dynamic_cast<opencpn_plugin_18*>(pic->m_pplugin);
@@ -1498,7 +1504,8 @@ bool PlugInManager::RenderAllCanvasOverlayPlugIns(ocpnDC& dc,
                                                               g_canvasConfig);
               break;
             }
-            case 118: {
+            case 118:
+            case 119: {
               if (priority <= 0) {
                 opencpn_plugin_18* ppi =
                     dynamic_cast<opencpn_plugin_18*>(pic->m_pplugin);
@@ -1585,7 +1592,8 @@ bool PlugInManager::RenderAllGLCanvasOverlayPlugIns(wxGLContext* pcontext,
             }
             break;
           }
-          case 118: {
+          case 118:
+          case 119: {
             if (priority <= 0) {
               opencpn_plugin_18* ppi =
                   dynamic_cast<opencpn_plugin_18*>(pic->m_pplugin);
@@ -1625,7 +1633,8 @@ bool PlugInManager::SendMouseEventToPlugins(wxMouseEvent& event) {
           case 115:
           case 116:
           case 117:
-          case 118: {
+          case 118:
+          case 119: {
             opencpn_plugin_112* ppi =
                 dynamic_cast<opencpn_plugin_112*>(pic->m_pplugin);
             if (ppi)
@@ -1656,7 +1665,8 @@ bool PlugInManager::SendKeyEventToPlugins(wxKeyEvent& event) {
             case 115:
             case 116:
             case 117:
-            case 118: {
+            case 118:
+            case 119: {
               opencpn_plugin_113* ppi =
                   dynamic_cast<opencpn_plugin_113*>(pic->m_pplugin);
               if (ppi && ppi->KeyboardEventHook(event)) bret = true;
@@ -1788,10 +1798,85 @@ void PlugInManager::SetCanvasContextMenuItemGrey(int item, bool grey,
   }
 }
 
+//  NMEA0183 sentences waiting to be passed to plugins, and whether a call
+//  passing them is pending in the event loop
+static std::vector<wxString> s_nmea_queue;
+static bool s_nmea_posted = false;
+
+//  The batch being passed, and the part of it for each API 1.19 plugin.
+//  Static, so they are not lost in registers when a plugin faults.
+static std::vector<wxString> s_nmea_batch;
+static std::vector<wxArrayString> s_nmea_plugin_batches;
+static bool s_nmea_sending = false;
+static volatile int s_nmea_current = -1;
+
+//  Plugins getting NMEA0183 sentences, and the subscriptions by sentence id
+//  as indexes into it. Rebuilt when the plugins or their ids change.
+static std::vector<PlugInContainer*> s_nmea_plugins;
+static NmeaSubscriptions s_nmea_subscriptions;
+static bool s_nmea_ids_changed = true;
+
+void SetNMEASentenceIds(opencpn_plugin* pplugin, const wxArrayString& ids) {
+  auto plugin_array = PluginLoader::getInstance()->GetPlugInArray();
+  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
+    PlugInContainer* pic = plugin_array->Item(i);
+    if (pic->m_pplugin == pplugin) {
+      pic->m_nmea_ids.clear();
+      for (size_t j = 0; j < ids.GetCount(); j++)
+        pic->m_nmea_ids.push_back(ids[j].ToStdString());
+      s_nmea_ids_changed = true;
+      break;
+    }
+  }
+}
+
 void PlugInManager::SendNMEASentenceToAllPlugIns(const wxString& sentence) {
-  wxString decouple_sentence(
-      sentence);  // decouples 'const wxString &' and 'wxString &' to keep bin
-                  // compat for plugins
+  //  Sentences arriving in the same event loop pass are passed on together,
+  //  so that the fault handler is set up once for all of them.
+  s_nmea_queue.push_back(sentence);
+  PostNMEABatch();
+}
+
+void PlugInManager::PostNMEABatch() {
+  if (s_nmea_posted || s_nmea_queue.empty()) return;
+  s_nmea_posted = true;
+  wxTheApp->CallAfter([] { SendNMEABatchToAllPlugIns(); });
+}
+
+void PlugInManager::UpdateNMEASubscriptions() {
+  std::vector<PlugInContainer*> plugins;
+  auto plugin_array = PluginLoader::getInstance()->GetPlugInArray();
+  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
+    PlugInContainer* pic = plugin_array->Item(i);
+    if (pic->m_enabled && pic->m_init_state && pic->m_pplugin &&
+        (pic->m_cap_flag & WANTS_NMEA_SENTENCES) && !pic->m_nmea_faulted)
+      plugins.push_back(pic);
+  }
+  if (plugins == s_nmea_plugins && !s_nmea_ids_changed) return;
+
+  s_nmea_plugins = plugins;
+  s_nmea_ids_changed = false;
+  s_nmea_subscriptions.Clear();
+  for (size_t i = 0; i < s_nmea_plugins.size(); i++)
+    s_nmea_subscriptions.Add(i, s_nmea_plugins[i]->m_nmea_ids);
+}
+
+void PlugInManager::SendNMEABatchToAllPlugIns() {
+  s_nmea_posted = false;
+  //  A plugin is running the event loop while handling the last batch.
+  //  The queue is posted again when that batch is done, posting it from
+  //  here would make the nested loop call this again and again.
+  if (s_nmea_sending || s_nmea_queue.empty()) return;
+  s_nmea_batch.swap(s_nmea_queue);
+  s_nmea_queue.clear();
+  UpdateNMEASubscriptions();
+  if (s_nmea_plugins.empty()) {
+    s_nmea_batch.clear();
+    return;
+  }
+  s_nmea_sending = true;
+  s_nmea_plugin_batches.assign(s_nmea_plugins.size(), wxArrayString());
+
 #ifndef __WXMSW__
   // Set up a framework to catch (some) sigsegv faults from plugins.
   sigaction(SIGSEGV, NULL, &sa_all_PIM_previous);  // save existing
@@ -1806,35 +1891,55 @@ void PlugInManager::SendNMEASentenceToAllPlugIns(const wxString& sentence) {
                                         // unblocked during my handler
   temp.sa_flags = 0;
   sigaction(SIGSEGV, &temp, NULL);
+
+  if (sigsetjmp(env_PIM, 1)) {
+    //  A plugin faulted. Drop the rest of the batch, and do not send it
+    //  any more sentences.
+    sigaction(SIGSEGV, &sa_all_PIM_previous, NULL);  // reset signal handler
+    if (s_nmea_current >= 0) {
+      PlugInContainer* pic = s_nmea_plugins[s_nmea_current];
+      pic->m_nmea_faulted = true;
+      wxLogMessage("PlugInManager: PlugIn faulted on NMEA input, disabled: " +
+                   pic->m_plugin_file);
+    }
+    s_nmea_current = -1;
+    s_nmea_batch.clear();
+    s_nmea_plugin_batches.clear();
+    s_nmea_sending = false;
+    PostNMEABatch();
+    return;
+  }
 #endif
-  auto plugin_array = PluginLoader::getInstance()->GetPlugInArray();
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = plugin_array->Item(i);
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_NMEA_SENTENCES) {
-#ifndef __WXMSW__
-        if (sigsetjmp(env_PIM, 1)) {
-          //  Something in the "else" code block faulted.
-          // Probably safest to assume that all variables in this method are
-          // trash... So, simply clean up and return.
-          sigaction(SIGSEGV, &sa_all_PIM_previous, NULL);
-          // reset signal handler
-          return;
-        } else
-#endif
-        {
-          // volatile int *x = 0;
-          //*x = 0;
-          if (pic->m_pplugin)
-            pic->m_pplugin->SetNMEASentence(decouple_sentence);
-        }
+
+  for (wxString& sentence : s_nmea_batch) {
+    std::string id = NmeaSubscriptions::SentenceId(sentence.ToStdString());
+    for (int i : s_nmea_subscriptions.Get(id)) {
+      PlugInContainer* pic = s_nmea_plugins[i];
+      if (pic->m_api_version >= 119) {
+        s_nmea_plugin_batches[i].Add(sentence);
+      } else {
+        s_nmea_current = i;
+        pic->m_pplugin->SetNMEASentence(sentence);
       }
     }
   }
+  for (size_t i = 0; i < s_nmea_plugins.size(); i++) {
+    if (s_nmea_plugin_batches[i].IsEmpty()) continue;
+    auto ppi = dynamic_cast<opencpn_plugin_119*>(s_nmea_plugins[i]->m_pplugin);
+    if (ppi) {
+      s_nmea_current = i;
+      ppi->SetNMEASentences(s_nmea_plugin_batches[i]);
+    }
+  }
+  s_nmea_current = -1;
 
 #ifndef __WXMSW__
   sigaction(SIGSEGV, &sa_all_PIM_previous, NULL);  // reset signal handler
 #endif
+  s_nmea_batch.clear();
+  s_nmea_plugin_batches.clear();
+  s_nmea_sending = false;
+  PostNMEABatch();
 }
 
 int PlugInManager::GetJSONMessageTargetCount() {
@@ -1855,8 +1960,8 @@ void PlugInManager::SendJSONMessageToAllPlugins(const wxString& message_id,
   wxString out;
   w.Write(v, out);
   SendMessageToAllPlugins(message_id, out);
-  wxLogDebug(message_id);
-  wxLogDebug(out);
+  LOG_DEBUG_LIMITED(10, "%s %s", message_id.ToUTF8().data(),
+                    out.ToUTF8().data());
 }
 
 void PlugInManager::SendMessageToAllPlugins(const wxString& message_id,
@@ -1899,7 +2004,8 @@ void PlugInManager::SendMessageToAllPlugins(const wxString& message_id,
           case 115:
           case 116:
           case 117:
-          case 118: {
+          case 118:
+          case 119: {
             opencpn_plugin_18* ppi =
                 dynamic_cast<opencpn_plugin_18*>(pic->m_pplugin);
             if (ppi)
@@ -1975,7 +2081,8 @@ void PlugInManager::SendPositionFixToAllPlugIns(GenericPosDatEx* ppos) {
           case 115:
           case 116:
           case 117:
-          case 118: {
+          case 118:
+          case 119: {
             opencpn_plugin_18* ppi =
                 dynamic_cast<opencpn_plugin_18*>(pic->m_pplugin);
             if (ppi) ppi->SetPositionFixEx(pfix_ex);
@@ -2014,7 +2121,8 @@ void PlugInManager::SendActiveLegInfoToAllPlugIns(
           case 116:
             break;
           case 117:
-          case 118: {
+          case 118:
+          case 119: {
             opencpn_plugin_117* ppi =
                 dynamic_cast<opencpn_plugin_117*>(pic->m_pplugin);
             if (ppi) ppi->SetActiveLegInfo(leg);
@@ -2058,7 +2166,8 @@ void PlugInManager::PrepareAllPluginContextMenus() {
         switch (pic->m_api_version) {
           case 116:
           case 117:
-          case 118: {
+          case 118:
+          case 119: {
             opencpn_plugin_116* ppi =
                 dynamic_cast<opencpn_plugin_116*>(pic->m_pplugin);
             if (ppi) ppi->PrepareContextMenu(canvasIndex);
@@ -3274,8 +3383,8 @@ bool UpdateSingleWaypoint(PlugIn_Waypoint* pwaypoint) {
     SelectItem* pFind =
         pSelect->FindSelection(ctx, lat_save, lon_save, SELTYPE_ROUTEPOINT);
     if (pFind) {
-      pFind->m_slat = pwaypoint->m_lat;  // update the SelectList entry
-      pFind->m_slon = pwaypoint->m_lon;
+      pSelect->ModifySelectablePoint(pwaypoint->m_lat, pwaypoint->m_lon,
+                                     pFind);  // update the SelectList entry
     }
 
     if (!prp->m_btemp) pConfig->UpdateWayPoint(prp);
@@ -6525,6 +6634,8 @@ int PI_PLIBRenderObjectToGL(const wxGLContext& glcc, PI_S57Obj* pObj,
     ps52plib->PrepareForRender();
 
     ps52plib->RenderObjectToGL(glcc, &rzRules);
+    //  The plugin may change the GL state before the next object
+    ps52plib->FlushText();
 
     //  Update the PLIB context after the render operation
     UpdatePIObjectPlibContext(pObj, &cobj, &rzRules);
@@ -7751,8 +7862,8 @@ bool UpdateSingleWaypointEx(PlugIn_Waypoint_Ex* pwaypoint) {
     SelectItem* pFind =
         pSelect->FindSelection(ctx, lat_save, lon_save, SELTYPE_ROUTEPOINT);
     if (pFind) {
-      pFind->m_slat = pwaypoint->m_lat;  // update the SelectList entry
-      pFind->m_slon = pwaypoint->m_lon;
+      pSelect->ModifySelectablePoint(pwaypoint->m_lat, pwaypoint->m_lon,
+                                     pFind);  // update the SelectList entry
     }
 
     if (!prp->m_btemp) pConfig->UpdateWayPoint(prp);
@@ -36,6 +36,8 @@
 #include <wx/statline.h>
 
 #include <iostream>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
 
@@ -106,43 +108,61 @@ static int SortRouteTrack(const int order, const wxString &it1,
   return it1.CmpNoCase(it2);
 }
 
-// sort callback. Sort by route name.
-static int sort_route_name_dir;
-#if wxCHECK_VERSION(2, 9, 0)
-static int wxCALLBACK SortRoutesOnName(wxIntPtr item1, wxIntPtr item2,
-                                       wxIntPtr list)
-#else
-int wxCALLBACK SortRoutesOnName(long item1, long item2, long list)
-#endif
-{
-  return SortRouteTrack(sort_route_name_dir, ((Route *)item1)->GetName(),
-                        ((Route *)item2)->GetName());
+// Case folded name, the key the object lists are sorted and filtered on
+static std::string ListKey(const wxString &name) {
+  return std::string(name.Upper().utf8_str());
 }
 
-// sort callback. Sort by route Destination.
+// Sort order on a number, computed once per object.
+static ListIndex::Less LessOnValue(std::function<double(const void *)> value) {
+  auto cache = std::make_shared<std::unordered_map<const void *, double>>();
+  return [value, cache](const void *obj1, const void *obj2) {
+    auto get = [&](const void *obj) {
+      auto it = cache->find(obj);
+      if (it == cache->end()) it = cache->emplace(obj, value(obj)).first;
+      return it->second;
+    };
+    return get(obj1) < get(obj2);
+  };
+}
+
+// Sort by route name.
+static int sort_route_name_dir;
+
+// Sort by route Destination.
 static int sort_route_to_dir;
-#if wxCHECK_VERSION(2, 9, 0)
-static int wxCALLBACK SortRoutesOnTo(wxIntPtr item1, wxIntPtr item2,
-                                     wxIntPtr list)
-#else
-int wxCALLBACK SortRoutesOnTo(long item1, long item2, long list)
-#endif
-{
-  return SortRouteTrack(sort_route_to_dir, ((Route *)item1)->GetTo(),
-                        ((Route *)item2)->GetTo());
+
+static bool RouteToLess(const void *route1, const void *route2) {
+  return ((Route *)route1)->GetTo().CmpNoCase(((Route *)route2)->GetTo()) < 0;
 }
 
-// sort callback. Sort by track name.
+// Sort by track name.
 static int sort_track_name_dir;
-#if wxCHECK_VERSION(2, 9, 0)
-static int wxCALLBACK SortTracksOnName(wxIntPtr item1, wxIntPtr item2,
-                                       wxIntPtr list)
-#else
-int wxCALLBACK SortTracksOnName(long item1, long item2, long list)
-#endif
-{
-  return SortRouteTrack(sort_track_name_dir, ((Track *)item1)->GetName(),
-                        ((Track *)item2)->GetName());
+
+// Sort by track length.
+static int sort_track_len_dir;
+
+static ListIndex::Less TrackLengthLess() {
+  return LessOnValue(
+      [](const void *track) { return ((Track *)track)->Length(); });
+}
+
+static int sort_wp_key;
+static int sort_track_key;
+
+// Sort by wpt name.
+static int sort_wp_name_dir;
+
+// Sort by wpt distance.
+static int sort_wp_len_dir;
+
+static ListIndex::Less WaypointDistanceLess() {
+  return LessOnValue([](const void *wp) {
+    double dst;
+    const RoutePoint *rp = (const RoutePoint *)wp;
+    DistanceBearingMercator(rp->m_lat, rp->m_lon, gLat, gLon, NULL, &dst);
+    return dst;
+  });
 }
 
 static int SortDouble(const int order, const double &it1, const double &it2) {
@@ -162,63 +182,6 @@ static int SortDouble(const int order, const double &it1, const double &it2) {
   return -1;
 }
 
-// sort callback. Sort by track length.
-static int sort_track_len_dir;
-#if wxCHECK_VERSION(2, 9, 0)
-static int wxCALLBACK SortTracksOnDistance(wxIntPtr item1, wxIntPtr item2,
-                                           wxIntPtr list)
-#else
-int wxCALLBACK SortTracksOnDistance(long item1, long item2, long list)
-#endif
-{
-  return SortDouble(sort_track_len_dir, ((Track *)item1)->Length(),
-                    ((Track *)item2)->Length());
-}
-
-static int sort_wp_key;
-static int sort_track_key;
-
-// sort callback. Sort by wpt name.
-static int sort_wp_name_dir;
-#if wxCHECK_VERSION(2, 9, 0)
-static int wxCALLBACK SortWaypointsOnName(wxIntPtr item1, wxIntPtr item2,
-                                          wxIntPtr list)
-#else
-int wxCALLBACK SortWaypointsOnName(long item1, long item2, long list)
-#endif
-
-{
-  RoutePoint *pRP1 = (RoutePoint *)item1;
-  RoutePoint *pRP2 = (RoutePoint *)item2;
-
-  if (pRP1 && pRP2) {
-    if (sort_wp_name_dir & 1)
-      return pRP2->GetName().CmpNoCase(pRP1->GetName());
-    else
-      return pRP1->GetName().CmpNoCase(pRP2->GetName());
-  } else
-    return 0;
-}
-
-// sort callback. Sort by wpt distance.
-static int sort_wp_len_dir;
-#if wxCHECK_VERSION(2, 9, 0)
-static int wxCALLBACK SortWaypointsOnDistance(wxIntPtr item1, wxIntPtr item2,
-                                              wxIntPtr list)
-#else
-int wxCALLBACK SortWaypointsOnDistance(long item1, long item2, long list)
-#endif
-{
-  double dst1, dst2;
-  DistanceBearingMercator(((RoutePoint *)item1)->m_lat,
-                          ((RoutePoint *)item1)->m_lon, gLat, gLon, NULL,
-                          &dst1);
-  DistanceBearingMercator(((RoutePoint *)item2)->m_lat,
-                          ((RoutePoint *)item2)->m_lon, gLat, gLon, NULL,
-                          &dst2);
-  return SortDouble(sort_wp_len_dir, dst1, dst2);
-}
-
 // sort callback. Sort by layer name.
 static int sort_layer_name_dir;
 #if wxCHECK_VERSION(2, 9, 0)
@@ -245,6 +208,67 @@ int wxCALLBACK SortLayersOnSize(long item1, long item2, long list)
                     ((Layer *)item2)->m_NoOfItems);
 }
 
+NavObjectListCtrl::NavObjectListCtrl(wxWindow *parent, ColumnText text,
+                                     ItemImage image, IsBold bold)
+    : wxListCtrl(parent, -1, wxDefaultPosition, wxDefaultSize,
+                 wxLC_REPORT | wxLC_VIRTUAL | wxLC_HRULES |
+                     wxBORDER_SUNKEN /*|wxLC_VRULES*/),
+      m_text(text),
+      m_image(image),
+      m_bold(bold) {
+  wxFont font = *wxNORMAL_FONT;
+  font.SetWeight(wxFONTWEIGHT_BOLD);
+  m_bold_attr.SetFont(font);
+}
+
+void *NavObjectListCtrl::GetObject(long item) const {
+  return const_cast<void *>(m_index.Get(item));
+}
+
+long NavObjectListCtrl::FindObject(const void *obj) const {
+  return m_index.Find(obj);
+}
+
+std::vector<void *> NavObjectListCtrl::GetSelectedObjects() const {
+  std::vector<void *> selected;
+  long item = -1;
+  for (;;) {
+    item = GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
+    if (item == -1) break;
+    if (GetObject(item)) selected.push_back(GetObject(item));
+  }
+  return selected;
+}
+
+void NavObjectListCtrl::ShowRows(const std::vector<void *> &select) {
+  // Selection is kept by row, which may now hold another object
+  if (GetSelectedItemCount())
+    SetItemState(-1, 0, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
+  SetItemCount(m_index.GetCount());
+  for (void *obj : select) {
+    long item = m_index.Find(obj);
+    if (item != -1)
+      SetItemState(item, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED,
+                   wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
+  }
+  Refresh();
+}
+
+wxString NavObjectListCtrl::OnGetItemText(long item, long column) const {
+  void *obj = GetObject(item);
+  return obj ? m_text(obj, column) : wxString();
+}
+
+int NavObjectListCtrl::OnGetItemImage(long item) const {
+  void *obj = GetObject(item);
+  return obj ? m_image(obj) : -1;
+}
+
+wxListItemAttr *NavObjectListCtrl::OnGetItemAttr(long item) const {
+  void *obj = GetObject(item);
+  return obj && m_bold(obj) ? &m_bold_attr : NULL;
+}
+
 // event table. Mostly empty, because I find it much easier to see what is
 // connected to what using Connect() where possible, so that it is visible in
 // the code.
@@ -382,10 +406,23 @@ void RouteManagerDialog::Create() {
       wxCommandEventHandler(RouteManagerDialog::OnShowAllRteCBClicked), NULL,
       this);
 
-  m_pRouteListCtrl =
-      new wxListCtrl(m_pPanelRte, -1, wxDefaultPosition, wxSize(-1, -1),
-                     wxLC_REPORT | wxLC_SORT_ASCENDING | wxLC_HRULES |
-                         wxBORDER_SUNKEN /*|wxLC_VRULES*/);
+  m_pRouteListCtrl = new NavObjectListCtrl(
+      m_pPanelRte,
+      [](void *obj, long column) {
+        Route *route = (Route *)obj;
+        wxString text;
+        if (column == rmROUTENAME) {
+          text = route->m_RouteNameString;
+          if (text.IsEmpty()) text = _("(Unnamed Route)");
+        } else if (column == rmROUTEDESC) {
+          text = route->m_RouteStartString;
+          if (!route->m_RouteEndString.IsEmpty())
+            text.append(_(" - ") + route->m_RouteEndString);
+        }
+        return text;
+      },
+      [](void *obj) { return ((Route *)obj)->IsVisible() ? 0 : 1; },
+      [](void *obj) { return ((Route *)obj)->m_bRtIsActive; });
 #ifdef __ANDROID__
   m_pRouteListCtrl->GetHandle()->setStyleSheet(getAdjustedDialogStyleSheet());
 #endif
@@ -560,10 +597,19 @@ void RouteManagerDialog::Create() {
       wxCommandEventHandler(RouteManagerDialog::OnShowAllTrkCBClicked), NULL,
       this);
 
-  m_pTrkListCtrl =
-      new wxListCtrl(m_pPanelTrk, -1, wxDefaultPosition, wxDefaultSize,
-                     wxLC_REPORT | wxLC_SORT_ASCENDING | wxLC_HRULES |
-                         wxBORDER_SUNKEN /*|wxLC_VRULES*/);
+  m_pTrkListCtrl = new NavObjectListCtrl(
+      m_pPanelTrk,
+      [](void *obj, long column) {
+        Track *trk = (Track *)obj;
+        wxString text;
+        if (column == colTRKNAME)
+          text = trk->GetName(true);
+        else if (column == colTRKLENGTH)
+          text.Printf(wxT("%5.2f"), trk->Length());
+        return text;
+      },
+      [](void *obj) { return ((Track *)obj)->IsVisible() ? 0 : 1; },
+      [](void *obj) { return g_pActiveTrack == (Track *)obj; });
 
 #ifdef __ANDROID__
   m_pTrkListCtrl->GetHandle()->setStyleSheet(getAdjustedDialogStyleSheet());
@@ -703,10 +749,29 @@ void RouteManagerDialog::Create() {
       wxCommandEventHandler(RouteManagerDialog::OnShowAllWpCBClicked), NULL,
       this);
 
-  m_pWptListCtrl =
-      new wxListCtrl(m_pPanelWpt, -1, wxDefaultPosition, wxDefaultSize,
-                     wxLC_REPORT | wxLC_SORT_ASCENDING | wxLC_HRULES |
-                         wxBORDER_SUNKEN /*|wxLC_VRULES*/);
+  m_pWptListCtrl = new NavObjectListCtrl(
+      m_pPanelWpt,
+      [](void *obj, long column) {
+        RoutePoint *rp = (RoutePoint *)obj;
+        wxString text;
+        if (column == colWPTSCALE) {
+          text = wxString::Format(_T("%i"), (int)rp->GetScaMin());
+          if (!rp->GetUseSca()) text = _("Always");
+          if (g_bOverruleScaMin) text = _("Overruled");
+        } else if (column == colWPTNAME) {
+          text = rp->GetName();
+          if (text.IsEmpty()) text = _("(Unnamed Waypoint)");
+        } else if (column == colWPTDIST) {
+          double dst;
+          DistanceBearingMercator(rp->m_lat, rp->m_lon, gLat, gLon, NULL, &dst);
+          text.Printf(_T("%5.2f ") + getUsrDistanceUnit(), toUsrDistance(dst));
+        }
+        return text;
+      },
+      [](void *obj) {
+        return RoutePointGui(*(RoutePoint *)obj).GetIconImageIndex();
+      },
+      [](void *obj) { return false; });
 #ifdef __ANDROID__
   m_pWptListCtrl->GetHandle()->setStyleSheet(getAdjustedDialogStyleSheet());
 #endif
@@ -1141,15 +1206,14 @@ void RouteManagerDialog::OnShowAllRteCBClicked(wxCommandEvent &event) {
                                          wxLIST_STATE_DONTCARE);
     if (item == -1) break;
 
-    Route *pR = (Route *)m_pRouteListCtrl->GetItemData(item);
+    Route *pR = (Route *)m_pRouteListCtrl->GetObject(item);
 
     pR->SetVisible(viz, viz);
     pR->SetSharedWPViz(viz);
 
-    m_pRouteListCtrl->SetItemImage(item, !viz);  // visible
-
     pConfig->UpdateRoute(pR);
   }
+  m_pRouteListCtrl->Refresh();
 
   UpdateWptListCtrlViz();
 
@@ -1164,16 +1228,16 @@ void RouteManagerDialog::OnShowAllWpCBClicked(wxCommandEvent &event) {
                                        wxLIST_STATE_DONTCARE);
     if (item == -1) break;
 
-    RoutePoint *pRP = (RoutePoint *)m_pWptListCtrl->GetItemData(item);
+    RoutePoint *pRP = (RoutePoint *)m_pWptListCtrl->GetObject(item);
 
     if (!pRP->IsSharedInVisibleRoute()) {
       pRP->SetVisible(viz);
     } else
       pRP->SetVisible(true);
 
-    m_pWptListCtrl->SetItemImage(item, RoutePointGui(*pRP).GetIconImageIndex());
     pConfig->UpdateWayPoint(pRP);
   }
+  m_pWptListCtrl->Refresh();
 
   gFrame->RefreshAllCanvas();
 }
@@ -1186,11 +1250,11 @@ void RouteManagerDialog::OnShowAllTrkCBClicked(wxCommandEvent &event) {
                                        wxLIST_STATE_DONTCARE);
     if (item == -1) break;
 
-    Track *track = (Track *)m_pTrkListCtrl->GetItemData(item);
+    Track *track = (Track *)m_pTrkListCtrl->GetObject(item);
 
     track->SetVisible(viz);
-    m_pTrkListCtrl->SetItemImage(item, track->IsVisible() ? 0 : 1);
   }
+  m_pTrkListCtrl->Refresh();
 
   gFrame->RefreshAllCanvas();
 }
@@ -1215,84 +1279,31 @@ void RouteManagerDialog::OnShowAllLayCBClicked(wxCommandEvent &event) {
 }
 
 void RouteManagerDialog::UpdateRouteListCtrl() {
-  // if an item was selected, make it selected again if it still exist
-  long item = -1;
-  item = m_pRouteListCtrl->GetNextItem(item, wxLIST_NEXT_ALL,
-                                       wxLIST_STATE_SELECTED);
-  wxUIntPtr selected_id = wxUIntPtr(0);
-  if (item != -1) selected_id = m_pRouteListCtrl->GetItemData(item);
+  // if items were selected, make them selected again if they still exist
+  std::vector<void *> selected = m_pRouteListCtrl->GetSelectedObjects();
 
-  // Delete existing items
-  m_pRouteListCtrl->DeleteAllItems();
-
-  // then add routes to the listctrl
-  RouteList::iterator it;
-  int index = 0;
-  int list_index = 0;
+  // then sync the listed routes into the index
+  std::vector<ListIndex::Entry> routes;
   bool bpartialViz = false;
 
-  for (it = (*pRouteList).begin(); it != (*pRouteList).end(); ++it, ++index) {
-    if (!(*it)->IsListed()) continue;
-
-    if (!(*it)->GetName().Upper().Contains(m_tFilterRte->GetValue().Upper())) {
-      continue;
-    }
-
-    wxListItem li;
-    li.SetId(list_index);
-    li.SetImage((*it)->IsVisible() ? 0 : 1);
-    li.SetData(*it);
-    li.SetText(_T(""));
-    li.SetAlign(wxLIST_FORMAT_LEFT);
-
-    if ((*it)->m_bRtIsActive) {
-      wxFont font = *wxNORMAL_FONT;
-      font.SetWeight(wxFONTWEIGHT_BOLD);
-      li.SetFont(font);
-    }
+  for (Route *route : *pRouteList) {
+    if (!route->IsListed()) continue;
 
-    long idx = m_pRouteListCtrl->InsertItem(li);
-
-    wxString name = (*it)->m_RouteNameString;
-    if (name.IsEmpty()) name = _("(Unnamed Route)");
-    m_pRouteListCtrl->SetItem(idx, rmROUTENAME, name);
-
-    wxString startend = (*it)->m_RouteStartString;
-    if (!(*it)->m_RouteEndString.IsEmpty())
-      startend.append(_(" - ") + (*it)->m_RouteEndString);
-    m_pRouteListCtrl->SetItem(idx, rmROUTEDESC, startend);
-
-    wxListItem lic;
-    lic.SetId(list_index);
-    lic.SetColumn(1);
-    lic.SetAlign(wxLIST_FORMAT_LEFT);
-    m_pRouteListCtrl->SetItem(lic);
-
-    lic.SetColumn(2);
-    lic.SetAlign(wxLIST_FORMAT_LEFT);
-    m_pRouteListCtrl->SetItem(lic);
+    routes.emplace_back(route, ListKey(route->GetName()));
 
     // Keep track if any are invisible
-    if (!(*it)->IsVisible()) bpartialViz = true;
-
-    list_index++;
+    if (!route->IsVisible()) bpartialViz = true;
   }
 
-  m_pRouteListCtrl->SortItems(SortRoutesOnName, (wxIntPtr)NULL);
+  ListIndex &index = m_pRouteListCtrl->GetIndex();
+  index.Sync(routes);
+  index.SetFilter(ListKey(m_tFilterRte->GetValue()));
+  m_pRouteListCtrl->ShowRows(selected);
 
   m_pRouteListCtrl->SetColumnWidth(0, 4 * m_charWidth);
 
-  // restore selection if possible
-  // NOTE this will select a different item, if one is deleted
-  // (the next route will get that index).
-  if (selected_id != wxUIntPtr(0)) {
-    item = m_pRouteListCtrl->FindItem(-1, selected_id);
-    m_pRouteListCtrl->SetItemState(
-        item, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED,
-        wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
-  }
-
-  if ((m_lastRteItem >= 0) && (m_pRouteListCtrl->GetItemCount()))
+  if ((m_lastRteItem >= 0) &&
+      (m_lastRteItem < m_pRouteListCtrl->GetItemCount()))
     m_pRouteListCtrl->EnsureVisible(m_lastRteItem);
   UpdateRteButtons();
 
@@ -1322,7 +1333,7 @@ void RouteManagerDialog::UpdateRteButtons() {
   // set activate button text
   Route *route = NULL;
   if (enable1)
-    route = (Route *)m_pRouteListCtrl->GetItemData(selected_index_index);
+    route = (Route *)m_pRouteListCtrl->GetObject(selected_index_index);
 
   if (!g_pRouteMan->IsAnyRouteActive()) {
     btnRteActivate->Enable(enable1);
@@ -1342,15 +1353,13 @@ void RouteManagerDialog::UpdateRteButtons() {
 
 void RouteManagerDialog::MakeAllRoutesInvisible() {
   RouteList::iterator it;
-  long index = 0;
-  for (it = (*pRouteList).begin(); it != (*pRouteList).end(); ++it, ++index) {
+  for (it = (*pRouteList).begin(); it != (*pRouteList).end(); ++it) {
     if ((*it)->IsVisible()) {  // avoid config updating as much as possible!
       (*it)->SetVisible(false);
-      m_pRouteListCtrl->SetItemImage(m_pRouteListCtrl->FindItem(-1, index),
-                                     1);  // Likely not same order :0
-      pConfig->UpdateRoute(*it);          // auch, flushes config to disk. FIXME
+      pConfig->UpdateRoute(*it);  // auch, flushes config to disk. FIXME
     }
   }
+  m_pRouteListCtrl->Refresh();
 }
 
 void RouteManagerDialog::ZoomtoRoute(Route *route) {
@@ -1403,7 +1412,7 @@ void RouteManagerDialog::OnRteDeleteClick(wxCommandEvent &event) {
                                          wxLIST_STATE_SELECTED);
     if (item == -1) break;
 
-    Route *proute_to_delete = (Route *)m_pRouteListCtrl->GetItemData(item);
+    Route *proute_to_delete = (Route *)m_pRouteListCtrl->GetObject(item);
 
     if (proute_to_delete) list.Append(proute_to_delete);
   }
@@ -1465,7 +1474,7 @@ void RouteManagerDialog::OnRtePropertiesClick(wxCommandEvent &event) {
                                        wxLIST_STATE_SELECTED);
   if (item == -1) return;
 
-  Route *route = (Route *)m_pRouteListCtrl->GetItemData(item);
+  Route *route = (Route *)m_pRouteListCtrl->GetObject(item);
 
   if (!route) return;
 
@@ -1490,14 +1499,14 @@ void RouteManagerDialog::OnRteZoomtoClick(wxCommandEvent &event) {
   // optionally make this route exclusively visible
   if (m_bCtrlDown) MakeAllRoutesInvisible();
 
-  Route *route = (Route *)m_pRouteListCtrl->GetItemData(item);
+  Route *route = (Route *)m_pRouteListCtrl->GetObject(item);
 
   if (!route) return;
 
   // Ensure route is visible
   if (!route->IsVisible()) {
     route->SetVisible(true);
-    m_pRouteListCtrl->SetItemImage(item, route->IsVisible() ? 0 : 1);
+    m_pRouteListCtrl->RefreshItem(item);
     pConfig->UpdateRoute(route);
   }
 
@@ -1511,7 +1520,7 @@ void RouteManagerDialog::OnRteReverseClick(wxCommandEvent &event) {
                                        wxLIST_STATE_SELECTED);
   if (item == -1) return;
 
-  Route *route = (Route *)m_pRouteListCtrl->GetItemData(item);
+  Route *route = (Route *)m_pRouteListCtrl->GetObject(item);
 
   if (!route) return;
   if (route->m_bIsInLayer) return;
@@ -1529,7 +1538,7 @@ void RouteManagerDialog::OnRteReverseClick(wxCommandEvent &event) {
     wxString startend = route->m_RouteStartString;
     if (!route->m_RouteEndString.IsEmpty())
       startend.append(_(" - ") + route->m_RouteEndString);
-    m_pRouteListCtrl->SetItem(item, 2, startend);
+    m_pRouteListCtrl->RefreshItem(item);
 
     pConfig->UpdateRoute(route);
     gFrame->RefreshAllCanvas();
@@ -1549,7 +1558,7 @@ void RouteManagerDialog::OnRteExportClick(wxCommandEvent &event) {
                                          wxLIST_STATE_SELECTED);
     if (item == -1) break;
 
-    Route *proute_to_export = (Route *)m_pRouteListCtrl->GetItemData(item);
+    Route *proute_to_export = (Route *)m_pRouteListCtrl->GetObject(item);
 
     if (proute_to_export) {
       list.Append(proute_to_export);
@@ -1567,7 +1576,7 @@ void RouteManagerDialog::OnRteResequenceClick(wxCommandEvent &event) {
                                        wxLIST_STATE_SELECTED);
   if (item == -1) return;
 
-  Route *route = (Route *)m_pRouteListCtrl->GetItemData(item);
+  Route *route = (Route *)m_pRouteListCtrl->GetObject(item);
 
   if (!route) return;
   if (route->m_bIsInLayer) return;
@@ -1582,7 +1591,7 @@ void RouteManagerDialog::OnRteSendToPeerClick(wxCommandEvent &event) {
                                          wxLIST_STATE_SELECTED);
     if (item == -1) break;
 
-    Route *proute = (Route *)m_pRouteListCtrl->GetItemData(item);
+    Route *proute = (Route *)m_pRouteListCtrl->GetObject(item);
 
     if (proute) {
       list.push_back(proute);
@@ -1622,7 +1631,7 @@ void RouteManagerDialog::OnWptSendToPeerClick(wxCommandEvent &event) {
                                          wxLIST_STATE_SELECTED);
     if (item == -1) break;
 
-    RoutePoint *proutep = (RoutePoint *)m_pWptListCtrl->GetItemData(item);
+    RoutePoint *proutep = (RoutePoint *)m_pWptListCtrl->GetObject(item);
 
     if (proutep) {
       list.push_back(proutep);
@@ -1662,7 +1671,7 @@ void RouteManagerDialog::OnTrkSendToPeerClick(wxCommandEvent &event) {
                                          wxLIST_STATE_SELECTED);
     if (item == -1) break;
 
-    Track *ptrk = (Track *)m_pTrkListCtrl->GetItemData(item);
+    Track *ptrk = (Track *)m_pTrkListCtrl->GetObject(item);
 
     if (ptrk) {
       list.push_back(ptrk);
@@ -1703,14 +1712,14 @@ void RouteManagerDialog::OnRteActivateClick(wxCommandEvent &event) {
 
   if (m_bCtrlDown) MakeAllRoutesInvisible();
 
-  Route *route = (Route *)m_pRouteListCtrl->GetItemData(item);
+  Route *route = (Route *)m_pRouteListCtrl->GetObject(item);
 
   if (!route) return;
 
   if (!route->m_bRtIsActive) {
     if (!route->IsVisible()) {
       route->SetVisible(true);
-      m_pRouteListCtrl->SetItemImage(item, 0, 0);
+      m_pRouteListCtrl->RefreshItem(item);
     }
 
     ZoomtoRoute(route);
@@ -1743,11 +1752,11 @@ void RouteManagerDialog::OnRteToggleVisibility(wxMouseEvent &event) {
   if (clicked_index > -1 &&
       event.GetX() < m_pRouteListCtrl->GetColumnWidth(rmVISIBLE)) {
     // Process the clicked item
-    Route *route = (Route *)m_pRouteListCtrl->GetItemData(clicked_index);
+    Route *route = (Route *)m_pRouteListCtrl->GetObject(clicked_index);
 
     route->SetVisible(!route->IsVisible());
 
-    m_pRouteListCtrl->SetItemImage(clicked_index, route->IsVisible() ? 0 : 1);
+    m_pRouteListCtrl->RefreshItem(clicked_index);
 
     ::wxBeginBusyCursor();
 
@@ -1767,7 +1776,7 @@ void RouteManagerDialog::OnRteToggleVisibility(wxMouseEvent &event) {
                                            wxLIST_STATE_DONTCARE);
       if (item == -1) break;
 
-      Route *pR = (Route *)m_pRouteListCtrl->GetItemData(item);
+      Route *pR = (Route *)m_pRouteListCtrl->GetObject(item);
 
       if (!pR->IsVisible()) {
         viz = false;
@@ -1791,9 +1800,9 @@ void RouteManagerDialog::OnRteBtnLeftDown(wxMouseEvent &event) {
 void RouteManagerDialog::OnRteSelected(wxListEvent &event) {
   long clicked_index = event.m_itemIndex;
   // Process the clicked item
-  Route *route = (Route *)m_pRouteListCtrl->GetItemData(clicked_index);
+  Route *route = (Route *)m_pRouteListCtrl->GetObject(clicked_index);
   //    route->SetVisible(!route->IsVisible());
-  m_pRouteListCtrl->SetItemImage(clicked_index, route->IsVisible() ? 0 : 1);
+  m_pRouteListCtrl->RefreshItem(clicked_index);
   //    pConfig->UpdateRoute(route);
 
   gFrame->RefreshAllCanvas();
@@ -1802,14 +1811,17 @@ void RouteManagerDialog::OnRteSelected(wxListEvent &event) {
 }
 
 void RouteManagerDialog::OnRteColumnClicked(wxListEvent &event) {
+  std::vector<void *> selected = m_pRouteListCtrl->GetSelectedObjects();
   if (event.m_col == 1) {
     sort_route_name_dir++;
 
-    m_pRouteListCtrl->SortItems(SortRoutesOnName, (wxIntPtr)NULL);
+    m_pRouteListCtrl->GetIndex().SetSort(ListIndex::Less(),
+                                         sort_route_name_dir & 1);
   } else if (event.m_col == 2) {
     sort_route_to_dir++;
-    m_pRouteListCtrl->SortItems(SortRoutesOnTo, (wxIntPtr)NULL);
+    m_pRouteListCtrl->GetIndex().SetSort(RouteToLess, sort_route_to_dir & 1);
   }
+  m_pRouteListCtrl->ShowRows(selected);
 }
 
 void RouteManagerDialog::OnRteSendToGPSClick(wxCommandEvent &event) {
@@ -1818,7 +1830,7 @@ void RouteManagerDialog::OnRteSendToGPSClick(wxCommandEvent &event) {
                                        wxLIST_STATE_SELECTED);
   if (item == -1) return;
 
-  Route *route = (Route *)m_pRouteListCtrl->GetItemData(item);
+  Route *route = (Route *)m_pRouteListCtrl->GetObject(item);
 
   if (!route) return;
 
@@ -1879,7 +1891,7 @@ void RouteManagerDialog::OnTrkMenuSelected(wxCommandEvent &event) {
       item = m_pTrkListCtrl->GetNextItem(item, wxLIST_NEXT_ALL,
                                          wxLIST_STATE_SELECTED);
       if (item == -1) break;
-      Track *track = (Track *)m_pTrkListCtrl->GetItemData(item);
+      Track *track = (Track *)m_pTrkListCtrl->GetObject(item);
       if (track->IsRunning()) {
         wxBell();
         break;
@@ -1945,7 +1957,7 @@ void RouteManagerDialog::OnTrkMenuSelected(wxCommandEvent &event) {
         item = m_pTrkListCtrl->GetNextItem(item, wxLIST_NEXT_ALL,
                                            wxLIST_STATE_SELECTED);
         if (item == -1) break;
-        Track *track = (Track *)m_pTrkListCtrl->GetItemData(item);
+        Track *track = (Track *)m_pTrkListCtrl->GetObject(item);
         csvString << track->GetName() << _T("\t")
                   << wxString::Format(_T("%.1f"), track->Length()) << _T("\t")
                   << _T("\n");
@@ -1976,7 +1988,7 @@ void RouteManagerDialog::OnTrkMenuSelected(wxCommandEvent &event) {
         item = m_pTrkListCtrl->GetNextItem(item, wxLIST_NEXT_ALL,
                                            wxLIST_STATE_SELECTED);
         if (item == -1) break;
-        Track *track = (Track *)m_pTrkListCtrl->GetItemData(item);
+        Track *track = (Track *)m_pTrkListCtrl->GetObject(item);
         mergeList.push_back(track);
       }
 
@@ -2039,21 +2051,11 @@ void RouteManagerDialog::OnTrkMenuSelected(wxCommandEvent &event) {
 }
 
 void RouteManagerDialog::UpdateTrkListCtrl() {
-  // if an item was selected, make it selected again if it still exist
-  long item = -1;
-  item =
-      m_pTrkListCtrl->GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
+  // if items were selected, make them selected again if they still exist
+  std::vector<void *> selected = m_pTrkListCtrl->GetSelectedObjects();
 
-  wxUIntPtr selected_id = wxUIntPtr(0);
-  if (item != -1) selected_id = m_pTrkListCtrl->GetItemData(item);
-
-  // Delete existing items
-  m_pTrkListCtrl->DeleteAllItems();
-
-  // then add tracks to the listctrl
-  std::vector<Track*>::iterator it;
-  int index = 0;
-  int list_index = 0;
+  // then sync the listed tracks into the index
+  std::vector<ListIndex::Entry> tracks;
   bool bpartialViz = false;
 
   for (Track *trk : g_TrackList) {
@@ -2061,66 +2063,21 @@ void RouteManagerDialog::UpdateTrkListCtrl() {
 
     if (!trk->IsListed()) continue;
 
-    if (!trk->GetName(true).Upper().Contains(
-            m_tFilterTrk->GetValue().Upper())) {
-      continue;
-    }
-
-    wxListItem li;
-    li.SetId(list_index);
-    li.SetImage(trk->IsVisible() ? 0 : 1);
-    li.SetData(trk);
-    li.SetText(_T(""));
-
-    if (g_pActiveTrack == trk) {
-      wxFont font = *wxNORMAL_FONT;
-      font.SetWeight(wxFONTWEIGHT_BOLD);
-      li.SetFont(font);
-    }
-    long idx = m_pTrkListCtrl->InsertItem(li);
-
-    m_pTrkListCtrl->SetItem(idx, colTRKNAME, trk->GetName(true));
-
-    wxString len;
-    len.Printf(wxT("%5.2f"), trk->Length());
-    m_pTrkListCtrl->SetItem(idx, colTRKLENGTH, len);
-
-    wxListItem lic;
-    lic.SetId(list_index);
-    lic.SetColumn(1);
-    lic.SetAlign(wxLIST_FORMAT_LEFT);
-    m_pTrkListCtrl->SetItem(lic);
-
-    lic.SetColumn(2);
-    lic.SetAlign(wxLIST_FORMAT_LEFT);
-    m_pTrkListCtrl->SetItem(lic);
-
-    list_index++;
+    tracks.emplace_back(trk, ListKey(trk->GetName(true)));
   }
 
-  switch (sort_track_key) {
-    case SORT_ON_DISTANCE:
-      m_pTrkListCtrl->SortItems(SortTracksOnDistance, (wxIntPtr)NULL);
-      break;
-    case SORT_ON_NAME:
-    default:
-      m_pTrkListCtrl->SortItems(SortTracksOnName, (wxIntPtr)NULL);
-      break;
-  }
+  ListIndex &index = m_pTrkListCtrl->GetIndex();
+  index.Sync(tracks);
+  //  Lengths change as tracks are recorded
+  if (sort_track_key == SORT_ON_DISTANCE)
+    index.SetSort(TrackLengthLess(), sort_track_len_dir & 1);
+  index.SetFilter(ListKey(m_tFilterTrk->GetValue()));
+  m_pTrkListCtrl->ShowRows(selected);
 
   m_pTrkListCtrl->SetColumnWidth(0, 4 * m_charWidth);
 
-  // restore selection if possible
-  // NOTE this will select a different item, if one is deleted
-  // (the next route will get that index).
-  if (selected_id != wxUIntPtr(0)) {
-    item = m_pTrkListCtrl->FindItem(-1, selected_id);
-    m_pTrkListCtrl->SetItemState(item,
-                                 wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED,
-                                 wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
-  }
-
-  if ((m_lastTrkItem >= 0) && (m_pTrkListCtrl->GetItemCount()))
+  if ((m_lastTrkItem >= 0) &&
+      (m_lastTrkItem < m_pTrkListCtrl->GetItemCount()))
     m_pTrkListCtrl->EnsureVisible(m_lastTrkItem);
 
   m_cbShowAllTrk->SetValue(!bpartialViz);
@@ -2132,15 +2089,19 @@ void RouteManagerDialog::OnTrkSelected(wxListEvent &event) {
 }
 
 void RouteManagerDialog::OnTrkColumnClicked(wxListEvent &event) {
+  std::vector<void *> selected = m_pTrkListCtrl->GetSelectedObjects();
   if (event.m_col == 1) {
     sort_track_key = SORT_ON_NAME;
     sort_track_name_dir++;
-    m_pTrkListCtrl->SortItems(SortTracksOnName, (wxIntPtr)NULL);
+    m_pTrkListCtrl->GetIndex().SetSort(ListIndex::Less(),
+                                       sort_track_name_dir & 1);
   } else if (event.m_col == 2) {
     sort_track_key = SORT_ON_DISTANCE;
     sort_track_len_dir++;
-    m_pTrkListCtrl->SortItems(SortTracksOnDistance, (wxIntPtr)NULL);
+    m_pTrkListCtrl->GetIndex().SetSort(TrackLengthLess(),
+                                       sort_track_len_dir & 1);
   }
+  m_pTrkListCtrl->ShowRows(selected);
 }
 
 void RouteManagerDialog::UpdateTrkButtons() {
@@ -2168,10 +2129,10 @@ void RouteManagerDialog::OnTrkToggleVisibility(wxMouseEvent &event) {
   if (clicked_index > -1 &&
       event.GetX() < m_pTrkListCtrl->GetColumnWidth(colTRKVISIBLE)) {
     // Process the clicked item
-    Track *track = (Track *)m_pTrkListCtrl->GetItemData(clicked_index);
+    Track *track = (Track *)m_pTrkListCtrl->GetObject(clicked_index);
     if (track) {
       track->SetVisible(!track->IsVisible());
-      m_pTrkListCtrl->SetItemImage(clicked_index, track->IsVisible() ? 0 : 1);
+      m_pTrkListCtrl->RefreshItem(clicked_index);
     }
 
     // Manage "show all" checkbox
@@ -2182,7 +2143,7 @@ void RouteManagerDialog::OnTrkToggleVisibility(wxMouseEvent &event) {
                                          wxLIST_STATE_DONTCARE);
       if (item == -1) break;
 
-      Track *track = (Track *)m_pTrkListCtrl->GetItemData(item);
+      Track *track = (Track *)m_pTrkListCtrl->GetObject(item);
 
       if (!track->IsVisible()) {
         viz = false;
@@ -2216,7 +2177,7 @@ void RouteManagerDialog::OnTrkPropertiesClick(wxCommandEvent &event) {
       m_pTrkListCtrl->GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
   if (item == -1) return;
 
-  Track *track = (Track *)m_pTrkListCtrl->GetItemData(item);
+  Track *track = (Track *)m_pTrkListCtrl->GetObject(item);
 
   if (!track) return;
 
@@ -2250,7 +2211,7 @@ void RouteManagerDialog::OnTrkDeleteClick(wxCommandEvent &event) {
                                        wxLIST_STATE_SELECTED);
     if (item == -1) break;
 
-    Track *ptrack_to_delete = (Track *)m_pTrkListCtrl->GetItemData(item);
+    Track *ptrack_to_delete = (Track *)m_pTrkListCtrl->GetObject(item);
 
     if (ptrack_to_delete) list.push_back(ptrack_to_delete);
   }
@@ -2289,7 +2250,7 @@ void RouteManagerDialog::OnTrkExportClick(wxCommandEvent &event) {
                                        wxLIST_STATE_SELECTED);
     if (item == -1) break;
 
-    Track *ptrack_to_export = (Track *)m_pTrkListCtrl->GetItemData(item);
+    Track *ptrack_to_export = (Track *)m_pTrkListCtrl->GetObject(item);
 
     if (ptrack_to_export) {
       list.push_back(ptrack_to_export);
@@ -2330,7 +2291,7 @@ void RouteManagerDialog::OnTrkRouteFromTrackClick(wxCommandEvent &event) {
       m_pTrkListCtrl->GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
   if (item == -1) return;
 
-  Track *track = (Track *)m_pTrkListCtrl->GetItemData(item);
+  Track *track = (Track *)m_pTrkListCtrl->GetObject(item);
 
   TrackToRoute(track);
 
@@ -2364,108 +2325,47 @@ void RouteManagerDialog::OnTrkDeleteAllClick(wxCommandEvent &event) {
 
 void RouteManagerDialog::UpdateWptListCtrl(RoutePoint *rp_select,
                                            bool b_retain_sort) {
-  wxIntPtr selected_id = wxUIntPtr(0);
-  long item = -1;
+  std::vector<void *> selected;
 
   if (NULL == rp_select) {
-    // if an item was selected, make it selected again if it still exists
-    item = m_pWptListCtrl->GetNextItem(item, wxLIST_NEXT_ALL,
-                                       wxLIST_STATE_SELECTED);
-
-    if (item != -1) selected_id = m_pWptListCtrl->GetItemData(item);
-  }
+    // if items were selected, make them selected again if they still exist
+    selected = m_pWptListCtrl->GetSelectedObjects();
+  } else
+    selected.push_back(rp_select);
 
   //  Freshen the image list
   m_pWptListCtrl->SetImageList(
       pWayPointMan->Getpmarkicon_image_list(m_listIconSize),
       wxIMAGE_LIST_SMALL);
 
-  m_pWptListCtrl->DeleteAllItems();
+  std::vector<ListIndex::Entry> wpts;
+  bool b_anyHidden = false;
 
   wxRoutePointListNode *node = pWayPointMan->GetWaypointList()->GetFirst();
-
-  int index = 0;
-  bool b_anyHidden = false;
-  while (node) {
+  for (; node; node = node->GetNext()) {
     RoutePoint *rp = node->GetData();
-    if (rp && rp->IsListed()) {
-      if (rp->m_bIsInRoute && !rp->IsShared()) {
-        node = node->GetNext();
-        continue;
-      }
-
-      if (!rp->GetName().Upper().Contains(m_tFilterWpt->GetValue().Upper())) {
-        node = node->GetNext();
-        continue;
-      }
-
-      wxListItem li;
-      li.SetId(index);
-      li.SetImage(RoutePointGui(*rp).GetIconImageIndex());
-      li.SetData(rp);
-      li.SetText(_T(""));
-      long idx = m_pWptListCtrl->InsertItem(li);
-
-      wxString scamin = wxString::Format(_T("%i"), (int)rp->GetScaMin());
-      if (!rp->GetUseSca()) scamin = _("Always");
-      if (g_bOverruleScaMin) scamin = _("Overruled");
-      m_pWptListCtrl->SetItem(idx, colWPTSCALE, scamin);
-
-      wxString name = rp->GetName();
-      if (name.IsEmpty()) name = _("(Unnamed Waypoint)");
-      m_pWptListCtrl->SetItem(idx, colWPTNAME, name);
-
-      double dst;
-      DistanceBearingMercator(rp->m_lat, rp->m_lon, gLat, gLon, NULL, &dst);
-      wxString dist;
-      dist.Printf(_T("%5.2f ") + getUsrDistanceUnit(), toUsrDistance(dst));
-      m_pWptListCtrl->SetItem(idx, colWPTDIST, dist);
-
-      if (rp == rp_select) selected_id = (wxIntPtr)rp_select;
-
-      wxListItem lic;
-      lic.SetId(index);
-      lic.SetColumn(1);
-      lic.SetAlign(wxLIST_FORMAT_LEFT);
-      m_pWptListCtrl->SetItem(lic);
+    if (!rp || !rp->IsListed()) continue;
+    if (rp->m_bIsInRoute && !rp->IsShared()) continue;
 
-      lic.SetColumn(2);
-      lic.SetAlign(wxLIST_FORMAT_LEFT);
-      m_pWptListCtrl->SetItem(lic);
+    wpts.emplace_back(rp, ListKey(rp->GetName()));
 
-      if (!rp->IsVisible()) b_anyHidden = true;
-
-      index++;
-    }
-
-    node = node->GetNext();
+    if (!rp->IsVisible()) b_anyHidden = true;
   }
 
+  ListIndex &index = m_pWptListCtrl->GetIndex();
+  index.Sync(wpts);
   if (!b_retain_sort) {
-    m_pWptListCtrl->SortItems(SortWaypointsOnName,
-                              reinterpret_cast<wxIntPtr>(m_pWptListCtrl));
     sort_wp_key = SORT_ON_NAME;
-  } else {
-    switch (sort_wp_key) {
-      case SORT_ON_NAME:
-        m_pWptListCtrl->SortItems(SortWaypointsOnName,
-                                  reinterpret_cast<wxIntPtr>(m_pWptListCtrl));
-        break;
-      case SORT_ON_DISTANCE:
-        m_pWptListCtrl->SortItems(SortWaypointsOnDistance,
-                                  reinterpret_cast<wxIntPtr>(m_pWptListCtrl));
-        break;
-    }
-  }
-
-  if (selected_id != wxUIntPtr(0)) {
-    item = m_pWptListCtrl->FindItem(-1, selected_id);
-    m_pWptListCtrl->SetItemState(item,
-                                 wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED,
-                                 wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
+    index.SetSort(ListIndex::Less(), sort_wp_name_dir & 1);
+  } else if (sort_wp_key == SORT_ON_DISTANCE) {
+    //  Own ship has moved
+    index.SetSort(WaypointDistanceLess(), sort_wp_len_dir & 1);
   }
+  index.SetFilter(ListKey(m_tFilterWpt->GetValue()));
+  m_pWptListCtrl->ShowRows(selected);
 
-  if ((m_lastWptItem >= 0) && (m_pWptListCtrl->GetItemCount()))
+  if ((m_lastWptItem >= 0) &&
+      (m_lastWptItem < m_pWptListCtrl->GetItemCount()))
     m_pWptListCtrl->EnsureVisible(m_lastWptItem);
 
   if (pWayPointMan->Getpmarkicon_image_list(m_listIconSize)->GetImageCount()) {
@@ -2482,17 +2382,8 @@ void RouteManagerDialog::UpdateWptListCtrl(RoutePoint *rp_select,
 }
 
 void RouteManagerDialog::UpdateWptListCtrlViz() {
-  long item = -1;
-  for (;;) {
-    item = m_pWptListCtrl->GetNextItem(item, wxLIST_NEXT_ALL,
-                                       wxLIST_STATE_DONTCARE);
-    if (item == -1) break;
-
-    RoutePoint *pRP = (RoutePoint *)m_pWptListCtrl->GetItemData(item);
-    int imageIndex = RoutePointGui(*pRP).GetIconImageIndex();
-
-    m_pWptListCtrl->SetItemImage(item, imageIndex);
-  }
+  //  Icons are looked up as rows are drawn
+  m_pWptListCtrl->Refresh();
 }
 
 void RouteManagerDialog::OnWptDefaultAction(wxListEvent &event) {
@@ -2507,15 +2398,13 @@ void RouteManagerDialog::OnWptSelected(wxListEvent &event) {
 void RouteManagerDialog::OnWptColumnClicked(wxListEvent &event) {
   if (event.m_col == NAME_COLUMN) {
     sort_wp_name_dir++;
-    m_pWptListCtrl->SortItems(SortWaypointsOnName,
-                              reinterpret_cast<wxIntPtr>(m_pWptListCtrl));
+    m_pWptListCtrl->GetIndex().SetSort(ListIndex::Less(),
+                                       sort_wp_name_dir & 1);
     sort_wp_key = SORT_ON_NAME;
   } else {
     if (event.m_col == DISTANCE_COLUMN) {
       sort_wp_len_dir++;
-      m_pWptListCtrl->SortItems(SortWaypointsOnDistance,
-                                reinterpret_cast<wxIntPtr>(m_pWptListCtrl));
-      sort_wp_key = SORT_ON_DISTANCE;
+      sort_wp_key = SORT_ON_DISTANCE;  // sorted on update
     }
   }
   UpdateWptListCtrl();
@@ -2542,7 +2431,7 @@ void RouteManagerDialog::UpdateWptButtons() {
                                        wxLIST_STATE_SELECTED);
     if (item == -1) break;
 
-    RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetItemData(item);
+    RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetObject(item);
 
     if (wp && wp->m_bIsInLayer) {
       b_delete_enable = false;
@@ -2569,11 +2458,11 @@ void RouteManagerDialog::OnWptToggleVisibility(wxMouseEvent &event) {
   if (clicked_index > -1 &&
       event.GetX() < m_pWptListCtrl->GetColumnWidth(colTRKVISIBLE)) {
     // Process the clicked item
-    RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetItemData(clicked_index);
+    RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetObject(clicked_index);
 
     if (!wp->IsSharedInVisibleRoute()) {
       wp->SetVisible(!wp->IsVisible());
-      m_pWptListCtrl->SetItemImage(clicked_index, RoutePointGui(*wp).GetIconImageIndex());
+      m_pWptListCtrl->RefreshItem(clicked_index);
 
       pConfig->UpdateWayPoint(wp);
     }
@@ -2586,7 +2475,7 @@ void RouteManagerDialog::OnWptToggleVisibility(wxMouseEvent &event) {
                                          wxLIST_STATE_DONTCARE);
       if (item == -1) break;
 
-      RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetItemData(item);
+      RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetObject(item);
 
       if (!wp->IsVisible()) {
         viz = false;
@@ -2602,13 +2491,11 @@ void RouteManagerDialog::OnWptToggleVisibility(wxMouseEvent &event) {
         event.GetX() < (m_pWptListCtrl->GetColumnWidth(colTRKVISIBLE) +
                         m_pWptListCtrl->GetColumnWidth(colWPTSCALE)) &&
         !g_bOverruleScaMin) {
-      RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetItemData(clicked_index);
+      RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetObject(clicked_index);
       wp->SetUseSca(!wp->GetUseSca());
       pConfig->UpdateWayPoint(wp);
       gFrame->RefreshAllCanvas();
-      wxString scamin = wxString::Format(_T("%i"), (int)wp->GetScaMin());
-      if (!wp->GetUseSca()) scamin = _("Always");
-      m_pWptListCtrl->SetItem(clicked_index, colWPTSCALE, scamin);
+      m_pWptListCtrl->RefreshItem(clicked_index);
     }
 
   // Allow wx to process...
@@ -2637,7 +2524,7 @@ void RouteManagerDialog::OnWptPropertiesClick(wxCommandEvent &event) {
   item = m_pWptListCtrl->GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
   while (item != wxNOT_FOUND)
   {
-    auto wp = (RoutePoint *)m_pWptListCtrl->GetItemData(item);
+    auto wp = (RoutePoint *)m_pWptListCtrl->GetObject(item);
     if (wp) {
       wptlist.push_back(wp);
     }
@@ -2682,7 +2569,7 @@ void RouteManagerDialog::OnWptZoomtoClick(wxCommandEvent &event) {
       m_pWptListCtrl->GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
   if (item == -1) return;
 
-  RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetItemData(item);
+  RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetObject(item);
 
   if (!wp) return;
 
@@ -2713,7 +2600,7 @@ void RouteManagerDialog::OnWptDeleteClick(wxCommandEvent &event) {
     if (item == -1) break;
 
     item_last_selected = item;
-    RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetItemData(item);
+    RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetObject(item);
 
     if (wp && !wp->m_bIsInLayer) list.Append(wp);
   }
@@ -2738,7 +2625,7 @@ void RouteManagerDialog::OnWptDeleteClick(wxCommandEvent &event) {
         m_pWptListCtrl->GetNextItem(item_last_selected);  // next in list
     RoutePoint *wp_next = NULL;
     if (item_next > -1)
-      wp_next = (RoutePoint *)m_pWptListCtrl->GetItemData(item_next);
+      wp_next = (RoutePoint *)m_pWptListCtrl->GetObject(item_next);
 
     m_lastWptItem = item_next;
 
@@ -2762,7 +2649,7 @@ void RouteManagerDialog::OnWptGoToClick(wxCommandEvent &event) {
       m_pWptListCtrl->GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
   if (item == -1) return;
 
-  RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetItemData(item);
+  RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetObject(item);
 
   if (!wp) return;
 
@@ -2807,7 +2694,7 @@ void RouteManagerDialog::OnWptExportClick(wxCommandEvent &event) {
                                        wxLIST_STATE_SELECTED);
     if (item == -1) break;
 
-    RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetItemData(item);
+    RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetObject(item);
 
     if (wp && !wp->m_bIsInLayer) {
       list.Append(wp);
@@ -2824,7 +2711,7 @@ void RouteManagerDialog::OnWptSendToGPSClick(wxCommandEvent &event) {
       m_pWptListCtrl->GetNextItem(item, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
   if (item == -1) return;
 
-  RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetItemData(item);
+  RoutePoint *wp = (RoutePoint *)m_pWptListCtrl->GetObject(item);
 
   if (!wp) return;
 
@@ -3359,14 +3246,25 @@ void RouteManagerDialog::OnExportVizClick(wxCommandEvent &event) {
 
 void RouteManagerDialog::OnFilterChanged(wxCommandEvent &event) {
   if (event.GetEventObject() == m_tFilterWpt) {
-    UpdateWptListCtrl(NULL, true);
+    FilterList(m_pWptListCtrl, m_tFilterWpt);
+    UpdateWptButtons();
   } else if (event.GetEventObject() == m_tFilterRte) {
-    UpdateRouteListCtrl();
+    FilterList(m_pRouteListCtrl, m_tFilterRte);
+    UpdateRteButtons();
   } else if (event.GetEventObject() == m_tFilterTrk) {
-    UpdateTrkListCtrl();
+    FilterList(m_pTrkListCtrl, m_tFilterTrk);
+    UpdateTrkButtons();
   } else if (event.GetEventObject() == m_tFilterLay) {
     UpdateLayListCtrl();
   }
 }
 
+void RouteManagerDialog::FilterList(NavObjectListCtrl *list,
+                                    wxTextCtrl *filter) {
+  //  Names are in the index already
+  std::vector<void *> selected = list->GetSelectedObjects();
+  list->GetIndex().SetFilter(ListKey(filter->GetValue()));
+  list->ShowRows(selected);
+}
+
 // END Event handlers
@@ -162,10 +162,12 @@ bool s57RegistrarMgr::s57_feature_init(const wxString& csv_dir) {
 int s57RegistrarMgr::getAttributeID(const char* pAttrName) {
   wxString key(pAttrName);
 
-  if (m_attrHash1.find(key) == m_attrHash1.end())
+  //  Read only, as SENC records are encoded on several threads
+  auto it = m_attrHash1.find(key);
+  if (it == m_attrHash1.end())
     return -1;
   else
-    return m_attrHash1[key];
+    return it->second;
 }
 
 std::string s57RegistrarMgr::getAttributeAcronym(int nID) {
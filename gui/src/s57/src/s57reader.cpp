@@ -104,8 +104,10 @@ int S57Reader::Open(int bTestOpen)
     return TRUE;
   }
 
+  //  Records are read in place from a mapping of the file, the index
+  //  copies below share it until the module is closed.
   poModule = new DDFModule();
-  if (!poModule->Open(pszModuleName)) {
+  if (!poModule->Open(pszModuleName, FALSE, TRUE)) {
     // notdef: test bTestOpen.
     delete poModule;
     poModule = NULL;
@@ -350,19 +352,19 @@ int S57Reader::Ingest(CallBackFunction pcallback) {
 
       switch (nRCNM) {
         case RCNM_VI:
-          oVI_Index.AddRecord(nRCID, poRecord->Copy());
+          oVI_Index.AddRecord(nRCID, poRecord->Copy(TRUE));
           break;
 
         case RCNM_VC:
-          oVC_Index.AddRecord(nRCID, poRecord->Copy());
+          oVC_Index.AddRecord(nRCID, poRecord->Copy(TRUE));
           break;
 
         case RCNM_VE:
-          oVE_Index.AddRecord(nRCID, poRecord->Copy());
+          oVE_Index.AddRecord(nRCID, poRecord->Copy(TRUE));
           break;
 
         case RCNM_VF:
-          oVF_Index.AddRecord(nRCID, poRecord->Copy());
+          oVF_Index.AddRecord(nRCID, poRecord->Copy(TRUE));
           break;
 
         default:
@@ -378,7 +380,7 @@ int S57Reader::Ingest(CallBackFunction pcallback) {
       //              try ./opencpn &>test.dbg
 
       int nRCID = poRecord->GetIntSubfield("FRID", 0, "RCID", 0);
-      oFE_Index.AddRecord(nRCID, poRecord->Copy());
+      oFE_Index.AddRecord(nRCID, poRecord->Copy(TRUE));
 
     }
 
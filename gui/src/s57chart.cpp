@@ -84,6 +84,7 @@
 
 #include <algorithm>  // for std::sort
 #include <map>
+#include <unordered_set>
 
 #include "ssl/sha1.h"
 #ifdef ocpnUSE_GL
@@ -280,6 +281,7 @@ s57chart::s57chart() {
   m_this_chart_context = 0;
   m_Chart_Skew = 0;
   m_vbo_byte_length = 0;
+  m_object_bytes = 0;
   m_SENCthreadStatus = THREAD_INACTIVE;
   bReadyToRender = false;
   m_RAZBuilt = false;
@@ -1815,6 +1817,8 @@ bool s57chart::DoRenderOnGL(const wxGLContext &glc, const ViewPort &VPoint) {
   }
   // qDebug() << "Done Points" << sw.GetTime();
 
+  ps52plib->FlushText();
+
 #endif  //#ifdef ocpnUSE_GL
 
   return true;
@@ -1846,8 +1850,9 @@ bool s57chart::DoRenderOnGLText(const wxGLContext &glc,
     }
 #endif
 
-  //    Render the lines and points
-  for (i = 0; i < PRIO_NUM; ++i) {
+  //    Render the text, highest display priority first so that those
+  //    labels win the declutter test
+  for (i = PRIO_NUM - 1; i >= 0; --i) {
     if (ps52plib->m_nBoundaryStyle == SYMBOLIZED_BOUNDARIES)
       top = razRules[i][4];  // Area Symbolized Boundaries
     else
@@ -1881,6 +1886,8 @@ bool s57chart::DoRenderOnGLText(const wxGLContext &glc,
     }
   }
 
+  ps52plib->FlushText();
+
 #endif  //#ifdef ocpnUSE_GL
 
   return true;
@@ -2334,27 +2341,17 @@ int s57chart::DCRenderRect(wxMemoryDC &dcinput, const ViewPort &vp,
   } else
     r = g = b = 0;
 
-  if (pb_spec.depth == 24) {
-    for (int i = 0; i < pb_spec.height; i++) {
-      unsigned char *p = pb_spec.pix_buff + (i * pb_spec.pb_pitch);
-      for (int j = 0; j < pb_spec.width; j++) {
-        *p++ = r;
-        *p++ = g;
-        *p++ = b;
-      }
-    }
-  } else {
-    int color_int = ((r) << 16) + ((g) << 8) + (b);
-
-    for (int i = 0; i < pb_spec.height; i++) {
-      int *p = (int *)(pb_spec.pix_buff + (i * pb_spec.pb_pitch));
-      for (int j = 0; j < pb_spec.width; j++) {
-        *p++ = color_int;
-      }
-    }
+  for (int i = 0; i < pb_spec.height; i++) {
+    unsigned char *p = pb_spec.pix_buff + (i * pb_spec.pb_pitch);
+    if (pb_spec.depth == 24)
+      TriRaster::FillSpan(p, pb_spec.width, 24, r, g, b);
+    else
+      TriRaster::FillSpan(p, pb_spec.width, 32, b, g, r);
   }
 
-  //      Render the areas quickly
+  //      Render the areas quickly. The objects are prepared here, their
+  //      triangles are rasterized in parallel bands by FlushAreaBatch()
+  ps52plib->BeginAreaBatch();
   for (i = 0; i < PRIO_NUM; ++i) {
     if (ps52plib->m_nBoundaryStyle == SYMBOLIZED_BOUNDARIES)
       top = razRules[i][4];  // Area Symbolized Boundaries
@@ -2368,6 +2365,7 @@ int s57chart::DCRenderRect(wxMemoryDC &dcinput, const ViewPort &vp,
       ps52plib->RenderAreaToDC(&dcinput, crnt, &pb_spec);
     }
   }
+  ps52plib->FlushAreaBatch(&pb_spec);
 
 //      Convert the Private render canvas into a bitmap
 #ifdef ocpnUSE_ocpnBitmap
@@ -2472,7 +2470,8 @@ bool s57chart::DCRenderText(wxMemoryDC &dcinput, const ViewPort &vp) {
   ObjRazRules *crnt;
   ViewPort tvp = vp;  // undo const  TODO fix this in PLIB
 
-  for (i = 0; i < PRIO_NUM; ++i) {
+  //    Highest display priority first, see DoRenderOnGLText()
+  for (i = PRIO_NUM - 1; i >= 0; --i) {
     if (ps52plib->m_nBoundaryStyle == SYMBOLIZED_BOUNDARIES)
       top = razRules[i][4];  // Area Symbolized Boundaries
     else
@@ -3008,6 +3007,53 @@ void s57chart::InvalidateCache() {
   pDIB = NULL;
 }
 
+static size_t S57ObjBytes(const S57Obj *obj) {
+  size_t bytes = sizeof(S57Obj);
+  if (obj->att_array) bytes += obj->n_attr * 6;
+  if (obj->attVal) bytes += obj->attVal->GetCount() * sizeof(S57attVal);
+  if (obj->geoPt) bytes += obj->npt * sizeof(pt);
+  if (obj->geoPtz) bytes += obj->npt * 3 * sizeof(double);
+  if (obj->geoPtMulti) bytes += obj->npt * 2 * sizeof(double);
+  if (obj->m_lsindex_array) bytes += obj->m_n_lsindex * 3 * sizeof(int);
+  for (line_segment_element *ls = obj->m_ls_list; ls; ls = ls->next)
+    bytes += sizeof(line_segment_element);
+  if (obj->pPolyTessGeo) {
+    PolyTriGroup *ppg = obj->pPolyTessGeo->Get_PolyTriGroup_head();
+    if (ppg && ppg->bsingle_alloc) bytes += ppg->single_buffer_size;
+  }
+  return bytes;
+}
+
+size_t s57chart::GetResidentBytes() {
+  if (!bReadyToRender) return 0;
+
+  //  The object tables do not change once the chart is built, walk them once
+  if (!m_object_bytes) {
+    std::unordered_set<const S57Obj *> seen;
+    size_t bytes = 0;
+    for (int i = 0; i < PRIO_NUM; ++i) {
+      for (int j = 0; j < LUPNAME_NUM; j++) {
+        for (ObjRazRules *top = razRules[i][j]; top; top = top->next) {
+          bytes += sizeof(ObjRazRules);
+          if (seen.insert(top->obj).second) bytes += S57ObjBytes(top->obj);
+          for (ObjRazRules *ctop = top->child; ctop; ctop = ctop->next)
+            bytes += sizeof(ObjRazRules) + S57ObjBytes(ctop->obj);
+        }
+      }
+    }
+    bytes += m_ve_hash.size() * (sizeof(VE_Element) + 2 * sizeof(void *));
+    bytes += m_vc_hash.size() * (sizeof(VC_Element) + 2 * sizeof(void *));
+    bytes += m_pcs_vector.size() *
+             (sizeof(connector_segment) + sizeof(connector_segment *));
+    m_object_bytes = bytes;
+  }
+
+  size_t bytes = m_object_bytes;
+  if (m_line_vertex_buffer) bytes += m_vbo_byte_length;
+  if (pDIB) bytes += (size_t)pDIB->GetLinePitch() * pDIB->GetHeight();
+  return bytes;
+}
+
 bool s57chart::BuildThumbnail(const wxString &bmpname) {
   bool ret_code;
 
@@ -277,14 +277,22 @@ void ShapeBaseChart::DoDrawPolygonFilled(ocpnDC &pnt, ViewPort &vp,
   double old_x = -9999999.0, old_y = -9999999.0;
   auto polygon = static_cast<shp::Polygon *>(feature.getGeometry());
   pnt.SetBrush(_color);
+  std::vector<double> lats, lons;
+  std::vector<wxPoint2DDouble> pix;
   for (auto &ring : polygon->getRings()) {
     wxPoint *poly_pt = new wxPoint[ring.getPoints().size()];
     size_t cnt{0};
-    auto bbox = vp.GetBBox();
+    lats.clear();
+    lons.clear();
     for (auto &point : ring.getPoints()) {
-      // if (bbox.ContainsMarge(point.getY(), point.getX(), 0.05)) {
-      wxPoint2DDouble q =
-          ShapeBaseChartSet::GetDoublePixFromLL(vp, point.getY(), point.getX());
+      lats.push_back(point.getY());
+      lons.push_back(point.getX());
+    }
+    pix.resize(lats.size());
+    if (!pix.empty())
+      vp.GetDoublePixFromLL(pix.size(), &lats[0], &lons[0], &pix[0]);
+    for (auto &q : pix) {
+      q.m_x -= vp.rv_rect.x, q.m_y -= vp.rv_rect.y;
       if (round(q.m_x) != round(old_x) || round(q.m_y) != round(old_y)) {
         poly_pt[cnt].x = round(q.m_x);
         poly_pt[cnt].y = round(q.m_y);
@@ -292,7 +300,6 @@ void ShapeBaseChart::DoDrawPolygonFilled(ocpnDC &pnt, ViewPort &vp,
       }
       old_x = q.m_x;
       old_y = q.m_y;
-      //}
     }
     if (cnt > 1) {
       pnt.DrawPolygonTessellated(cnt, poly_pt, 0, 0);
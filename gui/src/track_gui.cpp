@@ -1,4 +1,5 @@
 #include <list>
+#include <vector>
 
 #include <wx/colour.h>
 #include <wx/gdicmn.h>
@@ -222,15 +223,37 @@ void TrackGui::Segments(ChartCanvas *cc,
   if (!m_track.SubTracks.size()) return;
 
   int level = m_track.SubTracks.size() - 1, last = -2;
-  Assemble(cc, pointlists, box, 1 / scale / scale, last, level, 0);
+  std::vector<int> points;
+  Assemble(points, box, 1 / scale / scale, last, level, 0);
+
+  //  Project all the chosen points at once
+  std::vector<double> lats, lons;
+  for (int n : points) {
+    if (n < 0 || (size_t)n >= m_track.TrackPoints.size()) continue;
+    lats.push_back(m_track.TrackPoints[n]->m_lat);
+    lons.push_back(m_track.TrackPoints[n]->m_lon);
+  }
+  std::vector<wxPoint> pix(lats.size());
+  if (!pix.empty())
+    cc->GetCanvasPointPix(pix.size(), &lats[0], &lons[0], &pix[0]);
+
+  size_t i = 0;
+  for (int n : points) {
+    if (n < 0) {
+      std::list<wxPoint> new_list;
+      pointlists.push_back(new_list);
+    } else if ((size_t)n < m_track.TrackPoints.size()) {
+      AddPointToList(pointlists, pix[i++]);
+    } else {
+      AddPointToList(pointlists, wxPoint(INVALID_COORD, INVALID_COORD));
+    }
+  }
 }
 
-/* assembles lists of line strips from the given track recursively traversing
-   the subtracks data */
-void TrackGui::Assemble(ChartCanvas *cc,
-                        std::list<std::list<wxPoint> > &pointlists,
-                        const LLBBox &box, double scale, int &last, int level,
-                        int pos) {
+/* assembles the indices of the points of the line strips from the given track
+   recursively traversing the subtracks data, -1 starts a new strip */
+void TrackGui::Assemble(std::vector<int> &points, const LLBBox &box,
+                        double scale, int &last, int level, int pos) {
   if (pos == (int)m_track.SubTracks[level].size()) return;
 
   SubTrack &s = m_track.SubTracks[level][pos];
@@ -239,17 +262,14 @@ void TrackGui::Assemble(ChartCanvas *cc,
   if (s.m_scale < scale) {
     pos <<= level;
 
-    if (last < pos - 1) {
-      std::list<wxPoint> new_list;
-      pointlists.push_back(new_list);
-    }
+    if (last < pos - 1) points.push_back(-1);
 
-    if (last < pos) AddPointToList(cc, pointlists, pos);
+    if (last < pos) points.push_back(pos);
     last = wxMin(pos + (1 << level), m_track.TrackPoints.size() - 1);
-    AddPointToList(cc, pointlists, last);
+    points.push_back(last);
   } else {
-    Assemble(cc, pointlists, box, scale, last, level - 1, pos << 1);
-    Assemble(cc, pointlists, box, scale, last, level - 1, (pos << 1) + 1);
+    Assemble(points, box, scale, last, level - 1, pos << 1);
+    Assemble(points, box, scale, last, level - 1, (pos << 1) + 1);
   }
 }
 
@@ -258,7 +278,11 @@ void TrackGui::AddPointToList(ChartCanvas *cc,
   wxPoint r(INVALID_COORD, INVALID_COORD);
   if ((size_t)n < m_track.TrackPoints.size())
     cc->GetCanvasPointPix(m_track.TrackPoints[n]->m_lat, m_track.TrackPoints[n]->m_lon, &r);
+  AddPointToList(pointlists, r);
+}
 
+void TrackGui::AddPointToList(std::list<std::list<wxPoint> > &pointlists,
+                              const wxPoint &r) {
   std::list<wxPoint> &pointlist = pointlists.back();
   if (r.x == INVALID_COORD) {
     if (pointlist.size()) {
@@ -107,8 +107,8 @@ void doUndoMoveWaypoint(UndoAction* action, ChartCanvas* cc) {
   lastPoint->y = lat;
   lastPoint->x = lon;
   SelectItem* selectable = (SelectItem*)action->selectable[0];
-  selectable->m_slat = currentPoint->m_lat;
-  selectable->m_slon = currentPoint->m_lon;
+  pSelect->ModifySelectablePoint(currentPoint->m_lat, currentPoint->m_lon,
+                                 selectable);
 
   if ((NULL != g_pMarkInfoDialog) && (g_pMarkInfoDialog->IsShown())) {
     if (currentPoint == g_pMarkInfoDialog->GetRoutePoint())
@@ -169,24 +169,7 @@ wxPoint2DDouble ViewPort::GetDoublePixFromLL(double lat, double lon) {
       xlon += 360.;
   }
 
-  // update cache of trig functions used for projections
-  if (clat != lat0_cache) {
-    lat0_cache = clat;
-    switch (m_projection_type) {
-      case PROJECTION_MERCATOR:
-      case PROJECTION_WEB_MERCATOR:
-        cache0 = toSMcache_y30(clat);
-        break;
-      case PROJECTION_POLAR:
-        cache0 = toPOLARcache_e(clat);
-        break;
-      case PROJECTION_ORTHOGRAPHIC:
-      case PROJECTION_STEREOGRAPHIC:
-      case PROJECTION_GNOMONIC:
-        cache_phi0(clat, &cache0, &cache1);
-        break;
-    }
-  }
+  UpdateProjectionCache();
 
   switch (m_projection_type) {
     case PROJECTION_MERCATOR:
@@ -264,6 +247,119 @@ wxPoint2DDouble ViewPort::GetDoublePixFromLL(double lat, double lon) {
   return wxPoint2DDouble((pix_width / 2.0) + dxr, (pix_height / 2.0) - dyr);
 }
 
+void ViewPort::UpdateProjectionCache() {
+  // update cache of trig functions used for projections
+  if (clat != lat0_cache) {
+    lat0_cache = clat;
+    switch (m_projection_type) {
+      case PROJECTION_MERCATOR:
+      case PROJECTION_WEB_MERCATOR:
+        cache0 = toSMcache_y30(clat);
+        break;
+      case PROJECTION_POLAR:
+        cache0 = toPOLARcache_e(clat);
+        break;
+      case PROJECTION_ORTHOGRAPHIC:
+      case PROJECTION_STEREOGRAPHIC:
+      case PROJECTION_GNOMONIC:
+        cache_phi0(clat, &cache0, &cache1);
+        break;
+    }
+  }
+}
+
+void ViewPort::GetDoublePixFromLL(int n, const double *lat, const double *lon,
+                                  wxPoint2DDouble *pix) {
+  if (n <= 0) return;
+
+  std::vector<double> xlon(n), easting(n), northing(n);
+
+  /*  Make sure lon and clon are same phase */
+  for (int i = 0; i < n; i++) {
+    double x = lon[i];
+    if (x * clon < 0.) {
+      if (x < 0.)
+        x += 360.;
+      else
+        x -= 360.;
+    }
+    if (fabs(x - clon) > 180.) {
+      if (x > clon)
+        x -= 360.;
+      else
+        x += 360.;
+    }
+    xlon[i] = x;
+  }
+
+  UpdateProjectionCache();
+
+  switch (m_projection_type) {
+    case PROJECTION_MERCATOR:
+    case PROJECTION_WEB_MERCATOR:
+      toSMcache_batch(n, lat, &xlon[0], cache0, clon, &easting[0],
+                      &northing[0]);
+      break;
+
+    case PROJECTION_TRANSVERSE_MERCATOR: {
+      double tmceasting, tmcnorthing;
+      toTM(clat, clon, 0., clon, &tmceasting, &tmcnorthing);
+      toTM_batch(n, lat, &xlon[0], 0., clon, &easting[0], &northing[0]);
+      for (int i = 0; i < n; i++) {
+        northing[i] -= tmcnorthing;
+        easting[i] -= tmceasting;
+      }
+      break;
+    }
+
+    case PROJECTION_POLYCONIC: {
+      double pceasting, pcnorthing;
+      toPOLY(clat, clon, 0., clon, &pceasting, &pcnorthing);
+      toPOLY_batch(n, lat, &xlon[0], 0., clon, &easting[0], &northing[0]);
+      for (int i = 0; i < n; i++) northing[i] -= pcnorthing;
+      break;
+    }
+
+    case PROJECTION_ORTHOGRAPHIC:
+      toORTHO_batch(n, lat, &xlon[0], cache0, cache1, clon, &easting[0],
+                    &northing[0]);
+      break;
+
+    case PROJECTION_STEREOGRAPHIC:
+      toSTEREO_batch(n, lat, &xlon[0], cache0, cache1, clon, &easting[0],
+                     &northing[0]);
+      break;
+
+    default:
+      // No batch version of the remaining projections
+      for (int i = 0; i < n; i++) pix[i] = GetDoublePixFromLL(lat[i], lon[i]);
+      return;
+  }
+
+  const double cx = pix_width / 2.0, cy = pix_height / 2.0;
+  const double cosa = cos(rotation), sina = sin(rotation);
+
+  for (int i = 0; i < n; i++) {
+    if (!wxFinite(easting[i]) || !wxFinite(northing[i])) {
+      pix[i] = wxPoint2DDouble(easting[i], northing[i]);
+      continue;
+    }
+
+    double epix = easting[i] * view_scale_ppm;
+    double npix = northing[i] * view_scale_ppm;
+    double dxr = epix;
+    double dyr = npix;
+
+    //    Apply VP Rotation
+    if (rotation) {
+      dxr = epix * cosa + npix * sina;
+      dyr = npix * cosa - epix * sina;
+    }
+
+    pix[i] = wxPoint2DDouble(cx + dxr, cy - dyr);
+  }
+}
+
 void ViewPort::GetLLFromPix(const wxPoint2DDouble &p, double *lat,
                             double *lon) {
   double dx = p.m_x - (pix_width / 2.0);
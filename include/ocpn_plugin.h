@@ -68,7 +68,7 @@ class wxGLContext;
 //    PlugIns conforming to API Version less then the most modern will also
 //    be correctly supported.
 #define API_VERSION_MAJOR 1
-#define API_VERSION_MINOR 18
+#define API_VERSION_MINOR 19
 
 //    Fwd Definitions
 class wxFileConfig;
@@ -636,6 +636,19 @@ public:
 #endif
 
 };
+
+class DECL_EXP opencpn_plugin_119 : public opencpn_plugin_118 {
+public:
+  opencpn_plugin_119(void *pmgr);
+
+  /// Receive the NMEA0183 sentences which arrived since the last call, in
+  /// arrival order, if WANTS_NMEA_SENTENCES is returned by Init(). Replaces
+  /// SetNMEASentence() for plugins of this API version. The default
+  /// implementation calls SetNMEASentence() for each sentence.
+  ///
+  /// \param sentences The sentences, filtered by SetNMEASentenceIds()
+  virtual void SetNMEASentences(wxArrayString &sentences);
+};
 //------------------------------------------------------------------
 //      Route and Waypoint PlugIn support
 //
@@ -884,6 +897,17 @@ extern DECL_EXP wxString GetOCPN_ExePath(void);
 extern "C" DECL_EXP wxString *GetpPlugInLocation();
 extern DECL_EXP wxString GetPlugInPath(opencpn_plugin *pplugin);
 
+/**
+ * Declare the NMEA0183 sentences parsed by a plugin returning
+ * WANTS_NMEA_SENTENCES, so that only these are passed to it. Ids are the
+ * sentence formatter like "RMC" or "GGA" for all talkers, also "VDO" for
+ * !AIVDO, or the whole address of proprietary sentences like "PGRMZ".
+ * An empty array passes all sentences, which is the default. Usually
+ * called from Init().
+ */
+extern DECL_EXP void SetNMEASentenceIds(opencpn_plugin *pplugin,
+                                        const wxArrayString &ids);
+
 extern "C" DECL_EXP int AddChartToDBInPlace(wxString &full_path,
                                             bool b_RefreshCanvas);
 extern "C" DECL_EXP int RemoveChartFromDBInPlace(wxString &full_path);
@@ -1716,6 +1740,38 @@ extern DECL_EXP std::shared_ptr<ObservableListener> GetListener(
 extern DECL_EXP std::vector<uint8_t> GetN2000Payload(NMEA2000Id id,
                                                      ObservedEvt ev);
 
+/**
+ * Read-only view of the payload of a received n2000 message, in the same
+ * format as GetN2000Payload(). The view shares ownership of the message,
+ * so it stays valid after the event is handled and nothing is copied.
+ */
+class N2000PayloadView {
+public:
+  N2000PayloadView() {}
+  N2000PayloadView(std::shared_ptr<const std::vector<uint8_t>> payload)
+      : m_payload(payload) {}
+
+  const uint8_t *data() const { return m_payload ? m_payload->data() : 0; }
+  size_t size() const { return m_payload ? m_payload->size() : 0; }
+  bool empty() const { return size() == 0; }
+  const uint8_t *begin() const { return data(); }
+  const uint8_t *end() const { return data() + size(); }
+  uint8_t operator[](size_t i) const { return data()[i]; }
+
+  /** The shared payload, for parsers taking a vector. Never null. */
+  const std::vector<uint8_t> &vector() const {
+    static const std::vector<uint8_t> kEmpty;
+    return m_payload ? *m_payload : kEmpty;
+  }
+
+private:
+  std::shared_ptr<const std::vector<uint8_t>> m_payload;
+};
+
+/** Like GetN2000Payload(), without copying the payload. */
+extern DECL_EXP N2000PayloadView GetN2000PayloadView(NMEA2000Id id,
+                                                     ObservedEvt ev);
+
 /**
  *  Get SignalK status payload after receiving a message.
  *  @return pointer to a wxJSONValue map object. Typical usage:
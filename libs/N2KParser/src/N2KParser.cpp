@@ -36,12 +36,15 @@ uint32_t millis() {
   return 42;
 }
 
-tN2kMsg MakeN2kMsg(std::vector<unsigned char> &v) {
+tN2kMsg MakeN2kMsg(const std::vector<unsigned char> &v) {
 
   tN2kMsg Msg;
   Msg.Clear();;
 
-  unsigned char *Buf = v.data();
+  // Type, length, priority, PGN, destination, source, time and data length
+  if ( v.size()<13 ) return Msg;
+
+  const unsigned char *Buf = v.data();
 
   int i=2;
   Msg.Priority=Buf[i++];
@@ -60,12 +63,12 @@ tN2kMsg MakeN2kMsg(std::vector<unsigned char> &v) {
     Msg.Clear();
   }
 
-  for (int j=0; i<static_cast<int>(v.size())-1; i++, j++) Msg.Data[j]=Buf[i];
+  for (int j=0; i<static_cast<int>(v.size())-1 && j<tN2kMsg::MaxDataLen; i++, j++) Msg.Data[j]=Buf[i];
 
   return Msg;
 }
 
-bool ParseN2kPGN128275(std::vector<unsigned char> &v, uint16_t &DaysSince1970,
+bool ParseN2kPGN128275(const std::vector<unsigned char> &v, uint16_t &DaysSince1970,
                        double &SecondsSinceMidnight, uint32_t &Log, uint32_t &TripLog) {
 
   tN2kMsg msg = MakeN2kMsg(v);
@@ -74,7 +77,7 @@ bool ParseN2kPGN128275(std::vector<unsigned char> &v, uint16_t &DaysSince1970,
 }
 
 
-bool ParseN2kPGN129029(std::vector<unsigned char> &v, unsigned char &SID, uint16_t &DaysSince1970, double &SecondsSinceMidnight,
+bool ParseN2kPGN129029(const std::vector<unsigned char> &v, unsigned char &SID, uint16_t &DaysSince1970, double &SecondsSinceMidnight,
                      double &Latitude, double &Longitude, double &Altitude,
                      tN2kGNSStype &GNSStype, tN2kGNSSmethod &GNSSmethod,
                      uint8_t &nSatellites, double &HDOP, double &PDOP, double &GeoidalSeparation,
@@ -94,7 +97,7 @@ bool ParseN2kPGN129029(std::vector<unsigned char> &v, unsigned char &SID, uint16
 }
 
 
-bool ParseN2kPGN129025(std::vector<unsigned char> &v, double &Latitude, double &Longitude) {
+bool ParseN2kPGN129025(const std::vector<unsigned char> &v, double &Latitude, double &Longitude) {
 
   tN2kMsg msg = MakeN2kMsg(v);
 
@@ -102,7 +105,7 @@ bool ParseN2kPGN129025(std::vector<unsigned char> &v, double &Latitude, double &
 }
 
 
-bool ParseN2kPGN129026(std::vector<unsigned char> &v, unsigned char &SID,
+bool ParseN2kPGN129026(const std::vector<unsigned char> &v, unsigned char &SID,
                        tN2kHeadingReference &ref, double &COG, double &SOG) {
 
   tN2kMsg msg = MakeN2kMsg(v);
@@ -112,7 +115,7 @@ bool ParseN2kPGN129026(std::vector<unsigned char> &v, unsigned char &SID,
 }
 
 // Rudder
-bool ParseN2kPGN127245(std::vector<unsigned char> &v, double &RudderPosition, unsigned char &Instance,
+bool ParseN2kPGN127245(const std::vector<unsigned char> &v, double &RudderPosition, unsigned char &Instance,
                        tN2kRudderDirectionOrder &RudderDirectionOrder, double &AngleOrder) {
 
   tN2kMsg msg = MakeN2kMsg(v);
@@ -121,7 +124,7 @@ bool ParseN2kPGN127245(std::vector<unsigned char> &v, double &RudderPosition, un
                            RudderDirectionOrder, AngleOrder);
 }
 
-bool ParseN2kPGN127250(std::vector<unsigned char> &v, unsigned char &SID,
+bool ParseN2kPGN127250(const std::vector<unsigned char> &v, unsigned char &SID,
                        double &Heading, double &Deviation, double &Variation, tN2kHeadingReference &ref) {
 
   tN2kMsg msg = MakeN2kMsg(v);
@@ -130,7 +133,7 @@ bool ParseN2kPGN127250(std::vector<unsigned char> &v, unsigned char &SID,
 
 }
 
-bool ParseN2kPGN127257(std::vector<unsigned char> &v, unsigned char &SID,
+bool ParseN2kPGN127257(const std::vector<unsigned char> &v, unsigned char &SID,
                        double &Yaw, double &Pitch, double &Roll) {
 
   tN2kMsg msg = MakeN2kMsg(v);
@@ -139,7 +142,7 @@ bool ParseN2kPGN127257(std::vector<unsigned char> &v, unsigned char &SID,
 
 }
 
-bool ParseN2kPGN128259(std::vector<unsigned char> &v, unsigned char &SID,
+bool ParseN2kPGN128259(const std::vector<unsigned char> &v, unsigned char &SID,
                        double &WaterReferenced, double &GroundReferenced,
                        tN2kSpeedWaterReferenceType &SWRT) {
 
@@ -149,7 +152,7 @@ bool ParseN2kPGN128259(std::vector<unsigned char> &v, unsigned char &SID,
 
 }
 
-bool ParseN2kPGN129540(std::vector<unsigned char> &v, unsigned char &SID,
+bool ParseN2kPGN129540(const std::vector<unsigned char> &v, unsigned char &SID,
                        tN2kRangeResidualMode &Mode, uint8_t &nSats) {
 
   tN2kMsg msg = MakeN2kMsg(v);
@@ -158,7 +161,7 @@ bool ParseN2kPGN129540(std::vector<unsigned char> &v, unsigned char &SID,
 
 }
 
-bool ParseN2kPGN129540(std::vector<unsigned char> &v, uint8_t SVIndex, tSatelliteInfo& SatelliteInfo) {
+bool ParseN2kPGN129540(const std::vector<unsigned char> &v, uint8_t SVIndex, tSatelliteInfo& SatelliteInfo) {
 
   tN2kMsg msg = MakeN2kMsg(v);
 
@@ -166,7 +169,7 @@ bool ParseN2kPGN129540(std::vector<unsigned char> &v, uint8_t SVIndex, tSatellit
 }
 
 
-bool ParseN2kPGN129038(std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID,
+bool ParseN2kPGN129038(const std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID,
                         double &Latitude, double &Longitude, bool &Accuracy, bool &RAIM, uint8_t &Seconds,
                         double &COG, double &SOG, double &Heading, double &ROT, tN2kAISNavStatus &NavStatus,
                         tN2kAISTransceiverInformation &AISTransceiverInformation)
@@ -178,7 +181,7 @@ bool ParseN2kPGN129038(std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAI
                         COG, SOG, Heading, ROT, NavStatus, AISTransceiverInformation);
 }
 
-bool ParseN2kPGN129039(std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID,
+bool ParseN2kPGN129039(const std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID,
                         double &Latitude, double &Longitude, bool &Accuracy, bool &RAIM, uint8_t &Seconds, double &COG,
                         double &SOG, tN2kAISTransceiverInformation &AISTransceiverInformation, double &Heading,
                         tN2kAISUnit &Unit, bool &Display, bool &DSC, bool &Band, bool &Msg22, tN2kAISMode &Mode, bool &State)
@@ -193,7 +196,7 @@ bool ParseN2kPGN129039(std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAI
 
 
 
-bool ParseN2kPGN129794(std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID,
+bool ParseN2kPGN129794(const std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID,
                         uint32_t &IMOnumber, char *Callsign, char *Name, uint8_t &VesselType, double &Length,
                         double &Beam, double &PosRefStbd, double &PosRefBow, uint16_t &ETAdate, double &ETAtime,
                         double &Draught, char *Destination, tN2kAISVersion &AISversion, tN2kGNSStype &GNSStype,
@@ -208,7 +211,7 @@ bool ParseN2kPGN129794(std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAI
                         DTE, AISinfo);
 }
 
-bool ParseN2kPGN129809(std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID, char *Name)
+bool ParseN2kPGN129809(const std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID, char *Name)
 {
     tN2kMsg msg = MakeN2kMsg(v);
 
@@ -216,7 +219,7 @@ bool ParseN2kPGN129809(std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAI
 }
 
 
-bool ParseN2kPGN129810(std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID,
+bool ParseN2kPGN129810(const std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID,
                       uint8_t &VesselType, char *Vendor, char *Callsign, double &Length, double &Beam,
                       double &PosRefStbd, double &PosRefBow, uint32_t &MothershipID)
 {
@@ -227,7 +230,7 @@ bool ParseN2kPGN129810(std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAI
                       PosRefStbd, PosRefBow, MothershipID);
 }
 
-bool ParseN2kPGN129041(std::vector<unsigned char> &v, tN2kAISAtoNReportData &N2kData)
+bool ParseN2kPGN129041(const std::vector<unsigned char> &v, tN2kAISAtoNReportData &N2kData)
 {
     tN2kMsg msg = MakeN2kMsg(v);
 
@@ -235,7 +238,7 @@ bool ParseN2kPGN129041(std::vector<unsigned char> &v, tN2kAISAtoNReportData &N2k
 }
 
 // Water depth
-bool ParseN2kPGN128267(std::vector<unsigned char> &v, unsigned char &SID,
+bool ParseN2kPGN128267(const std::vector<unsigned char> &v, unsigned char &SID,
                        double &DepthBelowTransducer, double &Offset, double &Range)
 {
     tN2kMsg msg = MakeN2kMsg(v);
@@ -245,7 +248,7 @@ bool ParseN2kPGN128267(std::vector<unsigned char> &v, unsigned char &SID,
 }
 
 // Wind Speed
-bool ParseN2kPGN130306(std::vector<unsigned char> &v, unsigned char &SID,
+bool ParseN2kPGN130306(const std::vector<unsigned char> &v, unsigned char &SID,
                        double &WindSpeed, double &WindAngle, tN2kWindReference &WindReference)
 {
     tN2kMsg msg = MakeN2kMsg(v);
@@ -255,7 +258,7 @@ bool ParseN2kPGN130306(std::vector<unsigned char> &v, unsigned char &SID,
 }
 
 // Outside Environmental parameters
-bool ParseN2kPGN130310(std::vector<unsigned char> &v, unsigned char &SID, double &WaterTemperature,
+bool ParseN2kPGN130310(const std::vector<unsigned char> &v, unsigned char &SID, double &WaterTemperature,
                      double &OutsideAmbientAirTemperature, double &AtmosphericPressure)
 {
     tN2kMsg msg = MakeN2kMsg(v);
@@ -265,7 +268,7 @@ bool ParseN2kPGN130310(std::vector<unsigned char> &v, unsigned char &SID, double
 }
 
 // Humidity
-bool ParseN2kPGN130313(std::vector<unsigned char> &v, unsigned char &SID,
+bool ParseN2kPGN130313(const std::vector<unsigned char> &v, unsigned char &SID,
                        unsigned char &HumidityInstance,
                        tN2kHumiditySource &HumiditySource,
                        double &ActualHumidity, double &SetHumidity) {
@@ -277,7 +280,7 @@ bool ParseN2kPGN130313(std::vector<unsigned char> &v, unsigned char &SID,
 
 
 // AIS Base Station position/time report
-bool ParseN2kPGN129793(std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID,
+bool ParseN2kPGN129793(const std::vector<unsigned char> &v, uint8_t &MessageID, tN2kAISRepeat &Repeat, uint32_t &UserID,
                         double &Longitude, double &Latitude, unsigned int &SecondsSinceMidnight,
                         unsigned int &DaysSinceEpoch)
 {
@@ -84,7 +84,8 @@ class DDFModule
                 DDFModule();
                 ~DDFModule();
 
-    int         Open( const char * pszFilename, int bFailQuietly = FALSE );
+    int         Open( const char * pszFilename, int bFailQuietly = FALSE,
+                      int bMapFile = FALSE );
     int         Create( const char *pszFilename );
     void        Close();
 
@@ -120,7 +121,15 @@ class DDFModule
     // This is just for DDFRecord.
     FILE        *GetFP() { return fpDDF; }
 
+    /** TRUE if records are read as views into a mapping of the file. */
+    int         IsMapped() { return pachMap != NULL; }
+    const char  *MapPeek( long *pnAvailable );
+    void        MapSkip( long nBytes ) { nMapOffset += nBytes; }
+
   private:
+    int         MapFile();
+    void        UnmapFile();
+
     FILE        *fpDDF;
     int         bReadOnly;
     long        nFirstRecordOffset;
@@ -148,6 +157,13 @@ class DDFModule
     int         nCloneCount;
     int         nMaxCloneCount;
     DDFRecord   **papoClones;
+
+    // Read only mapping of the whole file, and the offset of the next
+    // record in it.
+    const char  *pachMap;
+    long        nMapSize;
+    long        nMapOffset;
+    void        *hMapping;
 };
 
 /************************************************************************/
@@ -386,7 +402,7 @@ class DDFRecord
 
     DDFRecord  *Clone();
     DDFRecord  *CloneOn( DDFModule * );
-    DDFRecord  *Copy();
+    DDFRecord  *Copy( int bShareMappedData = FALSE );
     void        Dump( FILE * );
 
     /** Get the number of DDFFields on this record. */
@@ -450,6 +466,7 @@ class DDFRecord
   private:
 
     int         ReadHeader();
+    int         MakeDataOwned();
 
     DDFModule   *poModule;
 
@@ -463,6 +480,7 @@ class DDFRecord
 
     int         nDataSize;      // Whole record except leader with header
     char        *pachData;
+    int         bDataIsMapped;  // pachData is a view into the module mapping
 
     int         nFieldCount;
     DDFField    *paoFields;
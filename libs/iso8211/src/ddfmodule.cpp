@@ -82,6 +82,14 @@
 #include "gdal/cpl_conv.h"
 #include "iso8211.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 /************************************************************************/
 /*                             DDFModule()                              */
 /************************************************************************/
@@ -103,6 +111,11 @@ DDFModule::DDFModule()
     fpDDF = NULL;
     bReadOnly = TRUE;
 
+    pachMap = NULL;
+    nMapSize = 0;
+    nMapOffset = 0;
+    hMapping = NULL;
+
     _interchangeLevel = '\0';
     _inlineCodeExtensionIndicator = '\0';
     _versionNumber = '\0';
@@ -185,6 +198,11 @@ void DDFModule::Close()
     CPLFree( papoFieldDefns );
     papoFieldDefns = NULL;
     nFieldDefnCount = 0;
+
+/* -------------------------------------------------------------------- */
+/*      Unmap the file last, the records above may be views into it.    */
+/* -------------------------------------------------------------------- */
+    UnmapFile();
 }
 
 /************************************************************************/
@@ -203,12 +221,16 @@ void DDFModule::Close()
  * @param pszFilename   The name of the file to open.
  * @param bFailQuietly If FALSE a CPL Error is issued for non-8211 files,
  * otherwise quietly return NULL.
+ * @param bMapFile If TRUE the file is mapped into memory, and the records
+ * read are views into the mapping instead of copies read from the file.
+ * Files which can not be mapped are read as a stream as usual.
  *
  * @return FALSE if the open fails or TRUE if it succeeds.  Errors messages
  * are issued internally with CPLError().
  */
 
-int DDFModule::Open( const char * pszFilename, int bFailQuietly )
+int DDFModule::Open( const char * pszFilename, int bFailQuietly,
+                     int bMapFile )
 
 {
     static const size_t nLeaderSize = 24;
@@ -384,9 +406,115 @@ int DDFModule::Open( const char * pszFilename, int bFailQuietly )
 /* -------------------------------------------------------------------- */
     nFirstRecordOffset = VSIFTell( fpDDF );
 
+    if( bMapFile && MapFile() )
+        nMapOffset = nFirstRecordOffset;
+
     return TRUE;
 }
 
+/************************************************************************/
+/*                              MapFile()                               */
+/*                                                                      */
+/*      Map the whole of the open file read only.                       */
+/************************************************************************/
+
+int DDFModule::MapFile()
+
+{
+#ifdef _WIN32
+    HANDLE hFile = (HANDLE) _get_osfhandle( _fileno( fpDDF ) );
+    LARGE_INTEGER nSize;
+
+    if( hFile == INVALID_HANDLE_VALUE || !GetFileSizeEx( hFile, &nSize )
+        || nSize.QuadPart == 0 || nSize.QuadPart > 0x7fffffff )
+        return FALSE;
+
+    HANDLE hMap = CreateFileMapping( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+    if( hMap == NULL )
+        return FALSE;
+
+    void *pView = MapViewOfFile( hMap, FILE_MAP_READ, 0, 0, 0 );
+    if( pView == NULL )
+    {
+        CloseHandle( hMap );
+        return FALSE;
+    }
+
+    hMapping = hMap;
+    nMapSize = (long) nSize.QuadPart;
+    pachMap = (const char *) pView;
+#else
+    struct stat sStat;
+    int fd = fileno( fpDDF );
+
+    if( fstat( fd, &sStat ) != 0 || !S_ISREG( sStat.st_mode )
+        || sStat.st_size == 0 || sStat.st_size > 0x7fffffff )
+        return FALSE;
+
+    void *pView = mmap( NULL, sStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    if( pView == MAP_FAILED )
+        return FALSE;
+
+#ifdef MADV_SEQUENTIAL
+    madvise( pView, sStat.st_size, MADV_SEQUENTIAL );
+#endif
+
+    nMapSize = (long) sStat.st_size;
+    pachMap = (const char *) pView;
+#endif
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                             UnmapFile()                              */
+/************************************************************************/
+
+void DDFModule::UnmapFile()
+
+{
+    if( pachMap == NULL )
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile( pachMap );
+    CloseHandle( (HANDLE) hMapping );
+#else
+    munmap( (void *) pachMap, nMapSize );
+#endif
+
+    pachMap = NULL;
+    hMapping = NULL;
+    nMapSize = 0;
+    nMapOffset = 0;
+}
+
+/************************************************************************/
+/*                              MapPeek()                               */
+/************************************************************************/
+
+/**
+ * Fetch the mapped data at the current read position.
+ *
+ * This is just for DDFRecord.  The position is advanced with MapSkip().
+ *
+ * @param pnAvailable Set to the number of bytes left in the file.
+ * @return Pointer to the data, or NULL if the file is not mapped.
+ */
+
+const char *DDFModule::MapPeek( long *pnAvailable )
+
+{
+    if( pachMap == NULL || nMapOffset >= nMapSize )
+    {
+        *pnAvailable = 0;
+        return pachMap ? pachMap + nMapSize : NULL;
+    }
+
+    *pnAvailable = nMapSize - nMapOffset;
+    return pachMap + nMapOffset;
+}
+
 /************************************************************************/
 /*                             Initialize()                             */
 /************************************************************************/
@@ -749,6 +877,7 @@ void DDFModule::Rewind( long nOffset )
         return;
 
     VSIFSeek( fpDDF, nOffset, SEEK_SET );
+    nMapOffset = nOffset;
 
     if( nOffset == nFirstRecordOffset && poRecord != NULL )
         poRecord->Clear();
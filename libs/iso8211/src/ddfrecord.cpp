@@ -139,6 +139,7 @@ DDFRecord::DDFRecord( DDFModule * poModuleIn )
 
     nDataSize = 0;
     pachData = NULL;
+    bDataIsMapped = FALSE;
 
     nFieldCount = 0;
     paoFields = NULL;
@@ -224,6 +225,29 @@ int DDFRecord::Read()
 /* -------------------------------------------------------------------- */
     size_t      nReadBytes;
 
+    if( poModule->IsMapped() )
+    {
+        long nAvailable;
+        const char *pachView = poModule->MapPeek( &nAvailable );
+
+        if( nAvailable == 0 )
+            return FALSE;
+        if( nAvailable < nDataSize - nFieldOffset )
+        {
+            CPLError( CE_Failure, CPLE_FileIO,
+                      "Data record is short on DDF file.\n" );
+            return FALSE;
+        }
+
+        // The reused header has to stay, so the data is copied once here.
+        if( !MakeDataOwned() )
+            return FALSE;
+        memcpy( pachData + nFieldOffset, pachView, nDataSize - nFieldOffset );
+        poModule->MapSkip( nDataSize - nFieldOffset );
+
+        return TRUE;
+    }
+
     nReadBytes = VSIFRead( pachData + nFieldOffset, 1,
                            nDataSize - nFieldOffset,
                            poModule->GetFP() );
@@ -320,14 +344,47 @@ void DDFRecord::Clear()
     paoFields = NULL;
     nFieldCount = 0;
 
-    if( pachData != NULL )
+    if( pachData != NULL && !bDataIsMapped )
         CPLFree( pachData );
 
     pachData = NULL;
+    bDataIsMapped = FALSE;
     nDataSize = 0;
     nReuseHeader = FALSE;
 }
 
+/************************************************************************/
+/*                           MakeDataOwned()                            */
+/*                                                                      */
+/*      Replace a view into the module mapping with a private copy,     */
+/*      before the data is modified or has to outlive the mapping.      */
+/************************************************************************/
+
+int DDFRecord::MakeDataOwned()
+
+{
+    if( !bDataIsMapped )
+        return TRUE;
+
+    const char *pachView = pachData;
+
+    pachData = (char *) CPLMalloc( nDataSize );
+    memcpy( pachData, pachView, nDataSize );
+    bDataIsMapped = FALSE;
+
+    for( int i = 0; i < nFieldCount; i++ )
+    {
+        int     nOffset;
+
+        nOffset = (paoFields[i].GetData() - pachView);
+        paoFields[i].Initialize( paoFields[i].GetFieldDefn(),
+                                 pachData + nOffset,
+                                 paoFields[i].GetDataSize() );
+    }
+
+    return TRUE;
+}
+
 /************************************************************************/
 /*                             ReadHeader()                             */
 /*                                                                      */
@@ -348,14 +405,31 @@ int DDFRecord::ReadHeader()
 /*      Read the 24 byte leader.                                        */
 /* -------------------------------------------------------------------- */
     char        achLeader[nLeaderSize];
+    const char  *pachLeader = achLeader;
     int         nReadBytes;
 
-    nReadBytes = VSIFRead(achLeader,1,nLeaderSize,poModule->GetFP());
-    if( nReadBytes == 0 && VSIFEof( poModule->GetFP() ) )
+    if( poModule->IsMapped() )
     {
-        return FALSE;
+        long nAvailable;
+
+        pachLeader = poModule->MapPeek( &nAvailable );
+        if( nAvailable == 0 )
+            return FALSE;
+
+        nReadBytes = nAvailable < (long) nLeaderSize ? (int) nAvailable
+                                                     : (int) nLeaderSize;
+        poModule->MapSkip( nReadBytes );
+    }
+    else
+    {
+        nReadBytes = VSIFRead(achLeader,1,nLeaderSize,poModule->GetFP());
+        if( nReadBytes == 0 && VSIFEof( poModule->GetFP() ) )
+        {
+            return FALSE;
+        }
     }
-    else if( nReadBytes != (int) nLeaderSize )
+
+    if( nReadBytes != (int) nLeaderSize )
     {
         CPLError( CE_Failure, CPLE_FileIO,
                   "Leader is short on DDF file." );
@@ -369,13 +443,13 @@ int DDFRecord::ReadHeader()
     int         _recLength, _fieldAreaStart;
     char        _leaderIden;
 
-    _recLength                    = DDFScanInt( achLeader+0, 5 );
-    _leaderIden                   = achLeader[6];
-    _fieldAreaStart               = DDFScanInt(achLeader+12,5);
+    _recLength                    = DDFScanInt( pachLeader+0, 5 );
+    _leaderIden                   = pachLeader[6];
+    _fieldAreaStart               = DDFScanInt(pachLeader+12,5);
 
-    _sizeFieldLength = achLeader[20] - '0';
-    _sizeFieldPos = achLeader[21] - '0';
-    _sizeFieldTag = achLeader[23] - '0';
+    _sizeFieldLength = pachLeader[20] - '0';
+    _sizeFieldPos = pachLeader[21] - '0';
+    _sizeFieldTag = pachLeader[23] - '0';
 
     if( _sizeFieldLength < 0 || _sizeFieldLength > 9
         || _sizeFieldPos < 0 || _sizeFieldPos > 9
@@ -414,15 +488,36 @@ int DDFRecord::ReadHeader()
 /*      Read the remainder of the record.                               */
 /* -------------------------------------------------------------------- */
         nDataSize = _recLength - nLeaderSize;
-        pachData = (char *) CPLMalloc(nDataSize);
 
-        if( VSIFRead( pachData, 1, nDataSize, poModule->GetFP()) !=
-            (size_t) nDataSize )
+        if( poModule->IsMapped() )
         {
-            CPLError( CE_Failure, CPLE_FileIO,
-                      "Data record is short on DDF file." );
+            long nAvailable;
+            const char *pachView = poModule->MapPeek( &nAvailable );
 
-            return FALSE;
+            if( nAvailable < nDataSize )
+            {
+                CPLError( CE_Failure, CPLE_FileIO,
+                          "Data record is short on DDF file." );
+
+                return FALSE;
+            }
+
+            pachData = (char *) pachView;
+            bDataIsMapped = TRUE;
+            poModule->MapSkip( nDataSize );
+        }
+        else
+        {
+            pachData = (char *) CPLMalloc(nDataSize);
+
+            if( VSIFRead( pachData, 1, nDataSize, poModule->GetFP()) !=
+                (size_t) nDataSize )
+            {
+                CPLError( CE_Failure, CPLE_FileIO,
+                          "Data record is short on DDF file." );
+
+                return FALSE;
+            }
         }
 
 #if 0
@@ -457,6 +552,7 @@ int DDFRecord::ReadHeader()
     {
         if( (pachData[nDataSize-2] == DDF_FIELD_TERMINATOR) && (pachData[nDataSize-1] == 0) )
         {
+            MakeDataOwned();
             nDataSize++;
             pachData = (char *) CPLRealloc(pachData,nDataSize);
             pachData[nDataSize-1] = DDF_FIELD_TERMINATOR;
@@ -552,69 +648,105 @@ int DDFRecord::ReadHeader()
         int nFieldEntryWidth = _sizeFieldLength + _sizeFieldPos + _sizeFieldTag;
         nFieldCount = 0;
         int i=0;
-        char *tmpBuf = (char*)CPLMalloc(nFieldEntryWidth);
-
-        // while we're not at the end, store this entry,
-        // and keep on reading...
-        do {
-            // read an Entry:
-            if(nFieldEntryWidth !=
-               (int) VSIFRead(tmpBuf, 1, nFieldEntryWidth, poModule->GetFP())) {
-                CPLError(CE_Failure, CPLE_FileIO,
-                         "Data record is short on DDF file.");
-                CPLFree(tmpBuf);
-                return FALSE;
+        char *tmpBuf = NULL;
+
+        if( poModule->IsMapped() ) {
+            // The directory and the field data follow each other in the
+            // file, so the record can be viewed in place once its size is
+            // known.
+            long nAvailable;
+            const char *pachView = poModule->MapPeek( &nAvailable );
+
+            while( nDataSize < nAvailable
+                   && pachView[nDataSize] != DDF_FIELD_TERMINATOR ) {
+                nDataSize += nFieldEntryWidth;
+                nFieldCount++;
             }
+            nDataSize++;
 
-            // move this temp buffer into more permanent storage:
-            char *newBuf = (char*)CPLMalloc(nDataSize+nFieldEntryWidth);
-            if(pachData!=NULL) {
-                memcpy(newBuf, pachData, nDataSize);
-                CPLFree(pachData);
+            for( i = 0; i < nFieldCount && nDataSize <= nAvailable; i++ ) {
+                int nEntryOffset = (i*nFieldEntryWidth) + _sizeFieldTag;
+                nDataSize += DDFScanInt(pachView + nEntryOffset,
+                                        _sizeFieldLength);
             }
-            memcpy(&newBuf[nDataSize], tmpBuf, nFieldEntryWidth);
-            pachData = newBuf;
-            nDataSize += nFieldEntryWidth;
 
-            if(DDF_FIELD_TERMINATOR != tmpBuf[0]) {
-                nFieldCount++;
-            }
-        }
-        while(DDF_FIELD_TERMINATOR != tmpBuf[0]);
-
-        // Now, rewind a little.  Only the TERMINATOR should have been read:
-        int rewindSize = nFieldEntryWidth - 1;
-        FILE *fp = poModule->GetFP();
-        long pos = ftell(fp) - rewindSize;
-        fseek(fp, pos, SEEK_SET);
-        nDataSize -= rewindSize;
-
-        // --------------------------------------------------------------------
-        // Okay, now let's populate the heck out of pachData...
-        // --------------------------------------------------------------------
-        for(i=0; i<nFieldCount; i++) {
-            int nEntryOffset = (i*nFieldEntryWidth) + _sizeFieldTag;
-            int nFieldLength = DDFScanInt(pachData + nEntryOffset,
-                                          _sizeFieldLength);
-            char *tmpBuf = (char*)CPLMalloc(nFieldLength);
-
-            // read an Entry:
-            if(nFieldLength !=
-               (int) VSIFRead(tmpBuf, 1, nFieldLength, poModule->GetFP())) {
+            if( nDataSize > nAvailable ) {
                 CPLError(CE_Failure, CPLE_FileIO,
                          "Data record is short on DDF file.");
-                CPLFree(tmpBuf);
+                nDataSize = 0;
+                nFieldCount = 0;
                 return FALSE;
             }
 
-            // move this temp buffer into more permanent storage:
-            char *newBuf = (char*)CPLMalloc(nDataSize+nFieldLength);
-            memcpy(newBuf, pachData, nDataSize);
-            CPLFree(pachData);
-            memcpy(&newBuf[nDataSize], tmpBuf, nFieldLength);
-            CPLFree(tmpBuf);
-            pachData = newBuf;
-            nDataSize += nFieldLength;
+            pachData = (char *) pachView;
+            bDataIsMapped = TRUE;
+            poModule->MapSkip( nDataSize );
+        }
+        else {
+            tmpBuf = (char*)CPLMalloc(nFieldEntryWidth);
+
+            // while we're not at the end, store this entry,
+            // and keep on reading...
+            do {
+                // read an Entry:
+                if(nFieldEntryWidth !=
+                   (int) VSIFRead(tmpBuf, 1, nFieldEntryWidth, poModule->GetFP())) {
+                    CPLError(CE_Failure, CPLE_FileIO,
+                             "Data record is short on DDF file.");
+                    CPLFree(tmpBuf);
+                    return FALSE;
+                }
+
+                // move this temp buffer into more permanent storage:
+                char *newBuf = (char*)CPLMalloc(nDataSize+nFieldEntryWidth);
+                if(pachData!=NULL) {
+                    memcpy(newBuf, pachData, nDataSize);
+                    CPLFree(pachData);
+                }
+                memcpy(&newBuf[nDataSize], tmpBuf, nFieldEntryWidth);
+                pachData = newBuf;
+                nDataSize += nFieldEntryWidth;
+
+                if(DDF_FIELD_TERMINATOR != tmpBuf[0]) {
+                    nFieldCount++;
+                }
+            }
+            while(DDF_FIELD_TERMINATOR != tmpBuf[0]);
+
+            // Now, rewind a little.  Only the TERMINATOR should have been read:
+            int rewindSize = nFieldEntryWidth - 1;
+            FILE *fp = poModule->GetFP();
+            long pos = ftell(fp) - rewindSize;
+            fseek(fp, pos, SEEK_SET);
+            nDataSize -= rewindSize;
+
+            // --------------------------------------------------------------------
+            // Okay, now let's populate the heck out of pachData...
+            // --------------------------------------------------------------------
+            for(i=0; i<nFieldCount; i++) {
+                int nEntryOffset = (i*nFieldEntryWidth) + _sizeFieldTag;
+                int nFieldLength = DDFScanInt(pachData + nEntryOffset,
+                                              _sizeFieldLength);
+                char *tmpBuf = (char*)CPLMalloc(nFieldLength);
+
+                // read an Entry:
+                if(nFieldLength !=
+                   (int) VSIFRead(tmpBuf, 1, nFieldLength, poModule->GetFP())) {
+                    CPLError(CE_Failure, CPLE_FileIO,
+                             "Data record is short on DDF file.");
+                    CPLFree(tmpBuf);
+                    return FALSE;
+                }
+
+                // move this temp buffer into more permanent storage:
+                char *newBuf = (char*)CPLMalloc(nDataSize+nFieldLength);
+                memcpy(newBuf, pachData, nDataSize);
+                CPLFree(pachData);
+                memcpy(&newBuf[nDataSize], tmpBuf, nFieldLength);
+                CPLFree(tmpBuf);
+                pachData = newBuf;
+                nDataSize += nFieldLength;
+            }
         }
 
         /* ----------------------------------------------------------------- */
@@ -955,8 +1087,18 @@ DDFRecord * DDFRecord::Clone()
     poNR->nFieldOffset = nFieldOffset;
 
     poNR->nDataSize = nDataSize;
-    poNR->pachData = (char *) CPLMalloc(nDataSize);
-    memcpy( poNR->pachData, pachData, nDataSize );
+    if( bDataIsMapped )
+    {
+        // Clones are deleted before the module is unmapped, so they can
+        // share the view.
+        poNR->pachData = pachData;
+        poNR->bDataIsMapped = TRUE;
+    }
+    else
+    {
+        poNR->pachData = (char *) CPLMalloc(nDataSize);
+        memcpy( poNR->pachData, pachData, nDataSize );
+    }
 
     poNR->nFieldCount = nFieldCount;
     poNR->paoFields = new DDFField[nFieldCount];
@@ -1024,6 +1166,9 @@ DDFRecord *DDFRecord::CloneOn( DDFModule *poTargetModule )
 
     poClone = Clone();
 
+    // The clone outlives the mapping of this module.
+    poClone->MakeDataOwned();
+
 /* -------------------------------------------------------------------- */
 /*      Update all internal information to reference other module.      */
 /* -------------------------------------------------------------------- */
@@ -1057,11 +1202,15 @@ DDFRecord *DDFRecord::CloneOn( DDFModule *poTargetModule )
  * This method is used to make a copy of a record that will become
  * the properly of application.
  *
+ * @param bShareMappedData If TRUE and the module is mapped, the copy is a
+ * view of the same data instead of a copy of it.  It must then be deleted
+ * before the module is closed.
+ *
  * @return A new copy of the DDFRecord.  This can be delete'd by the
  * application when no longer needed.
  */
 
-DDFRecord * DDFRecord::Copy()
+DDFRecord * DDFRecord::Copy( int bShareMappedData )
 
 {
     DDFRecord   *poNR;
@@ -1072,8 +1221,16 @@ DDFRecord * DDFRecord::Copy()
     poNR->nFieldOffset = nFieldOffset;
 
     poNR->nDataSize = nDataSize;
-    poNR->pachData = (char *) CPLMalloc(nDataSize);
-    memcpy( poNR->pachData, pachData, nDataSize );
+    if( bDataIsMapped && bShareMappedData )
+    {
+        poNR->pachData = pachData;
+        poNR->bDataIsMapped = TRUE;
+    }
+    else
+    {
+        poNR->pachData = (char *) CPLMalloc(nDataSize);
+        memcpy( poNR->pachData, pachData, nDataSize );
+    }
 
     poNR->nFieldCount = nFieldCount;
     poNR->paoFields = new DDFField[nFieldCount];
@@ -1176,6 +1333,9 @@ int DDFRecord::ResizeField( DDFField *poField, int nNewDataSize )
     int         iTarget, i;
     int         nBytesToMove;
 
+    if( !MakeDataOwned() )
+        return FALSE;
+
 /* -------------------------------------------------------------------- */
 /*      Find which field we are to resize.                              */
 /* -------------------------------------------------------------------- */
@@ -1358,6 +1518,9 @@ DDFRecord::SetFieldRaw( DDFField *poField, int iIndexWithinField,
 {
     int         iTarget, nRepeatCount;
 
+    if( !MakeDataOwned() )
+        return FALSE;
+
 /* -------------------------------------------------------------------- */
 /*      Find which field we are to update.                              */
 /* -------------------------------------------------------------------- */
@@ -1519,6 +1682,9 @@ DDFRecord::UpdateFieldRaw( DDFField *poField, int iIndexWithinField,
 {
     int         iTarget, nRepeatCount;
 
+    if( !MakeDataOwned() )
+        return FALSE;
+
 /* -------------------------------------------------------------------- */
 /*      Find which field we are to update.                              */
 /* -------------------------------------------------------------------- */
@@ -1604,6 +1770,9 @@ int DDFRecord::ResetDirectory()
 {
     int iField;
 
+    if( !MakeDataOwned() )
+        return FALSE;
+
 /* -------------------------------------------------------------------- */
 /*      Eventually we should try to optimize the size of offset and     */
 /*      field length.  For now we will use 5 for each which is          */
@@ -1740,6 +1909,9 @@ int DDFRecord::SetStringSubfield( const char *pszField, int iFieldIndex,
                                   const char *pszValue, int nValueLength )
 
 {
+    if( !MakeDataOwned() )
+        return FALSE;
+
 /* -------------------------------------------------------------------- */
 /*      Fetch the field. If this fails, return zero.                    */
 /* -------------------------------------------------------------------- */
@@ -1852,6 +2024,9 @@ int DDFRecord::SetIntSubfield( const char *pszField, int iFieldIndex,
                                int nNewValue )
 
 {
+    if( !MakeDataOwned() )
+        return FALSE;
+
 /* -------------------------------------------------------------------- */
 /*      Fetch the field. If this fails, return zero.                    */
 /* -------------------------------------------------------------------- */
@@ -1963,6 +2138,9 @@ int DDFRecord::SetFloatSubfield( const char *pszField, int iFieldIndex,
                                  double dfNewValue )
 
 {
+    if( !MakeDataOwned() )
+        return FALSE;
+
 /* -------------------------------------------------------------------- */
 /*      Fetch the field. If this fails, return zero.                    */
 /* -------------------------------------------------------------------- */
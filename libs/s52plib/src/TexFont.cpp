@@ -68,13 +68,41 @@
 CGLShaderProgram *m_TexFontShader;
 #endif
 
+unsigned int TexFont::s_draw_count = 0;
+
+/* Decode the next UTF-8 character, invalid bytes are skipped */
+static unsigned int NextCodePoint(const char *&s) {
+  const unsigned char *p = (const unsigned char *)s;
+  unsigned int c = *p++;
+  int n = 0;
+  if (c >= 0xf0 && c < 0xf8) {
+    c &= 0x07;
+    n = 3;
+  } else if (c >= 0xe0) {
+    c &= 0x0f;
+    n = 2;
+  } else if (c >= 0xc0) {
+    c &= 0x1f;
+    n = 1;
+  } else if (c >= 0x80) {
+    c = 0;
+  }
+  for (; n > 0 && (*p & 0xc0) == 0x80; n--) c = (c << 6) | (*p++ & 0x3f);
+  if (n) c = 0;  // truncated sequence
+  s = (const char *)p;
+  return c;
+}
+
 TexFont::TexFont() {
   texobj = 0;
   m_blur = false;
   m_built = false;
   m_color = wxColor(0, 0, 0);
-  m_angle = 0;
   m_ContentScaleFactor = 1.0;
+  m_dpi_factor = 1.0;
+  m_next_x = m_next_y = 0;
+  m_tex_dirty = false;
+  m_vpwidth = m_vpheight = 0;
 
   m_shadersLoaded = false;
 
@@ -88,6 +116,7 @@ void TexFont::Build(wxFont &font, double scale_factor, double dpi_factor, bool b
 
   m_font = font;
   m_blur = blur;
+  m_dpi_factor = dpi_factor;
 
   m_maxglyphw = 0;
   m_maxglyphh = 0;
@@ -100,6 +129,7 @@ void TexFont::Build(wxFont &font, double scale_factor, double dpi_factor, bool b
                                   font.GetFamily(), font.GetStyle(),
                                   font.GetWeight(), false,
                                   font.GetFaceName());
+  m_scaled_font = *scaled_font;
   wxScreenDC sdc;
   sdc.SetFont(*scaled_font);
 
@@ -133,7 +163,7 @@ void TexFont::Build(wxFont &font, double scale_factor, double dpi_factor, bool b
   int w = COLS_GLYPHS * m_maxglyphw;
   int h = ROWS_GLYPHS * m_maxglyphh;
 
-  wxASSERT(w < 2048 && h < 2048);
+  wxASSERT(w < MAX_TEXFONT_SIZE && h < MAX_TEXFONT_SIZE);
 
   /* make power of 2 */
   for (tex_w = 1; tex_w < w; tex_w *= 2)
@@ -167,6 +197,7 @@ void TexFont::Build(wxFont &font, double scale_factor, double dpi_factor, bool b
 
     tgi[i].x = col * m_maxglyphw;
     tgi[i].y = row * m_maxglyphh;
+    tgi[i].cell_width = m_maxglyphw;
 
     wxString text;
     if (i == DEGREE_GLYPH)
@@ -185,45 +216,35 @@ void TexFont::Build(wxFont &font, double scale_factor, double dpi_factor, bool b
 
   wxImage image = tbmp.ConvertToImage();
 
-  unsigned int format = 0, internalformat = 0;
-  int stride;
-
-#ifdef ocpnUSE_GL
-  format = GL_ALPHA;
-#endif
-
-  internalformat = format;
-  stride = 1;
-
   if (m_blur) image = image.Blur(1);
 
   unsigned char *imgdata = image.GetData();
 
+  Delete();
+  m_coords.clear();
+  m_uv.clear();
+  m_extra_glyphs.clear();
+  m_teximage.assign(tex_w * tex_h, 0);
   if (imgdata) {
-    unsigned char *teximage = (unsigned char *)malloc(stride * tex_w * tex_h);
-
-    for (int j = 0; j < tex_w * tex_h; j++)
-      for (int k = 0; k < stride; k++)
-        teximage[j * stride + k] = imgdata[3 * j];
+    for (int j = 0; j < tex_w * tex_h; j++) m_teximage[j] = imgdata[3 * j];
+  }
 
-    Delete();
+  /* added glyphs go below the ascii ones */
+  m_next_x = 0;
+  m_next_y = (row + 1) * m_maxglyphh;
 
 #ifdef ocpnUSE_GL
-    glGenTextures(1, &texobj);
-    glBindTexture(GL_TEXTURE_2D, texobj);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
-                    GL_NEAREST /*GL_LINEAR*/);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glGenTextures(1, &texobj);
+  glBindTexture(GL_TEXTURE_2D, texobj);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, internalformat, tex_w, tex_h, 0, format,
-                 GL_UNSIGNED_BYTE, teximage);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
+                  GL_NEAREST /*GL_LINEAR*/);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 #endif
-    free(teximage);
-
-  }
+  m_tex_dirty = true;
+  UploadTexture();
 
   m_built = true;
 }
@@ -238,24 +259,98 @@ void TexFont::Delete() {
   m_built = false;
 }
 
+void TexFont::UploadTexture() {
+  if (!m_tex_dirty || !texobj) return;
+#ifdef ocpnUSE_GL
+  glBindTexture(GL_TEXTURE_2D, texobj);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, tex_w, tex_h, 0, GL_ALPHA,
+               GL_UNSIGNED_BYTE, &m_teximage[0]);
+#endif
+  m_tex_dirty = false;
+}
+
+const TexGlyphInfo *TexFont::GetGlyph(unsigned int c) {
+  if (c == 0x00B0) c = DEGREE_GLYPH;
+  if (c < MIN_GLYPH) return NULL;
+  if (c < MAX_GLYPH) return &tgi[c];
+
+  std::unordered_map<unsigned int, TexGlyphInfo>::iterator it =
+      m_extra_glyphs.find(c);
+  if (it != m_extra_glyphs.end())
+    return it->second.cell_width ? &it->second : NULL;
+  return AddGlyph(c);
+}
+
+const TexGlyphInfo *TexFont::AddGlyph(unsigned int c) {
+  TexGlyphInfo &g = m_extra_glyphs[c];
+  g.x = g.y = g.width = g.height = g.cell_width = 0;
+  g.advance = 0;
+  if (!m_built) return NULL;
+
+  wxString text = wxString(wxUniChar(c));
+  wxCoord gw, gh, descent, exlead;
+  wxScreenDC sdc;
+  sdc.SetFont(m_scaled_font);
+  sdc.GetTextExtent(text, &gw, &gh, &descent, &exlead, &m_scaled_font);
+  if (gw <= 0 || gw > tex_w || gh >= m_maxglyphh) return NULL;
+
+  /* next row, growing the texture if needed */
+  if (m_next_x + gw > tex_w) {
+    m_next_x = 0;
+    m_next_y += m_maxglyphh;
+  }
+  if (m_next_y + m_maxglyphh > tex_h) {
+    if (2 * tex_h > MAX_TEXFONT_SIZE) return NULL;
+    Flush();  // queued uv are relative to the old size
+    tex_h *= 2;
+    m_teximage.resize(tex_w * tex_h, 0);
+  }
+
+  g.x = m_next_x;
+  g.y = m_next_y;
+  g.width = gw;
+  g.height = gh;
+  g.cell_width = gw;
+  g.advance = gw * m_dpi_factor;
+  m_next_x += gw;
+
+  wxBitmap bmp(gw, m_maxglyphh);
+  wxMemoryDC dc;
+  dc.SelectObject(bmp);
+  dc.SetFont(m_scaled_font);
+  dc.SetBackground(wxBrush(wxColour(0, 0, 0)));
+  dc.Clear();
+  dc.SetTextForeground(wxColour(255, 255, 255));
+  dc.DrawText(text, 0, 0);
+  dc.SelectObject(wxNullBitmap);
+
+  wxImage image = bmp.ConvertToImage();
+  if (m_blur) image = image.Blur(1);
+  unsigned char *imgdata = image.GetData();
+  if (imgdata) {
+    for (int y = 0; y < m_maxglyphh; y++)
+      for (int x = 0; x < gw; x++)
+        m_teximage[(g.y + y) * tex_w + g.x + x] = imgdata[3 * (y * gw + x)];
+  }
+  m_tex_dirty = true;
+  return &g;
+}
+
 void TexFont::GetTextExtent(const char *string, int *width, int *height) {
   int w = 0, h = 0;
 
-  for (int i = 0; string[i]; i++) {
-    unsigned char c = string[i];
+  const char *s = string;
+  while (*s) {
+    unsigned int c = NextCodePoint(s);
     if (c == '\n') {
       h += tgi[(int)'A'].height;
       continue;
     }
-    if (c == 0xc2 && (unsigned char)string[i + 1] == 0xb0) {
-      c = DEGREE_GLYPH;
-      i++;
-    }
-    if (c < MIN_GLYPH || c >= MAX_GLYPH) continue;
+    const TexGlyphInfo *g = GetGlyph(c);
+    if (!g) continue;
 
-    TexGlyphInfo &tgisi = tgi[c];
-    w += tgisi.advance;
-    if (tgisi.height > h) h = tgisi.height;
+    w += g->advance;
+    if (g->height > h) h = g->height;
   }
   if (width) *width = w;
   if (height) *height = h;
@@ -265,188 +360,129 @@ void TexFont::GetTextExtent(const wxString &string, int *width, int *height) {
   GetTextExtent((const char *)string.ToUTF8(), width, height);
 }
 
-void TexFont::RenderGlyph(int c) {
-#ifdef ocpnUSE_GL
-  if (c < MIN_GLYPH || c >= MAX_GLYPH) return;
-
-  TexGlyphInfo &tgic = tgi[c];
-
-  int x = tgic.x, y = tgic.y;
-  float w = m_maxglyphw, h = m_maxglyphh;
-  float tx1 = (float)x / (float)tex_w;
-  float tx2 = (float)(x + w) / (float)tex_w;
-  float ty1 = (float)y / (float)tex_h;
-  float ty2 = (float)(y + h) / (float)tex_h;
-
-  if(!m_TexFontShader)
-    return;
-
-  float uv[8];
-  float coords[8];
-
-  // normal uv
-  uv[0] = tx1;
-  uv[1] = ty1;
-  uv[2] = tx2;
-  uv[3] = ty1;
-  uv[4] = tx2;
-  uv[5] = ty2;
-  uv[6] = tx1;
-  uv[7] = ty2;
-
-  // pixels
-  coords[0] = 0;
-  coords[1] = 0;
-  coords[2] = w;
-  coords[3] = 0;
-  coords[4] = w;
-  coords[5] = h;
-  coords[6] = 0;
-  coords[7] = h;
-
-  m_TexFontShader->Bind();
-
-   // Set up the texture sampler to texture unit 0
-  m_TexFontShader->SetUniform1i( "uTex", 0);
-
-  float colorv[4];
-  colorv[0] = m_color.Red() / float(256);
-  colorv[1] = m_color.Green() / float(256);
-  colorv[2] = m_color.Blue() / float(256);
-  colorv[3] = 0;
-
-  m_TexFontShader->SetUniform4fv( "color", colorv);
-
-  // Rotate
-  //float angle = 0;
-  mat4x4 I, Q;
-  mat4x4_identity(I);
-  mat4x4_identity(Q);
-  //mat4x4_rotate_Z(Q, I, m_angle);
-
-    // Translate
-  Q[3][0] = m_dx; // - m_vpwidth/2; //m_dx;
-  Q[3][1] = m_dy;// - m_vpheight/2; //m_dy;
-
- // mat4x4_translate_in_place(I, m_dx, m_dy, 0);
- // mat4x4_rotate_Z(Q, I, m_angle);
-  //mat4x4_translate_in_place(Q, -m_dx, -m_dy, 0);
-
-  m_TexFontShader->SetUniformMatrix4fv( "TransformMatrix", (GLfloat *)Q);
-
-// For some reason, glDrawElements is busted on Android
-// So we do this a hard ugly way, drawing two triangles...
-#if 0
-    GLushort indices1[] = {0,1,3,2};
-    glDrawElements(GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_SHORT, indices1);
-#else
-
-  float co1[8];
-  co1[0] = coords[0];
-  co1[1] = coords[1];
-  co1[2] = coords[2];
-  co1[3] = coords[3];
-  co1[4] = coords[6];
-  co1[5] = coords[7];
-  co1[6] = coords[4];
-  co1[7] = coords[5];
-
-  float tco1[8];
-  tco1[0] = uv[0];
-  tco1[1] = uv[1];
-  tco1[2] = uv[2];
-  tco1[3] = uv[3];
-  tco1[4] = uv[6];
-  tco1[5] = uv[7];
-  tco1[6] = uv[4];
-  tco1[7] = uv[5];
-
-  m_TexFontShader->SetAttributePointerf( "position", co1);
-  m_TexFontShader->SetAttributePointerf( "aUV", tco1);
-
-  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-  m_TexFontShader->UnBind();
-
-#endif
+void TexFont::SetColor(wxColor &color) {
+  if (color != m_color) Flush();
+  m_color = color;
+}
 
-  m_dx += tgic.advance; // * cos(m_angle); // + tgic.advance * sin(m_angle);
-  //m_dy += tgic.advance * sin(m_angle); // - tgic.advance * cos(m_angle);
-#endif
+void TexFont::AddQuad(const TexGlyphInfo &g, float x, float y) {
+  float w = g.cell_width, h = m_maxglyphh;
+  float tx1 = (float)g.x / (float)tex_w;
+  float tx2 = (float)(g.x + w) / (float)tex_w;
+  float ty1 = (float)g.y / (float)tex_h;
+  float ty2 = (float)(g.y + h) / (float)tex_h;
+
+  const float coords[12] = {x,     y, x + w, y,     x, y + h,
+                            x,     y + h, x + w, y, x + w, y + h};
+  const float uv[12] = {tx1, ty1, tx2, ty1, tx1, ty2,
+                        tx1, ty2, tx2, ty1, tx2, ty2};
+  m_coords.insert(m_coords.end(), coords, coords + 12);
+  m_uv.insert(m_uv.end(), uv, uv + 12);
 }
 
 void TexFont::RenderString(const char *string, int x, int y, float angle) {
-#ifdef ocpnUSE_GL
-
-#if !defined(USE_ANDROID_GLES2) && !defined(ocpnUSE_GLSL)
-
-  glPushMatrix();
-  glTranslatef(x, y, 0);
-
-  glPushMatrix();
-  glBindTexture(GL_TEXTURE_2D, texobj);
+  size_t first = m_coords.size();
+  float dx = x, dy = y;
 
-  for (int i = 0; string[i]; i++) {
-    if (string[i] == '\n') {
-      glPopMatrix();
-      glTranslatef(0, tgi[(int)'A'].height, 0);
-      glPushMatrix();
+  const char *s = string;
+  while (*s) {
+    unsigned int c = NextCodePoint(s);
+    if (c == '\n') {
+      dx = x;
+      dy += tgi[(int)'A'].height;
       continue;
     }
-    /* degree symbol */
-    if ((unsigned char)string[i] == 0xc2 &&
-        (unsigned char)string[i + 1] == 0xb0) {
-      RenderGlyph(DEGREE_GLYPH);
-      i++;
-      continue;
+    const TexGlyphInfo *g = GetGlyph(c);
+    if (!g) continue;
+    AddQuad(*g, dx, dy);
+    dx += g->advance;
+  }
+
+  //  Turn the string's quads about its origin
+  if (angle != 0.0) {
+    float cosa = cos(angle), sina = sin(angle);
+    for (size_t i = first; i < m_coords.size(); i += 2) {
+      float ox = m_coords[i] - x, oy = m_coords[i + 1] - y;
+      m_coords[i] = x + ox * cosa + oy * sina;
+      m_coords[i + 1] = y - ox * sina + oy * cosa;
     }
-    RenderGlyph(string[i]);
   }
+}
 
-  glPopMatrix();
-  glPopMatrix();
-#else
-  //FIXME (dave)  this is awful code, drawing chars glyph at a time.
-  //FIXME (dave)  Also, need to render string at an angle....
-  m_dx = (x - m_vpwidth/2) * cos(angle) + (y - m_vpheight/2) * sin(angle);
-  m_dx += m_vpwidth/2;
-  m_dy = -(x - m_vpwidth/2) * sin(angle) + (y - m_vpheight/2) * cos(angle);
-  m_dy += m_vpheight/2;
+void TexFont::RenderString(const wxString &string, int x, int y, float angle) {
+#ifdef ocpnUSE_GL
+  LoadTexFontShaders();
+#endif
+  RenderString((const char *)string.ToUTF8(), x, y, angle);
+}
 
-  m_dx = x;
-  m_dy = y;
-  m_angle = angle;
+void TexFont::Flush() {
+  if (m_coords.empty()) return;
+#ifdef ocpnUSE_GL
+  UploadTexture();
 
+  GLboolean blend = glIsEnabled(GL_BLEND);
+  glEnable(GL_BLEND);
   glBindTexture(GL_TEXTURE_2D, texobj);
 
-  for (int i = 0; string[i]; i++) {
-    if (string[i] == '\n') {
-      m_dy += tgi[(int)'A'].height;
-      continue;
-    }
-    /* degree symbol */
-    if ((unsigned char)string[i] == 0xc2 &&
-        (unsigned char)string[i + 1] == 0xb0) {
-      RenderGlyph(DEGREE_GLYPH);
-      i++;
-      continue;
-    }
-    RenderGlyph(string[i]);
+#if !defined(USE_ANDROID_GLES2) && !defined(ocpnUSE_GLSL)
+  glEnable(GL_TEXTURE_2D);
+  glColor3ub(m_color.Red(), m_color.Green(), m_color.Blue());
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+  glVertexPointer(2, GL_FLOAT, 0, &m_coords[0]);
+  glTexCoordPointer(2, GL_FLOAT, 0, &m_uv[0]);
+  glDrawArrays(GL_TRIANGLES, 0, m_coords.size() / 2);
+  glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+  glDisable(GL_TEXTURE_2D);
+  s_draw_count++;
+#else
+  if (m_TexFontShader) {
+    m_TexFontShader->Bind();
+
+    // Set up the texture sampler to texture unit 0
+    m_TexFontShader->SetUniform1i("uTex", 0);
+
+    float colorv[4];
+    colorv[0] = m_color.Red() / float(256);
+    colorv[1] = m_color.Green() / float(256);
+    colorv[2] = m_color.Blue() / float(256);
+    colorv[3] = 0;
+    m_TexFontShader->SetUniform4fv("color", colorv);
+
+    // The glyph positions are in the vertices
+    mat4x4 I;
+    mat4x4_identity(I);
+    m_TexFontShader->SetUniformMatrix4fv("TransformMatrix", (GLfloat *)I);
+
+    // One draw for all the queued glyphs.  Plain triangles, as
+    // glDrawElements is busted on Android.
+    m_TexFontShader->SetAttributePointerf("position", &m_coords[0]);
+    m_TexFontShader->SetAttributePointerf("aUV", &m_uv[0]);
+    glDrawArrays(GL_TRIANGLES, 0, m_coords.size() / 2);
+
+    m_TexFontShader->UnBind();
+    s_draw_count++;
   }
-
 #endif
+  if (!blend) glDisable(GL_BLEND);
 #endif
+  m_coords.clear();
+  m_uv.clear();
 }
 
-void TexFont::RenderString(const wxString &string, int x, int y, float angle) {
-#ifdef ocpnUSE_GL
-  LoadTexFontShaders();
-#endif
-  RenderString((const char *)string.ToUTF8(), x, y, angle);
+unsigned int TexFont::TakeDrawCount() {
+  unsigned int n = s_draw_count;
+  s_draw_count = 0;
+  return n;
 }
 
 void TexFont::PrepareShader(int width, int height, double rotation){
 #ifdef ocpnUSE_GL
+  // Queued text was placed for the previous viewport
+  Flush();
+
   if(!m_TexFontShader)
     LoadTexFontShaders();
 
@@ -26,11 +26,14 @@
 #ifndef __TEXFONT_H__
 #define __TEXFONT_H__
 
+#include <unordered_map>
+#include <vector>
+
 #include <wx/colour.h>
 #include <wx/font.h>
 
-/* support ascii plus degree symbol for now pack font in a single texture 16x8
- */
+/* ascii plus degree symbol are packed in the first 16x8 cells of the
+ * texture, other characters are added below on first use */
 #define DEGREE_GLYPH 127
 #define MIN_GLYPH 32
 #define MAX_GLYPH 128
@@ -40,8 +43,12 @@
 #define COLS_GLYPHS 16
 #define ROWS_GLYPHS ((NUM_GLYPHS / COLS_GLYPHS) + 1)
 
+/* largest glyph texture, characters not fitting are not drawn */
+#define MAX_TEXFONT_SIZE 2048
+
 struct TexGlyphInfo {
   int x, y, width, height;
+  int cell_width;  // width of the textured quad, 0 if not in the texture
   float advance;
 };
 
@@ -54,22 +61,38 @@ public:
   void Delete();
 
   void GetTextExtent(const wxString &string, int *width, int *height);
+
+  /* Strings are UTF-8, turned by angle radians about x, y. They are
+   * queued and drawn together by Flush(), which also happens on a color or
+   * viewport change. Flush before changing the GL state for other drawing
+   * or deleting the font, queued text is lost otherwise. */
   void RenderString(const char *string, int x=0, int y=0, float angle = 0.0);
   void RenderString(const wxString &string, int x=0, int y=0, float angle = 0.0);
+  void Flush();
+
   bool IsBuilt() { return m_built; }
-  void SetColor(wxColor &color) { m_color = color; }
+  void SetColor(wxColor &color);
   void PrepareShader(int width, int height, double rotation);
   void SetContentScaleFactor(double s){m_ContentScaleFactor = s;}
 
+  /* Number of draw calls by all fonts since the last call */
+  static unsigned int TakeDrawCount();
+
 private:
   void GetTextExtent(const char *string, int *width, int *height);
-  void RenderGlyph(int c);
+  const TexGlyphInfo *GetGlyph(unsigned int c);
+  const TexGlyphInfo *AddGlyph(unsigned int c);
+  void AddQuad(const TexGlyphInfo &g, float x, float y);
+  void UploadTexture();
   bool LoadTexFontShaders();
 
   wxFont m_font;
+  wxFont m_scaled_font;
+  double m_dpi_factor;
   bool m_blur;
 
   TexGlyphInfo tgi[MAX_GLYPH];
+  std::unordered_map<unsigned int, TexGlyphInfo> m_extra_glyphs;
 
   unsigned int texobj;
   int tex_w, tex_h;
@@ -77,8 +100,16 @@ private:
   int m_maxglyphh;
   bool m_built;
 
-  float m_dx, m_dy;
-  float m_angle;
+  /* alpha copy of the texture and the next free cell for added glyphs */
+  std::vector<unsigned char> m_teximage;
+  int m_next_x, m_next_y;
+  bool m_tex_dirty;
+
+  /* queued quads, two triangles per glyph */
+  std::vector<float> m_coords;
+  std::vector<float> m_uv;
+  static unsigned int s_draw_count;
+
   int m_vpwidth, m_vpheight;
 
   wxColor m_color;
@@ -0,0 +1,102 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  S52 text declutter support
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#include "TextDeclutter.h"
+
+TextDeclutterGrid::TextDeclutterGrid(int cell_size)
+    : m_cell_size(cell_size), m_stamp(0), m_tests(0), m_last_frame_tests(0) {}
+
+//  Empty v, keeping its storage unless that is over twice what it held.
+template <typename T>
+static void ClearAndTrim(std::vector<T> &v) {
+  if (v.capacity() > 2 * v.size() + 16) {
+    std::vector<T> trimmed;
+    trimmed.reserve(v.size());
+    v.swap(trimmed);
+  } else {
+    v.clear();
+  }
+}
+
+void TextDeclutterGrid::Clear() {
+  // The next frame places about the same texts in about the same cells, so
+  // storage sized for this frame is kept. Cells this frame did not use are
+  // dropped, and storage a denser earlier frame needed is given back.
+  size_t placed = m_entries.size();
+  ClearAndTrim(m_entries);
+  m_slot.clear();
+  if (m_slot.bucket_count() > 4 * placed + 64) m_slot.rehash(placed);
+
+  for (auto it = m_cells.begin(); it != m_cells.end();) {
+    if (it->second.empty()) {
+      it = m_cells.erase(it);
+    } else {
+      ClearAndTrim(it->second);
+      ++it;
+    }
+  }
+  if (m_cells.bucket_count() > 4 * m_cells.size() + 64)
+    m_cells.rehash(m_cells.size());
+
+  m_last_frame_tests = m_tests;
+  m_tests = 0;
+}
+
+void TextDeclutterGrid::Place(S52_TextC *text, const wxRect &rect) {
+  auto found = m_slot.find(text);
+  if (found != m_slot.end()) {
+    if (m_entries[found->second].rect == rect) return;
+    m_entries[found->second].text = nullptr;
+  }
+  int index = m_entries.size();
+  m_entries.push_back({text, rect, m_stamp});
+  m_slot[text] = index;
+
+  int x1 = CellIndex(rect.GetLeft()), x2 = CellIndex(rect.GetRight());
+  int y1 = CellIndex(rect.GetTop()), y2 = CellIndex(rect.GetBottom());
+  for (int cy = y1; cy <= y2; cy++)
+    for (int cx = x1; cx <= x2; cx++)
+      m_cells[CellKey(cx, cy)].push_back(index);
+}
+
+bool TextDeclutterGrid::Overlaps(const wxRect &rect, const S52_TextC *self) {
+  if (m_entries.empty()) return false;
+
+  // An entry spanning several cells is tested only once per query
+  m_stamp++;
+  int x1 = CellIndex(rect.GetLeft()), x2 = CellIndex(rect.GetRight());
+  int y1 = CellIndex(rect.GetTop()), y2 = CellIndex(rect.GetBottom());
+  for (int cy = y1; cy <= y2; cy++) {
+    for (int cx = x1; cx <= x2; cx++) {
+      auto cell = m_cells.find(CellKey(cx, cy));
+      if (cell == m_cells.end()) continue;
+      for (int index : cell->second) {
+        Entry &entry = m_entries[index];
+        if (entry.stamp == m_stamp || entry.text == nullptr) continue;
+        entry.stamp = m_stamp;
+        m_tests++;
+        if (entry.text != self && entry.rect.Intersects(rect)) return true;
+      }
+    }
+  }
+  return false;
+}
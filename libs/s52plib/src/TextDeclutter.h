@@ -0,0 +1,89 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  S52 text declutter support
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#ifndef __TEXTDECLUTTER_H__
+#define __TEXTDECLUTTER_H__
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <wx/gdicmn.h>
+
+class S52_TextC;
+
+/**
+ * Rectangles of the texts placed in the current frame, bucketed in a
+ * uniform grid of screen cells so that an overlap test only looks at
+ * texts placed in the cells the tested rectangle covers.
+ */
+class TextDeclutterGrid {
+public:
+  TextDeclutterGrid(int cell_size = 64);
+
+  /** Forget all placed texts, start a new frame. */
+  void Clear();
+
+  /** Add text, or move it to rect if it was already placed. */
+  void Place(S52_TextC *text, const wxRect &rect);
+
+  /** True if text is placed in the current frame. */
+  bool IsPlaced(const S52_TextC *text) const {
+    return m_slot.find(text) != m_slot.end();
+  }
+
+  /** True if rect overlaps any placed text except self. */
+  bool Overlaps(const wxRect &rect, const S52_TextC *self);
+
+  /** Number of rectangle intersection tests since Clear(). */
+  size_t GetTestCount() const { return m_tests; }
+
+  /** Number of intersection tests done in the previous frame. */
+  size_t GetLastFrameTestCount() const { return m_last_frame_tests; }
+
+  /** Number of grid cells holding storage. */
+  size_t GetCellCount() const { return m_cells.size(); }
+
+private:
+  struct Entry {
+    S52_TextC *text;  // nullptr once moved
+    wxRect rect;
+    unsigned stamp;   // last Overlaps() query which tested this entry
+  };
+
+  int64_t CellKey(int cx, int cy) const {
+    return (int64_t)(((uint64_t)(uint32_t)cy << 32) | (uint32_t)cx);
+  }
+  int CellIndex(int pix) const {
+    return pix >= 0 ? pix / m_cell_size : (pix + 1) / m_cell_size - 1;
+  }
+
+  const int m_cell_size;
+  std::vector<Entry> m_entries;
+  std::unordered_map<int64_t, std::vector<int> > m_cells;
+  std::unordered_map<const S52_TextC *, int> m_slot;
+  unsigned m_stamp;
+  size_t m_tests;
+  size_t m_last_frame_tests;
+};
+
+#endif
@@ -0,0 +1,299 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  S52 software area rasterizer
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRIRASTER_SSE2
+#endif
+
+#include "TriRaster.h"
+
+//  Bands thinner than this are not worth a thread
+#define TRIRASTER_MIN_BAND_ROWS 32
+#define TRIRASTER_MAX_THREADS 8
+
+TriRaster::TriRaster()
+    : m_n_bands(0), m_next_band(0), m_bands_done(0), m_stop(false) {
+  memset(&m_target, 0, sizeof(m_target));
+}
+
+TriRaster::~TriRaster() {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for (auto &worker : m_workers) worker.join();
+}
+
+void TriRaster::FillSpan(unsigned char *p, int n, int depth, unsigned char c0,
+                         unsigned char c1, unsigned char c2) {
+  if (n <= 0) return;
+
+  if (depth == 32) {
+    unsigned int v = (c2 << 16) + (c1 << 8) + c0;
+    unsigned int *pi = (unsigned int *)p;
+#ifdef TRIRASTER_SSE2
+    __m128i v4 = _mm_set1_epi32(v);
+    for (; n >= 4; n -= 4, pi += 4) _mm_storeu_si128((__m128i *)pi, v4);
+#endif
+    while (n--) *pi++ = v;
+    return;
+  }
+
+  //  24 bit: 16 pixels are three 16 byte words
+  unsigned char block[48];
+  for (int i = 0; i < 48; i += 3) {
+    block[i] = c0;
+    block[i + 1] = c1;
+    block[i + 2] = c2;
+  }
+#ifdef TRIRASTER_SSE2
+  __m128i w0 = _mm_loadu_si128((const __m128i *)block);
+  __m128i w1 = _mm_loadu_si128((const __m128i *)(block + 16));
+  __m128i w2 = _mm_loadu_si128((const __m128i *)(block + 32));
+  for (; n >= 16; n -= 16, p += 48) {
+    _mm_storeu_si128((__m128i *)p, w0);
+    _mm_storeu_si128((__m128i *)(p + 16), w1);
+    _mm_storeu_si128((__m128i *)(p + 32), w2);
+  }
+#else
+  for (; n >= 16; n -= 16, p += 48) memcpy(p, block, 48);
+#endif
+  memcpy(p, block, n * 3);
+}
+
+void TriRaster::FillTri(const Tri &tri, const TriRasterTarget &target,
+                        const TriRasterPattern *pattern) {
+  //      Determine ymin and ymax indices
+  int imin = 0;
+  int imax = 0;
+  int ymin = tri.y[0];
+  int ymax = ymin;
+  for (int ip = 1; ip < 3; ip++) {
+    if (tri.y[ip] > ymax) {
+      imax = ip;
+      ymax = tri.y[ip];
+    }
+    if (tri.y[ip] <= ymin) {
+      imin = ip;
+      ymin = tri.y[ip];
+    }
+  }
+  int imid = 3 - (imin + imax);
+
+  int xmin = tri.x[imin];
+  int xmax = tri.x[imax];
+  int xmid = tri.x[imid];
+  int ymid = tri.y[imid];
+
+  //      Rows ya to yb - 1 are drawn
+  int ybt = target.y;
+  int yt = target.y + target.height;
+  int ya = std::min(std::max(ymin, ybt), yt);
+  int yb = std::min(std::max(ymax, ybt), yt);
+  if (ya >= yb) return;
+
+  int lclip = target.lclip;
+  int rclip = target.rclip;
+  if (std::max(std::max(xmin, xmax), xmid) < lclip) return;
+  if (std::min(std::min(xmin, xmax), xmid) > rclip) return;
+
+  if (pattern && (pattern->width <= 0 || pattern->height <= 0)) return;
+
+  //      The long edge runs from ymin to ymax, the short ones meet at ymid.
+  //      64 bit 16.16 DDA, good for any triangle the canvas can hold.
+  long long m_long = (((long long)(xmax - xmin)) << 16) / (ymax - ymin);
+  long long m_top = 0;
+  if (ymid != ymin)
+    m_top = (((long long)(xmid - xmin)) << 16) / (ymid - ymin);
+  long long m_bot = 0;
+  if (ymax != ymid)
+    m_bot = (((long long)(xmax - xmid)) << 16) / (ymax - ymid);
+
+  //      If cw is true, the long edge is on the left
+  long long sum = (long long)xmin * ymax - (long long)ymin * xmax;
+  sum += (long long)xmax * ymid - (long long)ymax * xmid;
+  sum += (long long)xmid * ymin - (long long)ymid * xmin;
+  bool cw = sum < 0;
+
+  int bpp = target.depth / 8;
+
+  for (int iy = ya; iy < yb; iy++) {
+    long long xl = (((long long)xmin) << 16) + (iy - ymin) * m_long;
+    long long xs;
+    if (iy < ymid)
+      xs = (((long long)xmin) << 16) + (iy - ymin) * m_top;
+    else
+      xs = (((long long)xmid) << 16) + (iy - ymid) * m_bot;
+
+    int ix, ixm;
+    if (cw) {
+      ix = (int)(xl >> 16);
+      ixm = (int)(xs >> 16);
+    } else {
+      ix = (int)(xs >> 16);
+      ixm = (int)(xl >> 16);
+    }
+
+    //  Clip the span, a reversed one is a DDA failure on huge triangles
+    if (ix > ixm || ixm < lclip || ix > rclip) continue;
+    if (ix < lclip) ix = lclip;
+    if (ixm > rclip) ixm = rclip;
+
+    unsigned char *px = target.pix_buff + (iy - target.y) * target.pb_pitch +
+                        (ix - target.x) * bpp;
+
+    if (!pattern) {
+      FillSpan(px, ixm - ix + 1, target.depth, tri.c[0], tri.c[1], tri.c[2]);
+      continue;
+    }
+
+    int patt_size_x = pattern->width;
+    int patt_size_y = pattern->height;
+    int y_stagger = (iy - pattern->y) / patt_size_y;
+    int x_stagger_off = 0;
+    if ((y_stagger & 1) && pattern->b_stagger)
+      x_stagger_off = pattern->width / 2;
+
+    int patt_y = abs((iy - pattern->y)) % patt_size_y;
+    const unsigned char *pp0 = pattern->pix_buff + (patt_y * pattern->pb_pitch);
+
+    for (; ix <= ixm; ix++, px += bpp) {
+      int patt_x = abs(((ix - pattern->x) + x_stagger_off) % patt_size_x);
+      const unsigned char *pp = pp0 + (patt_x * 4);
+      unsigned char alpha = pp[3];
+      double da = (double)alpha / 256.;
+
+      if (bpp == 3) {
+        px[0] = (unsigned char)(px[0] * (1.0 - da) + pp[0] * da);
+        px[1] = (unsigned char)(px[1] * (1.0 - da) + pp[1] * da);
+        px[2] = (unsigned char)(px[2] * (1.0 - da) + pp[2] * da);
+      } else if (alpha > 128) {
+        px[0] = (unsigned char)(pp[0] * da);
+        px[1] = (unsigned char)(pp[1] * da);
+        px[2] = (unsigned char)(pp[2] * da);
+      }
+    }
+  }
+}
+
+int TriRaster::AddPattern(const TriRasterPattern &pattern) {
+  //  All triangles of an area share the pattern
+  if (!m_patterns.empty()) {
+    const TriRasterPattern &last = m_patterns.back();
+    if (last.pix_buff == pattern.pix_buff && last.x == pattern.x &&
+        last.y == pattern.y && last.width == pattern.width &&
+        last.height == pattern.height && last.pb_pitch == pattern.pb_pitch &&
+        last.b_stagger == pattern.b_stagger)
+      return (int)m_patterns.size() - 1;
+  }
+  m_patterns.push_back(pattern);
+  return (int)m_patterns.size() - 1;
+}
+
+void TriRaster::Clear() {
+  m_tris.clear();
+  m_patterns.clear();
+}
+
+void TriRaster::RenderBand(int band) {
+  //  Bands split the rows evenly, and share the target buffer
+  TriRasterTarget t = m_target;
+  int y0 = m_target.height * band / m_n_bands;
+  int y1 = m_target.height * (band + 1) / m_n_bands;
+  t.pix_buff += y0 * t.pb_pitch;
+  t.y += y0;
+  t.height = y1 - y0;
+
+  for (const Tri &tri : m_tris) {
+    const TriRasterPattern *pattern =
+        tri.pattern >= 0 ? &m_patterns[tri.pattern] : 0;
+    FillTri(tri, t, pattern);
+  }
+}
+
+void TriRaster::RunBands(std::unique_lock<std::mutex> &lock) {
+  while (m_next_band < m_n_bands) {
+    int band = m_next_band++;
+    lock.unlock();
+    RenderBand(band);
+    lock.lock();
+    if (++m_bands_done == m_n_bands) m_cv.notify_all();
+  }
+}
+
+void TriRaster::Worker() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [this] { return m_stop || m_next_band < m_n_bands; });
+    if (m_stop) return;
+    RunBands(lock);
+  }
+}
+
+void TriRaster::StartWorkers(unsigned n) {
+  while (m_workers.size() < n)
+    m_workers.push_back(std::thread(&TriRaster::Worker, this));
+}
+
+void TriRaster::Render(const TriRasterTarget &target, unsigned n_threads) {
+  if (m_tris.empty() || target.height <= 0) {
+    Clear();
+    return;
+  }
+
+  if (n_threads == 0)
+    n_threads = std::min(std::thread::hardware_concurrency(),
+                         (unsigned)TRIRASTER_MAX_THREADS);
+  int max_bands = std::max(1, target.height / TRIRASTER_MIN_BAND_ROWS);
+  int n_bands = std::min((int)n_threads * 4, max_bands);
+  if (n_threads <= 1 || n_bands <= 1) {
+    m_target = target;
+    m_n_bands = 1;
+    RenderBand(0);
+    m_n_bands = 0;
+    Clear();
+    return;
+  }
+
+  //  The calling thread draws bands too
+  StartWorkers(std::min(n_threads - 1, (unsigned)n_bands - 1));
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_target = target;
+  m_n_bands = n_bands;
+  m_next_band = 0;
+  m_bands_done = 0;
+  m_cv.notify_all();
+  RunBands(lock);
+  m_cv.wait(lock, [this] { return m_bands_done == m_n_bands; });
+  m_n_bands = m_next_band = m_bands_done = 0;
+  lock.unlock();
+
+  Clear();
+}
@@ -0,0 +1,114 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  S52 software area rasterizer
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#ifndef __TRIRASTER_H__
+#define __TRIRASTER_H__
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** Pixel buffer and clip limits, in canvas coordinates. */
+struct TriRasterTarget {
+  unsigned char *pix_buff;  ///< Pixel of row y, column x
+  int pb_pitch;
+  int depth;  ///< 24 or 32
+  int x;
+  int y;
+  int width;
+  int height;
+  int lclip;  ///< First and last column drawn
+  int rclip;
+};
+
+/** RGBA area fill pattern, anchored at x, y. */
+struct TriRasterPattern {
+  const unsigned char *pix_buff;
+  int pb_pitch;
+  int x;
+  int y;
+  int width;
+  int height;
+  bool b_stagger;
+};
+
+/**
+ * Flat shaded and patterned triangles of the non-GL chart renderer.
+ *
+ * Triangles are either filled at once with FillTri(), or queued with
+ * Add() while the chart objects are prepared and drawn together by
+ * Render(). Render() splits the target into horizontal bands drawn by a
+ * pool of threads, each band draws all triangles in the order they were
+ * added so the result does not depend on the number of threads.
+ */
+class TriRaster {
+public:
+  struct Tri {
+    int x[3];
+    int y[3];
+    unsigned char c[3];  ///< See FillSpan()
+    int pattern;         ///< Index of the pattern, or -1 for a flat fill
+  };
+
+  TriRaster();
+  ~TriRaster();
+
+  static void FillTri(const Tri &tri, const TriRasterTarget &target,
+                      const TriRasterPattern *pattern);
+
+  /**
+   * Fill n pixels from p. 24 bit pixels are c0, c1, c2 in memory, 32 bit
+   * ones the int (c2 << 16) + (c1 << 8) + c0.
+   */
+  static void FillSpan(unsigned char *p, int n, int depth, unsigned char c0,
+                       unsigned char c1, unsigned char c2);
+
+  /** Queue a triangle for Render(), pattern is an AddPattern() index. */
+  void Add(const Tri &tri) { m_tris.push_back(tri); }
+  int AddPattern(const TriRasterPattern &pattern);
+  size_t GetCount() const { return m_tris.size(); }
+
+  /** Draw and clear the queued triangles, 0 threads means one per core. */
+  void Render(const TriRasterTarget &target, unsigned n_threads = 0);
+  void Clear();
+
+private:
+  void StartWorkers(unsigned n);
+  void Worker();
+  void RunBands(std::unique_lock<std::mutex> &lock);
+  void RenderBand(int band);
+
+  std::vector<Tri> m_tris;
+  std::vector<TriRasterPattern> m_patterns;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::vector<std::thread> m_workers;
+  TriRasterTarget m_target;
+  int m_n_bands;
+  int m_next_band;
+  int m_bands_done;
+  bool m_stop;
+};
+
+#endif  // __TRIRASTER_H__
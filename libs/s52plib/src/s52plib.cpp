@@ -135,10 +135,6 @@ GLint S52ring_shader_program;
 GLint S52Dash_shader_program;
 GLint S52AP_shader_program;
 
-//    Implement all lists
-#include <wx/listimpl.cpp>
-WX_DEFINE_LIST(TextObjList);
-
 //    Implement all arrays
 #include <wx/arrimpl.cpp>
 WX_DEFINE_OBJARRAY(ArrayOfNoshow);
@@ -313,6 +309,7 @@ s52plib::s52plib(const wxString &PLib, bool b_forceLegacy) {
 
   ledge = new int[2000];
   redge = new int[2000];
+  m_area_batch = false;
 
   //    Defaults
   m_VersionMajor = 3;
@@ -1777,6 +1774,7 @@ bool s52plib::RenderText(wxDC *pdc, S52_TextC *ptext, int x, int y,
     ptext->texobj = 0;    // This will leak, but only a little
     m_FinalTextScaleFactor = scale_factor;
 
+    FlushText();
     for (unsigned int i = 0; i < TXF_CACHE; i++) {
      s_txf[i].key = 0;
      s_txf[i].cache = 0;
@@ -1789,8 +1787,6 @@ bool s52plib::RenderText(wxDC *pdc, S52_TextC *ptext, int x, int y,
 #ifdef ocpnUSE_GL
 
     bool b_force_no_texfont = false;
-    if (ptext->bspecial_char)
-      b_force_no_texfont = true;
 
      //Fixme (dave)
     // We also do this the hard way for rotation of strings.  Very slow.
@@ -2177,19 +2173,14 @@ bool s52plib::RenderText(wxDC *pdc, S52_TextC *ptext, int x, int y,
       if (bdraw) {
 #if !defined(USE_ANDROID_GLES2) && !defined(ocpnUSE_GLSL)
 #else
-        glEnable(GL_BLEND);
-        glEnable(GL_TEXTURE_2D);
-
         wxColour wcolor = GetFontColour_PlugIn(_("ChartTexts"));
         f_cache->SetColor(wcolor);
 
         /* undo previous rotation to make text level */
         // glRotatef(vp->rotation*180/PI, 0, 0, -1);
 
+        //  Queued, drawn by FlushText()
         f_cache->RenderString(ptext->frmtd, xp, yp);
-
-        glDisable(GL_TEXTURE_2D);
-        glDisable(GL_BLEND);
 #endif
       }
     }
@@ -2308,17 +2299,8 @@ bool s52plib::RenderText(wxDC *pdc, S52_TextC *ptext, int x, int y,
 //    Return true if test_rect overlaps any rect in the current text rectangle
 //    list, except itself
 bool s52plib::CheckTextRectList(const wxRect &test_rect, S52_TextC *ptext) {
-  //    Iterate over the current object list, looking at rText
-
-  for (TextObjList::Node *node = m_textObjList.GetFirst(); node;
-       node = node->GetNext()) {
-    wxRect *pcurrent_rect = &(node->GetData()->rText);
-
-    if (pcurrent_rect->Intersects(test_rect)) {
-      if (node->GetData() != ptext) return true;
-    }
-  }
-  return false;
+  //    Only the texts placed in the grid cells covered by test_rect are tested
+  return m_textGrid.Overlaps(test_rect, ptext);
 }
 
 bool s52plib::TextRenderCheck(ObjRazRules *rzRules) {
@@ -2509,22 +2491,11 @@ int s52plib::RenderT_All(ObjRazRules *rzRules, Rules *rules,
     } else
       text->rText = rect;
 
-    //      If this text was actually drawn, add a pointer to its rect to the
-    //      de-clutter list if it doesn't already exist
+    //      If this text was actually drawn, add it to the de-clutter grid.
+    //      A text already placed in this frame follows its updated rect.
     if (m_bDeClutterText) {
-      if (bwas_drawn) {
-        bool b_found = false;
-        for (TextObjList::Node *node = m_textObjList.GetFirst(); node;
-             node = node->GetNext()) {
-          S52_TextC *oc = node->GetData();
-
-          if (oc == text) {
-            if (!b_dupok) b_found = true;
-            break;
-          }
-        }
-        if (!b_found) m_textObjList.Append(text);
-      }
+      if (bwas_drawn || m_textGrid.IsPlaced(text))
+        m_textGrid.Place(text, text->rText);
     }
 
     //  Update the object Bounding box
@@ -6990,437 +6961,80 @@ bool s52plib::inter_tri_rect(wxPoint *ptp, render_canvas_parms *pb_spec) {
 //----------------------------------------------------------------------------------
 int s52plib::dda_tri(wxPoint *ptp, S52color *c, render_canvas_parms *pb_spec,
                      render_canvas_parms *pPatt_spec) {
-  unsigned char r = 0;
-  unsigned char g = 0;
-  unsigned char b = 0;
-
   if (!inter_tri_rect(ptp, pb_spec)) return 0;
 
+  TriRaster::Tri tri;
+  for (int i = 0; i < 3; i++) {
+    tri.x[i] = ptp[i].x;
+    tri.y[i] = ptp[i].y;
+  }
+  tri.c[0] = tri.c[1] = tri.c[2] = 0;
   if (NULL != c) {
     if (pb_spec->b_revrgb) {
-      r = c->R;
-      g = c->G;
-      b = c->B;
+      tri.c[0] = c->B;
+      tri.c[1] = c->G;
+      tri.c[2] = c->R;
     } else {
-      b = c->R;
-      g = c->G;
-      r = c->B;
-    }
-  }
-
-  //      Color Debug
-  /*    int fc = rand();
-   b = fc & 0xff;
-   g = fc & 0xff;
-   r = fc & 0xff;
-   */
-
-  int color_int = 0;
-  if (NULL != c) color_int = ((r) << 16) + ((g) << 8) + (b);
-
-  //      Determine ymin and ymax indices
-
-  int ymax = ptp[0].y;
-  int ymin = ymax;
-  int xmin, xmax, xmid, ymid;
-  int imin = 0;
-  int imax = 0;
-  int imid;
-
-  for (int ip = 1; ip < 3; ip++) {
-    if (ptp[ip].y > ymax) {
-      imax = ip;
-      ymax = ptp[ip].y;
-    }
-    if (ptp[ip].y <= ymin) {
-      imin = ip;
-      ymin = ptp[ip].y;
-    }
-  }
-
-  imid = 3 - (imin + imax);  // do the math...
-
-  xmax = ptp[imax].x;
-  xmin = ptp[imin].x;
-  xmid = ptp[imid].x;
-  ymid = ptp[imid].y;
-
-  //      Create edge arrays using fast integer DDA
-  int m, x, dy, count;
-  bool cw;
-
-  if ((abs(xmax - xmin) > 32768) || (abs(xmid - xmin) > 32768) ||
-      (abs(xmax - xmid) > 32768) || (abs(ymax - ymin) > 32768) ||
-      (abs(ymid - ymin) > 32768) || (abs(ymax - ymid) > 32768) ||
-      (xmin > 32768) || (xmid > 32768)) {
-    dy = (ymax - ymin);
-    if (dy) {
-      m = (xmax - xmin) << 8;
-      m /= dy;
-
-      x = xmin << 8;
-
-      for (count = ymin; count <= ymax; count++) {
-        if ((count >= 0) && (count < 1500)) ledge[count] = x >> 8;
-        x += m;
-      }
-    }
-
-    dy = (ymid - ymin);
-    if (dy) {
-      m = (xmid - xmin) << 8;
-      m /= dy;
-
-      x = xmin << 8;
-
-      for (count = ymin; count <= ymid; count++) {
-        if ((count >= 0) && (count < 1500)) redge[count] = x >> 8;
-        x += m;
-      }
-    }
-
-    dy = (ymax - ymid);
-    if (dy) {
-      m = (xmax - xmid) << 8;
-      m /= dy;
-
-      x = xmid << 8;
-
-      for (count = ymid; count <= ymax; count++) {
-        if ((count >= 0) && (count < 1500)) redge[count] = x >> 8;
-        x += m;
-      }
-    }
-
-    double ddfSum = 0;
-    //      Check the triangle edge winding direction
-    ddfSum += (xmin / 1) * (ymax / 1) - (ymin / 1) * (xmax / 1);
-    ddfSum += (xmax / 1) * (ymid / 1) - (ymax / 1) * (xmid / 1);
-    ddfSum += (xmid / 1) * (ymin / 1) - (ymid / 1) * (xmin / 1);
-    cw = ddfSum < 0;
-
-  } else {
-    dy = (ymax - ymin);
-    if (dy) {
-      m = (xmax - xmin) << 16;
-      m /= dy;
-
-      x = xmin << 16;
-
-      for (count = ymin; count <= ymax; count++) {
-        if ((count >= 0) && (count < 1500)) ledge[count] = x >> 16;
-        x += m;
-      }
-    }
-
-    dy = (ymid - ymin);
-    if (dy) {
-      m = (xmid - xmin) << 16;
-      m /= dy;
-
-      x = xmin << 16;
-
-      for (count = ymin; count <= ymid; count++) {
-        if ((count >= 0) && (count < 1500)) redge[count] = x >> 16;
-        x += m;
-      }
-    }
-
-    dy = (ymax - ymid);
-    if (dy) {
-      m = (xmax - xmid) << 16;
-      m /= dy;
-
-      x = xmid << 16;
-
-      for (count = ymid; count <= ymax; count++) {
-        if ((count >= 0) && (count < 1500)) redge[count] = x >> 16;
-        x += m;
-      }
-    }
-
-    //      Check the triangle edge winding direction
-    long dfSum = 0;
-    dfSum += xmin * ymax - ymin * xmax;
-    dfSum += xmax * ymid - ymax * xmid;
-    dfSum += xmid * ymin - ymid * xmin;
-
-    cw = dfSum < 0;
-
-  }  // else
-
-  //      if cw is true, redge is actually on the right
-
-  int y1 = ymax;
-  int y2 = ymin;
-
-  int ybt = pb_spec->y;
-  int yt = pb_spec->y + pb_spec->height;
-
-  if (y1 > yt) y1 = yt;
-  if (y1 < ybt) y1 = ybt;
-
-  if (y2 > yt) y2 = yt;
-  if (y2 < ybt) y2 = ybt;
-
-  int lclip = pb_spec->lclip;
-  int rclip = pb_spec->rclip;
-  if (y1 == y2) return 0;
-
-  //              Clip the triangle
-  if (cw) {
-    for (int iy = y2; iy <= y1; iy++) {
-      if (ledge[iy] < lclip) {
-        if (redge[iy] < lclip)
-          ledge[iy] = -1;
-        else
-          ledge[iy] = lclip;
-      }
-
-      if (redge[iy] > rclip) {
-        if (ledge[iy] > rclip)
-          ledge[iy] = -1;
-        else
-          redge[iy] = rclip;
-      }
-    }
-  } else {
-    for (int iy = y2; iy <= y1; iy++) {
-      if (redge[iy] < lclip) {
-        if (ledge[iy] < lclip)
-          ledge[iy] = -1;
-        else
-          redge[iy] = lclip;
-      }
-
-      if (ledge[iy] > rclip) {
-        if (redge[iy] > rclip)
-          ledge[iy] = -1;
-        else
-          ledge[iy] = rclip;
-      }
+      tri.c[0] = c->R;
+      tri.c[1] = c->G;
+      tri.c[2] = c->B;
     }
   }
 
-  //              Fill the triangle
-
-  int ya = y2;
-  int yb = y1;
-
-  unsigned char *pix_buff = pb_spec->pix_buff;
-
-  int patt_size_x = 0, patt_size_y = 0, patt_pitch = 0;
-  unsigned char *patt_s0 = NULL;
+  TriRasterPattern patt;
   if (pPatt_spec) {
-    patt_size_y = pPatt_spec->height;
-    patt_size_x = pPatt_spec->width;
-    patt_pitch = pPatt_spec->pb_pitch;
-    patt_s0 = pPatt_spec->pix_buff;
-
-    if (patt_size_y == 0) /* integer division by this value below */
-      return false;
-  }
-
-  if (pb_spec->depth == 24) {
-    for (int iyp = ya; iyp < yb; iyp++) {
-      if ((iyp >= ybt) && (iyp < yt)) {
-        int yoff = (iyp - pb_spec->y) * pb_spec->pb_pitch;
-
-        unsigned char *py = pix_buff + yoff;
-
-        int ix, ixm;
-        if (cw) {
-          ix = ledge[iyp];
-          ixm = redge[iyp];
-        } else {
-          ixm = ledge[iyp];
-          ix = redge[iyp];
-        }
-
-        if (ledge[iyp] != -1) {
-          //    This would be considered a failure of the dda algorithm
-          //    Happens on very high zoom, with very large triangles.
-          //    The integers of the dda algorithm don't have enough bits...
-          //    Anyway, just ignore this triangle if it happens
-          if (ix > ixm) continue;
-
-          int xoff = (ix - pb_spec->x) * 3;
-
-          unsigned char *px = py + xoff;
-
-          if (pPatt_spec)  // Pattern
-          {
-            int y_stagger = (iyp - pPatt_spec->y) / patt_size_y;
-            int x_stagger_off = 0;
-            if ((y_stagger & 1) && pPatt_spec->b_stagger)
-              x_stagger_off = pPatt_spec->width / 2;
-
-            int patt_y = abs((iyp - pPatt_spec->y)) % patt_size_y;
-
-            unsigned char *pp0 = patt_s0 + (patt_y * patt_pitch);
-
-            while (ix <= ixm) {
-              int patt_x =
-                  abs(((ix - pPatt_spec->x) + x_stagger_off) % patt_size_x);
-
-              unsigned char *pp = pp0 + (patt_x * 4);
-              unsigned char alpha = pp[3];
-              double da = (double)alpha / 256.;
-
-              unsigned char r = (unsigned char)(*px * (1.0 - da) + pp[0] * da);
-              unsigned char g =
-                  (unsigned char)(*(px + 1) * (1.0 - da) + pp[1] * da);
-              unsigned char b =
-                  (unsigned char)(*(px + 2) * (1.0 - da) + pp[2] * da);
-
-              *px++ = r;
-              *px++ = g;
-              *px++ = b;
-              ix++;
-            }
-          }
-
-          else  // No Pattern
-          {
-#if defined(__WXGTK__) && defined(__INTEL__)
-#define memset3(dest, value, count)       \
-  __asm__ __volatile__(                   \
-      "cmp $0,%2\n\t"                     \
-      "jg 2f\n\t"                         \
-      "je 3f\n\t"                         \
-      "jmp 4f\n\t"                        \
-      "2:\n\t"                            \
-      "movl  %0,(%1)\n\t"                 \
-      "add $3,%1\n\t"                     \
-      "dec %2\n\t"                        \
-      "jnz 2b\n\t"                        \
-      "3:\n\t"                            \
-      "movb %b0,(%1)\n\t"                 \
-      "inc %1\n\t"                        \
-      "movb %h0,(%1)\n\t"                 \
-      "inc %1\n\t"                        \
-      "shr $16,%0\n\t"                    \
-      "movb %b0,(%1)\n\t"                 \
-      "4:\n\t"                            \
-      :                                   \
-      : "a"(value), "D"(dest), "r"(count) \
-      :);
-
-            int count = ixm - ix;
-            memset3(px, color_int, count)
-#else
-
-            while (ix <= ixm) {
-              *px++ = b;
-              *px++ = g;
-              *px++ = r;
-
-              ix++;
-            }
-#endif
-          }
-        }
-      }
-    }
+    patt.pix_buff = pPatt_spec->pix_buff;
+    patt.pb_pitch = pPatt_spec->pb_pitch;
+    patt.x = pPatt_spec->x;
+    patt.y = pPatt_spec->y;
+    patt.width = pPatt_spec->width;
+    patt.height = pPatt_spec->height;
+    patt.b_stagger = pPatt_spec->b_stagger;
+  }
+
+  //  Batched areas are drawn by FlushAreaBatch(), the pattern spec
+  //  origin is copied since it moves from one object to the next
+  if (m_area_batch) {
+    tri.pattern = pPatt_spec ? m_area_raster.AddPattern(patt) : -1;
+    m_area_raster.Add(tri);
+    return true;
   }
 
-  if (pb_spec->depth == 32) {
-    assert(ya <= yb);
-
-    for (int iyp = ya; iyp < yb; iyp++) {
-      if ((iyp >= ybt) && (iyp < yt)) {
-        int yoff = (iyp - pb_spec->y) * pb_spec->pb_pitch;
-
-        unsigned char *py = pix_buff + yoff;
-
-        int ix, ixm;
-        if (cw) {
-          ix = ledge[iyp];
-          ixm = redge[iyp];
-        } else {
-          ixm = ledge[iyp];
-          ix = redge[iyp];
-        }
-
-        if (ledge[iyp] != -1) {
-          //    This would be considered a failure of the dda algorithm
-          //    Happens on very high zoom, with very large triangles.
-          //    The integers of the dda algorithm don't have enough bits...
-          //    Anyway, just ignore this triangle if it happens
-          if (ix > ixm) continue;
-
-          int xoff = (ix - pb_spec->x) * pb_spec->depth / 8;
-
-          unsigned char *px = py + xoff;
-
-          if (pPatt_spec)  // Pattern
-          {
-            int y_stagger = (iyp - pPatt_spec->y) / patt_size_y;
-
-            int x_stagger_off = 0;
-            if ((y_stagger & 1) && pPatt_spec->b_stagger)
-              x_stagger_off = pPatt_spec->width / 2;
-
-            int patt_y = abs((iyp - pPatt_spec->y)) % patt_size_y;
-
-            unsigned char *pp0 = patt_s0 + (patt_y * patt_pitch);
-
-            while (ix <= ixm) {
-              int patt_x =
-                  abs(((ix - pPatt_spec->x) + x_stagger_off) % patt_size_x);
-              /*
-               if(pPatt_spec->depth == 24)
-               {
-               unsigned char *pp = pp0 + (patt_x * 3);
+  TriRasterTarget target;
+  target.pix_buff = pb_spec->pix_buff;
+  target.pb_pitch = pb_spec->pb_pitch;
+  target.depth = pb_spec->depth;
+  target.x = pb_spec->x;
+  target.y = pb_spec->y;
+  target.width = pb_spec->width;
+  target.height = pb_spec->height;
+  target.lclip = pb_spec->lclip;
+  target.rclip = pb_spec->rclip;
 
-               //  Todo    This line assumes unused_color is always 0,0,0
-               if( pp[0] && pp[1] && pp[2] ) {
-               *px++ = *pp++;
-               *px++ = *pp++;
-               *px++ = *pp++;
-               px++;
-               } else {
-               px += 4;
-               //                                                      pp += 4;
-               }
-               }
-               else
-               */
-              {
-                unsigned char *pp = pp0 + (patt_x * 4);
-                unsigned char alpha = pp[3];
-                if (alpha > 128) {
-                  double da = (double)alpha / 256.;
+  TriRaster::FillTri(tri, target, pPatt_spec ? &patt : NULL);
+  return true;
+}
 
-                  unsigned char r = (unsigned char)(pp[0] * da);
-                  unsigned char g = (unsigned char)(pp[1] * da);
-                  unsigned char b = (unsigned char)(pp[2] * da);
+void s52plib::BeginAreaBatch() {
+  m_area_raster.Clear();
+  m_area_batch = true;
+}
 
-                  *px++ = r;
-                  *px++ = g;
-                  *px++ = b;
-                  px++;
-                } else
-                  px += 4;
-              }
-              ix++;
-            }
-          }
+void s52plib::FlushAreaBatch(render_canvas_parms *pb_spec) {
+  m_area_batch = false;
 
-          else  // No Pattern
-          {
-            int *pxi = (int *)px;
-            while (ix <= ixm) {
-              *pxi++ = color_int;
-              ix++;
-            }
-          }
-        }
-      }
-    }
-  }
+  TriRasterTarget target;
+  target.pix_buff = pb_spec->pix_buff;
+  target.pb_pitch = pb_spec->pb_pitch;
+  target.depth = pb_spec->depth;
+  target.x = pb_spec->x;
+  target.y = pb_spec->y;
+  target.width = pb_spec->width;
+  target.height = pb_spec->height;
+  target.lclip = pb_spec->lclip;
+  target.rclip = pb_spec->rclip;
 
-  return true;
+  m_area_raster.Render(target);
 }
 
 //----------------------------------------------------------------------------------
@@ -7456,9 +7070,6 @@ inline int s52plib::dda_trap(wxPoint *segs, int lseg, int rseg, int ytop,
   //      int debug = 0;
   int ret_val = 0;
 
-  int color_int = 0;
-  if (NULL != c) color_int = ((r) << 16) + ((g) << 8) + (b);
-
   //      Create edge arrays using fast integer DDA
 
   int lclip = pb_spec->lclip;
@@ -7716,41 +7327,7 @@ inline int s52plib::dda_trap(wxPoint *segs, int lseg, int rseg, int ytop,
 
           else  // No Pattern
           {
-#if defined(__WXGTK__WITH_OPTIMIZE_0) && defined(__INTEL__)
-#define memset3d(dest, value, count)      \
-  __asm__ __volatile__(                   \
-      "cmp $0,%2\n\t"                     \
-      "jg ld0\n\t"                        \
-      "je ld1\n\t"                        \
-      "jmp ld2\n\t"                       \
-      "ld0:\n\t"                          \
-      "movl  %0,(%1)\n\t"                 \
-      "add $3,%1\n\t"                     \
-      "dec %2\n\t"                        \
-      "jnz ld0\n\t"                       \
-      "ld1:\n\t"                          \
-      "movb %b0,(%1)\n\t"                 \
-      "inc %1\n\t"                        \
-      "movb %h0,(%1)\n\t"                 \
-      "inc %1\n\t"                        \
-      "shr $16,%0\n\t"                    \
-      "movb %b0,(%1)\n\t"                 \
-      "ld2:\n\t"                          \
-      :                                   \
-      : "a"(value), "D"(dest), "r"(count) \
-      :);
-            int count = ixm - ix;
-            memset3d(px, color_int, count)
-#else
-
-            while (ix <= ixm) {
-              *px++ = b;
-              *px++ = g;
-              *px++ = r;
-
-              ix++;
-            }
-#endif
+            TriRaster::FillSpan(px, ixm - ix + 1, 24, b, g, r);
           }
         }
       }
@@ -7829,11 +7406,7 @@ inline int s52plib::dda_trap(wxPoint *segs, int lseg, int rseg, int ytop,
 
           else  // No Pattern
           {
-            int *pxi = (int *)px;
-            while (ix <= ixm) {
-              *pxi++ = color_int;
-              ix++;
-            }
+            TriRaster::FillSpan(px, ixm - ix + 1, 32, b, g, r);
           }
         }
       }
@@ -10004,7 +9577,17 @@ void s52plib::SetQualityOfData(bool val) {
 
 void s52plib::ClearTextList(void) {
   //      Clear the current text rectangle list
-  m_textObjList.Clear();
+  m_textGrid.Clear();
+}
+
+void s52plib::FlushText(void) {
+  for (unsigned int i = 0; i < TXF_CACHE; i++) {
+    if (s_txf[i].key && s_txf[i].cache) s_txf[i].cache->Flush();
+  }
+}
+
+unsigned int s52plib::TakeTextDrawCount(void) {
+  return TexFont::TakeDrawCount();
 }
 
 bool s52plib::EnableGLLS(bool b_enable) {
@@ -10014,24 +9597,7 @@ bool s52plib::EnableGLLS(bool b_enable) {
 }
 
 void s52plib::AdjustTextList(int dx, int dy, int screenw, int screenh) {
-  return;
-  wxRect rScreen(0, 0, screenw, screenh);
-  //    Iterate over the text rectangle list
-  //        1.  Apply the specified offset to the list elements
-  //        2.. Remove any list elements that are off screen after applied
-  //        offset
-
-  TextObjList::Node *node = m_textObjList.GetFirst();
-  TextObjList::Node *next;
-  while (node) {
-    next = node->GetNext();
-    wxRect *pcurrent = &(node->GetData()->rText);
-    pcurrent->Offset(dx, dy);
-    if (!pcurrent->Intersects(rScreen)) {
-      m_textObjList.DeleteNode(node);
-    }
-    node = next;
-  }
+  //    Text rectangles are rebuilt on every frame, nothing to adjust
 }
 
 bool s52plib::GetPointPixArray(ObjRazRules *rzRules, wxPoint2DDouble *pd,
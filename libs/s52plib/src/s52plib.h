@@ -35,6 +35,8 @@ class wxGLContext;
 #include "DepthFont.h"
 #include "chartsymbols.h"
 #include "TexFont.h"
+#include "TextDeclutter.h"
+#include "TriRaster.h"
 
 #include <wx/dcgraph.h>  // supplemental, for Mac
 #include <unordered_map>
@@ -107,8 +109,6 @@ WX_DECLARE_HASH_MAP(wxString, Rule *, wxStringHash, wxStringEqual, RuleHash);
 
 WX_DEFINE_SORTED_ARRAY(LUPrec *, wxArrayOfLUPrec);
 
-WX_DECLARE_LIST(S52_TextC, TextObjList);
-
 struct CARC_Buffer {
   unsigned char color[3][4];
   float line_width[3];
@@ -243,6 +243,10 @@ public:
   void PrepareForRender(void);
   void AdjustTextList(int dx, int dy, int screenw, int screenh);
   void ClearTextList(void);
+  //    Text overlap tests done while decluttering the previous frame
+  size_t GetTextCollisionTests() const {
+    return m_textGrid.GetLastFrameTestCount();
+  }
   int SetLineFeaturePriority(ObjRazRules *rzRules, int npriority);
   void FlushSymbolCaches(const ChartCtx& ctx);
 
@@ -251,6 +255,9 @@ public:
   int RenderObjectToDCText(wxDC *pdc, ObjRazRules *rzRules);
   int RenderAreaToDC(wxDC *pdc, ObjRazRules *rzRules,
                      render_canvas_parms *pb_spec);
+  //    Queue the area fills of RenderAreaToDC(), and draw them in parallel
+  void BeginAreaBatch();
+  void FlushAreaBatch(render_canvas_parms *pb_spec);
 
   // Accessors
   bool GetShowSoundings() { return m_bShowSoundg; }
@@ -311,6 +318,10 @@ public:
   int RenderObjectToGL(const wxGLContext &glcc, ObjRazRules *rzRules);
   int RenderAreaToGL(const wxGLContext &glcc, ObjRazRules *rzRules);
   int RenderObjectToGLText(const wxGLContext &glcc, ObjRazRules *rzRules);
+  //    Draw the text queued by the texture fonts, at the end of a pass
+  void FlushText(void);
+  //    Text draw calls since the last call
+  unsigned int TakeTextDrawCount(void);
 
   bool EnableGLLS(bool benable);
 
@@ -549,10 +560,13 @@ private:
   int *ledge;
   int *redge;
 
+  TriRaster m_area_raster;
+  bool m_area_batch;
+
   int m_colortable_index;
   int m_colortable_index_save;
 
-  TextObjList m_textObjList;
+  TextDeclutterGrid m_textGrid;
 
   wxString m_ColorScheme;
 
@@ -30,6 +30,8 @@
 class AisBitstring {
 public:
   AisBitstring(const char *str);
+  /** Construct from already decoded 6-bit values, see AisVdmParser. */
+  AisBitstring(const unsigned char *sixbit, int len);
   unsigned char to_6bit(const char c);
 
   /// sp is starting bit, 1-based
@@ -28,6 +28,7 @@
 #include <map>
 #include <unordered_map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <wx/datetime.h>
@@ -38,6 +39,7 @@
 #include "model/ais_bitstring.h"
 #include "model/ais_defs.h"
 #include "model/ais_target_data.h"
+#include "model/ais_vdm_parser.h"
 #include "model/comm_navmsg.h"
 #include "model/ocpn_types.h"
 #include "model/select.h"
@@ -211,6 +213,9 @@ private:
   int nsentences;
   int isentence;
   wxString sentence_accumulator;
+  AisVdmParser m_vdm_parser;
+  AisVdmMessage m_vdm_msg;
+  std::string m_vdm_text;  ///< Reused ASCII copy of the sentence
   bool m_OK;
 
   std::shared_ptr<AisTargetData> m_pLatestTargetData;
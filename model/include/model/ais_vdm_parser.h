@@ -0,0 +1,88 @@
+/**************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file ais_vdm_parser.h
+ * AIVDM/AIVDO sentence front end: checksum, field split, multipart
+ * reassembly and 6-bit payload decoding without heap allocations.
+ */
+
+#ifndef _AIS_VDM_PARSER_H__
+#define _AIS_VDM_PARSER_H__
+
+#include <string_view>
+
+#include "model/ais_bitstring.h"
+
+/** Result of feeding one sentence to AisVdmParser. */
+enum class AisVdmResult {
+  kComplete,       ///< A whole message is available
+  kPartial,        ///< Part of a multipart message stored, more to come
+  kNotVdm,         ///< Not a VDM or VDO sentence
+  kChecksumBad,    ///< Missing or wrong checksum
+  kMalformed,      ///< Bad fields or payload characters
+  kTooLong,        ///< Reassembled payload exceeds AIS_MAX_MESSAGE_LEN
+  kOutOfSequence,  ///< Part does not continue a pending message, dropped
+};
+
+/** A complete AIS message, payload as 6-bit values. Plain old data. */
+struct AisVdmMessage {
+  char talker[3];  ///< "AI", "BS", ... zero terminated
+  bool own_ship;   ///< VDO, not VDM
+  char channel;    ///< 'A', 'B', '1', '2' or 0 if absent
+  int fill_bits;
+  int payload_len;  ///< Number of 6-bit symbols
+  unsigned char payload[AIS_MAX_MESSAGE_LEN];
+
+  int GetBitCount() const { return payload_len * 6 - fill_bits; }
+  int GetMessageId() const { return payload_len ? payload[0] : -1; }
+};
+
+/**
+ * Incremental AIVDM/AIVDO parser. Multipart messages are reassembled per
+ * sequential message id, so interleaved multipart messages from combined
+ * feeds do not corrupt each other.
+ */
+class AisVdmParser {
+public:
+  AisVdmParser() { Reset(); }
+
+  /** Feed one sentence, trailing CR/LF accepted. msg is set on kComplete. */
+  AisVdmResult Parse(std::string_view sentence, AisVdmMessage &msg);
+
+  /** Drop all pending multipart messages. */
+  void Reset();
+
+  /** True if sentence has a '*hh' checksum matching its contents. */
+  static bool ChecksumOk(std::string_view sentence);
+
+  /** 6-bit value of an armored payload character, 0xff if invalid. */
+  static unsigned char SixBit(char c);
+
+private:
+  struct Pending {
+    int total;  ///< 0 if slot unused
+    int next;
+    int len;
+    unsigned char payload[AIS_MAX_MESSAGE_LEN];
+  };
+
+  /** Slot per sequential message id 0-9, last one for an empty id. */
+  Pending m_pending[11];
+};
+
+#endif  // _AIS_VDM_PARSER_H__
@@ -74,14 +74,16 @@ public:
   NMEA0183 m_NMEA0183;  // Used to parse messages from NMEA threads
 
   // NMEA2000 decoding, by PGN
-  bool DecodePGN129025(std::vector<unsigned char> v,  NavData& temp_data);
-  bool DecodePGN129026(std::vector<unsigned char> v,  NavData& temp_data);
-  bool DecodePGN129029(std::vector<unsigned char> v,  NavData& temp_data);
-  bool DecodePGN127250(std::vector<unsigned char> v,  NavData& temp_data);
-  bool DecodePGN129540(std::vector<unsigned char> v,  NavData& temp_data);
+  bool DecodePGN129025(const std::vector<unsigned char>& v,  NavData& temp_data);
+  bool DecodePGN129026(const std::vector<unsigned char>& v,  NavData& temp_data);
+  bool DecodePGN129029(const std::vector<unsigned char>& v,  NavData& temp_data);
+  bool DecodePGN127250(const std::vector<unsigned char>& v,  NavData& temp_data);
+  bool DecodePGN129540(const std::vector<unsigned char>& v,  NavData& temp_data);
 
   // SignalK
   bool DecodeSignalK(std::string s, NavData& temp_data);
+  /** Decode an already parsed SignalK delta. */
+  bool DecodeSignalK(const rapidjson::Value& root, NavData& temp_data);
   void handleUpdate(const rapidjson::Value &update, NavData& temp_data);
   void updateItem(const rapidjson::Value &item, wxString &sfixtime, NavData& temp_data);
   bool updateNavigationPosition(const rapidjson::Value &value,
@@ -33,6 +33,8 @@
 #include <netinet/in.h>
 #endif
 
+#include "rapidjson/fwd.h"
+
 #include "observable.h"
 
 struct N2kPGN {
@@ -329,14 +331,30 @@ public:
         context(_context),
         raw_message(_raw_message){};
 
+  SignalkMsg(std::string _context_self, std::string _context,
+             std::string _raw_message, std::string _iface,
+             std::shared_ptr<const rapidjson::Document> _root)
+      : SignalkMsg(_context_self, _context, _raw_message, _iface) {
+    root = _root;
+  }
+
   virtual ~SignalkMsg() = default;
 
+  /**
+   * Return the parsed raw_message. It is parsed on the first call and
+   * shared by all later ones. Callers should check HasParseError().
+   */
+  std::shared_ptr<const rapidjson::Document> GetDocument() const;
+
   struct in_addr dest;
   struct in_addr src;
   std::string context_self;
   std::string context;
   std::string raw_message;
 
+  /** Document parsed from raw_message, null until first needed. */
+  mutable std::shared_ptr<const rapidjson::Document> root;
+
   std::string key() const { return std::string("signalK"); };
 };
 
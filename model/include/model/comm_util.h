@@ -26,10 +26,29 @@
 #ifndef _COMM_UTIL_H
 #define _COMM_UTIL_H
 
+#include "rapidjson/fwd.h"
+
 #include "model/comm_navmsg.h"
 
+class wxJSONValue;
+
 bool StopAndRemoveCommDriver(std::string ident, NavAddr::Bus = NavAddr::Bus::Undef);
 
 wxString ProcessNMEA4Tags(wxString& msg);
 
+/**
+ * Convert an already parsed SignalK document to the wxJSONValue form
+ * used by the plugin API, with the same value types as wxJSONReader.
+ */
+void SignalkToJson(const rapidjson::Value& value, wxJSONValue& json);
+
+/**
+ * Extract the top level "version", "self" and "context" strings of a
+ * SignalK message without building a document. Scanning stops at the
+ * context, members which are not found are left unchanged.
+ * @return false if the message is not well-formed up to that point.
+ */
+bool SignalkScanIds(const std::string& msg, std::string& version,
+                    std::string& self, std::string& context);
+
 #endif  // _COMM_UTIL_H
@@ -150,6 +150,25 @@ extern "C" void toEQUIRECT(double lat, double lon, double lat0, double lon0,
 extern "C" void fromEQUIRECT(double x, double y, double lat0, double lon0,
                              double *lat, double *lon);
 
+//    Batch projections, n points from/to separate coordinate arrays
+extern "C" void toSM_batch(int n, const double *lat, const double *lon,
+                           double lat0, double lon0, double *x, double *y);
+extern "C" void toSMcache_batch(int n, const double *lat, const double *lon,
+                                double y30, double lon0, double *x, double *y);
+extern "C" void fromSM_batch(int n, const double *x, const double *y,
+                             double lat0, double lon0, double *lat,
+                             double *lon);
+extern "C" void toTM_batch(int n, const double *lat, const double *lon,
+                           float lat0, float lon0, double *x, double *y);
+extern "C" void toPOLY_batch(int n, const double *lat, const double *lon,
+                             double lat0, double lon0, double *x, double *y);
+extern "C" void toORTHO_batch(int n, const double *lat, const double *lon,
+                              double sin_phi0, double cos_phi0, double lon0,
+                              double *x, double *y);
+extern "C" void toSTEREO_batch(int n, const double *lat, const double *lon,
+                               double sin_phi0, double cos_phi0, double lon0,
+                               double *x, double *y);
+
 /// distance in nautical miles
 extern "C" void ll_gc_ll(double lat, double lon, double crs, double dist,
                          double *dlat, double *dlon);
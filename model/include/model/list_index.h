@@ -0,0 +1,93 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Sorted and filtered index of list control rows
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#ifndef _LIST_INDEX_H__
+#define _LIST_INDEX_H__
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Sorted and filtered rows of a virtual list control.
+ *
+ * Each object is indexed with a name, prepared by the caller in the form
+ * used for filtering, typically lower case. Objects are kept sorted as
+ * they are added and removed, so a change does not sort the whole list.
+ * The rows are the objects whose name contains the filter.
+ */
+class ListIndex {
+public:
+  using Object = const void*;
+  using Entry = std::pair<Object, std::string>;
+  /** Sort order, false for objects which are equal. */
+  using Less = std::function<bool(Object, Object)>;
+
+  ListIndex();
+
+  /**
+   * Sort by less, or by name if less is empty. Equal objects keep the
+   * order they were added in.
+   */
+  void SetSort(const Less& less, bool descending);
+  /** Sort again, after the order of the objects changed. */
+  void Resort();
+
+  void Clear();
+  void Add(Object obj, const std::string& name);
+  bool Remove(Object obj);
+
+  /**
+   * Make the index hold exactly objects, adding, removing and moving only
+   * the objects which are new, gone or renamed. Other objects keep their
+   * position. Return true if anything changed.
+   */
+  bool Sync(const std::vector<Entry>& objects);
+
+  /** Show objects whose name contains filter, all if empty. */
+  void SetFilter(const std::string& filter);
+
+  /** Number of rows. */
+  size_t GetCount() const { return m_rows.size(); }
+  /** Object in row, nullptr if out of range. */
+  Object Get(long row) const;
+  /** Row of object, -1 if it is not shown. */
+  long Find(Object obj) const;
+
+  /** Number of objects, shown or not. */
+  size_t GetSize() const { return m_entries.size(); }
+
+private:
+  bool Before(const Entry& a, const Entry& b) const;
+  bool IsShown(const Entry& entry) const;
+  size_t Insert(Entry&& entry);
+  void UpdateRows();
+
+  std::vector<Entry> m_entries;
+  std::vector<Object> m_rows;
+  std::string m_filter;
+  Less m_less;
+  bool m_descending;
+};
+
+#endif  // _LIST_INDEX_H__
@@ -25,10 +25,16 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <thread>
 
 #include <wx/log.h>
 
@@ -51,23 +57,68 @@
  * faster then the original wxLogMessage() and friends. They do not respect
  * wxLog's component levels and trace masks, logging anything with a
  * level <= wxLog::GetLogLevel().
+ *
+ * Hot paths can use the rate limited variants, which log at most a given
+ * number of records per second from each call site:
+ *
+ *    LOG_DEBUG_LIMITED(10, "Got: %s", what);
  */
 
+/**
+ * Bounded lock free queue of formatted log lines with many producers and a
+ * single consumer, after Dmitry Vyukov's bounded MPMC queue. The slots are
+ * allocated up front: Push() claims one with a compare and swap and moves
+ * the line in, it neither allocates nor waits for the consumer.
+ */
+class LogQueue {
+public:
+  /** Room for at least capacity lines. */
+  LogQueue(size_t capacity);
+
+  /** Add line, from any thread. False and line untouched if full. */
+  bool Push(std::string&& line);
+
+  /** Remove the oldest line, consumer thread only. False if empty. */
+  bool Pop(std::string& line);
+
+private:
+  struct Slot {
+    std::atomic<size_t> seq;  ///< Position it can be pushed to, or + 1 popped
+    std::string line;
+  };
+
+  std::unique_ptr<Slot[]> m_slots;
+  size_t m_mask;
+  std::atomic<size_t> m_push_pos;
+  size_t m_pop_pos;  ///< Consumer only
+};
+
 /**
  * Customized logger class appending to a file providing:
  *   - Millisecond timestamps
  *   - Consistent tagging WARNING, ERROR, MESSAGE etc.
  *   - Filename:line info.
+ *
+ * Records are formatted on the calling thread and queued, a background
+ * thread writes them in batches. Logging never waits for the disk, and
+ * records beyond kMaxPending queued ones are dropped and counted instead.
+ * Fatal errors are the exception, they wait for the queue to be written.
+ *
+ * When the file grows beyond max_size it is renamed to path.log, replacing
+ * any previous one, and a new file is started.
  */
 class OcpnLog : public wxLog {
 public:
   static const wxLogLevel LOG_BADLEVEL;
+  static const size_t kDefaultMaxSize;
+  static const size_t kMaxPending;
 
-  /** Create logger appending to given filename. */
-  OcpnLog(const char* path);
+  /** Create logger appending to given filename, 0 max_size: no rotation */
+  OcpnLog(const char* path, size_t max_size = kDefaultMaxSize);
 
   virtual ~OcpnLog();
 
+  /** Wake up the writer, does not wait for it. */
   void Flush() override;
 
   void DoLogRecord(wxLogLevel level, const wxString& msg,
@@ -76,8 +127,47 @@ public:
   static wxLogLevel str2level(const char* string);
   static std::string level2str(wxLogLevel level);
 
+  /** Number of records dropped since start, queue full. */
+  unsigned long GetDropped() const { return m_dropped; }
+
 protected:
+  void Run();
+  void WriteQueued();
+  void Rotate();
+
   std::ofstream log;
+  std::string m_path;
+  size_t m_max_size;
+  size_t m_size;
+
+  LogQueue m_queue;
+  std::atomic<size_t> m_pending;
+  std::atomic<unsigned long> m_dropped;
+  unsigned long m_dropped_reported;
+
+  std::mutex m_wake_mutex;
+  std::condition_variable m_wake;
+  bool m_stop;  ///< Guarded by m_wake_mutex
+  std::thread m_writer;
+};
+
+/**
+ * Per call site state of the rate limited log macros: at most
+ * max_per_second records are let through each second, the number of
+ * suppressed ones is reported with the first record of the next second.
+ */
+class LogRateLimit {
+public:
+  LogRateLimit(unsigned max_per_second);
+
+  /** True if the record should be logged. */
+  bool Allow(unsigned& suppressed);
+
+private:
+  const unsigned m_max;
+  std::atomic<long long> m_start;
+  std::atomic<unsigned> m_count;
+  std::atomic<unsigned> m_suppressed;
 };
 
 /** Transient logger class, instantiated/used by the *LOG* macros. */
@@ -107,6 +197,20 @@ protected:
     }                                                                    \
   }
 
+#define DO_LOG_RATE_LIMITED(level, max_per_second, fmt, ...)                  \
+  {                                                                          \
+    if (level <= wxLog::GetLogLevel()) {                                     \
+      static LogRateLimit rate_limit_(max_per_second);                       \
+      unsigned suppressed_;                                                  \
+      if (rate_limit_.Allow(suppressed_)) {                                  \
+        if (suppressed_)                                                     \
+          Logger::logMessage(level, __FILE__, __LINE__,                      \
+                             "(%u similar records suppressed)", suppressed_); \
+        Logger::logMessage(level, __FILE__, __LINE__, fmt, ##__VA_ARGS__);   \
+      }                                                                      \
+    }                                                                        \
+  }
+
 #define _LOG(level)                 \
   if (level > wxLog::GetLogLevel()) \
     ;                               \
@@ -127,4 +231,11 @@ protected:
 #define LOG_WARNING(fmt, ...) DO_LOG_MESSAGE(wxLOG_Warning, fmt, ##__VA_ARGS__);
 #define LOG_ERROR(fmt, ...) DO_LOG_MESSAGE(wxLOG_Error, fmt, ##__VA_ARGS__);
 
+#define LOG_DEBUG_LIMITED(n, fmt, ...) \
+  DO_LOG_RATE_LIMITED(wxLOG_Debug, n, fmt, ##__VA_ARGS__);
+#define LOG_INFO_LIMITED(n, fmt, ...) \
+  DO_LOG_RATE_LIMITED(wxLOG_Info, n, fmt, ##__VA_ARGS__);
+#define LOG_MESSAGE_LIMITED(n, fmt, ...) \
+  DO_LOG_RATE_LIMITED(wxLOG_Message, n, fmt, ##__VA_ARGS__);
+
 #endif  // LOGGER_H
@@ -0,0 +1,59 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Read only or shared writable file mappings
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#ifndef _MAPPED_FILE_H__
+#define _MAPPED_FILE_H__
+
+#include <cstdint>
+#include <string>
+
+/**
+ * A whole file mapped in memory. Writable mappings are shared with other
+ * users of the file. The mapping has the size of the file when mapped, an
+ * empty file maps to no data.
+ */
+class MappedFile {
+public:
+  MappedFile();
+  ~MappedFile();
+
+  bool Map(const std::string& path, bool writable);
+  void Unmap();
+  /** Write changes of a writable mapping to disk. */
+  bool Sync();
+
+  unsigned char* GetData() const { return m_data; }
+  uint64_t GetSize() const { return m_size; }
+
+private:
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  unsigned char* m_data;
+  uint64_t m_size;
+#ifdef _WIN32
+  void* m_file;
+  void* m_map;
+#endif
+};
+
+#endif  // _MAPPED_FILE_H__
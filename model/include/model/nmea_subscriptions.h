@@ -0,0 +1,63 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  NMEA0183 sentence subscriptions of plugins
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+
+#ifndef _NMEA_SUBSCRIPTIONS_H__
+#define _NMEA_SUBSCRIPTIONS_H__
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Lookup table of the subscribers of each NMEA0183 sentence id.
+ *
+ * Subscribers are identified by an index, typically into the plugin
+ * array. The subscriber list of each id is built when subscribing, so
+ * that routing a sentence is a single lookup.
+ */
+class NmeaSubscriptions {
+public:
+  /**
+   * Subscription id of sentence: the last three characters of the address
+   * field, "RMC" for "$GPRMC,...", or the whole address of proprietary
+   * sentences, "PGRMZ" for "$PGRMZ,...". Empty if there is no address.
+   */
+  static std::string SentenceId(const std::string& sentence);
+
+  void Clear();
+
+  /**
+   * Subscribe to sentences with the given ids, or to all sentences if ids
+   * is empty. Subscribers are listed in the order added.
+   */
+  void Add(int subscriber, const std::vector<std::string>& ids);
+
+  /** Subscribers of a sentence id. */
+  const std::vector<int>& Get(const std::string& id) const;
+
+private:
+  std::vector<int> m_all;
+  std::unordered_map<std::string, std::vector<int>> m_by_id;
+};
+
+#endif  // _NMEA_SUBSCRIPTIONS_H__
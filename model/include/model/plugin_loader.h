@@ -29,6 +29,8 @@
 #define PLUGIN_LOADER_H_GUARD
 
 #include <functional>
+#include <string>
+#include <vector>
 
 #include <wx/wx.h>
 #include <wx/bitmap.h>
@@ -105,6 +107,8 @@ public:
   opencpn_plugin* m_pplugin;
   wxDynamicLibrary m_library;
   destroy_t* m_destroy_fn;
+  std::vector<std::string> m_nmea_ids;  //!< NMEA0183 sentences, empty: all
+  bool m_nmea_faulted;  //!< Crashed on NMEA0183 input, none until re-init
 };
 
 class LoadError {
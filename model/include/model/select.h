@@ -24,7 +24,10 @@
 #ifndef _SELECT_H__
 #define _SELECT_H__
 
+#include <vector>
+
 #include "select_item.h"
+#include "model/select_index.h"
 
 #include "model/track.h"
 #include "model/route.h"
@@ -94,6 +97,8 @@ public:
   bool DeleteAllPoints(void);
   bool DeleteSelectablePoint(void *data, int SeltypeToDelete);
   bool ModifySelectablePoint(float slat, float slon, void *data, int fseltype);
+  /** Move pSelItem, keeping the spatial index up to date. */
+  bool ModifySelectablePoint(float slat, float slon, SelectItem *pSelItem);
 
   //    Delete all selectable points in list by type
   bool DeleteAllSelectableTypePoints(int SeltypeToDelete);
@@ -108,7 +113,13 @@ private:
   // FIXME (leamas?) this is not model stuff.
   void CalcSelectRadius(SelectCtx& ctx);
 
+  wxSelectableItemListNode *AddItem(SelectItem *pSelItem, bool at_front);
+  void RemoveItem(SelectItem *pSelItem);
+  void FindCandidates(int fseltype, float slat, float slon,
+                      std::vector<SelectItem *> &candidates);
+
   SelectableItemList *pSelectList;
+  SelectIndex m_index;
   int pixelRadius;
   float selectRadius;
 };
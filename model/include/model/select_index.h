@@ -0,0 +1,118 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#ifndef _SELECT_INDEX_H__
+#define _SELECT_INDEX_H__
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "model/select_item.h"
+
+/**
+ * Lookup tables for the items owned by a Select list.
+ *
+ * Each selection type has a uniform lat/lon grid. A point is stored in
+ * the cell that contains it, and a segment in every cell its bounding
+ * box covers. Segments spanning too many cells, or the antimeridian, are
+ * kept in a per type list checked by every query. Items are also indexed
+ * by the objects they refer to, so that deleting or updating all items
+ * of a route, track or point does not walk the whole list.
+ *
+ * The index remembers the list position of each item, so candidates are
+ * returned in list order and the first hit is the same as a list walk.
+ */
+class SelectIndex {
+public:
+  SelectIndex(double cell_deg = 1.0 / 16);
+
+  /** Index item, which has been put at the front or back of the list. */
+  void Add(SelectItem *item, wxSelectableItemListNode *node, bool at_front);
+
+  /** Drop item from all tables. */
+  void Remove(SelectItem *item);
+
+  /** Re-bin item after its coordinates have been changed. */
+  void Move(SelectItem *item);
+
+  void Clear();
+
+  bool Contains(const SelectItem *item) const {
+    return m_entries.find(item) != m_entries.end();
+  }
+
+  /** The list node holding item, or nullptr if not indexed. */
+  wxSelectableItemListNode *GetNode(const SelectItem *item) const;
+
+  /**
+   * Items of seltype which may be within radius degrees of lat/lon, in
+   * list order. Returns false without touching out if the query window
+   * is too large to be worth it; the caller should then walk the list.
+   */
+  bool Query(int seltype, float lat, float lon, float radius,
+             std::vector<SelectItem *> &out) const;
+
+  /** Items of any type with data as m_pData1 or m_pData2. */
+  std::vector<SelectItem *> GetByData(const void *data) const;
+
+  /** Items of any type with owner as m_pData3. */
+  std::vector<SelectItem *> GetByOwner(const void *owner) const;
+
+  /** All items of seltype. */
+  std::vector<SelectItem *> GetByType(int seltype) const;
+
+  static bool IsSegmentType(int seltype);
+
+private:
+  struct Entry {
+    wxSelectableItemListNode *node;
+    int64_t seq;
+    bool large;
+    std::vector<int64_t> cells;
+  };
+
+  struct TypeIndex {
+    std::unordered_map<int64_t, std::vector<SelectItem *>> cells;
+    std::unordered_set<SelectItem *> large;
+    std::unordered_set<SelectItem *> items;
+  };
+
+  void Bin(SelectItem *item, Entry &entry);
+  void Unbin(SelectItem *item, Entry &entry);
+  int CellOf(double deg) const;
+  static int64_t Key(int ilat, int ilon) {
+    return (static_cast<int64_t>(ilat) << 32) ^ static_cast<uint32_t>(ilon);
+  }
+  static void Erase(std::vector<SelectItem *> &v, SelectItem *item);
+
+  double m_cell_deg;
+  int64_t m_front_seq;
+  int64_t m_back_seq;
+  std::unordered_map<const SelectItem *, Entry> m_entries;
+  std::unordered_map<int, TypeIndex> m_types;
+  std::unordered_map<const void *, std::vector<SelectItem *>> m_by_data;
+  std::unordered_map<const void *, std::unordered_set<SelectItem *>>
+      m_by_owner;
+};
+
+#endif  // _SELECT_INDEX_H__
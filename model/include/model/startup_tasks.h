@@ -0,0 +1,122 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Dependency ordered, timed startup tasks
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#ifndef _STARTUP_TASKS_H__
+#define _STARTUP_TASKS_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * A small task graph used to overlap the independent parts of startup.
+ *
+ * Tasks are added with the tasks they depend on, and run once all of
+ * them are done. Worker tasks run on a pool of threads and must not
+ * create or touch any wx GUI object. Main tasks run on the thread calling
+ * Wait() or WaitAll(), which should be the GUI thread.
+ *
+ * Code which still runs in sequence on the main thread can be timed with
+ * Begin() and End(). Such an inline stage implicitly depends on the
+ * previous one and on the tasks waited for since.
+ *
+ * All tasks and stages are timed. Report() lists them and the critical
+ * path, the chain of dependencies which ended last.
+ */
+class StartupTasks {
+public:
+  using Func = std::function<void()>;
+  enum class Where { kWorker, kMain };
+
+  StartupTasks();
+  ~StartupTasks();
+
+  /** Add a task, returns its id. Worker tasks may start at once. */
+  int Add(const std::string& name, Func func, const std::vector<int>& deps = {},
+          Where where = Where::kWorker);
+
+  /** Start the worker threads, 0 means one per hardware thread. */
+  void Start(unsigned n_workers = 0);
+
+  /** Run ready main tasks until task id is done. */
+  void Wait(int id);
+
+  /** Run ready main tasks until all tasks are done. */
+  void WaitAll();
+
+  /** Stop and join the worker threads once they are idle. */
+  void Stop();
+
+  /** Start timing an inline main thread stage. */
+  int Begin(const std::string& name);
+  void End(int id);
+
+  bool IsDone(int id);
+
+  /** Ids on the critical path, first to last. */
+  std::vector<int> CriticalPath();
+
+  /** Per task start and duration in ms, followed by the critical path. */
+  std::vector<std::string> Report();
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Task {
+    std::string name;
+    Func func;
+    std::vector<int> deps;
+    std::vector<int> dependents;
+    Where where;
+    int pending;
+    bool done;
+    bool failed;
+    std::string error;  ///< what() of the exception a failed task threw
+    Clock::time_point start;
+    Clock::time_point end;
+  };
+
+  void Worker();
+  void RunTask(std::unique_lock<std::mutex>& lock, int id);
+  void Complete(int id);
+  void Enqueue(int id);
+  bool RunOneMain(std::unique_lock<std::mutex>& lock);
+  long Millis(Clock::time_point t) const;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::vector<Task> m_tasks;
+  std::deque<int> m_worker_ready;
+  std::deque<int> m_main_ready;
+  std::vector<std::thread> m_workers;
+  std::vector<int> m_waited;
+  int m_last_inline;
+  bool m_stop;
+  Clock::time_point m_origin;
+};
+
+#endif  // _STARTUP_TASKS_H__
@@ -0,0 +1,83 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Station index of tide and current harmonics files
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#ifndef _STATION_INDEX_H__
+#define _STATION_INDEX_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "model/mapped_file.h"
+
+/** What a station list needs of a station, without its constituents. */
+struct StationIndexEntry {
+  double lat;
+  double lon;
+  int32_t ref_index;    ///< Record of the reference station, own if reference
+  int32_t time_zone;    ///< Minutes east of UTC, standard time
+  int32_t ht_time_off;  ///< Minutes
+  int32_t lt_time_off;
+  float ht_mpy;
+  float ht_off;
+  float lt_mpy;
+  float lt_off;
+  int32_t flood_dir;
+  int32_t ebb_dir;
+  int32_t current_depth;
+  uint32_t name;  ///< Offset in the name table
+  char type;      ///< 'T' or 'C' reference, 't' or 'c' subordinate, else 0
+  uint8_t have_offsets;
+  uint16_t reserved;
+  uint32_t reserved2;
+};
+
+/**
+ * Sidecar file listing the stations of a harmonics file, one fixed size
+ * entry per record, so the list is mapped instead of decoded at startup.
+ * An index is only used with the harmonics file size and time it was
+ * built from.
+ */
+class StationIndex {
+public:
+  /** Write an index, false on errors. */
+  static bool Write(const std::string& path, uint64_t source_size,
+                    int64_t source_time, const std::string& ident,
+                    const std::vector<StationIndexEntry>& entries,
+                    const std::vector<std::string>& names);
+
+  /** Map an index, false if missing or not built from this source. */
+  bool Open(const std::string& path, uint64_t source_size,
+            int64_t source_time);
+  void Close() { m_file.Unmap(); }
+
+  size_t GetCount() const;
+  const StationIndexEntry& GetEntry(size_t i) const;
+  const char* GetName(size_t i) const;
+  /** Version string of the harmonics file. */
+  std::string GetIdent() const;
+
+private:
+  MappedFile m_file;
+};
+
+#endif  // _STATION_INDEX_H__
@@ -0,0 +1,138 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Shared store of compressed raster chart textures
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#ifndef _TEX_CACHE_STORE_H__
+#define _TEX_CACHE_STORE_H__
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "model/mapped_file.h"
+
+struct TexCacheKey {
+  uint64_t chart;  ///< TexCacheStore::ChartKey() of the chart
+  uint32_t x;
+  uint32_t y;
+  uint16_t level;
+  uint16_t scheme;
+
+  bool operator==(const TexCacheKey& other) const {
+    return chart == other.chart && x == other.x && y == other.y &&
+           level == other.level && scheme == other.scheme;
+  }
+};
+
+/**
+ * Compressed texture tiles of all raster charts in two files.
+ *
+ * Tiles are appended to a data file. They are located through an open
+ * addressing hash table in an index file, which is memory mapped so that
+ * opening the store does not read it. Reads hand out the tile in place
+ * in the mapped data file. The mapping is renewed as the file grows, tiles
+ * beyond it and all tiles in 32 bit builds are read through the file.
+ *
+ * New tiles can be read at once, and are indexed in batches. A commit
+ * syncs the data file before the index entries pointing into it are
+ * written, and entries carry a check sum, so a crash loses at most the
+ * last batch. The index is grown by writing a new one and renaming it.
+ *
+ * Tiles of charts which changed are not reused, since the chart key
+ * covers the chart file and texture format. They stay in the store
+ * until it is cleared. A store which has reached its size limit takes
+ * no more tiles, and is started over when next opened.
+ *
+ * All functions may be called from any thread.
+ */
+class TexCacheStore {
+public:
+  using Reader = std::function<void(const unsigned char* data, uint32_t size)>;
+
+  TexCacheStore();
+  ~TexCacheStore();
+
+  /** Key of a chart file version and texture format. */
+  static uint64_t ChartKey(const std::string& path, uint32_t chart_date,
+                           uint32_t file_date, uint32_t file_size,
+                           uint32_t format);
+
+  /** Open or create the store in directory dir. */
+  bool Open(const std::string& dir);
+  /** Size limit of the data file, applies from the next Open(). */
+  void SetMaxSize(uint64_t bytes);
+  /** Commit and close. */
+  void Close();
+  bool IsOpen();
+
+  /** Add a tile, false if the store is closed, full or has it already. */
+  bool Put(const TexCacheKey& key, const unsigned char* data, uint32_t size);
+  bool Contains(const TexCacheKey& key);
+  /** Call read with the tile, outside the store lock. */
+  bool Read(const TexCacheKey& key, const Reader& read);
+
+  /** Make the tiles added so far durable and indexed. */
+  bool Commit();
+  /** Commit if the pending batch is large or old enough. */
+  void MaybeCommit();
+
+  /** Close and remove the store files. */
+  void Clear();
+
+  size_t GetCount();
+  uint64_t GetDataSize();
+
+private:
+  struct Location {
+    uint64_t offset;
+    uint32_t size;
+  };
+  struct KeyHash {
+    size_t operator()(const TexCacheKey& key) const;
+  };
+
+  bool FindIndexed(const TexCacheKey& key, Location& loc);
+  bool Find(const TexCacheKey& key, Location& loc);
+  bool WriteIndex(uint64_t n_slots);
+  bool ReadFile(const Location& loc, std::vector<unsigned char>& buf);
+  void MapData();
+  bool CommitLocked();
+  void CloseLocked();
+
+  std::mutex m_mutex;
+  std::string m_dir;
+  std::unique_ptr<MappedFile> m_index;
+  std::shared_ptr<MappedFile> m_data;  ///< Kept by readers while they run
+  FILE* m_data_file;
+  FILE* m_read_file;
+  uint64_t m_data_size;
+  uint64_t m_max_size;
+  std::unordered_map<TexCacheKey, Location, KeyHash> m_pending;
+  std::chrono::steady_clock::time_point m_pending_since;
+};
+
+#endif  // _TEX_CACHE_STORE_H__
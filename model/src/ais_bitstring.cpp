@@ -34,6 +34,13 @@ AisBitstring::AisBitstring(const char *str) {
   }
 }
 
+AisBitstring::AisBitstring(const unsigned char *sixbit, int len) {
+  byte_length = len;
+  memcpy(bitbytes, sixbit, len);
+  // Reads past the end of short messages yield zero bits
+  memset(bitbytes + len, 0, sizeof(bitbytes) - len);
+}
+
 int AisBitstring::GetBitCount() { return byte_length * 6; }
 
 //  Convert printable characters to IEC 6 bit representation
@@ -381,7 +381,7 @@ bool AisDecoder::HandleN0183_AIS( std::shared_ptr <const Nmea0183Msg> n0183_msg
 }
 
 bool AisDecoder::HandleN2K_129038( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
   uint8_t MessageID;
   tN2kAISRepeat Repeat;
@@ -475,7 +475,7 @@ bool AisDecoder::HandleN2K_129038( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
 
   // AIS position reports for Class B
 bool AisDecoder::HandleN2K_129039( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
 // Input:
 //  - N2kMsg                NMEA2000 message to decode
@@ -560,7 +560,7 @@ bool AisDecoder::HandleN2K_129039( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
 }
 
 bool AisDecoder::HandleN2K_129041( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
   tN2kAISAtoNReportData data;
 
@@ -655,7 +655,7 @@ bool AisDecoder::HandleN2K_129041( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
 
 //AIS static data class A
 bool AisDecoder::HandleN2K_129794( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
   uint8_t MessageID;
   tN2kAISRepeat Repeat;
@@ -748,7 +748,7 @@ bool AisDecoder::HandleN2K_129794( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
 }
 // AIS static data class B part A
 bool AisDecoder::HandleN2K_129809( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
   uint8_t MessageID;
   tN2kAISRepeat Repeat;
@@ -795,7 +795,7 @@ bool AisDecoder::HandleN2K_129809( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
 
 // AIS static data class B part B
 bool AisDecoder::HandleN2K_129810( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
   uint8_t MessageID;
   tN2kAISRepeat Repeat;
@@ -852,7 +852,7 @@ bool AisDecoder::HandleN2K_129810( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
 
 // AIS Base Station Report
 bool AisDecoder::HandleN2K_129793( std::shared_ptr<const Nmea2000Msg> n2k_msg ){
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
   uint8_t MessageID;
   tN2kAISRepeat Repeat;
@@ -1030,30 +1030,29 @@ void AisDecoder::OnEvtAIS(OCPN_DataStreamEvent &event) {
 //     Handle events from SignalK
 //----------------------------------------------------------------------------------
 void AisDecoder::HandleSignalK(std::shared_ptr<const SignalkMsg> sK_msg){
-  rapidjson::Document root;
-
-  root.Parse(sK_msg->raw_message);
-
-  if (root.HasParseError()) return;
-
-  if (root.HasMember("self")) {
-    // m_signalk_selfid = _T("vessels.") + (root["self"].AsString());
-    m_signalk_selfid =
-        (root["self"]
-             .GetString());  // Verified for OpenPlotter node.js server 1.20
-  }
+  // The driver has already extracted the self and target contexts, so own
+  // ship updates are dropped before the document is touched.
+  m_signalk_selfid = sK_msg->context_self;
   if (m_signalk_selfid.IsEmpty()) {
     return;  // Don't handle any messages (with out self) until we know how we
              // are
   }
+  if (sK_msg->context == sK_msg->context_self) {
+#if 0
+            wxLogMessage(_T("** Ignore context own ship.."));
+#endif
+    return;
+  }
+
+  auto doc = sK_msg->GetDocument();
+  if (doc->HasParseError()) return;
+  const rapidjson::Value& root = *doc;
+
   long mmsi = 0;
   int meteo_SiteID = 0;
   if (root.HasMember("context") && root["context"].IsString()) {
     wxString context = root["context"].GetString();
     if (context == m_signalk_selfid) {
-#if 0
-            wxLogMessage(_T("** Ignore context own ship.."));
-#endif
       return;
     }
     wxString mmsi_string;
@@ -1640,7 +1639,6 @@ AisError AisDecoder::DecodeSingleVDO(const wxString &str,
 
 AisError AisDecoder::DecodeN0183(const wxString &str) {
   AisError ret = AIS_GENERIC_ERROR;
-  wxString string_to_parse;
 
   double gpsg_lat, gpsg_lon, gpsg_mins, gpsg_degs;
   double gpsg_cog, gpsg_sog, gpsg_utc_time;
@@ -1692,10 +1690,37 @@ AisError AisDecoder::DecodeN0183(const wxString &str) {
 
   if (str.Len() > 128) return AIS_NMEAVDX_TOO_LONG;
 
-  if (!NMEACheckSumOK(str)) {
+  //  VDM/VDO sentences, the bulk of the traffic, are checked, reassembled
+  //  and 6-bit decoded by the allocation free front end
+  bool b_vdx = str.Len() > 6 && str[3] == 'V' && str[4] == 'D';
+  bool b_vdx_complete = false;
+  if (b_vdx) {
+    m_vdm_text.clear();
+    for (wxString::const_iterator it = str.begin(); it != str.end(); ++it)
+      m_vdm_text.push_back(static_cast<char>((*it).GetValue() & 0xff));
+
+    switch (m_vdm_parser.Parse(m_vdm_text, m_vdm_msg)) {
+      case AisVdmResult::kComplete:
+        b_vdx_complete = true;
+        break;
+      case AisVdmResult::kPartial:
+        break;
+      case AisVdmResult::kChecksumBad:
+        return AIS_NMEAVDX_CHECKSUM_BAD;
+      case AisVdmResult::kOutOfSequence:
+        return AIS_INCOMPLETE_MULTIPART;
+      case AisVdmResult::kTooLong:
+        return AIS_NMEAVDX_TOO_LONG;
+      default:
+        return AIS_NMEAVDX_BAD;
+    }
+  } else if (!NMEACheckSumOK(str)) {
     return AIS_NMEAVDX_CHECKSUM_BAD;
   }
-  if (str.Mid(1, 2).IsSameAs(_T("CD"))) {
+
+  if (b_vdx) {
+    //  Payload decoded above
+  } else if (str.Mid(1, 2).IsSameAs(_T("CD"))) {
     ProcessDSx(str);
     return AIS_NoError;
   } else if (str.Mid(3, 3).IsSameAs(_T("TTM"))) {
@@ -1975,58 +2000,11 @@ AisError AisDecoder::DecodeN0183(const wxString &str) {
 
   //  OK, looks like the sentence is OK
 
-  //  Use a tokenizer to pull out the first 4 fields
-  wxString string(str);
-  wxStringTokenizer tkz(string, _T(","));
-
-  wxString token;
-  token = tkz.GetNextToken();  // !xxVDx
-
-  token = tkz.GetNextToken();
-  nsentences = atoi(token.mb_str());
-
-  token = tkz.GetNextToken();
-  isentence = atoi(token.mb_str());
-
-  token = tkz.GetNextToken();
-  long lsequence_id = 0;
-  token.ToLong(&lsequence_id);
-
-  token = tkz.GetNextToken();
-  long lchannel;
-  token.ToLong(&lchannel);
-  //  Now, some decisions
-
-  string_to_parse.Clear();
-
-  //  Simple case first
-  //  First and only part of a one-part sentence
-  if ((1 == nsentences) && (1 == isentence)) {
-    string_to_parse = tkz.GetNextToken();  // the encapsulated data
-  }
-
-  else if (nsentences > 1) {
-    if (1 == isentence) {
-      sentence_accumulator = tkz.GetNextToken();  // the encapsulated data
-    }
-
-    else {
-      sentence_accumulator += tkz.GetNextToken();
-    }
-
-    if (isentence == nsentences) {
-      string_to_parse = sentence_accumulator;
-    }
-  }
-
-  if (mmsi || (!string_to_parse.IsEmpty() &&
-               (string_to_parse.Len() < AIS_MAX_MESSAGE_LEN))) {
-    //  Create the bit accessible string
-    wxCharBuffer abuf = string_to_parse.ToUTF8();
-    if (!abuf.data())  // badly formed sentence?
-      return AIS_GENERIC_ERROR;
-
-    AisBitstring strbit(abuf.data());
+  if (mmsi || b_vdx_complete) {
+    //  Create the bit accessible string.  The other sentence types carry
+    //  no AIS payload and decode from their own fields above.
+    AisBitstring strbit(m_vdm_msg.payload,
+                        b_vdx_complete ? m_vdm_msg.payload_len : 0);
 
     //  Extract the MMSI
     if (!mmsi) mmsi = strbit.GetInt(9, 30);
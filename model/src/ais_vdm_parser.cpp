@@ -0,0 +1,179 @@
+/**************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/** \file ais_vdm_parser.cpp Implement ais_vdm_parser.h */
+
+#include <cstring>
+
+#include "model/ais_vdm_parser.h"
+
+namespace {
+
+// IEC 61162-1 payload armoring: '0'..'W' -> 0..39, '`'..'w' -> 40..63
+struct SixBitTable {
+  unsigned char v[256];
+  constexpr SixBitTable() : v() {
+    for (int c = 0; c < 256; c++) {
+      if (c >= 0x30 && c <= 0x57)
+        v[c] = c - 0x30;
+      else if (c >= 0x60 && c <= 0x77)
+        v[c] = c - 0x38;
+      else
+        v[c] = 0xff;
+    }
+  }
+};
+
+constexpr SixBitTable kTable;
+
+int HexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+/** Split off the next comma separated field of s. */
+std::string_view NextField(std::string_view &s) {
+  size_t comma = s.find(',');
+  std::string_view field = s.substr(0, comma);
+  s.remove_prefix(comma == std::string_view::npos ? s.size() : comma + 1);
+  return field;
+}
+
+/** 6-bit decode armored payload characters into out. */
+bool Decode(std::string_view payload, unsigned char *out) {
+  for (char c : payload) {
+    unsigned char v = kTable.v[(unsigned char)c];
+    if (v == 0xff) return false;
+    *out++ = v;
+  }
+  return true;
+}
+
+/** Parse a small unsigned decimal field, -1 if empty or bad. */
+int SmallInt(std::string_view field) {
+  if (field.empty() || field.size() > 3) return -1;
+  int value = 0;
+  for (char c : field) {
+    if (c < '0' || c > '9') return -1;
+    value = value * 10 + (c - '0');
+  }
+  return value;
+}
+
+}  // namespace
+
+unsigned char AisVdmParser::SixBit(char c) {
+  return kTable.v[(unsigned char)c];
+}
+
+void AisVdmParser::Reset() {
+  for (auto &pending : m_pending) pending.total = 0;
+}
+
+bool AisVdmParser::ChecksumOk(std::string_view sentence) {
+  size_t star = sentence.find('*');
+  if (star == std::string_view::npos || star < 1) return false;
+  if (sentence.size() < star + 3) return false;
+
+  unsigned char sum = 0;
+  for (size_t i = 1; i < star; i++) sum ^= (unsigned char)sentence[i];
+
+  int hi = HexDigit(sentence[star + 1]);
+  int lo = HexDigit(sentence[star + 2]);
+  if (hi < 0 || lo < 0) return false;
+  return sum == ((hi << 4) | lo);
+}
+
+AisVdmResult AisVdmParser::Parse(std::string_view sentence,
+                                 AisVdmMessage &msg) {
+  while (!sentence.empty() &&
+         (sentence.back() == '\n' || sentence.back() == '\r'))
+    sentence.remove_suffix(1);
+
+  if (sentence.size() < 7 || (sentence[0] != '!' && sentence[0] != '$') ||
+      sentence[3] != 'V' || sentence[4] != 'D' ||
+      (sentence[5] != 'M' && sentence[5] != 'O') || sentence[6] != ',')
+    return AisVdmResult::kNotVdm;
+
+  if (!ChecksumOk(sentence)) return AisVdmResult::kChecksumBad;
+
+  // !AIVDM,total,index,seq_id,channel,payload,fill_bits*hh
+  std::string_view fields = sentence.substr(7, sentence.find('*') - 7);
+  int total = SmallInt(NextField(fields));
+  int index = SmallInt(NextField(fields));
+  std::string_view seq_field = NextField(fields);
+  std::string_view channel_field = NextField(fields);
+  std::string_view payload = NextField(fields);
+  std::string_view fill_field = NextField(fields);
+  int fill_bits = fill_field.empty() ? 0 : SmallInt(fill_field);
+
+  if (total < 1 || total > 9 || index < 1 || index > total)
+    return AisVdmResult::kMalformed;
+  if (fill_bits < 0 || fill_bits > 5) return AisVdmResult::kMalformed;
+  if (seq_field.size() > 1 || channel_field.size() > 1)
+    return AisVdmResult::kMalformed;
+
+  int seq_id = seq_field.empty() ? 10 : SmallInt(seq_field);
+  if (seq_id < 0) return AisVdmResult::kMalformed;
+
+  // Single part messages, the common case, go straight to msg and leave
+  // any pending multipart message alone
+  if (total == 1) {
+    if (payload.size() >= AIS_MAX_MESSAGE_LEN) return AisVdmResult::kTooLong;
+    if (!Decode(payload, msg.payload)) return AisVdmResult::kMalformed;
+    msg.payload_len = payload.size();
+  } else {
+    Pending &pending = m_pending[seq_id];
+    if (index == 1) {
+      pending.total = total;
+      pending.len = 0;
+    } else if (pending.total != total || pending.next != index) {
+      pending.total = 0;
+      return AisVdmResult::kOutOfSequence;
+    }
+
+    // Same limit as the legacy decoder: the payload must be shorter than
+    // AIS_MAX_MESSAGE_LEN characters
+    if (pending.len + payload.size() >= AIS_MAX_MESSAGE_LEN) {
+      pending.total = 0;
+      return AisVdmResult::kTooLong;
+    }
+    if (!Decode(payload, pending.payload + pending.len)) {
+      pending.total = 0;
+      return AisVdmResult::kMalformed;
+    }
+    pending.len += payload.size();
+
+    if (index < total) {
+      pending.next = index + 1;
+      return AisVdmResult::kPartial;
+    }
+    msg.payload_len = pending.len;
+    memcpy(msg.payload, pending.payload, pending.len);
+    pending.total = 0;
+  }
+
+  msg.talker[0] = sentence[1];
+  msg.talker[1] = sentence[2];
+  msg.talker[2] = 0;
+  msg.own_ship = sentence[5] == 'O';
+  msg.channel = channel_field.empty() ? 0 : channel_field[0];
+  msg.fill_bits = fill_bits;
+  return AisVdmResult::kComplete;
+}
@@ -35,6 +35,8 @@
 #include <wx/tokenzr.h>
 #include <wx/fileconf.h>
 
+#include "rapidjson/document.h"
+
 #include "model/comm_ais.h"
 #include "model/comm_appmsg_bus.h"
 #include "model/comm_bridge.h"
@@ -523,7 +525,7 @@ void CommBridge::PresetPriorityContainers(){
 
 bool CommBridge::HandleN2K_129029(std::shared_ptr<const Nmea2000Msg> n2k_msg) {
 
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
   // extract and verify PGN
   uint64_t pgn = 0;
@@ -564,7 +566,7 @@ bool CommBridge::HandleN2K_129029(std::shared_ptr<const Nmea2000Msg> n2k_msg) {
 
 bool CommBridge::HandleN2K_129025(std::shared_ptr<const Nmea2000Msg> n2k_msg) {
 
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
   NavData temp_data;
   ClearNavData(temp_data);
@@ -593,7 +595,7 @@ bool CommBridge::HandleN2K_129025(std::shared_ptr<const Nmea2000Msg> n2k_msg) {
 
 bool CommBridge::HandleN2K_129026(std::shared_ptr<const Nmea2000Msg> n2k_msg) {
 
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
   NavData temp_data;
   ClearNavData(temp_data);
@@ -624,7 +626,7 @@ bool CommBridge::HandleN2K_129026(std::shared_ptr<const Nmea2000Msg> n2k_msg) {
 
 bool CommBridge::HandleN2K_127250(std::shared_ptr<const Nmea2000Msg> n2k_msg) {
 
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
   NavData temp_data;
   ClearNavData(temp_data);
@@ -665,7 +667,7 @@ bool CommBridge::HandleN2K_127250(std::shared_ptr<const Nmea2000Msg> n2k_msg) {
 
 bool CommBridge::HandleN2K_129540(std::shared_ptr<const Nmea2000Msg> n2k_msg) {
 
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const std::vector<unsigned char>& v = n2k_msg->payload;
 
   NavData temp_data;
   ClearNavData(temp_data);
@@ -957,18 +959,19 @@ bool CommBridge::HandleN0183_AIVDO(
 }
 
 bool CommBridge::HandleSignalK(std::shared_ptr<const SignalkMsg> sK_msg){
-  std::string str = sK_msg->raw_message;
-
   //  Here we ignore messages involving contexts other than ownship
   if (sK_msg->context_self != sK_msg->context)
     return false;
 
   g_ownshipMMSI_SK = sK_msg->context_self;
 
+  auto root = sK_msg->GetDocument();
+  if (root->HasParseError()) return false;
+
   NavData temp_data;
   ClearNavData(temp_data);
 
-  if (!m_decoder.DecodeSignalK(str, temp_data)) return false;
+  if (!m_decoder.DecodeSignalK(*root, temp_data)) return false;
 
   int valid_flag = 0;
 
@@ -255,7 +255,7 @@ bool CommDecoder::DecodeGGA(std::string s, NavData& temp_data) {
 // NMEA2000 PGN Decode
 //---------------------------------------------------------------------
 
-bool CommDecoder::DecodePGN129026(std::vector<unsigned char> v,  NavData& temp_data) {
+bool CommDecoder::DecodePGN129026(const std::vector<unsigned char>& v,  NavData& temp_data) {
 
   unsigned char SID;
   tN2kHeadingReference ref;
@@ -271,7 +271,7 @@ bool CommDecoder::DecodePGN129026(std::vector<unsigned char> v,  NavData& temp_d
   return false;
 }
 
-bool CommDecoder::DecodePGN129029(std::vector<unsigned char> v,  NavData& temp_data) {
+bool CommDecoder::DecodePGN129029(const std::vector<unsigned char>& v,  NavData& temp_data) {
   unsigned char SID;
   uint16_t DaysSince1970;
   double SecondsSinceMidnight;
@@ -313,7 +313,7 @@ bool CommDecoder::DecodePGN129029(std::vector<unsigned char> v,  NavData& temp_d
   return false;
 }
 
-bool CommDecoder::DecodePGN127250(std::vector<unsigned char> v,  NavData& temp_data) {
+bool CommDecoder::DecodePGN127250(const std::vector<unsigned char>& v,  NavData& temp_data) {
 
   unsigned char SID;
   double Heading, Deviation, Variation;
@@ -335,7 +335,7 @@ bool CommDecoder::DecodePGN127250(std::vector<unsigned char> v,  NavData& temp_d
   return false;
 }
 
-bool CommDecoder::DecodePGN129025(std::vector<unsigned char> v,  NavData& temp_data) {
+bool CommDecoder::DecodePGN129025(const std::vector<unsigned char>& v,  NavData& temp_data) {
 
   double Latitude, Longitude;
 
@@ -349,7 +349,7 @@ bool CommDecoder::DecodePGN129025(std::vector<unsigned char> v,  NavData& temp_d
   return false;
 }
 
-bool CommDecoder::DecodePGN129540(std::vector<unsigned char> v,  NavData& temp_data) {
+bool CommDecoder::DecodePGN129540(const std::vector<unsigned char>& v,  NavData& temp_data) {
 
   unsigned char SID;
   uint8_t NumberOfSVs;;
@@ -371,6 +371,13 @@ bool CommDecoder::DecodeSignalK(std::string s, NavData& temp_data){
   if (root.HasParseError())
     return false;
 
+  return DecodeSignalK(root, temp_data);
+}
+
+bool CommDecoder::DecodeSignalK(const rapidjson::Value& root,
+                                NavData& temp_data) {
+  if (!root.IsObject()) return false;
+
   if (root.HasMember("updates") && root["updates"].IsArray()) {
     for (rapidjson::Value::ConstValueIterator itr = root["updates"].Begin(); itr != root["updates"].End(); ++itr) {
       handleUpdate(*itr, temp_data);
@@ -32,6 +32,7 @@
 #include "rapidjson/document.h"
 
 #include "model/comm_drv_signalk_net.h"
+#include "model/comm_util.h"
 #include "model/comm_navmsg_bus.h"
 #include "model/comm_drv_registry.h"
 #include "model/geodesic.h"
@@ -392,50 +393,45 @@ void CommDriverSignalKNet::CloseWebSocket() {
 
 void CommDriverSignalKNet::handle_SK_sentence(
     CommDriverSignalKNetEvent& event) {
-  rapidjson::Document root;
-
   // LOG_DEBUG("%s\n", msg.c_str());
 
   std::string* msg = event.GetPayload().get();
   std::string msgTerminated = *msg;
   msgTerminated.append("\r\n");
 
-  root.Parse(*msg);
-  if (root.HasParseError()) {
-    wxLogMessage(wxString::Format(
-        _T("SignalKDataStream ERROR: the JSON document is not well-formed:%d"),
-        root.GetParseError()));
+  // Scan just enough of string to extract some identifiers
+  // such as the sK version, "self" context, and target context.
+  // Listeners filter on the contexts first, and only those which keep
+  // the message parse it, once, through SignalkMsg::GetDocument().
+  std::string version, self, context;
+  if (!SignalkScanIds(*msg, version, self, context)) {
+    wxLogMessage(
+        _T("SignalKDataStream ERROR: the JSON document is not well-formed"));
     return;
   }
 
-  // Decode just enough of string to extract some identifiers
-  // such as the sK version, "self" context, and target context
-  if (root.HasMember("version")) {
+  if (!version.empty()) {
     wxString msg = _T("Connected to Signal K server version: ");
-    msg << (root["version"].GetString());
+    msg << version;
     wxLogMessage(msg);
   }
 
-  if (root.HasMember("self")) {
-    if (strncmp(root["self"].GetString(), "vessels.", 8) == 0)
-      m_self = (root["self"].GetString());  // for java server, and OpenPlotter
-                                            // node.js server 1.20
+  if (!self.empty()) {
+    if (self.compare(0, 8, "vessels.") == 0)
+      m_self = self;  // for java server, and OpenPlotter node.js server 1.20
     else
-      m_self = std::string("vessels.")
-                   .append(root["self"].GetString());  // for Node.js server
+      m_self = std::string("vessels.").append(self);  // for Node.js server
   }
 
-  if (root.HasMember("context") && root["context"].IsString()) {
-    m_context = root["context"].GetString();
-  }
+  if (!context.empty()) m_context = context;
 
   // Notify all listeners
   auto pos = iface.find(":");
   std::string comm_interface = "";
   if (pos != std::string::npos)
     comm_interface = iface.substr(pos + 1);
-  auto navmsg =
-      std::make_shared<const SignalkMsg>(m_self, m_context, msgTerminated, comm_interface);
+  auto navmsg = std::make_shared<const SignalkMsg>(
+      m_self, m_context, msgTerminated, comm_interface);
   m_listener.Notify(std::move(navmsg));
 }
 
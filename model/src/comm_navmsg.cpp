@@ -31,6 +31,8 @@
 #include <string>
 #include <iomanip>
 
+#include "rapidjson/document.h"
+
 #include "model/comm_driver.h"
 
 std::string NavAddr::BusToString(NavAddr::Bus b) {
@@ -83,3 +85,13 @@ std::string Nmea2000Msg::to_string() const {
 
   return NavMsg::to_string() + " " + PGN.to_string() + " " + s;
 }
+
+std::shared_ptr<const rapidjson::Document> SignalkMsg::GetDocument() const {
+  auto parsed = std::atomic_load(&root);
+  if (parsed) return parsed;
+  auto doc = std::make_shared<rapidjson::Document>();
+  doc->Parse(raw_message);
+  parsed = doc;
+  std::atomic_store(&root, parsed);
+  return parsed;
+}
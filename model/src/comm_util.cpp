@@ -32,6 +32,11 @@
 #include <vector>
 #include <string>
 
+#include <wx/jsonval.h>
+
+#include "rapidjson/document.h"
+#include "rapidjson/reader.h"
+
 #include "model/comm_util.h"
 #include "model/comm_drv_registry.h"
 
@@ -70,3 +75,129 @@ wxString ProcessNMEA4Tags(wxString& msg) {
 
   return msg;
 }
+
+void SignalkToJson(const rapidjson::Value& value, wxJSONValue& json) {
+  switch (value.GetType()) {
+    case rapidjson::kNullType:
+      json.SetType(wxJSONTYPE_NULL);
+      break;
+    case rapidjson::kFalseType:
+      json = false;
+      break;
+    case rapidjson::kTrueType:
+      json = true;
+      break;
+    case rapidjson::kStringType:
+      json = wxString::FromUTF8(value.GetString(), value.GetStringLength());
+      break;
+    case rapidjson::kNumberType:
+#if defined(wxJSON_64BIT_INT)
+      if (value.IsInt64())
+        json = static_cast<wxInt64>(value.GetInt64());
+      else if (value.IsUint64())
+        json = static_cast<wxUint64>(value.GetUint64());
+#else
+      if (value.IsInt())
+        json = value.GetInt();
+      else if (value.IsUint())
+        json = value.GetUint();
+#endif
+      else
+        json = value.GetDouble();
+      break;
+    case rapidjson::kArrayType:
+      json.SetType(wxJSONTYPE_ARRAY);
+      for (auto& item : value.GetArray()) {
+        wxJSONValue element;
+        SignalkToJson(item, element);
+        json.Append(element);
+      }
+      break;
+    case rapidjson::kObjectType:
+      json.SetType(wxJSONTYPE_OBJECT);
+      for (auto& member : value.GetObject()) {
+        wxString key = wxString::FromUTF8(member.name.GetString(),
+                                          member.name.GetStringLength());
+        SignalkToJson(member.value, json[key]);
+      }
+      break;
+  }
+}
+
+namespace {
+
+/** SAX handler picking the identifiers out of a SignalK message. */
+class SignalkIdScanner
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, SignalkIdScanner> {
+public:
+  SignalkIdScanner(std::string& version, std::string& self,
+                   std::string& context)
+      : m_version(version),
+        m_self(self),
+        m_context(context),
+        m_target(nullptr),
+        m_depth(0),
+        m_done(false) {}
+
+  bool Default() {
+    m_target = nullptr;
+    return true;
+  }
+  bool String(const char* str, rapidjson::SizeType length, bool) {
+    std::string* target = m_target;
+    m_target = nullptr;
+    if (!target) return true;
+    target->assign(str, length);
+    m_done = target == &m_context;
+    return !m_done;  // nothing past the context is needed
+  }
+  bool Key(const char* str, rapidjson::SizeType length, bool) {
+    std::string key(str, length);
+    m_target = nullptr;
+    if (m_depth != 1) return true;
+    if (key == "version")
+      m_target = &m_version;
+    else if (key == "self")
+      m_target = &m_self;
+    else if (key == "context")
+      m_target = &m_context;
+    return true;
+  }
+  bool StartObject() {
+    m_depth++;
+    return Default();
+  }
+  bool EndObject(rapidjson::SizeType) {
+    m_depth--;
+    return true;
+  }
+  bool StartArray() {
+    m_depth++;
+    return Default();
+  }
+  bool EndArray(rapidjson::SizeType) {
+    m_depth--;
+    return true;
+  }
+
+  bool IsDone() const { return m_done; }
+
+private:
+  std::string& m_version;
+  std::string& m_self;
+  std::string& m_context;
+  std::string* m_target;  // member receiving the next string value
+  int m_depth;
+  bool m_done;
+};
+
+}  // namespace
+
+bool SignalkScanIds(const std::string& msg, std::string& version,
+                    std::string& self, std::string& context) {
+  SignalkIdScanner scanner(version, self, context);
+  rapidjson::Reader reader;
+  rapidjson::StringStream stream(msg.c_str());
+  rapidjson::ParseResult result = reader.Parse(stream, scanner);
+  return result || scanner.IsDone();
+}
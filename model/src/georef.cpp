@@ -889,6 +889,165 @@ void fromEQUIRECT(double x, double y, double lat0, double lon0, double *lat,
   *lon = lon0 + (x / (DEGREE * z));
 }
 
+/****************************************************************************/
+/* Batch projections                                                        */
+/*                                                                          */
+/* Array in/array out versions of the projections above for callers        */
+/* projecting whole polylines.  Terms depending only on the projection      */
+/* origin are computed once per call, and each point is computed with the   */
+/* same expressions as the scalar routine.                                  */
+/****************************************************************************/
+static inline double same_phase_lon(double lon, double lon0) {
+  double xlon = lon;
+  if ((lon * lon0 < 0.) && (fabs(lon - lon0) > 180.))
+    lon < 0.0 ? xlon += 360.0 : xlon -= 360.0;
+  return xlon;
+}
+
+void toSMcache_batch(int n, const double *lat, const double *lon, double y30,
+                     double lon0, double *x, double *y) {
+  const double z = WGS84_semimajor_axis_meters * mercator_k0;
+
+  for (int i = 0; i < n; i++)
+    x[i] = (same_phase_lon(lon[i], lon0) - lon0) * DEGREE * z;
+
+  for (int i = 0; i < n; i++) {
+    const double s = sin(lat[i] * DEGREE);
+    const double y3 = (.5 * log((1 + s) / (1 - s))) * z;
+    y[i] = y3 - y30;
+  }
+}
+
+void toSM_batch(int n, const double *lat, const double *lon, double lat0,
+                double lon0, double *x, double *y) {
+  toSMcache_batch(n, lat, lon, toSMcache_y30(lat0), lon0, x, y);
+}
+
+void fromSM_batch(int n, const double *x, const double *y, double lat0,
+                  double lon0, double *lat, double *lon) {
+  const double z = WGS84_semimajor_axis_meters * mercator_k0;
+  const double s0 = sin(lat0 * DEGREE);
+  const double y0 = (.5 * log((1 + s0) / (1 - s0))) * z;
+
+  for (int i = 0; i < n; i++) {
+    lat[i] = (2.0 * atan(exp((y0 + y[i]) / z)) - PI / 2.) / DEGREE;
+    lon[i] = lon0 + (x[i] / (DEGREE * z));
+  }
+}
+
+void toTM_batch(int n, const double *lat, const double *lon, float lat0,
+                float lon0, double *x, double *y) {
+  // Same constants and float input precision as toTM()
+  const double f = 1.0 / WGSinvf;
+  const double a = WGS84_semimajor_axis_meters;
+  const double k0 = 1.;
+
+  const double eccSquared = 2 * f - f * f;
+  const double eccPrimeSquared = (eccSquared) / (1 - eccSquared);
+  const double LongOriginRad = lon0 * DEGREE;
+
+  const double m0 = 1 - eccSquared / 4 - 3 * eccSquared * eccSquared / 64 -
+                    5 * eccSquared * eccSquared * eccSquared / 256;
+  const double m2 = 3 * eccSquared / 8 + 3 * eccSquared * eccSquared / 32 +
+                    45 * eccSquared * eccSquared * eccSquared / 1024;
+  const double m4 = 15 * eccSquared * eccSquared / 256 +
+                    45 * eccSquared * eccSquared * eccSquared / 1024;
+  const double m6 = 35 * eccSquared * eccSquared * eccSquared / 3072;
+
+  for (int i = 0; i < n; i++) {
+    const double LatRad = (float)lat[i] * DEGREE;
+    const double LongRad = (float)lon[i] * DEGREE;
+
+    const double sinLat = sin(LatRad);
+    const double cosLat = cos(LatRad);
+    const double tanLat = tan(LatRad);
+
+    const double N = a / sqrt(1 - eccSquared * sinLat * sinLat);
+    const double T = tanLat * tanLat;
+    const double C = eccPrimeSquared * cosLat * cosLat;
+    const double A = cosLat * (LongRad - LongOriginRad);
+
+    const double MM = a * (m0 * LatRad - m2 * sin(2 * LatRad) +
+                           m4 * sin(4 * LatRad) - m6 * sin(6 * LatRad));
+
+    x[i] = (k0 * N *
+            (A + (1 - T + C) * A * A * A / 6 +
+             (5 - 18 * T + T * T + 72 * C - 58 * eccPrimeSquared) * A * A * A *
+                 A * A / 120));
+
+    y[i] = (k0 *
+            (MM + N * tanLat *
+                      (A * A / 2 +
+                       (5 - T + 9 * C + 4 * C * C) * A * A * A * A / 24 +
+                       (61 - 58 * T + T * T + 600 * C - 330 * eccPrimeSquared) *
+                           A * A * A * A * A * A / 720)));
+  }
+}
+
+void toPOLY_batch(int n, const double *lat, const double *lon, double lat0,
+                  double lon0, double *x, double *y) {
+  const double z = WGS84_semimajor_axis_meters * mercator_k0;
+
+  for (int i = 0; i < n; i++) {
+    if (fabs((lat[i] - lat0) * DEGREE) <= TOL) {
+      x[i] = (lon[i] - lon0) * DEGREE * z;
+      y[i] = 0.;
+    } else {
+      const double E = (lon[i] - lon0) * DEGREE * sin(lat[i] * DEGREE);
+      const double cot = 1. / tan(lat[i] * DEGREE);
+      x[i] = sin(E) * cot * z;
+      y[i] = ((lat[i] * DEGREE) - (lat0 * DEGREE) + cot * (1. - cos(E))) * z;
+    }
+  }
+}
+
+void toORTHO_batch(int n, const double *lat, const double *lon,
+                   double sin_phi0, double cos_phi0, double lon0, double *x,
+                   double *y) {
+  const double z = WGS84_semimajor_axis_meters * mercator_k0;
+
+  for (int i = 0; i < n; i++) {
+    double theta = (same_phase_lon(lon[i], lon0) - lon0) * DEGREE;
+    double phi = lat[i] * DEGREE;
+    double cos_phi = cos(phi);
+
+    double vy = sin(phi), vz = cos(theta) * cos_phi;
+
+    if (vy * sin_phi0 + vz * cos_phi0 < 0) {  // on the far side of the earth
+      x[i] = y[i] = NAN;
+      continue;
+    }
+
+    double vx = sin(theta) * cos_phi;
+    double vw = vy * cos_phi0 - vz * sin_phi0;
+
+    x[i] = vx * z;
+    y[i] = vw * z;
+  }
+}
+
+void toSTEREO_batch(int n, const double *lat, const double *lon,
+                    double sin_phi0, double cos_phi0, double lon0, double *x,
+                    double *y) {
+  //  The scale is shared by every point, only the point's own sines and
+  //  cosines are left in the loop
+  const double z = WGS84_semimajor_axis_meters * mercator_k0;
+
+  for (int i = 0; i < n; i++) {
+    double theta = (same_phase_lon(lon[i], lon0) - lon0) * DEGREE;
+    double phi = lat[i] * DEGREE;
+    double cos_phi = cos(phi), v0 = sin(phi), w0 = cos(theta) * cos_phi;
+
+    double u = sin(theta) * cos_phi;
+    double v = cos_phi0 * v0 - sin_phi0 * w0;
+    double w = sin_phi0 * v0 + cos_phi0 * w0;
+
+    double t = 2 / (w + 1);
+    x[i] = u * t * z;
+    y[i] = v * t * z;
+  }
+}
+
 /* ---------------------------------------------------------------------------------
  *
 
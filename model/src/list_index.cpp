@@ -0,0 +1,154 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Sorted and filtered index of list control rows
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "model/list_index.h"
+
+//  More added objects than this are sorted in, instead of inserted
+static const size_t kInsertLimit = 64;
+
+ListIndex::ListIndex() : m_descending(false) {}
+
+bool ListIndex::Before(const Entry& a, const Entry& b) const {
+  if (m_descending) {
+    return m_less ? m_less(b.first, a.first) : b.second < a.second;
+  }
+  return m_less ? m_less(a.first, b.first) : a.second < b.second;
+}
+
+bool ListIndex::IsShown(const Entry& entry) const {
+  return m_filter.empty() || entry.second.find(m_filter) != std::string::npos;
+}
+
+void ListIndex::SetSort(const Less& less, bool descending) {
+  m_less = less;
+  m_descending = descending;
+  Resort();
+}
+
+void ListIndex::Resort() {
+  std::stable_sort(
+      m_entries.begin(), m_entries.end(),
+      [&](const Entry& a, const Entry& b) { return Before(a, b); });
+  UpdateRows();
+}
+
+void ListIndex::Clear() {
+  m_entries.clear();
+  m_rows.clear();
+}
+
+size_t ListIndex::Insert(Entry&& entry) {
+  auto before = [&](const Entry& a, const Entry& b) { return Before(a, b); };
+  size_t pos =
+      std::upper_bound(m_entries.begin(), m_entries.end(), entry, before) -
+      m_entries.begin();
+  m_entries.insert(m_entries.begin() + pos, std::move(entry));
+  return pos;
+}
+
+void ListIndex::Add(Object obj, const std::string& name) {
+  Entry entry(obj, name);
+  bool shown = IsShown(entry);
+  size_t pos = Insert(std::move(entry));
+  if (!shown) return;
+  // The new row follows the shown objects sorted before it
+  long row = std::count_if(m_entries.begin(), m_entries.begin() + pos,
+                           [&](const Entry& e) { return IsShown(e); });
+  m_rows.insert(m_rows.begin() + row, obj);
+}
+
+bool ListIndex::Remove(Object obj) {
+  auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                         [&](const Entry& e) { return e.first == obj; });
+  if (it == m_entries.end()) return false;
+  m_entries.erase(it);
+  auto row = std::find(m_rows.begin(), m_rows.end(), obj);
+  if (row != m_rows.end()) m_rows.erase(row);
+  return true;
+}
+
+bool ListIndex::Sync(const std::vector<Entry>& objects) {
+  std::unordered_map<Object, const std::string*> wanted;
+  wanted.reserve(objects.size());
+  for (const auto& obj : objects) wanted[obj.first] = &obj.second;
+
+  // Drop objects which are gone or renamed, and note the ones kept
+  std::unordered_set<Object> kept;
+  kept.reserve(m_entries.size());
+  auto gone = std::remove_if(m_entries.begin(), m_entries.end(),
+                             [&](const Entry& e) {
+                               auto it = wanted.find(e.first);
+                               if (it == wanted.end()) return true;
+                               if (*it->second != e.second) return true;
+                               kept.insert(e.first);
+                               return false;
+                             });
+  bool changed = gone != m_entries.end();
+  m_entries.erase(gone, m_entries.end());
+
+  std::vector<Entry> added;
+  for (const auto& obj : objects) {
+    if (kept.insert(obj.first).second) added.push_back(obj);
+  }
+  if (added.empty() && !changed) return false;
+
+  if (added.size() > kInsertLimit) {
+    auto before = [&](const Entry& a, const Entry& b) { return Before(a, b); };
+    std::stable_sort(added.begin(), added.end(), before);
+    size_t mid = m_entries.size();
+    for (auto& entry : added) m_entries.push_back(std::move(entry));
+    std::inplace_merge(m_entries.begin(), m_entries.begin() + mid,
+                       m_entries.end(), before);
+  } else {
+    for (auto& entry : added) Insert(std::move(entry));
+  }
+  UpdateRows();
+  return true;
+}
+
+void ListIndex::SetFilter(const std::string& filter) {
+  if (filter == m_filter) return;
+  m_filter = filter;
+  UpdateRows();
+}
+
+void ListIndex::UpdateRows() {
+  m_rows.clear();
+  m_rows.reserve(m_entries.size());
+  for (const auto& entry : m_entries) {
+    if (IsShown(entry)) m_rows.push_back(entry.first);
+  }
+}
+
+ListIndex::Object ListIndex::Get(long row) const {
+  if (row < 0 || row >= static_cast<long>(m_rows.size())) return nullptr;
+  return m_rows[row];
+}
+
+long ListIndex::Find(Object obj) const {
+  auto it = std::find(m_rows.begin(), m_rows.end(), obj);
+  return it == m_rows.end() ? -1 : it - m_rows.begin();
+}
@@ -23,6 +23,8 @@
  */
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdio>
 #include <iomanip>
 #include <map>
 #include <sstream>
@@ -34,6 +36,14 @@
 #include "model/logger.h"
 
 const wxLogLevel OcpnLog::LOG_BADLEVEL = wxLOG_Max + 1;
+const size_t OcpnLog::kDefaultMaxSize = 10 * 1024 * 1024;
+const size_t OcpnLog::kMaxPending = 20000;
+
+/** How often the writer looks for queued records when not woken up. */
+static const auto kWriteInterval = std::chrono::milliseconds(100);
+
+/** Queued records which wake up the writer, rather than waiting for it. */
+static const size_t kWakeupPending = 512;
 
 const static std::map<wxLogLevel, const char*> name_by_level = {
     {wxLOG_FatalError, "FATALERR"}, {wxLOG_Error, "ERROR"},
@@ -79,23 +89,181 @@ wxLogLevel OcpnLog::str2level(const char* string) {
   return search == level_by_name.end() ? LOG_BADLEVEL : search->second;
 }
 
-OcpnLog::OcpnLog(const char* path) {
+static size_t RoundUpPow2(size_t n) {
+  size_t size = 2;
+  while (size < n) size *= 2;
+  return size;
+}
+
+LogQueue::LogQueue(size_t capacity)
+    : m_slots(new Slot[RoundUpPow2(capacity)]),
+      m_mask(RoundUpPow2(capacity) - 1),
+      m_push_pos(0),
+      m_pop_pos(0) {
+  for (size_t i = 0; i <= m_mask; i++)
+    m_slots[i].seq.store(i, std::memory_order_relaxed);
+}
+
+bool LogQueue::Push(std::string&& line) {
+  size_t pos = m_push_pos.load(std::memory_order_relaxed);
+  Slot* slot;
+  while (true) {
+    slot = &m_slots[pos & m_mask];
+    size_t seq = slot->seq.load(std::memory_order_acquire);
+    auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+    if (diff == 0) {
+      if (m_push_pos.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed))
+        break;
+    } else if (diff < 0) {
+      return false;  // Not yet popped, a lap behind
+    } else {
+      pos = m_push_pos.load(std::memory_order_relaxed);
+    }
+  }
+  // Pop() left the slot line empty, so nothing is freed here
+  slot->line = std::move(line);
+  slot->seq.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool LogQueue::Pop(std::string& line) {
+  Slot& slot = m_slots[m_pop_pos & m_mask];
+  if (slot.seq.load(std::memory_order_acquire) != m_pop_pos + 1) return false;
+  line = std::move(slot.line);
+  std::string().swap(slot.line);  // Its buffer is freed here, not in Push()
+  slot.seq.store(m_pop_pos + m_mask + 1, std::memory_order_release);
+  m_pop_pos++;
+  return true;
+}
+
+OcpnLog::OcpnLog(const char* path, size_t max_size)
+    : m_path(path),
+      m_max_size(max_size),
+      m_size(0),
+      m_queue(kMaxPending),
+      m_pending(0),
+      m_dropped(0),
+      m_dropped_reported(0),
+      m_stop(false) {
   log.open(path, std::fstream::out | std::fstream::app);
+  log.seekp(0, std::ios::end);
+  auto pos = log.tellp();
+  if (pos > 0) m_size = static_cast<size_t>(pos);
+  m_writer = std::thread([this] { Run(); });
 }
 
-OcpnLog::~OcpnLog() { log.close(); }
+OcpnLog::~OcpnLog() {
+  {
+    std::lock_guard<std::mutex> lock(m_wake_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_one();
+  m_writer.join();
+  WriteQueued();  // Anything logged while stopping
+  log.close();
+}
 
 void OcpnLog::Flush() {
   wxLog::Flush();
-  log.flush();
+  m_wake.notify_one();
 }
 
 void OcpnLog::DoLogRecord(wxLogLevel level, const wxString& msg,
                           const wxLogRecordInfo& info) {
+  size_t pending = m_pending.fetch_add(1);
+  if (pending >= kMaxPending) {
+    m_pending--;
+    m_dropped++;
+    return;
+  }
   std::ostringstream oss;
   oss << timeStamp() << " " << std::setw(7) << level2str(level) << " "
-      << basename(info.filename) << ":" << info.line << " " << msg << std::endl;
-  log << oss.str();
+      << basename(info.filename) << ":" << info.line << " " << msg << "\n";
+  if (!m_queue.Push(oss.str())) {
+    m_pending--;
+    m_dropped++;
+    return;
+  }
+
+  if (level == wxLOG_FatalError) {
+    // The process is about to die, give the writer a second to save it.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (m_pending > 0 && std::chrono::steady_clock::now() < deadline) {
+      m_wake.notify_one();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  } else if (pending == kWakeupPending) {
+    m_wake.notify_one();
+  }
+}
+
+void OcpnLog::Run() {
+  std::unique_lock<std::mutex> lock(m_wake_mutex);
+  while (true) {
+    bool stop = m_stop;
+    lock.unlock();
+    WriteQueued();
+    lock.lock();
+    if (stop) return;
+    m_wake.wait_for(lock, kWriteInterval);
+  }
+}
+
+void OcpnLog::WriteQueued() {
+  std::string line;
+  size_t count = 0;
+  while (m_queue.Pop(line)) {
+    if (m_max_size && m_size + line.size() > m_max_size && m_size > 0)
+      Rotate();
+    log << line;
+    m_size += line.size();
+    count++;
+  }
+  unsigned long dropped = m_dropped;
+  if (dropped != m_dropped_reported) {
+    std::ostringstream oss;
+    oss << timeStamp() << " " << std::setw(7) << level2str(wxLOG_Warning)
+        << " " << basename(__FILE__) << ":" << __LINE__ << " "
+        << dropped - m_dropped_reported << " log records dropped\n";
+    log << oss.str();
+    m_size += oss.str().size();
+    m_dropped_reported = dropped;
+  }
+  if (count) {
+    log.flush();
+    m_pending -= count;
+  }
+}
+
+void OcpnLog::Rotate() {
+  log.close();
+  std::string old_path = m_path + ".log";
+  std::remove(old_path.c_str());
+  std::rename(m_path.c_str(), old_path.c_str());
+  log.open(m_path, std::fstream::out | std::fstream::app);
+  m_size = 0;
+}
+
+LogRateLimit::LogRateLimit(unsigned max_per_second)
+    : m_max(max_per_second), m_start(0), m_count(0), m_suppressed(0) {}
+
+bool LogRateLimit::Allow(unsigned& suppressed) {
+  using namespace std::chrono;
+  long long now =
+      duration_cast<milliseconds>(steady_clock::now().time_since_epoch())
+          .count();
+  long long start = m_start;
+  suppressed = 0;
+  if (now - start >= 1000 && m_start.compare_exchange_strong(start, now)) {
+    // First record of a new second
+    suppressed = m_suppressed.exchange(0);
+    m_count = 1;
+    return true;
+  }
+  if (m_count.fetch_add(1) < m_max) return true;
+  m_suppressed++;
+  return false;
 }
 
 Logger::Logger() : info("", 0, "", ""), level(wxLOG_Info){};
@@ -127,7 +295,7 @@ void Logger::logRecord(wxLogLevel level, const char* msg,
 
 void Logger::logMessage(wxLogLevel level, const char* path, int line,
                         const char* fmt, ...) {
-  wxLogRecordInfo info(__FILE__, __LINE__, "", "");
+  wxLogRecordInfo info(path, line, "", "");
   char buf[1024];
   va_list ap;
   va_start(ap, fmt);
@@ -0,0 +1,110 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Read only or shared writable file mappings
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "model/mapped_file.h"
+
+MappedFile::MappedFile() : m_data(0), m_size(0) {
+#ifdef _WIN32
+  m_file = INVALID_HANDLE_VALUE;
+  m_map = NULL;
+#endif
+}
+
+MappedFile::~MappedFile() { Unmap(); }
+
+bool MappedFile::Map(const std::string& path, bool writable) {
+  Unmap();
+#ifdef _WIN32
+  m_file = CreateFileA(path.c_str(),
+                       GENERIC_READ | (writable ? GENERIC_WRITE : 0),
+                       FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                       NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (m_file == INVALID_HANDLE_VALUE) return false;
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(m_file, &size)) {
+    Unmap();
+    return false;
+  }
+  m_size = size.QuadPart;
+  if (m_size == 0) return true;
+  m_map = CreateFileMappingA(m_file, NULL,
+                             writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0,
+                             NULL);
+  if (m_map)
+    m_data = (unsigned char*)MapViewOfFile(
+        m_map, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+#else
+  int fd = open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return false;
+  }
+  m_size = st.st_size;
+  if (m_size == 0) {
+    close(fd);
+    return true;
+  }
+  void* p = mmap(NULL, m_size, PROT_READ | (writable ? PROT_WRITE : 0),
+                 MAP_SHARED, fd, 0);
+  close(fd);
+  if (p != MAP_FAILED) m_data = (unsigned char*)p;
+#endif
+  if (!m_data) {
+    Unmap();
+    return false;
+  }
+  return true;
+}
+
+void MappedFile::Unmap() {
+#ifdef _WIN32
+  if (m_data) UnmapViewOfFile(m_data);
+  if (m_map) CloseHandle(m_map);
+  if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+  m_map = NULL;
+  m_file = INVALID_HANDLE_VALUE;
+#else
+  if (m_data) munmap(m_data, m_size);
+#endif
+  m_data = 0;
+  m_size = 0;
+}
+
+bool MappedFile::Sync() {
+  if (!m_data) return true;
+#ifdef _WIN32
+  return FlushViewOfFile(m_data, 0) && FlushFileBuffers(m_file);
+#else
+  return msync(m_data, m_size, MS_SYNC) == 0;
+#endif
+}
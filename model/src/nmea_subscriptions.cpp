@@ -0,0 +1,63 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  NMEA0183 sentence subscriptions of plugins
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+
+#include "model/nmea_subscriptions.h"
+
+std::string NmeaSubscriptions::SentenceId(const std::string& sentence) {
+  size_t start = sentence.find_first_of("$!");
+  if (start == std::string::npos) return "";
+  start++;
+  size_t end = sentence.find_first_of(",*\r\n", start);
+  if (end == std::string::npos) end = sentence.size();
+  if (end <= start) return "";
+  if (sentence[start] == 'P') return sentence.substr(start, end - start);
+  if (end - start < 3) return "";
+  return sentence.substr(end - 3, 3);
+}
+
+void NmeaSubscriptions::Clear() {
+  m_all.clear();
+  m_by_id.clear();
+}
+
+void NmeaSubscriptions::Add(int subscriber,
+                            const std::vector<std::string>& ids) {
+  if (ids.empty()) {
+    m_all.push_back(subscriber);
+    for (auto& item : m_by_id) item.second.push_back(subscriber);
+    return;
+  }
+  for (const auto& id : ids) {
+    auto found = m_by_id.find(id);
+    if (found == m_by_id.end())
+      found = m_by_id.emplace(id, m_all).first;
+    // The same id given twice
+    if (found->second.empty() || found->second.back() != subscriber)
+      found->second.push_back(subscriber);
+  }
+}
+
+const std::vector<int>& NmeaSubscriptions::Get(const std::string& id) const {
+  auto found = m_by_id.find(id);
+  return found == m_by_id.end() ? m_all : found->second;
+}
@@ -291,3 +291,11 @@ bool opencpn_plugin_118::RenderOverlayMultiCanvas(wxDC& dc, PlugIn_ViewPort* vp,
 						  int priority) {
   return false;
 }
+
+//    Opencpn_Plugin_119 Implementation
+opencpn_plugin_119::opencpn_plugin_119(void* pmgr) : opencpn_plugin_118(pmgr) {}
+
+void opencpn_plugin_119::SetNMEASentences(wxArrayString& sentences) {
+  for (size_t i = 0; i < sentences.GetCount(); i++)
+    SetNMEASentence(sentences[i]);
+}
@@ -33,6 +33,8 @@
 #include <wx/jsonval.h>
 #include <wx/jsonreader.h>
 
+#include "rapidjson/document.h"
+
 #include "model/base_platform.h"
 #include "model/comm_appmsg.h"
 #include "model/comm_drv_n0183_net.h"
@@ -40,6 +42,7 @@
 #include "model/comm_drv_n2k.h"
 #include "model/comm_drv_registry.h"
 #include "model/comm_navmsg_bus.h"
+#include "model/comm_util.h"
 
 #include "ocpn_plugin.h"
 using namespace std;
@@ -49,6 +52,14 @@ vector<uint8_t> GetN2000Payload(NMEA2000Id id, ObservedEvt ev) {
   return msg->payload;
 }
 
+N2000PayloadView GetN2000PayloadView(NMEA2000Id id, ObservedEvt ev) {
+  auto msg = UnpackEvtPointer<Nmea2000Msg>(ev);
+  if (!msg) return N2000PayloadView();
+  // Aliasing pointer: owns the message, points to its payload
+  return N2000PayloadView(
+      std::shared_ptr<const vector<uint8_t>>(msg, &msg->payload));
+}
+
 std::string GetN2000Source(NMEA2000Id id, ObservedEvt ev) {
   auto msg = UnpackEvtPointer<Nmea2000Msg>(ev);
   return msg->source->to_string();
@@ -69,7 +80,11 @@ std::shared_ptr<void> GetSignalkPayload(ObservedEvt ev) {
   auto msg = UnpackEvtPointer<SignalkMsg>(ev);
   wxJSONReader reader;
   wxJSONValue data;
-  reader.Parse(wxString(msg->raw_message), &data);
+  auto doc = msg->GetDocument();
+  if (!doc->HasParseError())
+    SignalkToJson(*doc, data);
+  else
+    reader.Parse(wxString(msg->raw_message), &data);
 
   wxJSONValue root(wxJSONTYPE_OBJECT);
   root["Data"] = data;
@@ -193,7 +193,11 @@ std::string PluginLoader::GetPluginVersion(
 }
 
 PlugInContainer::PlugInContainer()
-    : PlugInData(), m_pplugin(nullptr), m_library(), m_destroy_fn(nullptr) {}
+    : PlugInData(),
+      m_pplugin(nullptr),
+      m_library(),
+      m_destroy_fn(nullptr),
+      m_nmea_faulted(false) {}
 
 PlugInData::PlugInData()
     : m_has_setup_options(false),
@@ -343,7 +347,8 @@ void PluginLoader::NotifySetupOptionsPlugin(const PlugInData* pd) {
         case 115:
         case 116:
         case 117:
-        case 118: {
+        case 118:
+        case 119: {
           if (pic->m_pplugin) {
             auto ppi = dynamic_cast<opencpn_plugin_19*>(pic->m_pplugin);
             if (ppi) {
@@ -754,6 +759,7 @@ bool PluginLoader::UpdatePlugIns() {
       wxLogMessage(msg);
       if (pic->m_cap_flag & INSTALLS_TOOLBOX_PAGE)
         pic->m_has_setup_options = false;
+      pic->m_nmea_faulted = false;
       pic->m_cap_flag = pic->m_pplugin->Init();
       pic->m_pplugin->SetDefaults();
       pic->m_init_state = true;
@@ -1572,6 +1578,16 @@ PlugInContainer* PluginLoader::LoadPlugIn(const wxString& plugin_file,
                             p->GetPlugInVersionBuild());
       } while (false);  // NOLINT
       break;
+    case 119:
+      pic->m_pplugin = dynamic_cast<opencpn_plugin_119*>(plug_in);
+      do /* force a local scope */ {
+        auto p = dynamic_cast<opencpn_plugin_119*>(plug_in);
+        pi_ver =
+            SemanticVersion(pi_major, pi_minor, p->GetPlugInVersionPatch(),
+                            p->GetPlugInVersionPost(), p->GetPlugInVersionPre(),
+                            p->GetPlugInVersionBuild());
+      } while (false);  // NOLINT
+      break;
 
     default:
       break;
@@ -22,6 +22,8 @@
  ***************************************************************************
  */
 
+#include <vector>
+
 #include <wx/list.h>
 #include <wx/gdicmn.h>
 
@@ -42,23 +44,52 @@ Select::Select() {
 }
 
 Select::~Select() {
+  m_index.Clear();
   pSelectList->DeleteContents(true);
   pSelectList->Clear();
   delete pSelectList;
 }
 
-bool Select::IsSelectableRoutePointValid(RoutePoint *pRoutePoint) {
-  SelectItem *pFindSel;
+wxSelectableItemListNode *Select::AddItem(SelectItem *pSelItem,
+                                          bool at_front) {
+  wxSelectableItemListNode *node;
+  if (at_front)
+    node = pSelectList->Insert(pSelItem);
+  else
+    node = pSelectList->Append(pSelItem);
+  m_index.Add(pSelItem, node, at_front);
+  return node;
+}
 
-  //    Iterate on the select list
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
+void Select::RemoveItem(SelectItem *pSelItem) {
+  wxSelectableItemListNode *node = m_index.GetNode(pSelItem);
+  m_index.Remove(pSelItem);
+  if (node)
+    pSelectList->DeleteNode(node);
+  else
+    pSelectList->DeleteObject(pSelItem);
+  delete pSelItem;
+}
+
+void Select::FindCandidates(int fseltype, float slat, float slon,
+                            std::vector<SelectItem *> &candidates) {
+  if (m_index.Query(fseltype, slat, slon, selectRadius, candidates)) return;
 
+  //    Search window too large for the index, walk the list
+  candidates.clear();
+  wxSelectableItemListNode *node = pSelectList->GetFirst();
   while (node) {
-    pFindSel = node->GetData();
+    SelectItem *pFindSel = node->GetData();
+    if (pFindSel->m_seltype == fseltype) candidates.push_back(pFindSel);
+    node = node->GetNext();
+  }
+}
+
+bool Select::IsSelectableRoutePointValid(RoutePoint *pRoutePoint) {
+  for (SelectItem *pFindSel : m_index.GetByData(pRoutePoint)) {
     if (pFindSel->m_seltype == SELTYPE_ROUTEPOINT &&
         (RoutePoint *)pFindSel->m_pData1 == pRoutePoint)
       return true;
-    node = node->GetNext();
   }
   return false;
 }
@@ -72,12 +103,8 @@ bool Select::AddSelectableRoutePoint(float slat, float slon,
   pSelItem->m_bIsSelected = false;
   pSelItem->m_pData1 = pRoutePointAdd;
 
-  wxSelectableItemListNode *node;
-
-  if (pRoutePointAdd->m_bIsInLayer)
-    node = pSelectList->Append(pSelItem);
-  else
-    node = pSelectList->Insert(pSelItem);
+  wxSelectableItemListNode *node =
+      AddItem(pSelItem, !pRoutePointAdd->m_bIsInLayer);
 
   pRoutePointAdd->SetSelectNode(node);
 
@@ -99,67 +126,33 @@ bool Select::AddSelectableRouteSegment(float slat1, float slon1, float slat2,
   pSelItem->m_pData2 = pRoutePointAdd2;
   pSelItem->m_pData3 = pRoute;
 
-  if (pRoute->m_bIsInLayer)
-    pSelectList->Append(pSelItem);
-  else
-    pSelectList->Insert(pSelItem);
+  AddItem(pSelItem, !pRoute->m_bIsInLayer);
 
   return true;
 }
 
 bool Select::DeleteAllSelectableRouteSegments(Route *pr) {
-  SelectItem *pFindSel;
-
-  //    Iterate on the select list
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-  while (node) {
-    pFindSel = node->GetData();
-    if (pFindSel->m_seltype == SELTYPE_ROUTESEGMENT &&
-        (Route *)pFindSel->m_pData3 == pr) {
-      delete pFindSel;
-      wxSelectableItemListNode *d = node;
-      node = node->GetNext();
-      pSelectList->DeleteNode(d);  // delete node;
-    } else
-      node = node->GetNext();
+  for (SelectItem *pFindSel : m_index.GetByOwner(pr)) {
+    if (pFindSel->m_seltype == SELTYPE_ROUTESEGMENT) RemoveItem(pFindSel);
   }
 
   return true;
 }
 
 bool Select::DeleteAllSelectableRoutePoints(Route *pr) {
-  SelectItem *pFindSel;
-
-  //    Iterate on the select list
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-  while (node) {
-    pFindSel = node->GetData();
-    if (pFindSel->m_seltype == SELTYPE_ROUTEPOINT) {
-      RoutePoint *ps = (RoutePoint *)pFindSel->m_pData1;
-
-      //    inner loop iterates on the route's point list
-      wxRoutePointListNode *pnode = (pr->pRoutePointList)->GetFirst();
-      while (pnode) {
-        RoutePoint *prp = pnode->GetData();
-
-        if (prp == ps) {
-          delete pFindSel;
-          pSelectList->DeleteNode(node);  // delete node;
-          prp->SetSelectNode(NULL);
-
-          node = pSelectList->GetFirst();
-
-          goto got_next_outer_node;
-        }
-        pnode = pnode->GetNext();
+  //    Iterate on the route's point list
+  wxRoutePointListNode *pnode = (pr->pRoutePointList)->GetFirst();
+  while (pnode) {
+    RoutePoint *prp = pnode->GetData();
+
+    for (SelectItem *pFindSel : m_index.GetByData(prp)) {
+      if (pFindSel->m_seltype == SELTYPE_ROUTEPOINT &&
+          (RoutePoint *)pFindSel->m_pData1 == prp) {
+        RemoveItem(pFindSel);
+        prp->SetSelectNode(NULL);
       }
     }
-
-    node = node->GetNext();
-  got_next_outer_node:
-    continue;
+    pnode = pnode->GetNext();
   }
   return true;
 }
@@ -235,29 +228,24 @@ bool Select::AddAllSelectableTrackSegments(Track *pr) {
 }
 
 bool Select::UpdateSelectableRouteSegments(RoutePoint *prp) {
-  SelectItem *pFindSel;
   bool ret = false;
 
-  //    Iterate on the select list
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-  while (node) {
-    pFindSel = node->GetData();
+  for (SelectItem *pFindSel : m_index.GetByData(prp)) {
     if (pFindSel->m_seltype == SELTYPE_ROUTESEGMENT) {
       if (pFindSel->m_pData1 == prp) {
         pFindSel->m_slat = prp->m_lat;
         pFindSel->m_slon = prp->m_lon;
+        m_index.Move(pFindSel);
         ret = true;
-        ;
       }
 
       else if (pFindSel->m_pData2 == prp) {
         pFindSel->m_slat2 = prp->m_lat;
         pFindSel->m_slon2 = prp->m_lon;
+        m_index.Move(pFindSel);
         ret = true;
       }
     }
-    node = node->GetNext();
   }
 
   return ret;
@@ -273,7 +261,7 @@ SelectItem *Select::AddSelectablePoint(float slat, float slon,
     pSelItem->m_bIsSelected = false;
     pSelItem->m_pData1 = pdata;
 
-    pSelectList->Append(pSelItem);
+    AddItem(pSelItem, false);
   }
 
   return pSelItem;
@@ -289,57 +277,31 @@ bool Select::DeleteAllPoints( void )
 */
 
 bool Select::DeleteSelectablePoint(void *pdata, int SeltypeToDelete) {
-  SelectItem *pFindSel;
-
   if (NULL != pdata) {
-    //    Iterate on the list
-    wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-    while (node) {
-      pFindSel = node->GetData();
-      if (pFindSel->m_seltype == SeltypeToDelete) {
-        if (pdata == pFindSel->m_pData1) {
-          delete pFindSel;
-          delete node;
-
-          if (SELTYPE_ROUTEPOINT == SeltypeToDelete) {
-            RoutePoint *prp = (RoutePoint *)pdata;
-            prp->SetSelectNode(NULL);
-          }
+    for (SelectItem *pFindSel : m_index.GetByData(pdata)) {
+      if (pFindSel->m_seltype == SeltypeToDelete &&
+          pdata == pFindSel->m_pData1) {
+        RemoveItem(pFindSel);
 
-          return true;
+        if (SELTYPE_ROUTEPOINT == SeltypeToDelete) {
+          RoutePoint *prp = (RoutePoint *)pdata;
+          prp->SetSelectNode(NULL);
         }
+
+        return true;
       }
-      node = node->GetNext();
     }
   }
   return false;
 }
 
 bool Select::DeleteAllSelectableTypePoints(int SeltypeToDelete) {
-  SelectItem *pFindSel;
-
-  //    Iterate on the list
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-  while (node) {
-    pFindSel = node->GetData();
-    if (pFindSel->m_seltype == SeltypeToDelete) {
-      delete node;
-
-      if (SELTYPE_ROUTEPOINT == SeltypeToDelete) {
-        RoutePoint *prp = (RoutePoint *)pFindSel->m_pData1;
-        prp->SetSelectNode(NULL);
-      }
-      delete pFindSel;
-
-      node = pSelectList->GetFirst();
-      goto got_next_node;
+  for (SelectItem *pFindSel : m_index.GetByType(SeltypeToDelete)) {
+    if (SELTYPE_ROUTEPOINT == SeltypeToDelete) {
+      RoutePoint *prp = (RoutePoint *)pFindSel->m_pData1;
+      prp->SetSelectNode(NULL);
     }
-
-    node = node->GetNext();
-  got_next_node:
-    continue;
+    RemoveItem(pFindSel);
   }
   return true;
 }
@@ -351,8 +313,7 @@ bool Select::DeleteSelectableRoutePoint(RoutePoint *prp) {
     if (node) {
       SelectItem *pFindSel = node->GetData();
       if (pFindSel) {
-        delete pFindSel;
-        delete node;  // automatically removes from list
+        RemoveItem(pFindSel);  // also removes node from list
         prp->SetSelectNode(NULL);
         return true;
       }
@@ -364,26 +325,27 @@ bool Select::DeleteSelectableRoutePoint(RoutePoint *prp) {
 
 bool Select::ModifySelectablePoint(float lat, float lon, void *data,
                                    int SeltypeToModify) {
-  SelectItem *pFindSel;
-
-  //    Iterate on the list
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-  while (node) {
-    pFindSel = node->GetData();
-    if (pFindSel->m_seltype == SeltypeToModify) {
-      if (data == pFindSel->m_pData1) {
-        pFindSel->m_slat = lat;
-        pFindSel->m_slon = lon;
-        return true;
-      }
+  for (SelectItem *pFindSel : m_index.GetByData(data)) {
+    if (pFindSel->m_seltype == SeltypeToModify &&
+        data == pFindSel->m_pData1) {
+      pFindSel->m_slat = lat;
+      pFindSel->m_slon = lon;
+      m_index.Move(pFindSel);
+      return true;
     }
-
-    node = node->GetNext();
   }
   return false;
 }
 
+bool Select::ModifySelectablePoint(float lat, float lon,
+                                   SelectItem *pSelItem) {
+  if (!m_index.Contains(pSelItem)) return false;
+  pSelItem->m_slat = lat;
+  pSelItem->m_slon = lon;
+  m_index.Move(pSelItem);
+  return true;
+}
+
 bool Select::AddSelectableTrackSegment(float slat1, float slon1, float slat2,
                                        float slon2, TrackPoint *pTrackPointAdd1,
                                        TrackPoint *pTrackPointAdd2,
@@ -399,51 +361,24 @@ bool Select::AddSelectableTrackSegment(float slat1, float slon1, float slat2,
   pSelItem->m_pData2 = pTrackPointAdd2;
   pSelItem->m_pData3 = pTrack;
 
-  if (pTrack->m_bIsInLayer)
-    pSelectList->Append(pSelItem);
-  else
-    pSelectList->Insert(pSelItem);
+  AddItem(pSelItem, !pTrack->m_bIsInLayer);
 
   return true;
 }
 
 bool Select::DeleteAllSelectableTrackSegments(Track *pt) {
-  SelectItem *pFindSel;
-
-  //    Iterate on the select list
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-  while (node) {
-    pFindSel = node->GetData();
-    if (pFindSel->m_seltype == SELTYPE_TRACKSEGMENT &&
-        (Track *)pFindSel->m_pData3 == pt) {
-      delete pFindSel;
-      wxSelectableItemListNode *d = node;
-      node = node->GetNext();
-      pSelectList->DeleteNode(d);  // delete node;
-    } else
-      node = node->GetNext();
+  for (SelectItem *pFindSel : m_index.GetByOwner(pt)) {
+    if (pFindSel->m_seltype == SELTYPE_TRACKSEGMENT) RemoveItem(pFindSel);
   }
   return true;
 }
 
 bool Select::DeletePointSelectableTrackSegments(TrackPoint *pt) {
-  SelectItem *pFindSel;
-
-  //    Iterate on the select list
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-  while (node) {
-    pFindSel = node->GetData();
+  for (SelectItem *pFindSel : m_index.GetByData(pt)) {
     if (pFindSel->m_seltype == SELTYPE_TRACKSEGMENT &&
         ((TrackPoint *)pFindSel->m_pData1 == pt ||
-         (TrackPoint *)pFindSel->m_pData2 == pt)) {
-      delete pFindSel;
-      wxSelectableItemListNode *d = node;
-      node = node->GetNext();
-      pSelectList->DeleteNode(d);  // delete node;
-    } else
-      node = node->GetNext();
+         (TrackPoint *)pFindSel->m_pData2 == pt))
+      RemoveItem(pFindSel);
   }
   return true;
 }
@@ -520,43 +455,40 @@ SelectItem *Select::FindSelection(SelectCtx& ctx, float slat, float slon,
 
   CalcSelectRadius(ctx);
 
-  //    Iterate on the list
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-  while (node) {
-    pFindSel = node->GetData();
-    if (pFindSel->m_seltype == fseltype) {
-      switch (fseltype) {
-        case SELTYPE_ROUTEPOINT:
-        case SELTYPE_TIDEPOINT:
-        case SELTYPE_CURRENTPOINT:
-        case SELTYPE_AISTARGET:
-          if ((fabs(slat - pFindSel->m_slat) < selectRadius) &&
-              (fabs(slon - pFindSel->m_slon) < selectRadius)) {
-                if(fseltype == SELTYPE_ROUTEPOINT) {
-                    if (((RoutePoint *)pFindSel->m_pData1)->IsVisibleSelectable(ctx.chart_scale))
-                      goto find_ok;
-                } else {
+  //    Iterate on the items near slat/slon, in list order
+  std::vector<SelectItem *> candidates;
+  FindCandidates(fseltype, slat, slon, candidates);
+
+  for (SelectItem *pCandidate : candidates) {
+    pFindSel = pCandidate;
+    switch (fseltype) {
+      case SELTYPE_ROUTEPOINT:
+      case SELTYPE_TIDEPOINT:
+      case SELTYPE_CURRENTPOINT:
+      case SELTYPE_AISTARGET:
+        if ((fabs(slat - pFindSel->m_slat) < selectRadius) &&
+            (fabs(slon - pFindSel->m_slon) < selectRadius)) {
+              if(fseltype == SELTYPE_ROUTEPOINT) {
+                  if (((RoutePoint *)pFindSel->m_pData1)->IsVisibleSelectable(ctx.chart_scale))
                     goto find_ok;
-                }
-          }
-          break;
-        case SELTYPE_ROUTESEGMENT:
-        case SELTYPE_TRACKSEGMENT: {
-          a = pFindSel->m_slat;
-          b = pFindSel->m_slat2;
-          c = pFindSel->m_slon;
-          d = pFindSel->m_slon2;
-
-          if (IsSegmentSelected(a, b, c, d, slat, slon)) goto find_ok;
-          break;
+              } else {
+                  goto find_ok;
+              }
         }
-        default:
-          break;
+        break;
+      case SELTYPE_ROUTESEGMENT:
+      case SELTYPE_TRACKSEGMENT: {
+        a = pFindSel->m_slat;
+        b = pFindSel->m_slat2;
+        c = pFindSel->m_slon;
+        d = pFindSel->m_slon2;
+
+        if (IsSegmentSelected(a, b, c, d, slat, slon)) goto find_ok;
+        break;
       }
+      default:
+        break;
     }
-
-    node = node->GetNext();
   }
 
   return NULL;
@@ -566,18 +498,7 @@ SelectItem *Select::FindSelection(SelectCtx& ctx, float slat, float slon,
 
 bool Select::IsSelectableSegmentSelected(SelectCtx& ctx, float slat,
                                          float slon, SelectItem *pFindSel) {
-  bool valid = false;
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-  while (node) {
-    if (pFindSel == node->GetData()) {
-      valid = true;
-      break;
-    }
-    node = node->GetNext();
-  }
-
-  if (valid == false) {
+  if (!m_index.Contains(pFindSel)) {
     // not in the list anymore
     return false;
   }
@@ -611,53 +532,50 @@ SelectableItemList Select::FindSelectionList(SelectCtx& ctx, float slat,
 
   CalcSelectRadius(ctx);
 
-  //    Iterate on the list
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-  while (node) {
-    pFindSel = node->GetData();
-    if (pFindSel->m_seltype == fseltype) {
-      switch (fseltype) {
-        case SELTYPE_ROUTEPOINT:
-          if ((fabs(slat - pFindSel->m_slat) < selectRadius) &&
-              (fabs(slon - pFindSel->m_slon) < selectRadius))
-            if (is_selectable_wp(ctx, (RoutePoint *)pFindSel->m_pData1))
-              if (((RoutePoint *)pFindSel->m_pData1)->IsVisibleSelectable(ctx.chart_scale))
-                ret_list.Append(pFindSel);
-          break;
-        case SELTYPE_TIDEPOINT:
-        case SELTYPE_CURRENTPOINT:
-        case SELTYPE_AISTARGET:
-        case SELTYPE_DRAGHANDLE:
-          if ((fabs(slat - pFindSel->m_slat) < selectRadius) &&
-              (fabs(slon - pFindSel->m_slon) < selectRadius)) {
-            if (is_selectable_wp(ctx, (RoutePoint *)pFindSel->m_pData1))
+  //    Iterate on the items near slat/slon, in list order
+  std::vector<SelectItem *> candidates;
+  FindCandidates(fseltype, slat, slon, candidates);
+
+  for (SelectItem *pCandidate : candidates) {
+    pFindSel = pCandidate;
+    switch (fseltype) {
+      case SELTYPE_ROUTEPOINT:
+        if ((fabs(slat - pFindSel->m_slat) < selectRadius) &&
+            (fabs(slon - pFindSel->m_slon) < selectRadius))
+          if (is_selectable_wp(ctx, (RoutePoint *)pFindSel->m_pData1))
+            if (((RoutePoint *)pFindSel->m_pData1)->IsVisibleSelectable(ctx.chart_scale))
               ret_list.Append(pFindSel);
+        break;
+      case SELTYPE_TIDEPOINT:
+      case SELTYPE_CURRENTPOINT:
+      case SELTYPE_AISTARGET:
+      case SELTYPE_DRAGHANDLE:
+        if ((fabs(slat - pFindSel->m_slat) < selectRadius) &&
+            (fabs(slon - pFindSel->m_slon) < selectRadius)) {
+          if (is_selectable_wp(ctx, (RoutePoint *)pFindSel->m_pData1))
+            ret_list.Append(pFindSel);
+        }
+        break;
+      case SELTYPE_ROUTESEGMENT:
+      case SELTYPE_TRACKSEGMENT: {
+        a = pFindSel->m_slat;
+        b = pFindSel->m_slat2;
+        c = pFindSel->m_slon;
+        d = pFindSel->m_slon2;
+
+        if (IsSegmentSelected(a, b, c, d, slat, slon)) {
+          if (ctx.show_nav_objects ||
+              (fseltype == SELTYPE_ROUTESEGMENT &&
+               ((Route *)pFindSel->m_pData3)->m_bRtIsActive)) {
+            ret_list.Append(pFindSel);
           }
-          break;
-        case SELTYPE_ROUTESEGMENT:
-        case SELTYPE_TRACKSEGMENT: {
-          a = pFindSel->m_slat;
-          b = pFindSel->m_slat2;
-          c = pFindSel->m_slon;
-          d = pFindSel->m_slon2;
-
-          if (IsSegmentSelected(a, b, c, d, slat, slon)) {
-            if (ctx.show_nav_objects ||
-                (fseltype == SELTYPE_ROUTESEGMENT &&
-                 ((Route *)pFindSel->m_pData3)->m_bRtIsActive)) {
-              ret_list.Append(pFindSel);
-            }
-          }
-
-          break;
         }
-        default:
-          break;
+
+        break;
       }
+      default:
+        break;
     }
-
-    node = node->GetNext();
   }
 
   return ret_list;
@@ -0,0 +1,232 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Spatial and reference lookup tables for Select
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "model/select.h"
+#include "model/select_index.h"
+
+/** Segments covering more cells than this go to the per type list. */
+static const int kMaxSegmentCells = 64;
+
+/** Larger query windows fall back to walking the list. */
+static const int kMaxQueryCells = 1024;
+
+/** Same normalization as Select::IsSegmentSelected(). */
+static void NormalizeLatLon(float &lat, float &lon) {
+  if (lat > 90.0) lat -= 180.0;
+  if (lon > 180.0) lon -= 360.0;
+}
+
+SelectIndex::SelectIndex(double cell_deg)
+    : m_cell_deg(cell_deg), m_front_seq(0), m_back_seq(0) {}
+
+bool SelectIndex::IsSegmentType(int seltype) {
+  return seltype == SELTYPE_ROUTESEGMENT || seltype == SELTYPE_TRACKSEGMENT;
+}
+
+int SelectIndex::CellOf(double deg) const {
+  return static_cast<int>(std::floor(deg / m_cell_deg));
+}
+
+void SelectIndex::Erase(std::vector<SelectItem *> &v, SelectItem *item) {
+  auto it = std::find(v.begin(), v.end(), item);
+  if (it == v.end()) return;
+  *it = v.back();
+  v.pop_back();
+}
+
+void SelectIndex::Add(SelectItem *item, wxSelectableItemListNode *node,
+                      bool at_front) {
+  Entry &entry = m_entries[item];
+  entry.node = node;
+  entry.seq = at_front ? --m_front_seq : ++m_back_seq;
+  Bin(item, entry);
+
+  m_types[item->m_seltype].items.insert(item);
+  if (item->m_pData1) m_by_data[item->m_pData1].push_back(item);
+  if (IsSegmentType(item->m_seltype)) {
+    if (item->m_pData2 && item->m_pData2 != item->m_pData1)
+      m_by_data[item->m_pData2].push_back(item);
+    if (item->m_pData3) m_by_owner[item->m_pData3].insert(item);
+  }
+}
+
+void SelectIndex::Remove(SelectItem *item) {
+  auto found = m_entries.find(item);
+  if (found == m_entries.end()) return;
+  Unbin(item, found->second);
+  m_entries.erase(found);
+
+  m_types[item->m_seltype].items.erase(item);
+
+  auto remove_data = [&](const void *data) {
+    auto it = m_by_data.find(data);
+    if (it == m_by_data.end()) return;
+    Erase(it->second, item);
+    if (it->second.empty()) m_by_data.erase(it);
+  };
+  if (item->m_pData1) remove_data(item->m_pData1);
+  if (IsSegmentType(item->m_seltype)) {
+    if (item->m_pData2 && item->m_pData2 != item->m_pData1)
+      remove_data(item->m_pData2);
+    if (item->m_pData3) {
+      auto it = m_by_owner.find(item->m_pData3);
+      if (it != m_by_owner.end()) {
+        it->second.erase(item);
+        if (it->second.empty()) m_by_owner.erase(it);
+      }
+    }
+  }
+}
+
+void SelectIndex::Move(SelectItem *item) {
+  auto found = m_entries.find(item);
+  if (found == m_entries.end()) return;
+  Unbin(item, found->second);
+  Bin(item, found->second);
+}
+
+void SelectIndex::Clear() {
+  m_entries.clear();
+  m_types.clear();
+  m_by_data.clear();
+  m_by_owner.clear();
+  m_front_seq = m_back_seq = 0;
+}
+
+wxSelectableItemListNode *SelectIndex::GetNode(const SelectItem *item) const {
+  auto found = m_entries.find(item);
+  return found == m_entries.end() ? nullptr : found->second.node;
+}
+
+void SelectIndex::Bin(SelectItem *item, Entry &entry) {
+  TypeIndex &type = m_types[item->m_seltype];
+  entry.cells.clear();
+  entry.large = false;
+
+  float lat1 = item->m_slat;
+  float lon1 = item->m_slon;
+  float lat2 = lat1;
+  float lon2 = lon1;
+  if (IsSegmentType(item->m_seltype)) {
+    lat2 = item->m_slat2;
+    lon2 = item->m_slon2;
+    NormalizeLatLon(lat1, lon1);
+    NormalizeLatLon(lat2, lon2);
+    // Segments crossing the prime meridian or the antimeridian get their
+    // longitudes rearranged by IsSegmentSelected(), keep them out of the
+    // grid.
+    if (lon1 * lon2 < 0.) entry.large = true;
+  }
+
+  int ilat1 = CellOf(std::min(lat1, lat2));
+  int ilat2 = CellOf(std::max(lat1, lat2));
+  int ilon1 = CellOf(std::min(lon1, lon2));
+  int ilon2 = CellOf(std::max(lon1, lon2));
+  if (static_cast<int64_t>(ilat2 - ilat1 + 1) * (ilon2 - ilon1 + 1) >
+      kMaxSegmentCells)
+    entry.large = true;
+
+  if (entry.large) {
+    type.large.insert(item);
+    return;
+  }
+  for (int ilat = ilat1; ilat <= ilat2; ilat++) {
+    for (int ilon = ilon1; ilon <= ilon2; ilon++) {
+      int64_t key = Key(ilat, ilon);
+      type.cells[key].push_back(item);
+      entry.cells.push_back(key);
+    }
+  }
+}
+
+void SelectIndex::Unbin(SelectItem *item, Entry &entry) {
+  TypeIndex &type = m_types[item->m_seltype];
+  if (entry.large) {
+    type.large.erase(item);
+    return;
+  }
+  for (int64_t key : entry.cells) {
+    auto cell = type.cells.find(key);
+    if (cell == type.cells.end()) continue;
+    Erase(cell->second, item);
+    if (cell->second.empty()) type.cells.erase(cell);
+  }
+  entry.cells.clear();
+}
+
+bool SelectIndex::Query(int seltype, float lat, float lon, float radius,
+                        std::vector<SelectItem *> &out) const {
+  out.clear();
+  auto found = m_types.find(seltype);
+  if (found == m_types.end()) return true;
+  const TypeIndex &type = found->second;
+
+  if (IsSegmentType(seltype)) NormalizeLatLon(lat, lon);
+  int ilat1 = CellOf(lat - radius);
+  int ilat2 = CellOf(lat + radius);
+  int ilon1 = CellOf(lon - radius);
+  int ilon2 = CellOf(lon + radius);
+  if (static_cast<int64_t>(ilat2 - ilat1 + 1) * (ilon2 - ilon1 + 1) >
+      kMaxQueryCells)
+    return false;
+
+  std::vector<std::pair<int64_t, SelectItem *>> hits;
+  for (int ilat = ilat1; ilat <= ilat2; ilat++) {
+    for (int ilon = ilon1; ilon <= ilon2; ilon++) {
+      auto cell = type.cells.find(Key(ilat, ilon));
+      if (cell == type.cells.end()) continue;
+      for (SelectItem *item : cell->second)
+        hits.emplace_back(m_entries.at(item).seq, item);
+    }
+  }
+  for (SelectItem *item : type.large)
+    hits.emplace_back(m_entries.at(item).seq, item);
+
+  std::sort(hits.begin(), hits.end());
+  hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+  out.reserve(hits.size());
+  for (auto &hit : hits) out.push_back(hit.second);
+  return true;
+}
+
+std::vector<SelectItem *> SelectIndex::GetByData(const void *data) const {
+  auto found = m_by_data.find(data);
+  if (found == m_by_data.end()) return {};
+  return found->second;
+}
+
+std::vector<SelectItem *> SelectIndex::GetByOwner(const void *owner) const {
+  auto found = m_by_owner.find(owner);
+  if (found == m_by_owner.end()) return {};
+  return std::vector<SelectItem *>(found->second.begin(), found->second.end());
+}
+
+std::vector<SelectItem *> SelectIndex::GetByType(int seltype) const {
+  auto found = m_types.find(seltype);
+  if (found == m_types.end()) return {};
+  return std::vector<SelectItem *>(found->second.items.begin(),
+                                   found->second.items.end());
+}
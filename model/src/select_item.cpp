@@ -27,7 +27,8 @@
 #include <wx/listimpl.cpp>
 WX_DEFINE_LIST(SelectableItemList);
 
-SelectItem::SelectItem() {}
+SelectItem::SelectItem()
+    : m_pData1(NULL), m_pData2(NULL), m_pData3(NULL), m_Data4(0) {}
 
 SelectItem::~SelectItem() {}
 
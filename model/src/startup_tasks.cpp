@@ -0,0 +1,254 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Dependency ordered, timed startup tasks
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+
+#include <wx/log.h>
+
+#include "model/startup_tasks.h"
+
+StartupTasks::StartupTasks()
+    : m_last_inline(-1), m_stop(false), m_origin(Clock::now()) {}
+
+StartupTasks::~StartupTasks() { Stop(); }
+
+int StartupTasks::Add(const std::string& name, Func func,
+                      const std::vector<int>& deps, Where where) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  int id = static_cast<int>(m_tasks.size());
+  Task task;
+  task.name = name;
+  task.func = std::move(func);
+  task.deps = deps;
+  task.where = where;
+  task.pending = 0;
+  task.done = false;
+  task.failed = false;
+  m_tasks.push_back(std::move(task));
+  for (int dep : deps) {
+    if (dep < 0 || dep >= id || m_tasks[dep].done) continue;
+    m_tasks[dep].dependents.push_back(id);
+    m_tasks[id].pending++;
+  }
+  if (!m_tasks[id].pending) Enqueue(id);
+  return id;
+}
+
+void StartupTasks::Start(unsigned n_workers) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (!m_workers.empty()) return;
+  if (n_workers == 0)
+    n_workers = std::max(2u, std::thread::hardware_concurrency());
+  m_stop = false;
+  for (unsigned i = 0; i < n_workers; i++)
+    m_workers.emplace_back([this] { Worker(); });
+}
+
+void StartupTasks::Stop() {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for (auto& worker : m_workers) worker.join();
+  m_workers.clear();
+}
+
+void StartupTasks::Enqueue(int id) {
+  if (m_tasks[id].where == Where::kMain)
+    m_main_ready.push_back(id);
+  else
+    m_worker_ready.push_back(id);
+  m_cv.notify_all();
+}
+
+void StartupTasks::Complete(int id) {
+  Task& task = m_tasks[id];
+  task.done = true;
+  for (int dependent : task.dependents) {
+    if (--m_tasks[dependent].pending == 0) Enqueue(dependent);
+  }
+  m_cv.notify_all();
+}
+
+void StartupTasks::RunTask(std::unique_lock<std::mutex>& lock, int id) {
+  Func func = std::move(m_tasks[id].func);
+  std::string name = m_tasks[id].name;
+  m_tasks[id].start = Clock::now();
+  lock.unlock();
+
+  //  Reported, dependents still run
+  bool failed = false;
+  std::string error;
+  try {
+    if (func) func();
+  } catch (const std::exception& e) {
+    failed = true;
+    error = e.what();
+    wxLogMessage("Startup task %s failed: %s", name.c_str(), error.c_str());
+  } catch (...) {
+    failed = true;
+    wxLogMessage("Startup task %s failed", name.c_str());
+  }
+
+  lock.lock();
+  m_tasks[id].end = Clock::now();
+  m_tasks[id].failed = failed;
+  m_tasks[id].error = error;
+  Complete(id);
+}
+
+void StartupTasks::Worker() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [this] { return m_stop || !m_worker_ready.empty(); });
+    if (!m_worker_ready.empty()) {
+      int id = m_worker_ready.front();
+      m_worker_ready.pop_front();
+      RunTask(lock, id);
+    } else if (m_stop) {
+      return;
+    }
+  }
+}
+
+bool StartupTasks::RunOneMain(std::unique_lock<std::mutex>& lock) {
+  if (m_main_ready.empty()) return false;
+  int id = m_main_ready.front();
+  m_main_ready.pop_front();
+  RunTask(lock, id);
+  return true;
+}
+
+void StartupTasks::Wait(int id) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (id < 0 || id >= static_cast<int>(m_tasks.size())) return;
+  while (!m_tasks[id].done) {
+    if (RunOneMain(lock)) continue;
+    // Without workers, worker tasks are run here too
+    if (m_workers.empty() && !m_worker_ready.empty()) {
+      int next = m_worker_ready.front();
+      m_worker_ready.pop_front();
+      RunTask(lock, next);
+      continue;
+    }
+    m_cv.wait(lock);
+  }
+  m_waited.push_back(id);
+}
+
+void StartupTasks::WaitAll() {
+  int n_tasks;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    n_tasks = static_cast<int>(m_tasks.size());
+  }
+  for (int id = 0; id < n_tasks; id++) Wait(id);
+}
+
+int StartupTasks::Begin(const std::string& name) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  int id = static_cast<int>(m_tasks.size());
+  Task task;
+  task.name = name;
+  task.deps = m_waited;
+  if (m_last_inline >= 0) task.deps.push_back(m_last_inline);
+  task.where = Where::kMain;
+  task.pending = 0;
+  task.done = false;
+  task.failed = false;
+  task.start = Clock::now();
+  m_tasks.push_back(std::move(task));
+  m_waited.clear();
+  return id;
+}
+
+void StartupTasks::End(int id) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (id < 0 || id >= static_cast<int>(m_tasks.size())) return;
+  m_tasks[id].end = Clock::now();
+  m_last_inline = id;
+  Complete(id);
+}
+
+bool StartupTasks::IsDone(int id) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  return id >= 0 && id < static_cast<int>(m_tasks.size()) && m_tasks[id].done;
+}
+
+long StartupTasks::Millis(Clock::time_point t) const {
+  return static_cast<long>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(t - m_origin)
+          .count());
+}
+
+std::vector<int> StartupTasks::CriticalPath() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  std::vector<int> path;
+  int last = -1;
+  for (int i = 0; i < static_cast<int>(m_tasks.size()); i++) {
+    if (!m_tasks[i].done) continue;
+    if (last < 0 || m_tasks[i].end > m_tasks[last].end) last = i;
+  }
+  // Walk back through the dependency which finished last
+  while (last >= 0) {
+    path.push_back(last);
+    int prev = -1;
+    for (int dep : m_tasks[last].deps) {
+      if (dep < 0 || !m_tasks[dep].done) continue;
+      if (prev < 0 || m_tasks[dep].end > m_tasks[prev].end) prev = dep;
+    }
+    last = prev;
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+std::vector<std::string> StartupTasks::Report() {
+  std::vector<int> path = CriticalPath();
+  std::unique_lock<std::mutex> lock(m_mutex);
+  std::vector<std::string> lines;
+  char buf[256];
+  for (const auto& task : m_tasks) {
+    if (!task.done) continue;
+    snprintf(buf, sizeof(buf), "%7ld ms %7ld ms  %-6s %s",
+             Millis(task.start), Millis(task.end) - Millis(task.start),
+             task.where == Where::kMain ? "main" : "worker", task.name.c_str());
+    std::string line(buf);
+    if (task.failed)
+      line += task.error.empty() ? " (failed)" : " (failed: " + task.error + ")";
+    lines.push_back(line);
+  }
+  if (!path.empty()) {
+    std::string s("Critical path:");
+    for (size_t i = 0; i < path.size(); i++) {
+      s += i ? " > " : " ";
+      s += m_tasks[path[i]].name;
+    }
+    snprintf(buf, sizeof(buf), " (%ld ms)", Millis(m_tasks[path.back()].end));
+    s += buf;
+    lines.push_back(s);
+  }
+  return lines;
+}
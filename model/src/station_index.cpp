@@ -0,0 +1,143 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Station index of tide and current harmonics files
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "model/station_index.h"
+
+#define STATION_INDEX_MAGIC 0x5854534f  // "OSTX"
+#define STATION_INDEX_VERSION 1
+
+struct StationIndexHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t source_size;
+  int64_t source_time;
+  uint32_t n_entries;
+  uint32_t names_size;
+  char ident[96];
+};
+
+static_assert(sizeof(StationIndexHeader) == 128, "index header layout");
+static_assert(sizeof(StationIndexEntry) == 72, "index entry layout");
+
+static const StationIndexHeader* Header(const MappedFile& file) {
+  return (const StationIndexHeader*)file.GetData();
+}
+
+static const StationIndexEntry* Entries(const MappedFile& file) {
+  return (const StationIndexEntry*)(file.GetData() +
+                                    sizeof(StationIndexHeader));
+}
+
+static const char* Names(const MappedFile& file) {
+  return (const char*)(Entries(file) + Header(file)->n_entries);
+}
+
+bool StationIndex::Write(const std::string& path, uint64_t source_size,
+                         int64_t source_time, const std::string& ident,
+                         const std::vector<StationIndexEntry>& entries,
+                         const std::vector<std::string>& names) {
+  StationIndexHeader hdr;
+  memset(&hdr, 0, sizeof(hdr));
+  hdr.magic = STATION_INDEX_MAGIC;
+  hdr.version = STATION_INDEX_VERSION;
+  hdr.source_size = source_size;
+  hdr.source_time = source_time;
+  hdr.n_entries = entries.size();
+  strncpy(hdr.ident, ident.c_str(), sizeof(hdr.ident) - 1);
+
+  std::string table;
+  std::vector<StationIndexEntry> out(entries);
+  for (size_t i = 0; i < out.size(); i++) {
+    out[i].name = table.size();
+    if (i < names.size()) table += names[i];
+    table += '\0';
+  }
+  if (table.empty()) table += '\0';
+  hdr.names_size = table.size();
+
+  //  Replaced as a whole, so a reader never sees a partial index
+  std::string tmp_path = path + ".tmp";
+  FILE* f = fopen(tmp_path.c_str(), "wb");
+  if (!f) return false;
+  bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+  if (ok && !out.empty())
+    ok = fwrite(out.data(), sizeof(StationIndexEntry), out.size(), f) ==
+         out.size();
+  if (ok) ok = fwrite(table.data(), table.size(), 1, f) == 1;
+  ok = fclose(f) == 0 && ok;
+#ifdef _WIN32
+  ok = ok && MoveFileExA(tmp_path.c_str(), path.c_str(),
+                         MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  ok = ok && rename(tmp_path.c_str(), path.c_str()) == 0;
+#endif
+  if (!ok) remove(tmp_path.c_str());
+  return ok;
+}
+
+bool StationIndex::Open(const std::string& path, uint64_t source_size,
+                        int64_t source_time) {
+  if (!m_file.Map(path, false)) return false;
+
+  bool ok = m_file.GetSize() >= sizeof(StationIndexHeader);
+  const StationIndexHeader* hdr = Header(m_file);
+  ok = ok && hdr->magic == STATION_INDEX_MAGIC &&
+       hdr->version == STATION_INDEX_VERSION &&
+       hdr->source_size == source_size && hdr->source_time == source_time;
+  ok = ok && hdr->names_size > 0 &&
+       m_file.GetSize() == sizeof(StationIndexHeader) +
+                               (uint64_t)hdr->n_entries *
+                                   sizeof(StationIndexEntry) +
+                               hdr->names_size;
+  //  Names must stay within the table
+  ok = ok && Names(m_file)[hdr->names_size - 1] == '\0';
+  for (uint32_t i = 0; ok && i < hdr->n_entries; i++)
+    ok = Entries(m_file)[i].name < hdr->names_size;
+
+  if (!ok) m_file.Unmap();
+  return ok;
+}
+
+size_t StationIndex::GetCount() const {
+  return m_file.GetData() ? Header(m_file)->n_entries : 0;
+}
+
+const StationIndexEntry& StationIndex::GetEntry(size_t i) const {
+  return Entries(m_file)[i];
+}
+
+const char* StationIndex::GetName(size_t i) const {
+  return Names(m_file) + Entries(m_file)[i].name;
+}
+
+std::string StationIndex::GetIdent() const {
+  if (!m_file.GetData()) return "";
+  const StationIndexHeader* hdr = Header(m_file);
+  return std::string(hdr->ident, strnlen(hdr->ident, sizeof(hdr->ident)));
+}
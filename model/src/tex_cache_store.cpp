@@ -0,0 +1,472 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Shared store of compressed raster chart textures
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "model/mapped_file.h"
+#include "model/tex_cache_store.h"
+
+#define TEX_STORE_MAGIC 0x5843544f  // "OTCX"
+#define TEX_STORE_VERSION 1
+
+static const char* const kIndexName = "texstore.idx";
+static const char* const kDataName = "texstore.dat";
+
+static const size_t kCommitBatch = 256;
+static const int kCommitSeconds = 5;
+static const uint64_t kMinSlots = 4096;
+static const uint64_t kMaxSize = 4ULL << 30;
+static const uint64_t kRemapSize = 16 << 20;  ///< Unmapped tail renewing the map
+
+struct TexIndexHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t n_slots;
+  uint64_t n_entries;
+  uint64_t data_size;  ///< Data file size at the last commit
+  uint32_t reserved[8];
+};
+
+struct TexIndexSlot {
+  uint64_t chart;
+  uint64_t offset;
+  uint32_t x;
+  uint32_t y;
+  uint16_t level;
+  uint16_t scheme;
+  uint32_t size;
+  uint32_t check;  ///< 0 for an empty slot, see SlotCheck()
+  uint32_t reserved;
+};
+
+struct TexDataHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t reserved[2];
+};
+
+static_assert(sizeof(TexIndexHeader) == 64, "index header layout");
+static_assert(sizeof(TexIndexSlot) == 40, "index slot layout");
+
+static uint64_t Mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+static uint64_t HashKey(const TexCacheKey& key) {
+  uint64_t h = Mix(key.chart);
+  h = Mix(h ^ (((uint64_t)key.x << 32) | key.y));
+  return Mix(h ^ (((uint64_t)key.level << 16) | key.scheme));
+}
+
+static TexCacheKey SlotKey(const TexIndexSlot& slot) {
+  TexCacheKey key;
+  key.chart = slot.chart;
+  key.x = slot.x;
+  key.y = slot.y;
+  key.level = slot.level;
+  key.scheme = slot.scheme;
+  return key;
+}
+
+/** Detects slots torn by a crash, never 0. */
+static uint32_t SlotCheck(const TexIndexSlot& slot) {
+  uint64_t h = Mix(HashKey(SlotKey(slot)) ^ slot.offset);
+  h = Mix(h ^ slot.size);
+  return (uint32_t)h | 1;
+}
+
+static bool IsValidSlot(const TexIndexSlot& slot) {
+  return slot.check && slot.check == SlotCheck(slot);
+}
+
+/** Insert or replace, returns true if a new entry was added. */
+static bool InsertSlot(TexIndexSlot* slots, uint64_t n_slots,
+                       const TexIndexSlot& slot) {
+  TexCacheKey key = SlotKey(slot);
+  uint64_t mask = n_slots - 1;
+  uint64_t i = HashKey(key) & mask;
+  for (uint64_t n = 0; n < n_slots; n++, i = (i + 1) & mask) {
+    TexIndexSlot& s = slots[i];
+    bool valid = IsValidSlot(s);
+    if (valid && !(SlotKey(s) == key)) continue;
+    s = slot;
+    s.check = SlotCheck(s);
+    return !valid;
+  }
+  return false;
+}
+
+static uint64_t FileTell(FILE* f) {
+#ifdef _WIN32
+  return _ftelli64(f);
+#else
+  return ftello(f);
+#endif
+}
+
+static bool FileSeek(FILE* f, uint64_t offset) {
+#ifdef _WIN32
+  return _fseeki64(f, offset, SEEK_SET) == 0;
+#else
+  return fseeko(f, offset, SEEK_SET) == 0;
+#endif
+}
+
+static bool SyncFile(FILE* f) {
+  if (fflush(f) != 0) return false;
+#ifdef _WIN32
+  return _commit(_fileno(f)) == 0;
+#else
+  return fsync(fileno(f)) == 0;
+#endif
+}
+
+static bool ReplaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+  return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+size_t TexCacheStore::KeyHash::operator()(const TexCacheKey& key) const {
+  return (size_t)HashKey(key);
+}
+
+TexCacheStore::TexCacheStore()
+    : m_data_file(0), m_read_file(0), m_data_size(0), m_max_size(kMaxSize) {}
+
+TexCacheStore::~TexCacheStore() { Close(); }
+
+uint64_t TexCacheStore::ChartKey(const std::string& path, uint32_t chart_date,
+                                 uint32_t file_date, uint32_t file_size,
+                                 uint32_t format) {
+  uint64_t h = 0xcbf29ce484222325ULL;  // FNV-1a
+  for (unsigned char c : path) {
+    h ^= c;
+    h *= 0x100000001b3ULL;
+  }
+  h = Mix(h ^ (((uint64_t)chart_date << 32) | file_date));
+  h = Mix(h ^ (((uint64_t)file_size << 32) | format));
+  return h ? h : 1;
+}
+
+static TexIndexHeader* IndexHeader(MappedFile* index) {
+  return (TexIndexHeader*)index->GetData();
+}
+
+static TexIndexSlot* IndexSlots(MappedFile* index) {
+  return (TexIndexSlot*)(index->GetData() + sizeof(TexIndexHeader));
+}
+
+static bool IsValidIndex(MappedFile* index) {
+  if (index->GetSize() < sizeof(TexIndexHeader)) return false;
+  const TexIndexHeader* h = IndexHeader(index);
+  if (h->magic != TEX_STORE_MAGIC || h->version != TEX_STORE_VERSION)
+    return false;
+  if (h->n_slots == 0 || (h->n_slots & (h->n_slots - 1))) return false;
+  return index->GetSize() ==
+         sizeof(TexIndexHeader) + h->n_slots * sizeof(TexIndexSlot);
+}
+
+bool TexCacheStore::Open(const std::string& dir) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  CloseLocked();
+  m_dir = dir;
+  std::string index_path = dir + "/" + kIndexName;
+  std::string data_path = dir + "/" + kDataName;
+
+  //  A store without a usable index is started over
+  m_index.reset(new MappedFile());
+  bool fresh = !m_index->Map(index_path, true) || !IsValidIndex(m_index.get());
+  if (!fresh) {
+    FILE* f = fopen(data_path.c_str(), "rb");
+    TexDataHeader hdr;
+    fresh = !f || fread(&hdr, sizeof(hdr), 1, f) != 1 ||
+            hdr.magic != TEX_STORE_MAGIC || hdr.version != TEX_STORE_VERSION;
+    //  A full store is started over, tiles of old charts go with it
+    if (!fresh) fresh = fseek(f, 0, SEEK_END) != 0 || FileTell(f) >= m_max_size;
+    if (f) fclose(f);
+  }
+  if (fresh) {
+    m_index->Unmap();
+    FILE* f = fopen(data_path.c_str(), "wb");
+    TexDataHeader hdr = {TEX_STORE_MAGIC, TEX_STORE_VERSION, {0, 0}};
+    bool ok = f && fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    if (f) fclose(f);
+    if (!ok || !WriteIndex(kMinSlots)) {
+      CloseLocked();
+      return false;
+    }
+  }
+
+  m_data_file = fopen(data_path.c_str(), "ab");
+  m_read_file = fopen(data_path.c_str(), "rb");
+  if (!m_data_file || !m_read_file) {
+    CloseLocked();
+    return false;
+  }
+  fseek(m_data_file, 0, SEEK_END);
+  m_data_size = FileTell(m_data_file);
+  MapData();
+  return true;
+}
+
+void TexCacheStore::SetMaxSize(uint64_t bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_max_size = bytes;
+}
+
+void TexCacheStore::MapData() {
+  //  A large store does not fit in a 32 bit address space
+  if (sizeof(void*) < 8) return;
+  std::shared_ptr<MappedFile> data = std::make_shared<MappedFile>();
+  if (data->Map(m_dir + "/" + kDataName, false))
+    m_data = data;
+  else
+    m_data.reset();
+}
+
+bool TexCacheStore::WriteIndex(uint64_t n_slots) {
+  std::vector<unsigned char> buf(
+      sizeof(TexIndexHeader) + n_slots * sizeof(TexIndexSlot), 0);
+  TexIndexHeader* h = (TexIndexHeader*)buf.data();
+  TexIndexSlot* slots = (TexIndexSlot*)(buf.data() + sizeof(TexIndexHeader));
+  h->magic = TEX_STORE_MAGIC;
+  h->version = TEX_STORE_VERSION;
+  h->n_slots = n_slots;
+  h->data_size = sizeof(TexDataHeader);
+
+  //  Rehash the current entries
+  if (m_index && m_index->GetData()) {
+    const TexIndexHeader* old = IndexHeader(m_index.get());
+    const TexIndexSlot* old_slots = IndexSlots(m_index.get());
+    h->data_size = old->data_size;
+    for (uint64_t i = 0; i < old->n_slots; i++) {
+      if (IsValidSlot(old_slots[i]) && InsertSlot(slots, n_slots, old_slots[i]))
+        h->n_entries++;
+    }
+  }
+
+  std::string index_path = m_dir + "/" + kIndexName;
+  std::string tmp_path = index_path + ".tmp";
+  FILE* f = fopen(tmp_path.c_str(), "wb");
+  if (!f) return false;
+  bool ok = fwrite(buf.data(), buf.size(), 1, f) == 1 && SyncFile(f);
+  fclose(f);
+
+  if (!m_index) m_index.reset(new MappedFile());
+  m_index->Unmap();
+  if (!ok || !ReplaceFile(tmp_path, index_path)) {
+    remove(tmp_path.c_str());
+    return false;
+  }
+  return m_index->Map(index_path, true) && IsValidIndex(m_index.get());
+}
+
+void TexCacheStore::Close() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  CloseLocked();
+}
+
+void TexCacheStore::CloseLocked() {
+  CommitLocked();
+  m_pending.clear();
+  m_index.reset();
+  m_data.reset();
+  if (m_data_file) fclose(m_data_file);
+  if (m_read_file) fclose(m_read_file);
+  m_data_file = 0;
+  m_read_file = 0;
+  m_data_size = 0;
+}
+
+bool TexCacheStore::IsOpen() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_data_file != 0;
+}
+
+bool TexCacheStore::FindIndexed(const TexCacheKey& key, Location& loc) {
+  if (!m_index || !m_index->GetData()) return false;
+  uint64_t n_slots = IndexHeader(m_index.get())->n_slots;
+  const TexIndexSlot* slots = IndexSlots(m_index.get());
+  uint64_t mask = n_slots - 1;
+  uint64_t i = HashKey(key) & mask;
+  for (uint64_t n = 0; n < n_slots; n++, i = (i + 1) & mask) {
+    const TexIndexSlot& s = slots[i];
+    if (s.check == 0) return false;
+    if (IsValidSlot(s) && SlotKey(s) == key) {
+      loc.offset = s.offset;
+      loc.size = s.size;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TexCacheStore::Find(const TexCacheKey& key, Location& loc) {
+  auto it = m_pending.find(key);
+  if (it != m_pending.end()) {
+    loc = it->second;
+    return true;
+  }
+  return FindIndexed(key, loc);
+}
+
+bool TexCacheStore::Put(const TexCacheKey& key, const unsigned char* data,
+                        uint32_t size) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Location loc;
+  if (!m_data_file || !size || m_data_size >= m_max_size || Find(key, loc))
+    return false;
+
+  if (fwrite(data, size, 1, m_data_file) != 1) {
+    //  Whatever was written is never indexed
+    fseek(m_data_file, 0, SEEK_END);
+    m_data_size = FileTell(m_data_file);
+    return false;
+  }
+  loc.offset = m_data_size;
+  loc.size = size;
+  m_data_size += size;
+  if (m_pending.empty()) m_pending_since = std::chrono::steady_clock::now();
+  m_pending[key] = loc;
+
+  if (m_pending.size() >= kCommitBatch) CommitLocked();
+  return true;
+}
+
+bool TexCacheStore::Contains(const TexCacheKey& key) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Location loc;
+  return Find(key, loc);
+}
+
+bool TexCacheStore::ReadFile(const Location& loc,
+                             std::vector<unsigned char>& buf) {
+  //  The tile may still be in the write buffer
+  if (fflush(m_data_file) != 0 || !FileSeek(m_read_file, loc.offset))
+    return false;
+  buf.resize(loc.size);
+  return fread(buf.data(), loc.size, 1, m_read_file) == 1;
+}
+
+bool TexCacheStore::Read(const TexCacheKey& key, const Reader& read) {
+  std::shared_ptr<MappedFile> data;
+  std::vector<unsigned char> buf;
+  Location loc;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_data_file || !Find(key, loc)) return false;
+    if (m_data && loc.offset + loc.size <= m_data->GetSize())
+      data = m_data;
+    else if (!ReadFile(loc, buf))
+      return false;
+  }
+  //  Other threads are not held up while the tile is decompressed
+  read(data ? data->GetData() + loc.offset : buf.data(), loc.size);
+  return true;
+}
+
+bool TexCacheStore::CommitLocked() {
+  if (m_pending.empty() || !m_data_file) return true;
+
+  //  The data is made durable before it is indexed
+  if (!SyncFile(m_data_file)) return false;
+
+  TexIndexHeader* h = IndexHeader(m_index.get());
+  uint64_t n_slots = h->n_slots;
+  while ((h->n_entries + m_pending.size()) * 2 > n_slots) n_slots *= 2;
+  if (n_slots != h->n_slots) {
+    if (!WriteIndex(n_slots)) return false;
+    h = IndexHeader(m_index.get());
+  }
+
+  TexIndexSlot* slots = IndexSlots(m_index.get());
+  for (const auto& entry : m_pending) {
+    TexIndexSlot slot;
+    memset(&slot, 0, sizeof(slot));
+    slot.chart = entry.first.chart;
+    slot.x = entry.first.x;
+    slot.y = entry.first.y;
+    slot.level = entry.first.level;
+    slot.scheme = entry.first.scheme;
+    slot.offset = entry.second.offset;
+    slot.size = entry.second.size;
+    if (InsertSlot(slots, h->n_slots, slot)) h->n_entries++;
+  }
+  h->data_size = m_data_size;
+  m_pending.clear();
+
+  //  Readers of the old mapping keep it until they are done
+  uint64_t mapped = m_data ? m_data->GetSize() : 0;
+  if (m_data_size - mapped >= kRemapSize) MapData();
+  return m_index->Sync();
+}
+
+bool TexCacheStore::Commit() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return CommitLocked();
+}
+
+void TexCacheStore::MaybeCommit() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_pending.empty()) return;
+  if (m_pending.size() >= kCommitBatch ||
+      std::chrono::steady_clock::now() - m_pending_since >=
+          std::chrono::seconds(kCommitSeconds))
+    CommitLocked();
+}
+
+void TexCacheStore::Clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pending.clear();
+  CloseLocked();
+  if (m_dir.empty()) return;
+  remove((m_dir + "/" + kIndexName).c_str());
+  remove((m_dir + "/" + kDataName).c_str());
+}
+
+size_t TexCacheStore::GetCount() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  size_t n = m_pending.size();
+  if (m_index && m_index->GetData()) n += IndexHeader(m_index.get())->n_entries;
+  return n;
+}
+
+uint64_t TexCacheStore::GetDataSize() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_data_size;
+}
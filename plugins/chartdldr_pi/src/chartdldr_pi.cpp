@@ -33,6 +33,7 @@
 #endif  // precompiled headers
 
 #include "chartdldr_pi.h"
+#include "chartdldr_pipeline.h"
 #include "wxWTranslateCatalog.h"
 #include <wx/stdpaths.h>
 #include <wx/url.h>
@@ -45,7 +46,9 @@
 #include <wx/filesys.h>
 #include <wx/zipstrm.h>
 #include <wx/wfstream.h>
+#include <algorithm>
 #include <memory>
+#include <thread>
 #include <wx/regex.h>
 #include <wx/debug.h>
 
@@ -74,6 +77,9 @@
 
 
 
+// Minimum seconds between chart database updates during a download
+#define CHARTDLDR_DB_UPDATE_INTERVAL 60
+
 #ifdef __WXMAC__
 #define CATALOGS_NAME_WIDTH 300
 #define CATALOGS_DATE_WIDTH 120
@@ -1336,8 +1342,28 @@ void ChartDldrPanelImpl::DownloadCharts() {
   m_bDnldCharts->SetLabel(_("Abort download"));
   DownloadIsCancel = true;
 
-  wxFileName downloaded_p;
-  int idx = -1;
+  // Downloads go one at a time through the host, extraction of the charts
+  // already downloaded runs meanwhile on the pipeline's worker threads.
+  unsigned n_threads = std::max(2u, std::thread::hardware_concurrency());
+#ifdef __OCPN__ANDROID__
+  unsigned n_fetchers = 0, n_extractors = 0;  // Extraction uses the GUI
+#else
+  unsigned n_fetchers = 2, n_extractors = n_threads;
+#endif
+  ChartDldrPipeline pipeline(
+      [](ChartDldrPipeline::Job &job) {
+        if (!wxCopyFile(job.source, job.archive)) return false;
+        job.bytes = wxFileName::GetSize(job.archive).ToDouble();
+        return true;
+      },
+      [this](ChartDldrPipeline::Job &job) {
+        return pPlugIn->ProcessFile(job.archive, job.target_dir, true,
+                                    job.mtime);
+      },
+      n_fetchers, n_extractors, 2 * n_threads);
+  m_extracted = 0;
+  m_db_updated = 0;
+  m_db_update_watch.Start();
 
   for (int i = 0; i < GetChartCount() && to_download; i++) {
     int index = i;
@@ -1388,6 +1414,31 @@ After downloading the charts, please extract them to %s"),
     if (wxFileExists(path)) wxRemoveFile(path);
     wxString title = pPlugIn->m_pChartCatalog.charts.at(index)->GetChartTitle();
 
+    ChartDldrPipeline::Job job;
+    job.index = index;
+    job.archive = path;
+    job.target_dir = fn.GetPath();
+    job.mtime = pPlugIn->m_pChartCatalog.charts.at(index)->GetUpdateDatetime();
+
+    // Local sources need no transfer through the host, copy them in the
+    // background, several at a time.
+    if (url.GetScheme() == _T("file")) {
+      job.source = wxFileName::URLToFileName(url.BuildURI()).GetFullPath();
+      pipeline.Fetch(job);
+      ProcessFinishedCharts(pipeline, cs);
+      continue;
+    }
+
+    // Don't let downloaded archives pile up faster than they are extracted
+    while (pipeline.IsExtractQueueFull() && !cancelled) {
+      ProcessFinishedCharts(pipeline, cs);
+      SetChartInfo(GetPipelineInfo(pipeline));
+      wxTheApp->ProcessPendingEvents();
+      wxYieldIfNeeded();
+      wxMilliSleep(10);
+    }
+    if (cancelled) break;
+
     //  Ready to start download
 #ifdef __OCPN__ANDROID__
     wxString file_path = _T("file://") + fn.GetFullPath();
@@ -1395,33 +1446,23 @@ After downloading the charts, please extract them to %s"),
     wxString file_path = fn.GetFullPath();
 #endif
 
+    wxStopWatch transfer_watch;
     long handle;
     OCPN_downloadFileBackground(url.BuildURI(), file_path, this, &handle);
 
-    if (idx >= 0) {
-      if (pPlugIn->ProcessFile(
-              downloaded_p.GetFullPath(), downloaded_p.GetPath(), true,
-              pPlugIn->m_pChartCatalog.charts.at(idx)->GetUpdateDatetime())) {
-        cs->ChartUpdated(pPlugIn->m_pChartCatalog.charts.at(idx)->number,
-                         pPlugIn->m_pChartCatalog.charts.at(idx)
-                             ->GetUpdateDatetime()
-                             .GetTicks());
-      } else {
-        m_failed_downloads++;
-      }
-      idx = -1;
-    }
-
     while (!m_bTransferComplete && m_bTransferSuccess && !cancelled) {
+      ProcessFinishedCharts(pipeline, cs);
+      wxString info;
       if (m_failed_downloads)
-        SetChartInfo(wxString::Format(
+        info = wxString::Format(
             _("Downloading chart %u of %u, %u downloads failed (%s / %s)"),
             m_downloading, to_download, m_failed_downloads,
-            m_transferredsize.c_str(), m_totalsize.c_str()));
+            m_transferredsize.c_str(), m_totalsize.c_str());
       else
-        SetChartInfo(wxString::Format(
-            _("Downloading chart %u of %u (%s / %s)"), m_downloading,
-            to_download, m_transferredsize.c_str(), m_totalsize.c_str()));
+        info = wxString::Format(_("Downloading chart %u of %u (%s / %s)"),
+                                m_downloading, to_download,
+                                m_transferredsize.c_str(), m_totalsize.c_str());
+      SetChartInfo(info + _T(", ") + GetPipelineInfo(pipeline));
 
       // if(g_pi && g_pi->m_dldrpanel)
       // g_pi->m_dldrpanel->Raise();
@@ -1431,31 +1472,31 @@ After downloading the charts, please extract them to %s"),
     }
 
     if (cancelled) {
-      idx = -1;
       OCPN_cancelDownloadFileBackground(handle);
     }
 
     if (m_bTransferSuccess && !cancelled) {
-      idx = index;
-      downloaded_p = path;
+      job.bytes = wxFileName::GetSize(path).ToDouble();
+      pipeline.Downloaded(job, transfer_watch.Time() / 1000.);
     } else {
-      idx = -1;
       if (wxFileExists(path)) wxRemoveFile(path);
       m_failed_downloads++;
     }
   }
-  if (idx >= 0) {
-    if (pPlugIn->ProcessFile(
-            downloaded_p.GetFullPath(), downloaded_p.GetPath(), true,
-            pPlugIn->m_pChartCatalog.charts.at(idx)->GetUpdateDatetime())) {
-      cs->ChartUpdated(pPlugIn->m_pChartCatalog.charts.at(idx)->number,
-                       pPlugIn->m_pChartCatalog.charts.at(idx)
-                           ->GetUpdateDatetime()
-                           .GetTicks());
-    } else {
-      m_failed_downloads++;
-    }
+
+  // Archives downloaded before a cancel are not extracted any more, those
+  // being extracted are finished.
+  if (cancelled) pipeline.Cancel();
+  while (!pipeline.IsIdle()) {
+    ProcessFinishedCharts(pipeline, cs);
+    SetChartInfo(GetPipelineInfo(pipeline));
+    wxTheApp->ProcessPendingEvents();
+    wxYieldIfNeeded();
+    wxMilliSleep(10);
   }
+  ProcessFinishedCharts(pipeline, cs);
+  wxLogMessage(_T("chartdldr_pi: ") + GetPipelineInfo(pipeline));
+
   DisableForDownload(true);
   m_bDnldCharts->SetLabel(_("Download selected charts"));
   DownloadIsCancel = false;
@@ -1477,6 +1518,54 @@ After downloading the charts, please extract them to %s"),
     ForceChartDBUpdate();
 }
 
+void ChartDldrPanelImpl::ProcessFinishedCharts(
+    ChartDldrPipeline &pipeline, std::unique_ptr<ChartSource> &cs) {
+  std::vector<ChartDldrPipeline::Job> done;
+  pipeline.TakeFinished(done);
+  for (auto &job : done) {
+    if (job.ok) {
+      cs->ChartUpdated(pPlugIn->m_pChartCatalog.charts.at(job.index)->number,
+                       job.mtime.GetTicks());
+      m_extracted++;
+    } else {
+      m_failed_downloads++;
+    }
+  }
+
+  // Add the charts extracted so far to the database while the download goes
+  // on. Each update reloads the whole database, so they are kept apart.
+  if (m_extracted == m_db_updated || pipeline.IsIdle() ||
+      m_db_update_watch.Time() < CHARTDLDR_DB_UPDATE_INTERVAL * 1000)
+    return;
+  wxArrayString dirs = GetChartDBDirArrayString();
+  bool in_db = false;
+  for (size_t i = 0; i < dirs.GetCount(); i++) {
+    if (cs->GetDir().StartsWith(dirs.Item(i))) in_db = true;
+  }
+  if (!in_db) return;  // Charts are added by the update when finished
+
+  // The update must not find charts which are still being written. No new
+  // extraction starts, and the update waits for the running ones to finish.
+  pipeline.PauseExtraction(true);
+  if (pipeline.IsExtracting()) return;
+  UpdateChartDBInplace(dirs, false, false);
+  pipeline.PauseExtraction(false);
+  m_db_updated = m_extracted;
+  m_db_update_watch.Start();
+}
+
+wxString ChartDldrPanelImpl::GetPipelineInfo(ChartDldrPipeline &pipeline) {
+  ChartDldrPipeline::StageStats fetch =
+      pipeline.GetStats(ChartDldrPipeline::STAGE_FETCH);
+  ChartDldrPipeline::StageStats extract =
+      pipeline.GetStats(ChartDldrPipeline::STAGE_EXTRACT);
+  return wxString::Format(
+      _("download %.1f MB/s, extracting %u (%u queued) %.1f MB/s, %u charts "
+        "ready"),
+      fetch.Rate() / 1024 / 1024, (unsigned)extract.active,
+      (unsigned)extract.queued, extract.Rate() / 1024 / 1024, m_extracted);
+}
+
 ChartDldrPanelImpl::~ChartDldrPanelImpl() {
   Disconnect(
       wxEVT_DOWNLOAD_EVENT,
@@ -1516,6 +1605,8 @@ ChartDldrPanelImpl::ChartDldrPanelImpl(chartdldr_pi *plugin, wxWindow *parent,
   m_populated = false;
   DownloadIsCancel = false;
   m_failed_downloads = 0;
+  m_extracted = 0;
+  m_db_updated = 0;
   SetChartInfo(wxEmptyString);
   m_bTransferComplete = true;
   m_bTransferSuccess = true;
@@ -40,6 +40,7 @@
 #include <wx/event.h>
 
 #include <wx/imaglist.h>
+#include <wx/stopwatch.h>
 
 #include <map>
 
@@ -60,6 +61,7 @@
 // forward declarations
 class ChartSource;
 class ChartDldrPanelImpl;
+class ChartDldrPipeline;
 class ChartDldrGuiAddSourceDlg;
 class ChartDldrPrefsDlgImpl;
 
@@ -198,6 +200,13 @@ private:
   wxString m_transferredsize;
   int m_failed_downloads;
   int m_downloading;
+  int m_extracted;
+  int m_db_updated;  // m_extracted at the last database update
+  wxStopWatch m_db_update_watch;
+
+  void ProcessFinishedCharts(ChartDldrPipeline& pipeline,
+                             std::unique_ptr<ChartSource>& cs);
+  wxString GetPipelineInfo(ChartDldrPipeline& pipeline);
 
   void DisableForDownload(bool enabled);
   bool m_bconnected;
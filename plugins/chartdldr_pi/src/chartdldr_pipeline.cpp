@@ -0,0 +1,181 @@
+/******************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Chart downloader Plugin, download and extraction pipeline
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************
+ */
+
+#include "chartdldr_pipeline.h"
+
+ChartDldrPipeline::ChartDldrPipeline(StageFunc fetch, StageFunc extract,
+                                     unsigned n_fetchers, unsigned n_extractors,
+                                     size_t max_extract_queue)
+    : m_max_extract_queue(max_extract_queue ? max_extract_queue : 1),
+      m_extract_paused(false),
+      m_stop(false) {
+  m_stages[STAGE_FETCH].func = fetch;
+  m_stages[STAGE_EXTRACT].func = extract;
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    StageStats &stats = m_stages[i].stats;
+    stats.queued = stats.active = stats.done = stats.failed = 0;
+    stats.bytes = stats.seconds = 0.;
+  }
+  m_threads[STAGE_FETCH] = n_fetchers;
+  m_threads[STAGE_EXTRACT] = n_extractors;
+  for (unsigned i = 0; i < n_fetchers; i++)
+    m_workers.push_back(
+        std::thread(&ChartDldrPipeline::Worker, this, STAGE_FETCH));
+  for (unsigned i = 0; i < n_extractors; i++)
+    m_workers.push_back(
+        std::thread(&ChartDldrPipeline::Worker, this, STAGE_EXTRACT));
+}
+
+ChartDldrPipeline::~ChartDldrPipeline() {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (int i = 0; i < STAGE_COUNT; i++) m_stages[i].queue.clear();
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for (auto &worker : m_workers) worker.join();
+}
+
+void ChartDldrPipeline::Worker(Stage stage) {
+  StageState &state = m_stages[stage];
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    // Fetching stops while the extraction queue is full, that bounds the
+    // disk space taken by archives waiting to be extracted.
+    m_cv.wait(lock, [&] {
+      return m_stop ||
+             (!state.queue.empty() &&
+              (stage != STAGE_FETCH ||
+               m_stages[STAGE_EXTRACT].queue.size() < m_max_extract_queue) &&
+              (stage != STAGE_EXTRACT || !m_extract_paused));
+    });
+    if (m_stop) return;
+    Job job = state.queue.front();
+    state.queue.pop_front();
+    Run(lock, stage, job);
+  }
+}
+
+void ChartDldrPipeline::Run(std::unique_lock<std::mutex> &lock, Stage stage,
+                            Job job) {
+  StageState &state = m_stages[stage];
+  if (state.stats.active++ == 0) state.busy_since = Clock::now();
+  lock.unlock();
+
+  bool ok = false;
+  try {
+    ok = state.func && state.func(job);
+  } catch (...) {
+    ok = false;
+  }
+  job.ok = ok;
+
+  lock.lock();
+  if (--state.stats.active == 0)
+    state.stats.seconds +=
+        std::chrono::duration<double>(Clock::now() - state.busy_since).count();
+  if (ok) {
+    state.stats.done++;
+    state.stats.bytes += job.bytes;
+  } else {
+    state.stats.failed++;
+  }
+  if (stage == STAGE_FETCH && ok)
+    Queue(lock, STAGE_EXTRACT, job);
+  else
+    m_finished.push_back(job);
+  m_cv.notify_all();
+}
+
+void ChartDldrPipeline::Queue(std::unique_lock<std::mutex> &lock, Stage stage,
+                              const Job &job) {
+  if (m_threads[stage] == 0) {
+    Run(lock, stage, job);
+    return;
+  }
+  m_stages[stage].queue.push_back(job);
+  m_cv.notify_all();
+}
+
+void ChartDldrPipeline::Fetch(const Job &job) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  Queue(lock, STAGE_FETCH, job);
+}
+
+void ChartDldrPipeline::Downloaded(const Job &job, double seconds) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  StageStats &stats = m_stages[STAGE_FETCH].stats;
+  stats.done++;
+  stats.bytes += job.bytes;
+  stats.seconds += seconds;
+  Queue(lock, STAGE_EXTRACT, job);
+}
+
+bool ChartDldrPipeline::IsExtractQueueFull() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stages[STAGE_EXTRACT].queue.size() >= m_max_extract_queue;
+}
+
+bool ChartDldrPipeline::IsIdle() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    if (!m_stages[i].queue.empty() || m_stages[i].stats.active) return false;
+  }
+  return true;
+}
+
+size_t ChartDldrPipeline::TakeFinished(std::vector<Job> &done) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  size_t n = m_finished.size();
+  done.insert(done.end(), m_finished.begin(), m_finished.end());
+  m_finished.clear();
+  return n;
+}
+
+void ChartDldrPipeline::Cancel() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (int i = 0; i < STAGE_COUNT; i++) m_stages[i].queue.clear();
+  m_cv.notify_all();
+}
+
+void ChartDldrPipeline::PauseExtraction(bool pause) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_extract_paused = pause;
+  m_cv.notify_all();
+}
+
+bool ChartDldrPipeline::IsExtracting() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stages[STAGE_EXTRACT].stats.active != 0;
+}
+
+ChartDldrPipeline::StageStats ChartDldrPipeline::GetStats(Stage stage) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const StageState &state = m_stages[stage];
+  StageStats stats = state.stats;
+  stats.queued = state.queue.size();
+  if (stats.active)
+    stats.seconds +=
+        std::chrono::duration<double>(Clock::now() - state.busy_since).count();
+  return stats;
+}
@@ -0,0 +1,135 @@
+/******************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Chart downloader Plugin, download and extraction pipeline
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************
+ */
+
+#ifndef _CHARTDLDR_PIPELINE_H_
+#define _CHARTDLDR_PIPELINE_H_
+
+#include "wx/wxprec.h"
+
+#ifndef WX_PRECOMP
+#include "wx/wx.h"
+#endif  // precompiled headers
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Downloaded charts are extracted on a pool of worker threads while the
+ * next chart is being downloaded.
+ *
+ * Charts fetched through the host (http, https) are downloaded one at a
+ * time on the GUI thread and handed over with Downloaded(). Charts with a
+ * local source, a file:// url or a local mirror standing in for a server,
+ * are copied by the fetch workers instead, several at a time.
+ *
+ * Finished jobs are collected by the GUI thread with TakeFinished(); the
+ * stage functions themselves must not touch any GUI object. With no
+ * worker threads the stages run inline on the calling thread.
+ */
+class ChartDldrPipeline {
+public:
+  struct Job {
+    Job() : index(-1), bytes(0), ok(false) {}
+
+    int index;            ///< Chart index in the catalog
+    wxString source;      ///< Local file to fetch from, if any
+    wxString archive;     ///< Downloaded file
+    wxString target_dir;  ///< Directory to extract to
+    wxDateTime mtime;     ///< Time stamp of the extracted files
+    double bytes;         ///< Size of the downloaded file
+    bool ok;
+  };
+
+  enum Stage { STAGE_FETCH = 0, STAGE_EXTRACT, STAGE_COUNT };
+
+  struct StageStats {
+    size_t queued;
+    size_t active;
+    size_t done;
+    size_t failed;
+    double bytes;    ///< Input bytes of the finished jobs
+    double seconds;  ///< Time with at least one job running
+    double Rate() const { return seconds > 0. ? bytes / seconds : 0.; }
+  };
+
+  typedef std::function<bool(Job &)> StageFunc;
+
+  ChartDldrPipeline(StageFunc fetch, StageFunc extract, unsigned n_fetchers,
+                    unsigned n_extractors, size_t max_extract_queue);
+  /** Drops the queued jobs and waits for the running ones. */
+  ~ChartDldrPipeline();
+
+  /** Queue a job with a local source for the fetch workers. */
+  void Fetch(const Job &job);
+  /** Queue a job downloaded by the caller in the given time. */
+  void Downloaded(const Job &job, double seconds);
+
+  /** True when the extraction queue should not grow any more. */
+  bool IsExtractQueueFull();
+  /** True when no job is queued or running. */
+  bool IsIdle();
+  /** Move the finished jobs to done, return their number. */
+  size_t TakeFinished(std::vector<Job> &done);
+  /** Drop the queued jobs, the running ones still finish. */
+  void Cancel();
+  /**
+   * Start no more extractions until called again with false. Those already
+   * running still finish, IsExtracting() tells when they have.
+   */
+  void PauseExtraction(bool pause);
+  /** True while an extraction is running. */
+  bool IsExtracting();
+
+  StageStats GetStats(Stage stage);
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  struct StageState {
+    std::deque<Job> queue;
+    StageFunc func;
+    StageStats stats;
+    Clock::time_point busy_since;
+  };
+
+  void Worker(Stage stage);
+  void Run(std::unique_lock<std::mutex> &lock, Stage stage, Job job);
+  void Queue(std::unique_lock<std::mutex> &lock, Stage stage, const Job &job);
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  StageState m_stages[STAGE_COUNT];
+  std::vector<Job> m_finished;
+  std::vector<std::thread> m_workers;
+  unsigned m_threads[STAGE_COUNT];
+  size_t m_max_extract_queue;
+  bool m_extract_paused;
+  bool m_stop;
+};
+
+#endif  // _CHARTDLDR_PIPELINE_H_
@@ -75,8 +75,9 @@ void DashboardInstrument_Clock::SetData(DASH_CAP, double, wxString) {
 }
 
 void DashboardInstrument_Clock::SetUtcTime(wxDateTime data) {
+  wxString shown = m_data;
   m_data = GetDisplayTime(data);
-  Refresh();
+  if (m_data != shown) SetDirty();
 }
 
 wxString DashboardInstrument_Clock::GetDisplayTime(wxDateTime UTCtime) {
@@ -113,8 +114,9 @@ void DashboardInstrument_CPUClock::SetData(DASH_CAP, double, wxString) {
 }
 
 void DashboardInstrument_CPUClock::SetUtcTime(wxDateTime data) {
+  wxString shown = m_data;
   m_data = wxDateTime::Now().FormatISOTime().Append(_T( " CPU" ));
-  Refresh();
+  if (m_data != shown) SetDirty();
 }
 
 DashboardInstrument_Moon::DashboardInstrument_Moon(wxWindow *parent,
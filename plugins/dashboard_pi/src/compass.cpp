@@ -59,16 +59,21 @@ void DashboardInstrument_Compass::SetData(DASH_CAP st, double data,
   if (std::isnan(data)) m_gpsWD = true;
 
   if (st == m_MainValueCap) {
+    if (IsValueChange(m_MainValue, data, m_MainValueUnit, unit,
+                      m_MainValueFormat, true))
+      SetDirty();
     // Rotate the rose
     m_AngleStart = -data;
     // Required to display data
     m_MainValue = data;
     m_MainValueUnit = unit;
   } else if (st == m_ExtraValueCap) {
+    if (IsValueChange(m_ExtraValue, data, m_ExtraValueUnit, unit,
+                      m_ExtraValueFormat, false))
+      SetDirty();
     m_ExtraValue = data;
     m_ExtraValueUnit = unit;
   }
-  Refresh();
 }
 
 void DashboardInstrument_Compass::DrawBackground(wxGCDC* dc) {
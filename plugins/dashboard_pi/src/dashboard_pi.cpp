@@ -74,6 +74,7 @@ int g_iDashDepthUnit;
 int g_iDashDistanceUnit;
 int g_iDashWindSpeedUnit;
 int g_iUTCOffset;
+int g_iDashRedrawRate;
 double g_dDashDBTOffset;
 bool g_bDBtrueWindGround;
 double g_dHDT;
@@ -681,6 +682,13 @@ int dashboard_pi::Init(void) {
 
   Start(1000, wxTIMER_CONTINUOUS);
 
+  //  Only the sentences handled in SetNMEASentence(), !AIVDO included
+  const wxString nmea_ids[] = {
+      "DBT", "DPT", "GGA", "GLL", "GSV", "HDG", "HDM", "HDT",
+      "MDA", "MTA", "MTW", "MWD", "MWV", "RMC", "RSA", "VDO",
+      "VHW", "VLW", "VTG", "VWR", "VWT", "XDR", "ZDA"};
+  SetNMEASentenceIds(this, wxArrayString(WXSIZEOF(nmea_ids), nmea_ids));
+
   return (WANTS_CURSOR_LATLON | WANTS_TOOLBAR_CALLBACK | INSTALLS_TOOLBAR_TOOL |
           WANTS_PREFERENCES | WANTS_CONFIG | WANTS_NMEA_SENTENCES |
           WANTS_NMEA_EVENTS | USES_AUI_MANAGER | WANTS_PLUGIN_MESSAGING);
@@ -948,6 +956,7 @@ Provides navigation instrument display from NMEA source.");
 
 void dashboard_pi::SendSentenceToAllInstruments(DASH_CAP st, double value,
                                                 wxString unit) {
+  m_data.Set(st, value, unit);
   for (size_t i = 0; i < m_ArrayOfDashboardWindow.GetCount(); i++) {
     DashboardWindow *dashboard_window =
         m_ArrayOfDashboardWindow.Item(i)->m_pDashboardWindow;
@@ -3496,6 +3505,8 @@ bool dashboard_pi::LoadConfig(void) {
     pConf->Read(_T("TemperatureUnit"), &g_iDashTempUnit, 0);
 
     pConf->Read(_T("UTCOffset"), &g_iUTCOffset, 0);
+    pConf->Read(_T("RedrawRate"), &g_iDashRedrawRate, 10);
+    g_iDashRedrawRate = wxMax(1, wxMin(g_iDashRedrawRate, 50));
 
     pConf->Read(_T("PrefWidth"), &g_dashPrefWidth, 0);
     pConf->Read(_T("PrefHeight"), &g_dashPrefHeight, 0);
@@ -3675,6 +3686,7 @@ bool dashboard_pi::SaveConfig(void) {
     pConf->Write(_T("DistanceUnit"), g_iDashDistanceUnit);
     pConf->Write(_T("WindSpeedUnit"), g_iDashWindSpeedUnit);
     pConf->Write(_T("UTCOffset"), g_iUTCOffset);
+    pConf->Write(_T("RedrawRate"), g_iDashRedrawRate);
     pConf->Write(_T("UseSignKtruewind"), g_bDBtrueWindGround);
     pConf->Write(_T("TemperatureUnit"), g_iDashTempUnit);
     pConf->Write(_T("PrefWidth"), g_dashPrefWidth);
@@ -5054,9 +5066,17 @@ DashboardWindow::DashboardWindow(wxWindow *pparent, wxWindowID id,
 
   m_binResize = false;
   m_binPinch = false;
+
+  //  Instruments only mark themselves changed when given data, and are
+  //  repainted here, at most g_iDashRedrawRate times a second.
+  m_RedrawTimer.SetOwner(this);
+  Connect(wxEVT_TIMER, wxTimerEventHandler(DashboardWindow::OnRedrawTimer),
+          NULL, this);
+  m_RedrawTimer.Start(1000 / g_iDashRedrawRate, wxTIMER_CONTINUOUS);
 }
 
 DashboardWindow::~DashboardWindow() {
+  m_RedrawTimer.Stop();
   for (size_t i = 0; i < m_ArrayOfInstrument.GetCount(); i++) {
     DashboardInstrumentContainer *pdic = m_ArrayOfInstrument.Item(i);
     delete pdic;
@@ -5836,6 +5856,19 @@ void DashboardWindow::SetInstrumentList(wxArrayInt list, wxArrayOfInstrumentProp
     }
   }
 
+  //  Show the data already received, instead of waiting for the next update
+  const DashboardData &data = m_plugin->GetData();
+  for (size_t i = 0; i < m_ArrayOfInstrument.GetCount(); i++) {
+    DashboardInstrumentContainer *pdic = m_ArrayOfInstrument.Item(i);
+    for (int cap = 0; cap < N_INSTRUMENTS; cap++) {
+      double value;
+      wxString unit;
+      if (pdic->m_cap_flag.test(cap) &&
+          data.Get((DASH_CAP)cap, value, unit, gps_watchdog_timeout_ticks))
+        pdic->m_pInstrument->SetData((DASH_CAP)cap, value, unit);
+    }
+  }
+
   //  In the absense of any other hints, build the default instrument sizes by
   //  taking the calculated with of the first (and succeeding) instruments as
   //  hints for the next. So, best in default loads to start with an instrument
@@ -5863,6 +5896,12 @@ void DashboardWindow::SendSentenceToAllInstruments(DASH_CAP st, double value,
   }
 }
 
+void DashboardWindow::OnRedrawTimer(wxTimerEvent &event) {
+  if (!IsShownOnScreen()) return;
+  for (size_t i = 0; i < m_ArrayOfInstrument.GetCount(); i++)
+    m_ArrayOfInstrument.Item(i)->m_pInstrument->RedrawIfChanged();
+}
+
 void DashboardWindow::SendSatInfoToAllInstruments(int cnt, int seq,
                                                   wxString talk,
                                                   SAT_INFO sats[4]) {
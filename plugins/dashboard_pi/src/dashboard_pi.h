@@ -238,6 +238,7 @@ public:
   int GetToolbarItemId() { return m_toolbar_item_id; }
   int GetDashboardWindowShownCount();
   void SetPluginMessage(wxString &message_id, wxString &message_body);
+  const DashboardData &GetData() { return m_data; }
 
 private:
   bool LoadConfig(void);
@@ -292,6 +293,7 @@ private:
   int m_toolbar_item_id;
 
   wxArrayOfDashboard m_ArrayOfDashboardWindow;
+  DashboardData m_data;
   int m_show_id;
   int m_hide_id;
 
@@ -447,6 +449,7 @@ public:
   void SendSatInfoToAllInstruments(int cnt, int seq, wxString talk,
                                    SAT_INFO sats[4]);
   void SendUtcTimeToAllInstruments(wxDateTime value);
+  void OnRedrawTimer(wxTimerEvent &event);
   void ChangePaneOrientation(int orient, bool updateAUImgr);
   /*TODO: OnKeyPress pass event to main window or disable focus*/
 
@@ -467,6 +470,7 @@ private:
   // wx2.9      wxWrapSizer*          itemBoxSizer;
   wxBoxSizer *itemBoxSizer;
   wxArrayOfInstrument m_ArrayOfInstrument;
+  wxTimer m_RedrawTimer;
 
   wxButton *m_tButton;
 };
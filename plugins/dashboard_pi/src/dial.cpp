@@ -95,13 +95,32 @@ wxSize DashboardInstrument_Dial::GetSize(int orient, wxSize hint) {
 void DashboardInstrument_Dial::SetData(DASH_CAP st, double data,
                                        wxString unit) {
   if (st == m_MainValueCap) {
+    if (IsValueChange(m_MainValue, data, m_MainValueUnit, unit,
+                      m_MainValueFormat, true))
+      SetDirty();
     m_MainValue = data;
     m_MainValueUnit = unit;
   } else if (st == m_ExtraValueCap) {
+    if (IsValueChange(m_ExtraValue, data, m_ExtraValueUnit, unit,
+                      m_ExtraValueFormat, false))
+      SetDirty();
     m_ExtraValue = data;
     m_ExtraValueUnit = unit;
   }
-  Refresh();
+}
+
+bool DashboardInstrument_Dial::IsValueChange(double old_value, double value,
+                                             const wxString& old_unit,
+                                             const wxString& unit,
+                                             const wxString& format,
+                                             bool needle) {
+  if (unit != old_unit) return true;
+  if (IsDisplayChange(old_value, value, GetFormatStep(format))) return true;
+  if (!needle || m_AngleRange == 0) return false;
+  // Half a degree of needle travel
+  double step =
+      0.5 * std::abs((m_MainValueMax - m_MainValueMin) / m_AngleRange);
+  return step > 0 && IsDisplayChange(old_value, value, step);
 }
 
 void DashboardInstrument_Dial::Draw(wxGCDC* bdc) {
@@ -144,6 +144,11 @@ protected:
   virtual void DrawData(wxGCDC* dc, double value, wxString unit,
                         wxString format, DialPositionOption position);
   virtual void DrawForeground(wxGCDC* dc);
+  /** True if a value drawn as text with format, and as needle if needle,
+   *  is drawn differently after changing from old_value to value. */
+  bool IsValueChange(double old_value, double value, const wxString& old_unit,
+                     const wxString& unit, const wxString& format,
+                     bool needle);
 };
 
 /* Shared functions */
@@ -30,6 +30,7 @@
 #ifndef WX_PRECOMP
 #include "wx/wx.h"
 #endif  // precompiled headers
+#include <wx/time.h>
 #include <cmath>
 
 #include "instrument.h"
@@ -117,6 +118,35 @@ wxColour GetColourSchemeFont(wxColour co)
 }
 
 
+//----------------------------------------------------------------
+//
+//    DashboardData Implementation
+//
+//----------------------------------------------------------------
+
+DashboardData::DashboardData() {
+  for (int i = 0; i < N_INSTRUMENTS; i++) {
+    m_value[i] = NAN;
+    m_time[i] = 0;
+  }
+}
+
+void DashboardData::Set(DASH_CAP cap, double value, const wxString& unit) {
+  m_value[cap] = value;
+  m_unit[cap] = unit;
+  m_time[cap] = wxGetUTCTimeMillis();
+}
+
+bool DashboardData::Get(DASH_CAP cap, double& value, wxString& unit,
+                        int max_age) const {
+  if (m_time[cap] == 0 || std::isnan(m_value[cap])) return false;
+  if (wxGetUTCTimeMillis() - m_time[cap] > wxLongLong(max_age) * 1000)
+    return false;
+  value = m_value[cap];
+  unit = m_unit[cap];
+  return true;
+}
+
 //----------------------------------------------------------------
 //
 //    Generic DashboardInstrument Implementation
@@ -131,6 +161,7 @@ DashboardInstrument::DashboardInstrument(wxWindow* pparent, wxWindowID id,
   m_title = title;
   m_Properties = Properties;
   m_cap_flag.set(cap_flag);
+  m_dirty = false;
 
   SetBackgroundStyle(wxBG_STYLE_CUSTOM);
   SetDrawSoloInPane(false);
@@ -178,7 +209,13 @@ void DashboardInstrument::OnEraseBackground(wxEraseEvent& WXUNUSED(evt)) {
   // intentionally empty
 }
 
+void DashboardInstrument::RedrawIfChanged() {
+  if (m_dirty && IsShownOnScreen()) Refresh();
+  m_dirty = false;
+}
+
 void DashboardInstrument::OnPaint(wxPaintEvent& WXUNUSED(event)) {
+    m_dirty = false;
     wxAutoBufferedPaintDC pdc(this);
     if (!pdc.IsOk()) {
         wxLogMessage(
@@ -319,6 +356,7 @@ void DashboardInstrument_Single::Draw(wxGCDC* dc) {
 void DashboardInstrument_Single::SetData(DASH_CAP st, double data,
                                          wxString unit) {
   if (m_cap_flag.test(st)) {
+    wxString shown = m_data;
     if (!std::isnan(data)) {
       if (unit == _T("C"))
         m_data = wxString::Format(m_format, data) + DEGREE_SIGN + _T("C");
@@ -346,7 +384,7 @@ void DashboardInstrument_Single::SetData(DASH_CAP st, double data,
     } else
       m_data = _T("---");
 
-    Refresh();
+    if (m_data != shown) SetDirty();
   }
 }
 
@@ -420,6 +458,8 @@ void DashboardInstrument_Position::Draw(wxGCDC* dc) {
 void DashboardInstrument_Position::SetData(DASH_CAP st, double data,
                                            wxString unit) {
   if (std::isnan(data)) return;
+  wxString shown1 = m_data1;
+  wxString shown2 = m_data2;
   if (st == m_cap_flag1) {
     m_data1 = toSDMM(1, data);
     m_data1[0] = ' ';
@@ -427,13 +467,42 @@ void DashboardInstrument_Position::SetData(DASH_CAP st, double data,
     m_data2 = toSDMM(2, data);
   } else
     return;
-  Refresh();
+  if (m_data1 != shown1 || m_data2 != shown2) SetDirty();
 }
 
 /**************************************************************************/
 /*          Some assorted utilities                                       */
 /**************************************************************************/
 
+double GetFormatStep(const wxString& format) {
+  int start = format.Find('%');
+  if (start == wxNOT_FOUND) return 1.0;
+
+  //  %d and %i print whole numbers, %f defaults to six decimals
+  int precision = -1;
+  for (size_t i = start + 1; i < format.Length(); i++) {
+    wxChar c = format[i];
+    if (c == '.') {
+      precision = 0;
+      while (i + 1 < format.Length()) {
+        wxChar d = format[i + 1];
+        if (!wxIsdigit(d)) break;
+        precision = precision * 10 + (d - '0');
+        i++;
+      }
+    } else if (wxIsalpha(c)) {
+      if (precision < 0) precision = (c == 'd' || c == 'i') ? 0 : 6;
+      break;
+    }
+  }
+  return std::pow(10.0, -wxMax(precision, 0));
+}
+
+bool IsDisplayChange(double a, double b, double step) {
+  if (std::isnan(a) || std::isnan(b)) return std::isnan(a) != std::isnan(b);
+  return std::floor(a / step + 0.5) != std::floor(b / step + 0.5);
+}
+
 wxString toSDMM(int NEflag, double a) {
   short neg = 0;
   int d;
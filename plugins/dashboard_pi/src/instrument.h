@@ -57,6 +57,10 @@ extern wxFontData *g_pFontLabel;
 extern wxFontData *g_pFontSmall;
 
 wxString toSDMM(int NEflag, double a);
+/** Resolution of a value printed with a printf style format. */
+double GetFormatStep(const wxString &format);
+/** True if a value changing from a to b shows differently at resolution step. */
+bool IsDisplayChange(double a, double b, double step);
 
 class DashboardInstrument;
 class DashboardInstrument_Single;
@@ -107,6 +111,23 @@ enum DASH_CAP {
   ((int)OCPN_DBP_STC_LAST)  // Number of instrument capability flags
 using CapType = std::bitset<N_INSTRUMENTS>;
 
+/**
+ * Latest value of each instrument capability, kept apart from the
+ * instruments drawing them so that new instruments can be filled in.
+ */
+class DashboardData {
+public:
+  DashboardData();
+
+  void Set(DASH_CAP cap, double value, const wxString &unit);
+  /** Value received within max_age seconds, false if none. */
+  bool Get(DASH_CAP cap, double &value, wxString &unit, int max_age) const;
+
+private:
+  double m_value[N_INSTRUMENTS];
+  wxString m_unit[N_INSTRUMENTS];
+  wxLongLong m_time[N_INSTRUMENTS];
+};
 
 wxColour GetColourSchemeBackgroundColour(wxColour co);
 wxColour GetColourSchemeFont(wxColour co);
@@ -167,6 +188,8 @@ public:
   void MouseEvent(wxMouseEvent &event);
   void SetCapFlag(DASH_CAP val) { m_cap_flag.set(val); }
   bool HasCapFlag(DASH_CAP val) { return m_cap_flag.test(val); }
+  /** Repaint if the data shown changed since the last paint. */
+  void RedrawIfChanged();
   int instrumentTypeId;
   InstrumentProperties *m_Properties;
 
@@ -175,9 +198,12 @@ protected:
   int m_TitleHeight;
   wxString m_title;
   virtual void Draw(wxGCDC *dc) = 0;
+  /** Repaint at the next redraw tick of the dashboard window. */
+  void SetDirty() { m_dirty = true; }
 
 private:
   bool m_drawSoloInPane;
+  bool m_dirty;
 };
 
 class DashboardInstrument_Single : public DashboardInstrument {
@@ -106,6 +106,8 @@ DashboardInstrument_AppTrueWindAngle::DashboardInstrument_AppTrueWindAngle(
                        _T("120"), _T("150"), _T(""),   _T("150"),
                        _T("120"), _T("90"),  _T("60"), _T("30")};
   SetOptionLabel(30, DIAL_LABEL_HORIZONTAL, wxArrayString(12, labels));
+  m_MainValueOption1 = m_MainValueOption2 = DIAL_POSITION_NONE;
+  m_ExtraValueOption1 = m_ExtraValueOption2 = DIAL_POSITION_NONE;
 }
 
 void DashboardInstrument_AppTrueWindAngle::DrawBackground(wxGCDC* dc) {
@@ -115,23 +117,38 @@ void DashboardInstrument_AppTrueWindAngle::DrawBackground(wxGCDC* dc) {
 void DashboardInstrument_AppTrueWindAngle::SetData(DASH_CAP st, double data,
                                                    wxString unit) {
   if (st == OCPN_DBP_STC_TWA) {
+    if (m_MainValueOption2 != DIAL_POSITION_BOTTOMLEFT ||
+        IsValueChange(m_MainValueTrue, data, m_MainValueTrueUnit, unit,
+                      m_MainValueFormat, true))
+      SetDirty();
     m_MainValueTrue = data;
     m_MainValueTrueUnit = unit;
     m_MainValueOption2 = DIAL_POSITION_BOTTOMLEFT;
   } else if (st == OCPN_DBP_STC_AWA) {
+    if (m_MainValueOption1 != DIAL_POSITION_TOPLEFT ||
+        IsValueChange(m_MainValueApp, data, m_MainValueAppUnit, unit,
+                      m_MainValueFormat, true))
+      SetDirty();
     m_MainValueApp = data;
     m_MainValueAppUnit = unit;
     m_MainValueOption1 = DIAL_POSITION_TOPLEFT;
   } else if (st == OCPN_DBP_STC_AWS) {
+    if (m_ExtraValueOption1 != DIAL_POSITION_TOPRIGHT ||
+        IsValueChange(m_ExtraValueApp, data, m_ExtraValueAppUnit, unit,
+                      m_ExtraValueFormat, false))
+      SetDirty();
     m_ExtraValueApp = data;
     m_ExtraValueAppUnit = unit;
     m_ExtraValueOption1 = DIAL_POSITION_TOPRIGHT;
   } else if (st == OCPN_DBP_STC_TWS) {
+    if (m_ExtraValueOption2 != DIAL_POSITION_BOTTOMRIGHT ||
+        IsValueChange(m_ExtraValueTrue, data, m_ExtraValueTrueUnit, unit,
+                      m_ExtraValueFormat, false))
+      SetDirty();
     m_ExtraValueTrue = data;
     m_ExtraValueTrueUnit = unit;
     m_ExtraValueOption2 = DIAL_POSITION_BOTTOMRIGHT;
   }
-  Refresh();
 }
 void DashboardInstrument_AppTrueWindAngle::Draw(wxGCDC* bdc) {
 
@@ -239,6 +239,13 @@ void jpc_initluts()
     float u;
     float v;
     float t;
+    /* The tables are constant once built; skipping the rebuild makes
+       concurrent decoders safe after a first call from a single thread. */
+    static int initialized = 0;
+
+    if (initialized) {
+        return;
+    }
 
 /* XXX - hack */
 jpc_initmqctxs();
@@ -280,6 +287,7 @@ jpc_initmqctxs();
 /* XXX - this calc is not correct */
         jpc_refnmsedec0[i] = jpc_dbltofix(floor((u * u) * jpc_pow2i(JPC_NMSEDEC_FRACBITS) + 0.5) / jpc_pow2i(JPC_NMSEDEC_FRACBITS));
     }
+    initialized = 1;
 }
 
 jpc_fix_t jpc_getsignmsedec_func(jpc_fix_t x, int bitpos)
@@ -35,7 +35,6 @@
 
 #include <wx/glcanvas.h>
 #include <wx/graphics.h>
-#include <wx/progdlg.h>
 #include "pi_ocpndc.h"
 #include "pi_shaders.h"
 
@@ -1431,24 +1430,25 @@ void GRIBOverlayFactory::RenderGribIsobar(int settings, GribRecord **pGR,
   //    Initialize the array of Isobars if necessary
   if (!pIsobarArray[idx]) {
     // build magnitude from multiple record types like wind and current
-    if (idy >= 0 && !polar && pGR[idy]) {
-      pGRM = GribRecord::MagnitudeRecord(*pGR[idx], *pGR[idy]);
-      if (!pGRM->isOk()) {
-        m_Message_Hiden.Append(_("IsoBar Unable to compute record magnitude"));
-        delete pGRM;
-        return;
-      }
-      pGRA = pGRM;
-    }
-
-    pIsobarArray[idx] = new wxArrayPtrVoid;
-    IsoLine *piso;
+    GribRecord *pGRY = NULL;
+    if (idy >= 0 && !polar && pGR[idy]) pGRY = pGR[idy];
 
-    wxGenericProgressDialog *progressdialog = nullptr;
-    wxDateTime start = wxDateTime::Now();
+    // isolines of records read from the file (not interpolated) are kept
+    // for the lifetime of the file
+    IsoLineCache *cache = NULL;
+    if (m_dlg.m_bGRIBActiveFile && m_pGribTimelineRecordSet &&
+        !m_pGribTimelineRecordSet->IsUnRefGribRecord(idx) &&
+        !(pGRY && m_pGribTimelineRecordSet->IsUnRefGribRecord(idy)))
+      cache = &m_dlg.m_bGRIBActiveFile->GetIsoLineCache();
 
     double min = m_Settings.GetMin(settings);
     double max = m_Settings.GetMax(settings);
+    if (cache)
+      cache->SetSettingsKey(
+          settings,
+          wxString::Format("%g %g %g %d", min, max,
+                           m_Settings.Settings[settings].m_iIsoBarSpacing,
+                           m_Settings.Settings[settings].m_Units));
 
     /* convert min and max to units being used */
     double factor = (settings == GribOverlaySettings::PRESSURE &&
@@ -1456,28 +1456,43 @@ void GRIBOverlayFactory::RenderGribIsobar(int settings, GribRecord **pGR,
                         ? 0.03
                         : 1.;  // divide spacing by 1/33 for PRESURRE & inHG
 
+    std::vector<double> press_values, levels;
+    std::vector<std::shared_ptr<const IsoLineTrace> > traces;
+    std::vector<double> missing;
     for (double press = min; press <= max;
          press += (m_Settings.Settings[settings].m_iIsoBarSpacing * factor)) {
-      if (progressdialog)
-        progressdialog->Update(press - min);
-      else {
-        wxDateTime now = wxDateTime::Now();
-        if ((now - start).GetSeconds() > 3 && press - min < (max - min) / 2) {
-          progressdialog = new wxGenericProgressDialog(
-              _("Building Isobar map"), _("Wind"), max - min + 1, NULL,
-              wxPD_SMOOTH | wxPD_ELAPSED_TIME | wxPD_REMAINING_TIME);
+      double level = press / m_Settings.CalibrationFactor(settings, press, true) -
+                     m_Settings.CalibrationOffset(settings);
+      press_values.push_back(press);
+      levels.push_back(level);
+      traces.push_back(cache ? cache->Get(settings, pGRA, pGRY, level)
+                             : nullptr);
+      if (!traces.back()) missing.push_back(level);
+    }
+
+    if (!missing.empty()) {
+      if (pGRY) {
+        pGRM = GribRecord::MagnitudeRecord(*pGRA, *pGRY);
+        if (!pGRM->isOk()) {
+          m_Message_Hiden.Append(
+              _("IsoBar Unable to compute record magnitude"));
+          delete pGRM;
+          return;
         }
       }
-
-      piso = new IsoLine(press,
-                         m_Settings.CalibrationFactor(settings, press, true),
-                         m_Settings.CalibrationOffset(settings), pGRA);
-
-      pIsobarArray[idx]->Add(piso);
+      std::vector<std::shared_ptr<const IsoLineTrace> > extracted =
+          IsoLine::ExtractIsoLines(pGRM ? pGRM : pGRA, missing);
+      for (size_t i = 0, n = 0; i < traces.size(); i++) {
+        if (traces[i]) continue;
+        traces[i] = extracted[n++];
+        if (cache) cache->Put(settings, pGRA, pGRY, levels[i], traces[i]);
+      }
+      delete pGRM;
     }
-    delete progressdialog;
 
-    delete pGRM;
+    pIsobarArray[idx] = new wxArrayPtrVoid;
+    for (size_t i = 0; i < traces.size(); i++)
+      pIsobarArray[idx]->Add(new IsoLine(press_values[i], traces[i]));
   }
 
   //    Draw the Isobars
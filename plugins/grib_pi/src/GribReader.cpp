@@ -22,20 +22,33 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "wx/wx.h"
 #endif  // precompiled headers
 
+#include <wx/stopwatch.h>
+
 #include "GribReader.h"
 #include "GribV1Record.h"
 #include "GribV2Record.h"
+#include "GribWorkerPool.h"
+#include <algorithm>
 #include <cassert>
 
+// Upper bound of packed GRIB2 data kept in memory before decoding a batch
+#define GRIB_DEFERRED_DATA_BUDGET (64 * 1024 * 1024)
+
 //-------------------------------------------------------------------------------
 GribReader::GribReader() {
   ok = false;
   dewpointDataStatus = NO_DATA_IN_FILE;
+  deferredBytes = 0;
+  decodedRecords = 0;
+  decodeTime = 0;
 }
 //-------------------------------------------------------------------------------
 GribReader::GribReader(const wxString fname) {
   ok = false;
   dewpointDataStatus = NO_DATA_IN_FILE;
+  deferredBytes = 0;
+  decodedRecords = 0;
+  decodeTime = 0;
   if (fname != _T("")) {
     openFile(fname);
   } else {
@@ -87,6 +100,39 @@ void GribReader::storeRecordInMap(GribRecord *rec) {
     assert(mapGribRecords[rec->getKey()]);
   }
   mapGribRecords[rec->getKey()]->push_back(rec);
+
+  GribV2Record *rec2 = dynamic_cast<GribV2Record *>(rec);
+  if (rec2 && rec2->hasDeferredData()) {
+    deferredRecords.push_back(rec2);
+    deferredBytes += rec2->deferredDataSize();
+    if (deferredBytes > GRIB_DEFERRED_DATA_BUDGET) decodeDeferredRecords();
+  }
+}
+
+//---------------------------------------------------------------------------------
+void GribReader::decodeDeferredRecords() {
+  if (deferredRecords.empty()) return;
+
+  wxStopWatch sw;
+  std::vector<GribV2Record *> todo;
+  todo.swap(deferredRecords);
+  deferredBytes = 0;
+
+  if (!GribV2Record::initDecoder()) {
+    // JPEG2000 data sets are decoded here, the others in parallel
+    auto jpeg2000 = std::stable_partition(
+        todo.begin(), todo.end(),
+        [](GribV2Record *rec) { return !rec->deferredDataIsJpeg2000(); });
+    for (auto it = jpeg2000; it != todo.end(); ++it)
+      (*it)->decodeDeferredData();
+    decodedRecords += todo.end() - jpeg2000;
+    todo.erase(jpeg2000, todo.end());
+  }
+  GribWorkerPool::Get().ParallelFor(
+      todo.size(), [&todo](size_t i) { todo[i]->decodeDeferredData(); });
+
+  decodedRecords += todo.size();
+  decodeTime += sw.Time();
 }
 
 //---------------------------------------------------------------------------------
@@ -133,7 +179,7 @@ void GribReader::readAllGribRecords() {
       rec = new GribV1Record(file, id);
       if (rec->isOk() == false) {
         delete rec;
-        rec = new GribV2Record(file, id);
+        rec = new GribV2Record(file, id, true);
         is_v2 = rec->isOk();
       }
     } else {
@@ -142,7 +188,7 @@ void GribReader::readAllGribRecords() {
         rec = rec2->GribV2NextDataSet(file, id);
         delete prevDataSet;
       } else {
-        rec = new GribV2Record(file, id);
+        rec = new GribV2Record(file, id, true);
       }
 
       is_v2 = rec->isOk();
@@ -279,6 +325,7 @@ void GribReader::readAllGribRecords() {
     }
   } while (!b_EOF);
   delete prevDataSet;
+  decodeDeferredRecords();
 }
 
 //---------------------------------------------------------------------------------
@@ -680,6 +727,7 @@ double GribReader::computeDewPoint(double lon, double lat, time_t now) {
 //-------------------------------------------------------------------------------
 void GribReader::openFile(const wxString fname) {
   grib_debug("Open file: %s", (const char *)fname.mb_str());
+  wxStopWatch sw;
   fileName = fname;
   ok = false;
   // clean_all_vectors();
@@ -713,4 +761,10 @@ void GribReader::openFile(const wxString fname) {
     zu_close(file);
     file = NULL;
   }
+  if (ok)
+    wxLogMessage(
+        "GRIB: %s loaded in %ld ms, %d GRIB2 fields decoded in %ld ms on %u "
+        "threads",
+        fname, sw.Time(), decodedRecords, decodeTime,
+        GribWorkerPool::Get().GetThreadCount());
 }
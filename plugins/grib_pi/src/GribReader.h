@@ -39,6 +39,8 @@ Reader for a GRIB file
 #include "GribRecord.h"
 #include "zuFile.h"
 
+class GribV2Record;
+
 //===============================================================
 class GribReader {
 public:
@@ -111,6 +113,14 @@ private:
 
   void storeRecordInMap(GribRecord *rec);
 
+  // GRIB2 data sections are only unpacked for records kept in the map,
+  // in batches decoded on all cores.
+  std::vector<GribV2Record *> deferredRecords;
+  size_t deferredBytes;
+  int decodedRecords;
+  long decodeTime;  // ms
+  void decodeDeferredRecords();
+
   void readGribFileContent();
   void readAllGribRecords();
   void createListDates();
@@ -89,6 +89,12 @@ public:
     m_GribRecordUnref[i] = true;
   }
 
+  // true if record i is not owned by the GRIB file (interpolated)
+  bool IsUnRefGribRecord(int i) const {
+    assert(i >= 0 && i < Idx_COUNT);
+    return m_GribRecordUnref[i];
+  }
+
   void RemoveGribRecords() {
     for (int i = 0; i < Idx_COUNT; i++) {
       if (m_GribRecordUnref[i] == true) {
@@ -254,6 +254,7 @@ public:
   time_t GetRefDateTime(void) { return m_pRefDateTime; }
 
   const unsigned int GetCounter() { return m_counter; }
+  IsoLineCache &GetIsoLineCache() { return m_IsoLineCache; }
 
   WX_DEFINE_ARRAY_INT(int, GribIdxArray);
   GribIdxArray m_GribIdxArray;
@@ -272,6 +273,9 @@ private:
   ArrayOfGribRecordSets m_GribRecordSetArray;
 
   int m_nGribRecords;
+
+  // isolines of the records above
+  IsoLineCache m_IsoLineCache;
 };
 
 //----------------------------------------------------------------------------------------------------------
@@ -43,6 +43,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #ifdef JASPER
 #include <jasper/jasper.h>
+#ifdef GRIB_BUNDLED_JASPER
+//  Internal to jasper, see initDecoder()
+extern "C" void jpc_initluts(void);
+#endif
 #endif
 
 const double GRIB_MISSING_VALUE = GRIB_NOTDEF;
@@ -1002,6 +1006,41 @@ static bool unpackDS(GRIBMessage *grib_msg) {
   return true;
 }
 
+// Keep a private copy of the packed data section and of the metadata
+// unpackDS() depends on, so that it can be decoded after grib_msg moved on
+// to the next data set or was deleted.
+static GRIBMessage *deferDS(GRIBMessage *grib_msg, int len) {
+  GRIBMessage *ds = new GRIBMessage();
+  size_t ofs = grib_msg->offset / 8;
+
+  // getBits() may read up to 3 bytes past the last packed value
+  ds->buffer = new unsigned char[len + 4];
+  memcpy(ds->buffer, grib_msg->buffer + ofs, len);
+  memset(ds->buffer + len, 0, 4);
+  ds->offset = 0;
+  ds->total_len = len;
+  ds->num_grids = 1;
+
+  ds->md.nx = grib_msg->md.nx;
+  ds->md.ny = grib_msg->md.ny;
+  ds->md.drs_templ_num = grib_msg->md.drs_templ_num;
+  ds->md.precision = grib_msg->md.precision;
+  ds->md.R = grib_msg->md.R;
+  ds->md.E = grib_msg->md.E;
+  ds->md.D = grib_msg->md.D;
+  ds->md.pack_width = grib_msg->md.pack_width;
+  ds->md.complex_pack = grib_msg->md.complex_pack;
+  ds->md.bmssize = 0;
+  if (grib_msg->md.bitmap != NULL) {
+    size_t bits = grib_msg->md.bmssize * 8;
+    ds->md.bmssize = grib_msg->md.bmssize;
+    ds->md.bitmap = new unsigned char[bits];
+    memcpy(ds->md.bitmap, grib_msg->md.bitmap, bits);
+    ds->total_len += bits;
+  }
+  return ds;
+}
+
 static zuchar GRBV2_TO_DATA(int productDiscipline, int dataCat, int dataNum) {
   zuchar ret = 255;
   // printf("search %d %d %d\n", productDiscipline, dataCat,  dataNum);
@@ -1416,7 +1455,10 @@ void GribV2Record::translateDataType() {
   // NOAA GFS
   //------------------------
   if (dataType == GRB_PRECIP_RATE) {  // mm/s -> mm/h
-    multiplyAllData(3600.0);
+    if (deferredDS)
+      deferredScale = 3600.0;
+    else
+      multiplyAllData(3600.0);
   }
   if (idCenter == 7 && idModel == 2)  // NOAA
   {
@@ -1544,6 +1586,7 @@ void GribV2Record::readDataSet(ZUFILE *file) {
   hasBMS = false;
   knownData = false;
   IsDuplicated = false;
+  deferredScale = 1.0;
 
   while (strncmp(&((char *)grib_msg->buffer)[grib_msg->offset / 8], "7777",
                  4) != 0) {
@@ -1661,10 +1704,14 @@ void GribV2Record::readDataSet(ZUFILE *file) {
         break;
       case 7:  // Section 7: Data Section
         if (skip == false) {
-          ok = unpackDS(grib_msg);
-          if (ok) {
-            data = grib_msg->grids.gridpoints;
-            grib_msg->grids.gridpoints = 0;
+          if (deferData) {
+            deferredDS = deferDS(grib_msg, len);
+          } else {
+            ok = unpackDS(grib_msg);
+            if (ok) {
+              data = grib_msg->grids.gridpoints;
+              grib_msg->grids.gridpoints = 0;
+            }
           }
         }
         if (grib_msg->num_grids != 1) DS = true;
@@ -1702,8 +1749,11 @@ void GribV2Record::readDataSet(ZUFILE *file) {
 }
 
 // -----------------
-GribV2Record::GribV2Record(ZUFILE *file, int id_) {
+GribV2Record::GribV2Record(ZUFILE *file, int id_, bool deferData_) {
   id = id_;
+  deferData = deferData_;
+  deferredDS = 0;
+  deferredScale = 1.0;
   seekStart = zu_tell(file);  // moved to section 0 read
   data = NULL;
   BMSsize = 0;
@@ -1788,6 +1838,7 @@ GribV2Record *GribV2Record::GribV2NextDataSet(ZUFILE *file, int id_) {
   delete[] rec1->BMSbits;
   // new records take ownership
   this->grib_msg = 0;
+  rec1->deferredDS = 0;
   rec1->id = id_;
   rec1->readDataSet(file);
   return rec1;
@@ -1800,9 +1851,63 @@ GribV2Record *GribV2Record::GribV2NextDataSet(ZUFILE *file, int id_) {
 GribV2Record::GribV2Record(const GribRecord &rec) : GribRecord(rec) {
   *this = rec;
 #pragma warning(default : 4717)
+  grib_msg = 0;
+  deferredDS = 0;
+  deferData = false;
+  deferredScale = 1.0;
+}
+
+GribV2Record::~GribV2Record() {
+  delete grib_msg;
+  delete deferredDS;
+}
+
+// ---------------------------------------
+size_t GribV2Record::deferredDataSize() const {
+  return deferredDS ? deferredDS->total_len : 0;
 }
 
-GribV2Record::~GribV2Record() { delete grib_msg; }
+// ---------------------------------------
+bool GribV2Record::decodeDeferredData() {
+  if (deferredDS == 0) return data != NULL;
+
+  bool decoded = unpackDS(deferredDS);
+  if (decoded && deferredDS->grids.gridpoints != NULL) {
+    data = deferredDS->grids.gridpoints;
+    deferredDS->grids.gridpoints = 0;
+    if (deferredScale != 1.0) multiplyAllData(deferredScale);
+  } else {
+    // The record is already in use, leave it valid but without values
+    erreur("Record %d: can't decode data section", id);
+    decoded = false;
+    int npoints = Ni * Nj;
+    data = new double[npoints];
+    for (int l = 0; l < npoints; l++) data[l] = GRIB_MISSING_VALUE;
+  }
+  delete deferredDS;
+  deferredDS = 0;
+  return decoded;
+}
+
+// ---------------------------------------
+bool GribV2Record::deferredDataIsJpeg2000() const {
+  return deferredDS && (deferredDS->md.drs_templ_num == 40 ||
+                        deferredDS->md.drs_templ_num == 40000);
+}
+
+// ---------------------------------------
+bool GribV2Record::initDecoder() {
+#if defined(JASPER) && defined(GRIB_BUNDLED_JASPER)
+  // The bundled jasper sets up its tables on first use, which races when
+  // several threads decode at once. System builds don't export the setup.
+  jpc_initluts();
+  return true;
+#elif defined(JASPER)
+  return false;
+#else
+  return true;
+#endif
+}
 
 //==============================================================
 // Lecture des données
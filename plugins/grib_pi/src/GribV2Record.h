@@ -34,9 +34,16 @@ class GRIBMessage;
 //----------------------------------------------
 class GribV2Record : public GribRecord {
 public:
-  GribV2Record(ZUFILE* file, int id_);
+  // When deferData is true section 7 is not unpacked while reading, only
+  // a copy of its packed bytes is kept; call decodeDeferredData() later.
+  GribV2Record(ZUFILE* file, int id_, bool deferData = false);
   GribV2Record(const GribRecord& rec);
-  GribV2Record() { grib_msg = 0; }
+  GribV2Record() {
+    grib_msg = 0;
+    deferredDS = 0;
+    deferData = false;
+    deferredScale = 1.0;
+  }
 
   ~GribV2Record();
 
@@ -44,10 +51,25 @@ public:
   GribV2Record* GribV2NextDataSet(ZUFILE* file, int id_);
   bool hasMoreDataSet() const;
 
+  // Deferred data section access, decodeDeferredData() may be called
+  // concurrently on different records.
+  bool hasDeferredData() const { return deferredDS != 0; }
+  size_t deferredDataSize() const;
+  bool decodeDeferredData();
+  bool deferredDataIsJpeg2000() const;
+
+  // Must be called once from a single thread before decoding data sets
+  // on several threads. Returns false if JPEG2000 data sets must still be
+  // decoded one at a time.
+  static bool initDecoder();
+
 private:
   zuint periodSeconds(zuchar unit, zuint P1, zuint P2, zuchar range);
   void readDataSet(ZUFILE* file);
   class GRIBMessage* grib_msg;
+  class GRIBMessage* deferredDS;  // packed section 7 + metadata, or 0
+  bool deferData;
+  double deferredScale;  // unit conversion to apply once decoded
 
   //-----------------------------------------
   void translateDataType();  // adapte les codes des différents centres météo
@@ -0,0 +1,112 @@
+/******************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  GRIB Plugin worker threads
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#include <algorithm>
+
+#include "GribWorkerPool.h"
+
+GribWorkerPool &GribWorkerPool::Get() {
+  static GribWorkerPool pool;
+  return pool;
+}
+
+GribWorkerPool::GribWorkerPool()
+    : m_fn(nullptr),
+      m_count(0),
+      m_next(0),
+      m_generation(0),
+      m_busy(0),
+      m_stop(false) {}
+
+GribWorkerPool::~GribWorkerPool() { Stop(); }
+
+void GribWorkerPool::Stop() {
+  std::lock_guard<std::mutex> run_lock(m_run_mutex);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for (auto &t : m_workers) t.join();
+  m_workers.clear();
+  m_stop = false;
+}
+
+unsigned GribWorkerPool::GetThreadCount() const {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void GribWorkerPool::Work(const std::function<void(size_t)> &fn,
+                          size_t count) {
+  size_t i;
+  while ((i = m_next++) < count) fn(i);
+}
+
+void GribWorkerPool::Run() {
+  unsigned seen = 0;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [&] { return m_stop || m_generation != seen; });
+    if (m_stop) return;
+    seen = m_generation;
+    //  Woken after the loop has ended, nothing is left to do
+    if (!m_fn) continue;
+    //  Taken under the lock, the next loop does not set them before this
+    //  one has counted the thread out
+    const std::function<void(size_t)> *fn = m_fn;
+    size_t count = m_count;
+    m_busy++;
+    lock.unlock();
+    Work(*fn, count);
+    lock.lock();
+    if (--m_busy == 0) m_cv.notify_all();
+  }
+}
+
+void GribWorkerPool::ParallelFor(size_t count,
+                                 const std::function<void(size_t)> &fn) {
+  std::unique_lock<std::mutex> run_lock(m_run_mutex, std::try_to_lock);
+  if (!run_lock.owns_lock() || GetThreadCount() < 2 || count < 2) {
+    for (size_t i = 0; i < count; i++) fn(i);
+    return;
+  }
+  if (m_workers.empty()) {
+    for (unsigned i = 1; i < GetThreadCount(); i++)
+      m_workers.emplace_back([this] { Run(); });
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fn = &fn;
+    m_count = count;
+    m_next = 0;
+    m_generation++;
+  }
+  m_cv.notify_all();
+  Work(fn, count);
+
+  //  Workers which have not woken up yet find nothing left to do
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [&] { return m_busy == 0; });
+  m_fn = nullptr;
+}
@@ -0,0 +1,74 @@
+/******************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  GRIB Plugin worker threads
+ *
+ ***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#ifndef _GRIBWORKERPOOL_H_
+#define _GRIBWORKERPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Threads shared by GRIB decoding and isoline extraction, started on first
+ * use and kept until Stop() or the next use after it.
+ *
+ * One ParallelFor() runs at a time. A call made while another one runs,
+ * including one from inside a loop body, runs serially in the calling
+ * thread.
+ */
+class GribWorkerPool {
+public:
+  static GribWorkerPool &Get();
+
+  /** Call fn(0) ... fn(count - 1) on the pool and the calling thread. */
+  void ParallelFor(size_t count, const std::function<void(size_t)> &fn);
+
+  /** Number of threads a loop runs on, the calling one included. */
+  unsigned GetThreadCount() const;
+
+  /** Join the threads, as when the plugin is unloaded. */
+  void Stop();
+
+private:
+  GribWorkerPool();
+  ~GribWorkerPool();
+  void Run();
+  void Work(const std::function<void(size_t)> &fn, size_t count);
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_run_mutex;  // held by the running ParallelFor()
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  const std::function<void(size_t)> *m_fn;
+  size_t m_count;
+  std::atomic<size_t> m_next;
+  unsigned m_generation;
+  unsigned m_busy;
+  bool m_stop;
+};
+
+#endif
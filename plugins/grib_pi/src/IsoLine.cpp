@@ -26,7 +26,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //#include "model/georef.h"
 #include <wx/graphics.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
 #include "IsoLine.h"
+#include "GribWorkerPool.h"
 #include "GribSettingsDialog.h"
 #include "GribOverlayFactory.h"
 
@@ -38,10 +43,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // static void ClearSplineList();
 wxList ocpn_wx_spline_point_list;
 
-#include <wx/listimpl.cpp>
-WX_DEFINE_LIST(MySegList);
-WX_DEFINE_LIST(MySegListList);
-
 #ifndef PI
 #define PI 3.14159
 #endif
@@ -167,208 +168,329 @@ IsoLine::IsoLine(double val, double coeff, double offset,
   } else
     m_pixelMM = 0.27;  // semi-standard number...
 
-  value = val / coeff - offset;
-
-  rec = rec_;
-  W = rec_->getNi();
-  H = rec_->getNj();
-
-  //---------------------------------------------------------
-  // Génère la liste des segments.
-  extractIsoLine(rec_);
+  std::vector<double> levels(1, val / coeff - offset);
+  trace = ExtractIsoLines(rec_, levels)[0];
 
   value = val;
+}
 
-  if (trace.size() == 0) return;
-
-  //      Join the isoline segments into a nice list
-  //      Which is end-to-end continuous and unidirectional
-
-  //      Create a master wxList of the trace list
-  std::list<Segment *>::iterator it;
-  for (it = trace.begin(); it != trace.end(); it++) {
-    Segment *seg = *it;
-    seg->bUsed = false;
-    m_seglist.Append(*it);
-  }
-
-  //      Isoline may be discontinuous....
-  //      So build a list of continuous segments
-  bool bdone = false;
-  while (!bdone) {
-    MySegList *ps = BuildContinuousSegment();
+//---------------------------------------------------------------
+IsoLine::IsoLine(double val, std::shared_ptr<const IsoLineTrace> trace_)
+    : value(val), trace(trace_) {
+  if (wxGetDisplaySize().x > 0) {
+    m_pixelMM = PlugInGetDisplaySizeMM() / wxGetDisplaySize().x;
+    m_pixelMM = wxMax(.02, m_pixelMM);  // protect against bad data
+  } else
+    m_pixelMM = 0.27;  // semi-standard number...
+}
 
-    m_SegListList.Append(ps);
+//---------------------------------------------------------------
+IsoLine::~IsoLine() {}
 
-    MySegList::Node *node;
-    Segment *seg;
+//---------------------------------------------------------------
+// Marching squares
+//---------------------------------------------------------------
+namespace {
+
+// Cell corners, a b on row j-1 and c d on row j:
+// a  b
+// c  d
+enum { EDGE_AB, EDGE_CD, EDGE_AC, EDGE_BD, EDGE_NONE };
+
+// Edges crossed by the isoline, indexed by
+// (a > v) << 3 | (b > v) << 2 | (c > v) << 1 | (d > v).
+// Saddles (6 and 9) have two segments.
+const char s_cellEdges[16][4] = {
+    {EDGE_NONE, EDGE_NONE, EDGE_NONE, EDGE_NONE},  // 0
+    {EDGE_CD, EDGE_BD, EDGE_NONE, EDGE_NONE},      // 1  d
+    {EDGE_AC, EDGE_CD, EDGE_NONE, EDGE_NONE},      // 2  c
+    {EDGE_AC, EDGE_BD, EDGE_NONE, EDGE_NONE},      // 3  c d
+    {EDGE_AB, EDGE_BD, EDGE_NONE, EDGE_NONE},      // 4  b
+    {EDGE_AB, EDGE_CD, EDGE_NONE, EDGE_NONE},      // 5  b d
+    {EDGE_AB, EDGE_BD, EDGE_AC, EDGE_CD},          // 6  b c
+    {EDGE_AB, EDGE_AC, EDGE_NONE, EDGE_NONE},      // 7  b c d
+    {EDGE_AB, EDGE_AC, EDGE_NONE, EDGE_NONE},      // 8  a
+    {EDGE_AB, EDGE_AC, EDGE_BD, EDGE_CD},          // 9  a d
+    {EDGE_AB, EDGE_CD, EDGE_NONE, EDGE_NONE},      // 10 a c
+    {EDGE_AB, EDGE_BD, EDGE_NONE, EDGE_NONE},      // 11 a c d
+    {EDGE_AC, EDGE_BD, EDGE_NONE, EDGE_NONE},      // 12 a b
+    {EDGE_AC, EDGE_CD, EDGE_NONE, EDGE_NONE},      // 13 a b d
+    {EDGE_CD, EDGE_BD, EDGE_NONE, EDGE_NONE},      // 14 a b c
+    {EDGE_NONE, EDGE_NONE, EDGE_NONE, EDGE_NONE},  // 15
+};
 
-    // recreate the master list, removing used segs
+// A segment before stitching, with the grid edges it joins.
+struct RawSegment {
+  Segment seg;
+  int64_t e1, e2;
+};
 
-    node = m_seglist.GetFirst();
-    while (node) {
-      seg = node->GetData();
-      if (seg->bUsed) {
-        m_seglist.Erase(node);
-        node = m_seglist.GetFirst();
-      } else
-        node = node->GetNext();
-    }
+// Band of rows extracted by one thread, one segment list per level.
+typedef std::vector<std::vector<RawSegment> > BandSegments;
 
-    if (0 == m_seglist.GetCount()) bdone = true;
+class IsoLineGrid {
+public:
+  IsoLineGrid(const GribRecord *rec_) : rec(rec_) {
+    W = rec->getNi();
+    H = rec->getNj();
+    We = W;
+    if (rec->getLonMax() + rec->getDi() - rec->getLonMin() == 360) We++;
   }
 
-  /// printf("create Isobar : press=%4.0f long=%d\n", pressure/100,
-  /// trace.size());
-}
-//---------------------------------------------------------------
-IsoLine::~IsoLine() {
-  // printf("delete Isobar : press=%4.0f long=%d\n", pressure/100,
-  // trace.size());
-
-  std::list<Segment *>::iterator it;
-  for (it = trace.begin(); it != trace.end(); it++) {
-    delete *it;
-    *it = NULL;
+  // Unique id of the edge between grid points (i,j)-(k,l), where the two
+  // points are either horizontal or vertical neighbours, left/top first.
+  int64_t edgeKey(int i, int j, bool vertical) const {
+    return ((int64_t)j * We + i) * 2 + (vertical ? 1 : 0);
   }
-  trace.clear();
-
-  m_SegListList.DeleteContents(true);
-  m_SegListList.Clear();
-}
-
-MySegList *IsoLine::BuildContinuousSegment(void) {
-  MySegList::Node *node;
-  Segment *seg;
 
-  MySegList *ret_list = new MySegList;
+  // Intersection of the level with the edge (i,j)-(k,l)
+  void intersection(int i, int j, int k, int l, double v, double *x,
+                    double *y) const {
+    double xa, xb, ya, yb, pa, pb, dec;
+    pa = rec->getValue(i, j);
+    pb = rec->getValue(k, l);
 
-  //     Build a chain extending from the "2" end of the target segment
-  //      The joined list, side 2...
-  MySegList segjoin2;
+    rec->getXY(i, j, &xa, &ya);
+    rec->getXY(k, l, &xb, &yb);
 
-  //      Add any first segment to the list
-  node = m_seglist.GetFirst();
-  Segment *seg0 = node->GetData();
-  seg0->bUsed = true;
-  segjoin2.Append(seg0);
-
-  Segment *tseg = seg0;
-
-  while (tseg) {
-    bool badded = false;
-    Segment *seg;
-    node = m_seglist.GetFirst();
-    while (node) {
-      seg = node->GetData();
+    if (pb != pa)
+      dec = (v - pa) / (pb - pa);
+    else
+      dec = 0.5;
+    if (fabs(dec) > 1) dec = 0.5;
+    double xd = xb - xa;
+    if (xd < -180)
+      xd += 360;
+    else if (xd > 180)
+      xd -= 360;
+    *x = xa + xd * dec;
+    *y = ya + (yb - ya) * dec;
+  }
 
-      if ((!seg->bUsed) && (seg->py1 == tseg->py2) &&
-          (seg->px1 == tseg->px2))  // fits without reverse
-      {
-        seg->bUsed = true;
-        segjoin2.Append(seg);
-        badded = true;
+  void edgePoint(int edge, int im1, int ni, int j, double v, double *x,
+                 double *y, int64_t *key) const {
+    switch (edge) {
+      case EDGE_AB:
+        intersection(im1, j - 1, ni, j - 1, v, x, y);
+        *key = edgeKey(im1, j - 1, false);
         break;
-      } else if ((!seg->bUsed) && (seg->py2 == tseg->py2) &&
-                 (seg->px2 == tseg->px2))  // fits, needs reverse
-      {
-        seg->bUsed = true;
-        double a = seg->px2;
-        seg->px2 = seg->px1;
-        seg->px1 = a;
-        double b = seg->py2;
-        seg->py2 = seg->py1;
-        seg->py1 = b;
-        segjoin2.Append(seg);
-        badded = true;
+      case EDGE_CD:
+        intersection(im1, j, ni, j, v, x, y);
+        *key = edgeKey(im1, j, false);
+        break;
+      case EDGE_AC:
+        intersection(im1, j - 1, im1, j, v, x, y);
+        *key = edgeKey(im1, j - 1, true);
+        break;
+      default:  // EDGE_BD
+        intersection(ni, j - 1, ni, j, v, x, y);
+        *key = edgeKey(ni, j - 1, true);
         break;
-      }
-
-      node = node->GetNext();
     }
-    if (badded == true)
-      tseg = seg;
-    else
-      tseg = NULL;
   }
 
-  //     Build a chain extending from the "1" end of the target segment
-  //      The joined list, side 1...
-  MySegList segjoin1;
-
-  //      Add the same first segment to the list
-  node = m_seglist.GetFirst();
-  seg0 = node->GetData();
-  seg0->bUsed = true;
-  segjoin1.Append(seg0);
+  // Rows [j0, j1) of cells, levels must be sorted
+  void extract(int j0, int j1, const std::vector<double> &levels,
+               BandSegments &out) const {
+    out.resize(levels.size());
+    for (int j = j0; j < j1; j++) {
+      double a = rec->getValue(0, j - 1);
+      double c = rec->getValue(0, j);
+      double b, d;
+      for (int i = 1; i < We; i++, a = b, c = d) {
+        int ni = i == W ? 0 : i;
+        int im1 = i - 1;
+        b = rec->getValue(ni, j - 1);
+        d = rec->getValue(ni, j);
+
+        if (a == GRIB_NOTDEF || b == GRIB_NOTDEF || c == GRIB_NOTDEF ||
+            d == GRIB_NOTDEF)
+          continue;
+
+        // only levels with min <= v < max cross this cell
+        double vmin = std::min(std::min(a, b), std::min(c, d));
+        double vmax = std::max(std::max(a, b), std::max(c, d));
+        size_t n = std::lower_bound(levels.begin(), levels.end(), vmin) -
+                   levels.begin();
+        for (; n < levels.size() && levels[n] < vmax; n++) {
+          double v = levels[n];
+          int code = (a > v) << 3 | (b > v) << 2 | (c > v) << 1 | (d > v);
+          const char *edges = s_cellEdges[code];
+          for (int e = 0; e < 4 && edges[e] != EDGE_NONE; e += 2) {
+            RawSegment rs;
+            edgePoint(edges[e], im1, ni, j, v, &rs.seg.px1, &rs.seg.py1,
+                      &rs.e1);
+            edgePoint(edges[e + 1], im1, ni, j, v, &rs.seg.px2, &rs.seg.py2,
+                      &rs.e2);
+            out[n].push_back(rs);
+          }
+        }
+      }
+    }
+  }
 
-  tseg = seg0;
+private:
+  const GribRecord *rec;
+  int W, H, We;
+};
 
-  while (tseg) {
-    bool badded = false;
-    node = m_seglist.GetFirst();
-    while (node) {
-      seg = node->GetData();
+void Reverse(RawSegment &rs) {
+  std::swap(rs.seg.px1, rs.seg.px2);
+  std::swap(rs.seg.py1, rs.seg.py2);
+  std::swap(rs.e1, rs.e2);
+}
 
-      if ((!seg->bUsed) && (seg->py2 == tseg->py1) &&
-          (seg->px2 == tseg->px1))  // fits without reverse
-      {
-        seg->bUsed = true;
-        segjoin1.Append(seg);
-        badded = true;
-        break;
-      } else if ((!seg->bUsed) && (seg->py1 == tseg->py1) &&
-                 (seg->px1 == tseg->px1))  // fits, needs reverse
-      {
-        seg->bUsed = true;
-        double a = seg->px2;
-        seg->px2 = seg->px1;
-        seg->px1 = a;
-        double b = seg->py2;
-        seg->py2 = seg->py1;
-        seg->py1 = b;
-        segjoin1.Append(seg);
-        badded = true;
-        break;
-      }
+// Join segments sharing a grid edge into continuous, unidirectional lines.
+// An edge is shared by at most two segments, so each step is a lookup.
+IsoLineTrace *Stitch(std::vector<RawSegment> &segs) {
+  IsoLineTrace *trace = new IsoLineTrace;
+  trace->reserve(segs.size());
+
+  std::unordered_map<int64_t, std::pair<int, int> > edges;
+  edges.reserve(segs.size() * 2);
+  for (int s = 0; s < (int)segs.size(); s++) {
+    for (int64_t e : {segs[s].e1, segs[s].e2}) {
+      auto it = edges.emplace(e, std::make_pair(s, -1));
+      if (!it.second) it.first->second.second = s;
+    }
+  }
+  auto other = [&edges](int64_t e, int s) {
+    const std::pair<int, int> &p = edges[e];
+    return p.first == s ? p.second : p.first;
+  };
+
+  std::vector<bool> used(segs.size(), false);
+  std::vector<RawSegment> side1;
+  for (int s0 = 0; s0 < (int)segs.size(); s0++) {
+    if (used[s0]) continue;
+    used[s0] = true;
+
+    // extend backwards from the "1" end, collected in reverse order
+    side1.clear();
+    int cur = s0;
+    int64_t e = segs[s0].e1;
+    for (int s; (s = other(e, cur)) >= 0 && !used[s]; cur = s) {
+      used[s] = true;
+      if (segs[s].e2 != e) Reverse(segs[s]);
+      side1.push_back(segs[s]);
+      e = segs[s].e1;
+    }
+    for (auto it = side1.rbegin(); it != side1.rend(); ++it)
+      trace->push_back(it->seg);
+
+    // then the first segment and forward from its "2" end
+    trace->push_back(segs[s0].seg);
+    cur = s0;
+    e = segs[s0].e2;
+    for (int s; (s = other(e, cur)) >= 0 && !used[s]; cur = s) {
+      used[s] = true;
+      if (segs[s].e1 != e) Reverse(segs[s]);
+      trace->push_back(segs[s].seg);
+      e = segs[s].e2;
+    }
+  }
+  return trace;
+}
 
-      node = node->GetNext();
+}  // namespace
+
+std::vector<std::shared_ptr<const IsoLineTrace> > IsoLine::ExtractIsoLines(
+    const GribRecord *rec, const std::vector<double> &levels) {
+  std::vector<std::shared_ptr<const IsoLineTrace> > ret(levels.size());
+  if (levels.empty()) return ret;
+
+  std::vector<double> sorted(levels);
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+  IsoLineGrid grid(rec);
+  int H = rec->getNj();
+  // bands of at least 32 rows, a few per thread for load balancing
+  GribWorkerPool &pool = GribWorkerPool::Get();
+  int nbands = pool.GetThreadCount() * 4;
+  nbands = std::max(1, std::min(nbands, (H - 1) / 32));
+  std::vector<BandSegments> bands(nbands);
+  pool.ParallelFor(nbands, [&](size_t b) {
+    int j0 = 1 + (H - 1) * b / nbands;
+    int j1 = 1 + (H - 1) * (b + 1) / nbands;
+    grid.extract(j0, j1, sorted, bands[b]);
+  });
+
+  std::vector<std::shared_ptr<const IsoLineTrace> > traces(sorted.size());
+  pool.ParallelFor(sorted.size(), [&](size_t n) {
+    std::vector<RawSegment> segs;
+    for (auto &band : bands) {
+      if (n >= band.size()) continue;
+      segs.insert(segs.end(), band[n].begin(), band[n].end());
+      std::vector<RawSegment>().swap(band[n]);
     }
-    if (badded == true)
-      tseg = seg;
-    else
-      tseg = NULL;
+    traces[n].reset(Stitch(segs));
+  });
+
+  for (size_t l = 0; l < levels.size(); l++) {
+    size_t n = std::lower_bound(sorted.begin(), sorted.end(), levels[l]) -
+               sorted.begin();
+    ret[l] = traces[n];
   }
+  return ret;
+}
 
-  //     Now have two lists...
+//---------------------------------------------------------------
+// IsoLineCache
+//---------------------------------------------------------------
+void IsoLineCache::SetSettingsKey(int settings, const wxString &key) {
+  auto it = m_settingsKeys.find(settings);
+  if (it != m_settingsKeys.end() && it->second == key) return;
+  m_settingsKeys[settings] = key;
+
+  // keys of an overlay are contiguous, they sort on settings first
+  auto first = m_traces.lower_bound(Key(settings, nullptr, nullptr, -HUGE_VAL));
+  while (first != m_traces.end() && std::get<0>(first->first) == settings)
+    Erase(first++);
+}
 
-  //     Start with "1" side list,
-  //    starting from the end, and skipping the first segment
+std::shared_ptr<const IsoLineTrace> IsoLineCache::Get(int settings,
+                                                      const GribRecord *recx,
+                                                      const GribRecord *recy,
+                                                      double value) {
+  auto it = m_traces.find(Key(settings, recx, recy, value));
+  if (it == m_traces.end()) return nullptr;
+  m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+  return it->second.trace;
+}
 
-  int n1 = segjoin1.GetCount();
-  for (int i = n1 - 1; i > 0; i--) {
-    node = segjoin1.Item(i);
-    seg = node->GetData();
-    ret_list->Append(seg);
-  }
+void IsoLineCache::Put(int settings, const GribRecord *recx,
+                       const GribRecord *recy, double value,
+                       std::shared_ptr<const IsoLineTrace> trace) {
+  Key key(settings, recx, recy, value);
+  auto it = m_traces.find(key);
+  if (it != m_traces.end()) Erase(it);
 
-  //     Now add the "2"side list
-  int n2 = segjoin2.GetCount();
-  for (int i = 0; i < n2; i++) {
-    node = segjoin2.Item(i);
-    seg = node->GetData();
-    ret_list->Append(seg);
-  }
+  m_lru.push_front(key);
+  m_traces[key] = Entry{trace, m_lru.begin()};
+  m_segments += trace->size();
+
+  // the isoline just added is kept, even if larger than the budget
+  while (m_segments > m_maxSegments && m_lru.size() > 1)
+    Erase(m_traces.find(m_lru.back()));
+}
 
-  //     And there it is
+void IsoLineCache::Clear() {
+  m_traces.clear();
+  m_lru.clear();
+  m_segments = 0;
+}
 
-  return ret_list;
+void IsoLineCache::Erase(std::map<Key, Entry>::iterator it) {
+  m_segments -= it->second.trace->size();
+  m_lru.erase(it->second.lru);
+  m_traces.erase(it);
 }
 
 //---------------------------------------------------------------
 void IsoLine::drawIsoLine(GRIBOverlayFactory *pof, wxDC *dc,
                           PlugIn_ViewPort *vp, bool bHiDef) {
-  int nsegs = trace.size();
+  int nsegs = trace->size();
   if (nsegs < 1) return;
 
   GetGlobalColor(_T ( "UITX1" ), &isoLineColor);
@@ -411,13 +533,11 @@ void IsoLine::drawIsoLine(GRIBOverlayFactory *pof, wxDC *dc,
 #endif
   }
 
-  std::list<Segment *>::iterator it;
-
   //---------------------------------------------------------
   // Dessine les segments
   //---------------------------------------------------------
-  for (it = trace.begin(); it != trace.end(); it++) {
-    Segment *seg = *it;
+  for (auto it = trace->begin(); it != trace->end(); it++) {
+    const Segment *seg = &*it;
 
     if (vp->m_projection_type == PI_PROJECTION_MERCATOR ||
         vp->m_projection_type == PI_PROJECTION_EQUIRECTANGULAR) {
@@ -473,7 +593,6 @@ void IsoLine::drawIsoLineLabels(GRIBOverlayFactory *pof, wxDC *dc,
                                 wxImage &imageLabel)
 
 {
-  std::list<Segment *>::iterator it;
   int nb = first;
   wxString label;
 
@@ -481,9 +600,9 @@ void IsoLine::drawIsoLineLabels(GRIBOverlayFactory *pof, wxDC *dc,
   // Ecrit les labels
   //---------------------------------------------------------
   wxRect prev;
-  for (it = trace.begin(); it != trace.end(); it++, nb++) {
+  for (auto it = trace->begin(); it != trace->end(); it++, nb++) {
     if (nb % density == 0) {
-      Segment *seg = *it;
+      const Segment *seg = &*it;
 
       //            if(vp->vpBBox.PointInBox((seg->px1 + seg->px2)/2., (seg->py1
       //            + seg->py2)/2., 0.))
@@ -521,7 +640,6 @@ void IsoLine::drawIsoLineLabelsGL(GRIBOverlayFactory *pof, PlugIn_ViewPort *vp,
                                   wxColour &color, TexFont &texfont)
 
 {
-  std::list<Segment *>::iterator it;
   int nb = first;
 
 #ifdef ocpnUSE_GL
@@ -532,9 +650,9 @@ void IsoLine::drawIsoLineLabelsGL(GRIBOverlayFactory *pof, PlugIn_ViewPort *vp,
   // Ecrit les labels
   //---------------------------------------------------------
   wxRect prev;
-  for (it = trace.begin(); it != trace.end(); it++, nb++) {
+  for (auto it = trace->begin(); it != trace->end(); it++, nb++) {
     if (nb % density == 0) {
-      Segment *seg = *it;
+      const Segment *seg = &*it;
 
       //            if(vp->vpBBox.PointInBox((seg->px1 + seg->px2)/2., (seg->py1
       //            + seg->py2)/2., 0.))
@@ -599,152 +717,6 @@ void IsoLine::drawIsoLineLabelsGL(GRIBOverlayFactory *pof, PlugIn_ViewPort *vp,
 #endif
 }
 
-//==================================================================================
-// Segment
-//==================================================================================
-Segment::Segment(int I, int w, int J, char c1, char c2, char c3, char c4,
-                 const GribRecord *rec, double pressure) {
-  traduitCode(I, w, J, c1, i, j);
-  traduitCode(I, w, J, c2, k, l);
-  traduitCode(I, w, J, c3, m, n);
-  traduitCode(I, w, J, c4, o, p);
-
-  intersectionAreteGrille(i, j, k, l, &px1, &py1, rec, pressure);
-  intersectionAreteGrille(m, n, o, p, &px2, &py2, rec, pressure);
-}
-//-----------------------------------------------------------------------
-void Segment::intersectionAreteGrille(int i, int j, int k, int l, double *x,
-                                      double *y, const GribRecord *rec,
-                                      double pressure) {
-  double xa, xb, ya, yb, pa, pb, dec;
-  pa = rec->getValue(i, j);
-  pb = rec->getValue(k, l);
-
-  rec->getXY(i, j, &xa, &ya);
-  rec->getXY(k, l, &xb, &yb);
-
-  // Abscisse
-  if (pb != pa)
-    dec = (pressure - pa) / (pb - pa);
-  else
-    dec = 0.5;
-  if (fabs(dec) > 1) dec = 0.5;
-  double xd = xb - xa;
-  if (xd < -180)
-    xd += 360;
-  else if (xd > 180)
-    xd -= 360;
-  *x = xa + xd * dec;
-
-  // Ordonnée
-  if (pb != pa)
-    dec = (pressure - pa) / (pb - pa);
-  else
-    dec = 0.5;
-  if (fabs(dec) > 1) dec = 0.5;
-  *y = ya + (yb - ya) * dec;
-}
-//---------------------------------------------------------------
-void Segment::traduitCode(int I, int w, int J, char c1, int &i, int &j) {
-  int Im1 = I ? I - 1 : w - 1;
-  switch (c1) {
-    case 'a':
-      i = Im1;
-      j = J - 1;
-      break;
-    case 'b':
-      i = I;
-      j = J - 1;
-      break;
-    case 'c':
-      i = Im1;
-      j = J;
-      break;
-    case 'd':
-      i = I;
-      j = J;
-      break;
-    default:
-      i = I;
-      j = J;
-  }
-}
-
-//-----------------------------------------------------------------------
-// Génère la liste des segments.
-// Les coordonnées sont les indices dans la grille du GribRecord
-//---------------------------------------------------------
-void IsoLine::extractIsoLine(const GribRecord *rec) {
-  int i, j, W, H;
-  double a, b, c, d;
-  W = rec->getNi();
-  H = rec->getNj();
-
-  int We = W;
-  if (rec->getLonMax() + rec->getDi() - rec->getLonMin() == 360) We++;
-
-  for (j = 1; j < H; j++)  // !!!! 1 to end
-  {
-    a = rec->getValue(0, j - 1);
-    c = rec->getValue(0, j);
-    for (i = 1; i < We; i++, a = b, c = d) {
-      //            x = rec->getX(i);
-      //            y = rec->getY(j);
-
-      int ni = i;
-      if (i == W) ni = 0;
-      b = rec->getValue(ni, j - 1);
-      d = rec->getValue(ni, j);
-
-      if (a == GRIB_NOTDEF || b == GRIB_NOTDEF || c == GRIB_NOTDEF ||
-          d == GRIB_NOTDEF)
-        continue;
-
-      if ((a < value && b < value && c < value && d < value) ||
-          (a > value && b > value && c > value && d > value))
-        continue;
-
-      // Détermine si 1 ou 2 segments traversent la case ab-cd
-      // a  b
-      // c  d
-      //--------------------------------
-      // 1 segment en diagonale
-      //--------------------------------
-      if ((a <= value && b <= value && c <= value && d > value) ||
-          (a > value && b > value && c > value && d <= value))
-        trace.push_back(new Segment(ni, W, j, 'c', 'd', 'b', 'd', rec, value));
-      else if ((a <= value && c <= value && d <= value && b > value) ||
-               (a > value && c > value && d > value && b <= value))
-        trace.push_back(new Segment(ni, W, j, 'a', 'b', 'b', 'd', rec, value));
-      else if ((c <= value && d <= value && b <= value && a > value) ||
-               (c > value && d > value && b > value && a <= value))
-        trace.push_back(new Segment(ni, W, j, 'a', 'b', 'a', 'c', rec, value));
-      else if ((a <= value && b <= value && d <= value && c > value) ||
-               (a > value && b > value && d > value && c <= value))
-        trace.push_back(new Segment(ni, W, j, 'a', 'c', 'c', 'd', rec, value));
-      //--------------------------------
-      // 1 segment H ou V
-      //--------------------------------
-      else if ((a <= value && b <= value && c > value && d > value) ||
-               (a > value && b > value && c <= value && d <= value))
-        trace.push_back(new Segment(ni, W, j, 'a', 'c', 'b', 'd', rec, value));
-      else if ((a <= value && c <= value && b > value && d > value) ||
-               (a > value && c > value && b <= value && d <= value))
-        trace.push_back(new Segment(ni, W, j, 'a', 'b', 'c', 'd', rec, value));
-      //--------------------------------
-      // 2 segments en diagonale
-      //--------------------------------
-      else if (a <= value && d <= value && c > value && b > value) {
-        trace.push_back(new Segment(ni, W, j, 'a', 'b', 'b', 'd', rec, value));
-        trace.push_back(new Segment(ni, W, j, 'a', 'c', 'c', 'd', rec, value));
-      } else if (a > value && d > value && c <= value && b <= value) {
-        trace.push_back(new Segment(ni, W, j, 'a', 'b', 'a', 'c', rec, value));
-        trace.push_back(new Segment(ni, W, j, 'b', 'd', 'c', 'd', rec, value));
-      }
-    }
-  }
-}
-
 // ----------------------------------------------------------------------------
 // splines code lifted from wxWidgets
 // ----------------------------------------------------------------------------
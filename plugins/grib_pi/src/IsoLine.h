@@ -25,6 +25,9 @@ Dessin des données GRIB (avec QT)
 
 #include <iostream>
 #include <cmath>
+#include <map>
+#include <memory>
+#include <tuple>
 #include <vector>
 #include <list>
 #include <set>
@@ -36,10 +39,6 @@ Dessin des données GRIB (avec QT)
 class ViewPort;
 class wxDC;
 
-class Segment;
-WX_DECLARE_LIST(Segment, MySegList);
-WX_DECLARE_LIST(MySegList, MySegListList);
-
 //-------------------------------------------------------------------------------------------------------
 //  Cohen & Sutherland Line clipping algorithms
 //-------------------------------------------------------------------------------------------------------
@@ -71,30 +70,56 @@ extern "C" ClipResult cohen_sutherland_line_clip_i(int *x0, int *y0, int *x1,
 
 #endif
 
-// TODO: join segments and draw a spline
-
 //===============================================================
-// Elément d'isobare qui passe dans un carré (ab-cd)de la grille.
-// a  b
-// c  d
-// Rejoint l'arête (i,j)-(k,l) à l'arête (m,n)-(o,p) (indices ds la grille GRIB)
+// Elément d'isobare qui passe dans un carré de la grille.
+// (px1,py1) - (px2,py2) : lon/lat des intersections avec les arêtes.
+// In an IsoLineTrace segments are stitched: the end of a segment is the
+// start of the next one, except where the line is broken.
+struct Segment {
+  double px1, py1;
+  double px2, py2;
+};
 
-class Segment {
+typedef std::vector<Segment> IsoLineTrace;
+
+//===============================================================
+// Isolines already extracted from a GRIB file record, per overlay and
+// level. Records are identified by address, so the cache must not outlive
+// them. The least recently used isolines are dropped beyond maxSegments.
+class IsoLineCache {
 public:
-  Segment(int I, int w, int J, char c1, char c2, char c3, char c4,
-          const GribRecord *rec, double pressure);
+  IsoLineCache(size_t maxSegments = 2 * 1024 * 1024)
+      : m_segments(0), m_maxSegments(maxSegments) {}
 
-  int i, j, k, l;   // arête 1
-  double px1, py1;  // Coordonées de l'intersection (i,j)-(k,l)
-  int m, n, o, p;   // arête 2
-  double px2, py2;  // Coordonées de l'intersection (m,n)-(o,p)
-  bool bUsed;
+  // Drop the isolines of overlay settings when the settings they were
+  // extracted with, summarized by key, change.
+  void SetSettingsKey(int settings, const wxString &key);
 
-private:
-  void traduitCode(int I, int w, int J, char c1, int &i, int &j);
+  std::shared_ptr<const IsoLineTrace> Get(int settings,
+                                          const GribRecord *recx,
+                                          const GribRecord *recy,
+                                          double value);
+  void Put(int settings, const GribRecord *recx, const GribRecord *recy,
+           double value, std::shared_ptr<const IsoLineTrace> trace);
+  void Clear();
 
-  void intersectionAreteGrille(int i, int j, int k, int l, double *x, double *y,
-                               const GribRecord *rec, double pressure);
+  size_t GetSegmentCount() const { return m_segments; }
+
+private:
+  typedef std::tuple<int, const GribRecord *, const GribRecord *, double>
+      Key;
+  struct Entry {
+    std::shared_ptr<const IsoLineTrace> trace;
+    std::list<Key>::iterator lru;
+  };
+
+  void Erase(std::map<Key, Entry>::iterator it);
+
+  std::map<Key, Entry> m_traces;
+  std::list<Key> m_lru;  // most recently used first
+  std::map<int, wxString> m_settingsKeys;
+  size_t m_segments;
+  size_t m_maxSegments;
 };
 
 class GRIBOverlayFactory;
@@ -104,8 +129,14 @@ class TexFont;
 class IsoLine {
 public:
   IsoLine(double val, double coeff, double offset, const GribRecord *rec);
+  IsoLine(double val, std::shared_ptr<const IsoLineTrace> trace);
   ~IsoLine();
 
+  // Marching squares over the whole grid for all levels (in record units)
+  // in a single pass, split in row bands processed in parallel.
+  static std::vector<std::shared_ptr<const IsoLineTrace> > ExtractIsoLines(
+      const GribRecord *rec, const std::vector<double> &levels);
+
   void drawIsoLine(GRIBOverlayFactory *pof, wxDC *dc, PlugIn_ViewPort *vp,
                    bool bHiDef);
 
@@ -115,30 +146,15 @@ public:
                            int density, int first, wxString label,
                            wxColour &color, TexFont &texfont);
 
-  int getNbSegments() { return trace.size(); }
+  int getNbSegments() { return trace->size(); }
 
   double getValue() { return value; }
 
 private:
   double value;
-  int W, H;  // taille de la grille
-  const GribRecord *rec;
 
   wxColour isoLineColor;
-  std::list<Segment *> trace;
-
-  void intersectionAreteGrille(int i, int j, int k, int l, double *x, double *y,
-                               const GribRecord *rec);
-
-  //-----------------------------------------------------------------------
-  // Génère la liste des segments.
-  // Les coordonnées sont les indices dans la grille du GribRecord
-  //---------------------------------------------------------
-  void extractIsoLine(const GribRecord *rec);
-  MySegList *BuildContinuousSegment(void);
-
-  MySegList m_seglist;
-  MySegListList m_SegListList;
+  std::shared_ptr<const IsoLineTrace> trace;
 
   double m_pixelMM;
 };
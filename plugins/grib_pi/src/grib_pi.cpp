@@ -41,6 +41,7 @@
 #include <wx/stdpaths.h>
 
 #include "grib_pi.h"
+#include "GribWorkerPool.h"
 
 #ifdef __WXQT__
 #include "qdebug.h"
@@ -184,6 +185,8 @@ bool grib_pi::DeInit(void) {
   delete m_pGRIBOverlayFactory;
   m_pGRIBOverlayFactory = NULL;
 
+  GribWorkerPool::Get().Stop();
+
   return true;
 }
 
@@ -31,8 +31,6 @@
 #include "wx/wx.h"
 #endif  // precompiled headers
 
-#include <wx/progdlg.h>
-
 #include "ocpn_plugin.h"
 #include "pi_ocpndc.h"
 
@@ -52,27 +50,23 @@
 
 double square(double x) { return x * x; }
 
-/* initialize cache to contain data */
-void ParamCache::Initialize(double step) {
-  if (m_step != step) {
-    m_step = step;
-    delete[] values;
-    int size = 360 / step;
-    values = new double[size];
-  }
-  m_lat = 100; /* invalidate data */
+/* initialize cache for the zone with south west corner lat, lon */
+void ParamCache::Initialize(double step, double lat, double lon) {
+  m_step = step;
+  m_lat = lat;
+  m_lon = lon;
+  m_n = ZONE_SIZE / step;
+  values.resize((m_n + 1) * (m_n + 1));
 }
 
 /* attempt a cache read returning a hit or miss */
 bool ParamCache::Read(double lat, double lon, double &value) {
-  if (lat != m_lat) return false;
-  lon += 180;
-  if (lon > 360) lon -= 360;
-  if (lon < 0 || lon >= 360) return false;
-  double div = lon / m_step;
-  if (div != floor(div)) return false;
-
-  value = values[(int)div];
+  double divlat = (lat - m_lat) / m_step;
+  double divlon = (lon - m_lon) / m_step;
+  if (divlat != floor(divlat) || divlon != floor(divlon)) return false;
+  if (divlat < 0 || divlat > m_n || divlon < 0 || divlon > m_n) return false;
+
+  value = values[(int)divlat * (m_n + 1) + (int)divlon];
   return true;
 }
 
@@ -126,8 +120,30 @@ void MagneticPlotMap::ConfigureAccuracy(int step, int poleaccuracy) {
   }
 }
 
+MagneticPlotCalc::MagneticPlotCalc(MagneticPlotType type,
+                                   MAGtype_MagneticModel *mm,
+                                   MAGtype_Ellipsoid ellip, MAGtype_Date date,
+                                   double step, double spacing,
+                                   double poleaccuracy)
+    : m_type(type),
+      m_Spacing(spacing),
+      m_Step(step),
+      m_PoleAccuracy(poleaccuracy),
+      Ellip(ellip),
+      UserDate(date) {
+  int NumTerms = (mm->nMax + 1) * (mm->nMax + 2) / 2;
+  TimedMagneticModel = MAG_AllocateModelMemory(NumTerms);
+
+  /* Time adjust the coefficients, Equation 19, WMM Technical report */
+  MAG_TimelyModifyMagneticModel(UserDate, mm, TimedMagneticModel);
+}
+
+MagneticPlotCalc::~MagneticPlotCalc() {
+  MAG_FreeMagneticModelMemory(TimedMagneticModel);
+}
+
 /* compute the graphed parameter for one lat/lon location */
-double MagneticPlotMap::CalcParameter(double lat, double lon) {
+double MagneticPlotCalc::CalcParameter(double lat, double lon) {
   MAGtype_CoordSpherical CoordSpherical;
   MAGtype_CoordGeodetic CoordGeodetic;
   MAGtype_GeoMagneticElements GeoMagneticElements;
@@ -140,10 +156,10 @@ double MagneticPlotMap::CalcParameter(double lat, double lon) {
 
   /* Convert from geodeitic to Spherical Equations: 17-18, WMM Technical report
    */
-  MAG_GeodeticToSpherical(*Ellip, CoordGeodetic, &CoordSpherical);
+  MAG_GeodeticToSpherical(Ellip, CoordGeodetic, &CoordSpherical);
 
   /* Computes the geoMagnetic field elements and their time change */
-  MAG_Geomag(*Ellip, CoordSpherical, CoordGeodetic, TimedMagneticModel,
+  MAG_Geomag(Ellip, CoordSpherical, CoordGeodetic, TimedMagneticModel,
              &GeoMagneticElements);
   MAG_CalculateGridVariation(CoordGeodetic, &GeoMagneticElements);
 
@@ -164,21 +180,13 @@ double MagneticPlotMap::CalcParameter(double lat, double lon) {
   return ret;
 }
 
-/* build up cache for all longitudes */
-void MagneticPlotMap::BuildParamCache(ParamCache &cache, double lat) {
-  int i = 0;
-  for (double lon = -180; lon < 180; lon += m_Step, i++)
-    cache.values[i] = CalcParameter(lat, lon);
-  cache.m_lat = lat;
-}
-
 /* a possible speedup would be to cache the last 4-10 values
-   calculated as well as the two main cache banks to speed
-   up the recursion in PlotRegion */
-double MagneticPlotMap::CachedCalcParameter(double lat, double lon) {
+   calculated as well as the zone grid to speed up the recursion
+   in PlotRegion */
+double MagneticPlotCalc::CachedCalcParameter(ParamCache &cache, double lat,
+                                             double lon) {
   double value;
-  if (!m_Cache[0].Read(lat, lon, value) && !m_Cache[1].Read(lat, lon, value))
-    value = CalcParameter(lat, lon);
+  if (!cache.Read(lat, lon, value)) value = CalcParameter(lat, lon);
   return value;
 }
 
@@ -188,7 +196,7 @@ double MagneticPlotMap::CachedCalcParameter(double lat, double lon) {
    x2 to allow computing new y values along te segment.   rx is set to nan if
    there is no intersection.  True is returned if success, otherwise false
    to signify that we need to dig deeper to get a decent map. */
-bool MagneticPlotMap::Interpolate(double x1, double x2, double y1, double y2,
+bool MagneticPlotCalc::Interpolate(double x1, double x2, double y1, double y2,
                                   bool lat, double lonval, double &rx,
                                   double &ry) {
   if (fabs(x1 - x2) < m_PoleAccuracy) { /* to avoid recursing too far. make this
@@ -278,13 +286,12 @@ bool MagneticPlotMap::Interpolate(double x1, double x2, double y1, double y2,
 }
 
 /* once we have a final line segment, store it in the database */
-void AddLineSeg(std::list<PlotLineSeg *> &region, double lat1, double lon1,
+void AddLineSeg(std::vector<PlotLineSeg> &region, double lat1, double lon1,
                 double lat2, double lon2, double contour1, double contour2) {
   if (contour1 != contour2) /* this should not be possible */
     return;
 
-  PlotLineSeg *seg = new PlotLineSeg(lat1, lon1, lat2, lon2, contour1);
-  region.push_back(seg);
+  region.push_back(PlotLineSeg(lat1, lon1, lat2, lon2, contour1));
 }
 
 /* we generate contour maps by sampling the value at various
@@ -299,12 +306,14 @@ void AddLineSeg(std::list<PlotLineSeg *> &region, double lat1, double lon1,
               lon4
 
 */
-void MagneticPlotMap::PlotRegion(std::list<PlotLineSeg *> &region, double lat1,
-                                 double lon1, double lat2, double lon2) {
-  double p1 = CachedCalcParameter(lat1, lon1);
-  double p2 = CachedCalcParameter(lat1, lon2);
-  double p3 = CachedCalcParameter(lat2, lon1);
-  double p4 = CachedCalcParameter(lat2, lon2);
+void MagneticPlotCalc::PlotRegion(ParamCache &cache,
+                                  std::vector<PlotLineSeg> &region,
+                                  double lat1, double lon1, double lat2,
+                                  double lon2) {
+  double p1 = CachedCalcParameter(cache, lat1, lon1);
+  double p2 = CachedCalcParameter(cache, lat1, lon2);
+  double p3 = CachedCalcParameter(cache, lat2, lon1);
+  double p4 = CachedCalcParameter(cache, lat2, lon2);
 
   if (std::isnan(p1) || std::isnan(p2) || std::isnan(p3) || std::isnan(p4))
     return;
@@ -316,8 +325,8 @@ void MagneticPlotMap::PlotRegion(std::list<PlotLineSeg *> &region, double lat1,
   if (!Interpolate(lon1, lon2, p1, p2, false, lat1, lon3, ry1) ||
       !Interpolate(lon1, lon2, p3, p4, false, lat2, lon4, ry2)) {
     lon3 = (lon1 + lon2) / 2;
-    PlotRegion(region, lat1, lon1, lat2, lon3);
-    PlotRegion(region, lat1, lon3, lat2, lon2);
+    PlotRegion(cache, region, lat1, lon1, lat2, lon3);
+    PlotRegion(cache, region, lat1, lon3, lat2, lon2);
     return;
   }
 
@@ -325,8 +334,8 @@ void MagneticPlotMap::PlotRegion(std::list<PlotLineSeg *> &region, double lat1,
   if (!Interpolate(lat1, lat2, p1, p3, true, lon1, lat3, ry3) ||
       !Interpolate(lat1, lat2, p2, p4, true, lon2, lat4, ry4)) {
     lat3 = (lat1 + lat2) / 2;
-    PlotRegion(region, lat1, lon1, lat3, lon2);
-    PlotRegion(region, lat3, lon1, lat2, lon2);
+    PlotRegion(cache, region, lat1, lon1, lat3, lon2);
+    PlotRegion(cache, region, lat3, lon1, lat2, lon2);
     return;
   }
 
@@ -340,10 +349,10 @@ void MagneticPlotMap::PlotRegion(std::list<PlotLineSeg *> &region, double lat1,
     case 0: /* all 4 sides? need to recurse to get better resolution */
       lon3 = (lon1 + lon2) / 2;
       lat3 = (lat1 + lat2) / 2;
-      PlotRegion(region, lat1, lon1, lat3, lon3);
-      PlotRegion(region, lat1, lon3, lat3, lon2);
-      PlotRegion(region, lat3, lon1, lat2, lon3);
-      PlotRegion(region, lat3, lon3, lat2, lon2);
+      PlotRegion(cache, region, lat1, lon1, lat3, lon3);
+      PlotRegion(cache, region, lat1, lon3, lat3, lon2);
+      PlotRegion(cache, region, lat3, lon1, lat2, lon3);
+      PlotRegion(cache, region, lat3, lon3, lat2, lon2);
       break;
     case 1:
     case 2:
@@ -377,56 +386,159 @@ void MagneticPlotMap::PlotRegion(std::list<PlotLineSeg *> &region, double lat1,
   }
 }
 
-/* rebuild the map at a given date */
-bool MagneticPlotMap::Recompute(wxDateTime date) {
-  if (!m_bEnabled) return true;
+/* plot one zone, sampling the grid of the zone only once */
+bool MagneticPlotCalc::PlotZone(int latind, int lonind,
+                                std::vector<PlotLineSeg> &region,
+                                const std::atomic<bool> &cancel) {
+  double lat0 = latind * ZONE_SIZE - MAX_LAT;
+  double lon0 = lonind * ZONE_SIZE - 180;
+
+  ParamCache cache;
+  cache.Initialize(m_Step, lat0, lon0);
+  for (int i = 0; i <= cache.m_n; i++)
+    for (int j = 0; j <= cache.m_n; j++)
+      cache.values[i * (cache.m_n + 1) + j] =
+          CalcParameter(lat0 + i * m_Step, lon0 + j * m_Step);
+
+  for (int i = 0; i < cache.m_n; i++) {
+    if (cancel) return false;
+    double lat = lat0 + i * m_Step;
+    for (int j = 0; j < cache.m_n; j++) {
+      double lon = lon0 + j * m_Step;
+      PlotRegion(cache, region, lat, lon, lat + m_Step, lon + m_Step);
+    }
+  }
+  return true;
+}
 
-  UserDate.Year = date.GetYear();
-  UserDate.Month = date.GetMonth();
-  UserDate.Day = date.GetDay();
+MagneticPlotSet::MagneticPlotSet(MagneticPlotCalc *calc)
+    : m_calc(calc), m_next(0), m_done(0), m_cancel(false) {
+  for (int latind = 0; latind < LATITUDE_ZONES; latind++)
+    for (int lonind = 0; lonind < LONGITUDE_ZONES; lonind++)
+      m_ready[latind][lonind] = false;
+}
 
-  char err[255];
-  MAG_DateToYear(&UserDate, err);
+bool MagneticPlotSet::Matches(const MAGtype_Date &date, double step,
+                              double spacing, double poleaccuracy) const {
+  return m_calc->UserDate.Year == date.Year &&
+         m_calc->UserDate.Month == date.Month &&
+         m_calc->UserDate.Day == date.Day && m_calc->m_Step == step &&
+         m_calc->m_Spacing == spacing && m_calc->m_PoleAccuracy == poleaccuracy;
+}
 
-  /* Time adjust the coefficients, Equation 19, WMM Technical report */
-  MAG_TimelyModifyMagneticModel(UserDate, MagneticModel, TimedMagneticModel);
+int MagneticPlotSet::ClaimZone() {
+  if (m_cancel) return -1;
+  int n = m_next++;
+  return n < LATITUDE_ZONES * LONGITUDE_ZONES ? n : -1;
+}
 
-  /* clear out old data */
-  ClearMap();
+/* zones are handed out working outwards from the equator so the
+   busiest waters show up first */
+void MagneticPlotSet::PlotZone(int n) {
+  int row = n / LONGITUDE_ZONES;
+  int latind = LATITUDE_ZONES / 2 + (row % 2 ? -(row + 1) / 2 : row / 2);
+  int lonind = n % LONGITUDE_ZONES;
 
-  wxGenericProgressDialog progressdialog(
-      _("Building Magnetic Map"),
-      m_type == DECLINATION_PLOT   ? _("Variation")
-      : m_type == INCLINATION_PLOT ? _("Inclination")
-                                   : _("Field Strength"),
-      180, NULL,
-      wxPD_SMOOTH | wxPD_ELAPSED_TIME | wxPD_REMAINING_TIME | wxPD_CAN_ABORT);
+  if (!m_calc->PlotZone(latind, lonind, m_zones[latind][lonind], m_cancel))
+    return;
+  m_ready[latind][lonind].store(true, std::memory_order_release);
+  m_done++;
+}
 
-  int cachepage = 0;
-  m_Cache[0].Initialize(m_Step);
-  m_Cache[1].Initialize(m_Step);
+MagneticPlotPool::MagneticPlotPool() : m_stop(false) {}
 
-  BuildParamCache(m_Cache[cachepage], -MAX_LAT);
+MagneticPlotPool::~MagneticPlotPool() { Stop(); }
+
+void MagneticPlotPool::Add(std::shared_ptr<MagneticPlotSet> set) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_workers.empty()) {
+    unsigned int nthreads = std::thread::hardware_concurrency();
+    nthreads = nthreads > 1 ? nthreads - 1 : 1;
+    for (unsigned int i = 0; i < nthreads; i++)
+      m_workers.push_back(std::thread(&MagneticPlotPool::Worker, this));
+  }
+  m_queue.push_back(set);
+  m_cv.notify_all();
+}
+
+void MagneticPlotPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < m_queue.size(); i++) m_queue[i]->Cancel();
+    m_queue.clear();
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for (size_t i = 0; i < m_workers.size(); i++) m_workers[i].join();
+  m_workers.clear();
+  m_stop = false;
+}
 
-  for (double lat = -MAX_LAT; lat + m_Step <= MAX_LAT; lat += m_Step) {
-    if (!progressdialog.Update(lat + 90)) {
-      return false;
+/* all threads work on the oldest set until its zones are handed out */
+void MagneticPlotPool::Worker() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (;;) {
+    m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+    if (m_stop) return;
+
+    std::shared_ptr<MagneticPlotSet> set = m_queue.front();
+    int n = set->ClaimZone();
+    if (n < 0) {
+      m_queue.pop_front();
+      continue;
     }
+    lock.unlock();
+    set->PlotZone(n);
+    set.reset(); /* a dropped set is freed here, outside the lock */
+    lock.lock();
+  }
+}
+
+/* most recently used plots kept for each plot type */
+static const size_t kMaxCachedPlots = 4;
+
+/* rebuild the map at a given date. The plot is computed in the background,
+   or taken from the recently computed ones if already there */
+bool MagneticPlotMap::Recompute(wxDateTime date) {
+  if (!m_bEnabled) return true;
+  if (!MagneticModel) return false;
 
-    cachepage = !cachepage;
-    BuildParamCache(m_Cache[cachepage], lat + m_Step);
+  UserDate.Year = date.GetYear();
+  UserDate.Month = date.GetMonth();
+  UserDate.Day = date.GetDay();
 
-    int latind = floor((lat + MAX_LAT) / ZONE_SIZE);
-    if (latind > LATITUDE_ZONES - 1) latind = LATITUDE_ZONES - 1;
-    for (double lon = -180; lon + m_Step <= 180; lon += m_Step) {
-      int lonind = floor((lon + 180) / ZONE_SIZE);
-      PlotRegion(m_map[latind][lonind], lat, lon, lat + m_Step, lon + m_Step);
+  char err[255];
+  MAG_DateToYear(&UserDate, err);
+
+  for (std::list<std::shared_ptr<MagneticPlotSet> >::iterator it =
+           m_Plots.begin();
+       it != m_Plots.end(); it++) {
+    if ((*it)->Matches(UserDate, m_Step, m_Spacing, m_PoleAccuracy)) {
+      m_Plots.splice(m_Plots.begin(), m_Plots, it);
+      return true;
     }
   }
 
+  /* a plot which was not finished is of no further use */
+  if (!m_Plots.empty() && !m_Plots.front()->IsComplete()) {
+    m_Plots.front()->Cancel();
+    m_Plots.pop_front();
+  }
+  while (m_Plots.size() >= kMaxCachedPlots) m_Plots.pop_back();
+
+  MagneticPlotCalc *calc =
+      new MagneticPlotCalc(m_type, MagneticModel, *Ellip, UserDate, m_Step,
+                           m_Spacing, m_PoleAccuracy);
+  m_Plots.push_front(std::make_shared<MagneticPlotSet>(calc));
+  m_Pool.Add(m_Plots.front());
+
   return true;
 }
 
+bool MagneticPlotMap::IsComputing() {
+  return m_bEnabled && !m_Plots.empty() && !m_Plots.front()->IsComplete();
+}
+
 /* draw a line segment in opengl from lat/lon and viewport */
 void DrawLineSeg(pi_ocpnDC *dc, PlugIn_ViewPort &VP, double lat1, double lon1,
                  double lat2, double lon2) {
@@ -453,11 +565,13 @@ void DrawLineSeg(pi_ocpnDC *dc, PlugIn_ViewPort &VP, double lat1, double lon1,
 #endif
 }
 
-/* reset the map and clear all the data so it can be reused */
+/* reset the map and clear all the data, stopping any computation */
 void MagneticPlotMap::ClearMap() {
-  for (int latind = 0; latind < LATITUDE_ZONES; latind++)
-    for (int lonind = 0; lonind < LONGITUDE_ZONES; lonind++)
-      m_map[latind][lonind].clear();
+  for (std::list<std::shared_ptr<MagneticPlotSet> >::iterator it =
+           m_Plots.begin();
+       it != m_Plots.end(); it++)
+    (*it)->Cancel();
+  m_Plots.clear();
 }
 
 /* draw text of the value of a contour at a given location */
@@ -503,7 +617,8 @@ void MagneticPlotMap::DrawContour(pi_ocpnDC *dc, PlugIn_ViewPort &VP,
 
 /* plot to dc, or opengl is dc is NULL */
 void MagneticPlotMap::Plot(pi_ocpnDC *dc, PlugIn_ViewPort *vp, wxColour color) {
-  if (!m_bEnabled) return;
+  if (!m_bEnabled || m_Plots.empty()) return;
+  MagneticPlotSet &plot = *m_Plots.front();
 
   wxFont font(15, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_ITALIC,
               wxFONTWEIGHT_NORMAL);
@@ -549,14 +664,14 @@ void MagneticPlotMap::Plot(pi_ocpnDC *dc, PlugIn_ViewPort *vp, wxColour color) {
   for (int latind = startlatind; latind <= endlatind; latind++)
     for (int lonind = startlonind;; lonind++) {
       if (lonind > LONGITUDE_ZONES - 1) lonind = 0;
-      for (std::list<PlotLineSeg *>::iterator it =
-               m_map[latind][lonind].begin();
-           it != m_map[latind][lonind].end(); it++) {
-        DrawLineSeg(dc, *vp, (*it)->lat1, (*it)->lon1, (*it)->lat2,
-                    (*it)->lon2);
-        wxString msg;
-        DrawContour(dc, *vp, (*it)->contour, ((*it)->lat1 + (*it)->lat2) / 2,
-                    ((*it)->lon1 + (*it)->lon2) / 2);
+      if (plot.IsReady(latind, lonind)) {
+        std::vector<PlotLineSeg> &zone = plot.m_zones[latind][lonind];
+        for (std::vector<PlotLineSeg>::iterator it = zone.begin();
+             it != zone.end(); it++) {
+          DrawLineSeg(dc, *vp, it->lat1, it->lon1, it->lat2, it->lon2);
+          DrawContour(dc, *vp, it->contour, (it->lat1 + it->lat2) / 2,
+                      (it->lon1 + it->lon2) / 2);
+        }
       }
       if (lonind == endlonind) break;
     }
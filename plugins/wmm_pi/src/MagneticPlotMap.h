@@ -25,7 +25,14 @@
  ***************************************************************************
  */
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "pi_TexFont.h"
 #include "GeomagnetismHeader.h"
 
@@ -57,24 +64,107 @@ public:
   double contour;
 };
 
-/* cache values computed from wmm to improve speed */
+/* cache values computed from wmm on the grid of one zone */
 class ParamCache {
 public:
-  ParamCache() : values(NULL), m_step(0), m_lat(0.0) {}
-  ~ParamCache() { delete[] values; }
-  void Initialize(double step);
+  ParamCache() : m_step(0), m_lat(0.0), m_lon(0.0), m_n(0) {}
+  void Initialize(double step, double lat, double lon);
   bool Read(double lat, double lon, double &value);
 
-  double *values;
+  std::vector<double> values;
   double m_step;
-  double m_lat;
+  double m_lat, m_lon; /* south west corner of the zone */
+  int m_n;             /* grid steps across the zone */
+};
+
+/* computes the contours of one parameter, zone by zone. Only reads its
+   own members, so any number of zones can be computed at once */
+class MagneticPlotCalc {
+public:
+  MagneticPlotCalc(MagneticPlotType type, MAGtype_MagneticModel *mm,
+                   MAGtype_Ellipsoid ellip, MAGtype_Date date, double step,
+                   double spacing, double poleaccuracy);
+  ~MagneticPlotCalc();
+
+  double CalcParameter(double lat, double lon);
+  double CachedCalcParameter(ParamCache &cache, double lat, double lon);
+  bool Interpolate(double x1, double x2, double y1, double y2, bool lat,
+                   double lonval, double &rx, double &ry);
+  void PlotRegion(ParamCache &cache, std::vector<PlotLineSeg> &region,
+                  double lat1, double lon1, double lat2, double lon2);
+  /* false if cancelled before done */
+  bool PlotZone(int latind, int lonind, std::vector<PlotLineSeg> &region,
+                const std::atomic<bool> &cancel);
+
+  MagneticPlotType m_type;
+  double m_Spacing;
+  double m_Step;
+  double m_PoleAccuracy;
+
+  MAGtype_MagneticModel *TimedMagneticModel; /* own copy for the date */
+  MAGtype_Ellipsoid Ellip;
+  MAGtype_Date UserDate;
+};
+
+/* the line segments for the entire globe at one date and accuracy,
+   computed in the background and drawable zone by zone as they complete */
+class MagneticPlotSet {
+public:
+  MagneticPlotSet(MagneticPlotCalc *calc);
+
+  bool Matches(const MAGtype_Date &date, double step, double spacing,
+               double poleaccuracy) const;
+  bool IsComplete() const {
+    return m_done == LATITUDE_ZONES * LONGITUDE_ZONES;
+  }
+  bool IsReady(int latind, int lonind) const {
+    return m_ready[latind][lonind].load(std::memory_order_acquire);
+  }
+
+  /* next zone to compute, -1 when none is left or cancelled */
+  int ClaimZone();
+  void PlotZone(int n);
+  /* zones being computed stop early, no more are handed out */
+  void Cancel() { m_cancel = true; }
+
+  std::vector<PlotLineSeg> m_zones[LATITUDE_ZONES][LONGITUDE_ZONES];
+
+private:
+  std::unique_ptr<MagneticPlotCalc> m_calc;
+  std::atomic<bool> m_ready[LATITUDE_ZONES][LONGITUDE_ZONES];
+  std::atomic<int> m_next;
+  std::atomic<int> m_done;
+  std::atomic<bool> m_cancel;
+};
+
+/* threads computing the zones of queued plot sets in turn, shared by the
+   plots of all types. Started on first use, one less than the number of
+   cores so the GUI thread keeps one */
+class MagneticPlotPool {
+public:
+  MagneticPlotPool();
+  ~MagneticPlotPool();
+
+  void Add(std::shared_ptr<MagneticPlotSet> set);
+  /* cancel the queued sets and join the threads */
+  void Stop();
+
+private:
+  void Worker();
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::shared_ptr<MagneticPlotSet> > m_queue;
+  std::vector<std::thread> m_workers;
+  bool m_stop;
 };
 
 /* main model map suitable for a single plot type */
 class MagneticPlotMap {
 public:
   MagneticPlotMap(MagneticPlotType type, MAGtype_MagneticModel *&mm,
-                  MAGtype_MagneticModel *&tmm, MAGtype_Ellipsoid *ellip)
+                  MAGtype_MagneticModel *&tmm, MAGtype_Ellipsoid *ellip,
+                  MagneticPlotPool &pool)
       : m_type(type),
         m_bEnabled(false),
         m_Spacing(0.0),
@@ -83,6 +173,7 @@ public:
         MagneticModel(mm),
         TimedMagneticModel(tmm),
         Ellip(ellip),
+        m_Pool(pool),
         lastx(0),
         lasty(0) {
     UserDate.Year = 2015;
@@ -94,14 +185,9 @@ public:
   ~MagneticPlotMap() { ClearMap(); }
 
   void ConfigureAccuracy(int stepsize, int poleaccuracy);
-  double CalcParameter(double lat, double lon);
-  void BuildParamCache(ParamCache &cache, double lat);
-  double CachedCalcParameter(double lat, double lon);
-  bool Interpolate(double x1, double x2, double y1, double y2, bool lat,
-                   double lonval, double &rx, double &ry);
-  void PlotRegion(std::list<PlotLineSeg *> &region, double lat1, double lon1,
-                  double lat2, double lon2);
   bool Recompute(wxDateTime date);
+  /* true while the current plot is still being computed */
+  bool IsComputing();
   void Plot(pi_ocpnDC *dc, PlugIn_ViewPort *vp, wxColour color);
 
   void ClearMap();
@@ -114,18 +200,14 @@ public:
   double m_Step;
   double m_PoleAccuracy;
 
-  /* two caches for all longitudes alternate
-     places (step over each other) to cover the two latitudes
-     currently being built */
-  ParamCache m_Cache[2];
-
   MAGtype_MagneticModel *&MagneticModel;
   MAGtype_MagneticModel *&TimedMagneticModel;
   MAGtype_Ellipsoid *Ellip;
   MAGtype_Date UserDate;
 
-  /* the line segments for the entire globe split into zones */
-  std::list<PlotLineSeg *> m_map[LATITUDE_ZONES][LONGITUDE_ZONES];
+  MagneticPlotPool &m_Pool;
+  /* recently computed plots, the current one first */
+  std::list<std::shared_ptr<MagneticPlotSet> > m_Plots;
 
   TexFont m_TexFont;
   int lastx, lasty; /* when rendering to prevent overcluttering */
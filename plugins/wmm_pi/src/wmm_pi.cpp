@@ -113,12 +113,13 @@ wmm_pi::wmm_pi(void *ppimgr)
     : opencpn_plugin_18(ppimgr),
       m_bShowPlot(false),
       m_DeclinationMap(DECLINATION_PLOT, MagneticModel, TimedMagneticModel,
-                       &Ellip),
+                       &Ellip, m_PlotPool),
       m_InclinationMap(INCLINATION_PLOT, MagneticModel, TimedMagneticModel,
-                       &Ellip),
+                       &Ellip, m_PlotPool),
       m_FieldStrengthMap(FIELD_STRENGTH_PLOT, MagneticModel, TimedMagneticModel,
-                         &Ellip),
-      m_bComputingPlot(false) {
+                         &Ellip, m_PlotPool),
+      m_bComputingPlot(false),
+      m_PlotRefreshTimer(*this) {
   // Create the PlugIn icons
   initialize_images();
 
@@ -242,6 +243,14 @@ bool wmm_pi::DeInit(void) {
     m_pWmmDialog = NULL;
   }
   SaveConfig();
+
+  m_PlotRefreshTimer.Stop();
+  m_bComputingPlot = false;
+  m_DeclinationMap.ClearMap();
+  m_InclinationMap.ClearMap();
+  m_FieldStrengthMap.ClearMap();
+  m_PlotPool.Stop();
+
   if (MagneticModel) {
     MAG_FreeMagneticModelMemory(MagneticModel);
   }
@@ -451,9 +460,6 @@ bool wmm_pi::RenderGLOverlay(wxGLContext *pcontext, PlugIn_ViewPort *vp) {
 void wmm_pi::RecomputePlot() {
   if (m_bCachedPlotOk) return;
 
-  if (m_bComputingPlot) return;
-  m_bComputingPlot = true;
-
   if (!m_DeclinationMap.Recompute(m_MapDate) ||
       !m_InclinationMap.Recompute(m_MapDate) ||
       !m_FieldStrengthMap.Recompute(m_MapDate)) {
@@ -462,9 +468,27 @@ void wmm_pi::RecomputePlot() {
   } else
     m_bCachedPlotOk = true;
 
-  m_bComputingPlot = false;
+  /* the plots are computed in the background, show them as they come */
+  if (!m_bComputingPlot &&
+      (m_DeclinationMap.IsComputing() || m_InclinationMap.IsComputing() ||
+       m_FieldStrengthMap.IsComputing())) {
+    m_bComputingPlot = true;
+    m_PlotRefreshTimer.Start(250);
+  }
 }
 
+void wmm_pi::OnPlotRefreshTimer() {
+  if (m_bShowPlot) RequestRefresh(m_parent_window);
+
+  if (!m_DeclinationMap.IsComputing() && !m_InclinationMap.IsComputing() &&
+      !m_FieldStrengthMap.IsComputing()) {
+    m_PlotRefreshTimer.Stop();
+    m_bComputingPlot = false;
+  }
+}
+
+void PlotRefreshTimer::Notify() { m_pi.OnPlotRefreshTimer(); }
+
 void wmm_pi::SetCursorLatLon(double lat, double lon) {
   if (!m_pWmmDialog) return;
 
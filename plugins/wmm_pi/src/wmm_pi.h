@@ -36,6 +36,7 @@
 #endif  // precompiled headers
 
 #include <wx/fileconf.h>
+#include <wx/timer.h>
 
 #include "version.h"
 #include "wxWTranslateCatalog.h"
@@ -93,6 +94,16 @@ public:
   void Cancel(wxCommandEvent &event) { EndDialog(wxID_CANCEL); }
 };
 
+/* refreshes the canvas while the plots are computed in the background */
+class PlotRefreshTimer : public wxTimer {
+public:
+  PlotRefreshTimer(wmm_pi &pi) : m_pi(pi) {}
+  void Notify();
+
+private:
+  wmm_pi &m_pi;
+};
+
 class wmm_pi : public opencpn_plugin_18 {
 public:
   wmm_pi(void *ppimgr);
@@ -118,6 +129,7 @@ public:
   bool RenderOverlay(wxDC &dc, PlugIn_ViewPort *vp);
   bool RenderGLOverlay(wxGLContext *pcontext, PlugIn_ViewPort *vp);
   void RecomputePlot();
+  void OnPlotRefreshTimer();
 
   int GetToolbarToolCount(void);
   void ShowPreferencesDialog(wxWindow *parent);
@@ -175,6 +187,7 @@ private:
   wxString AngleToText(double angle);
 
   bool m_bCachedPlotOk, m_bShowPlot;
+  MagneticPlotPool m_PlotPool; /* before the maps using it */
   MagneticPlotMap m_DeclinationMap, m_InclinationMap, m_FieldStrengthMap;
   wxDateTime m_MapDate;
   int m_MapStep;
@@ -193,6 +206,7 @@ private:
   MAGtype_GeoMagneticElements m_boatVariation;
 
   bool m_bComputingPlot;
+  PlotRefreshTimer m_PlotRefreshTimer;
   wxFont *pFontSmall;
   double m_scale;
   wxString m_shareLocn;
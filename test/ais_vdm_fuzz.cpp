@@ -0,0 +1,52 @@
+/**************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file ais_vdm_fuzz.cpp  libFuzzer target for AisVdmParser.
+ *
+ * Input is split on newlines and fed as a stream of sentences to one
+ * parser, so that multipart reassembly state is exercised too.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "model/ais_bitstring.h"
+#include "model/ais_vdm_parser.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  static AisVdmParser parser;
+  AisVdmMessage msg;
+  std::string_view input(reinterpret_cast<const char*>(data), size);
+
+  while (!input.empty()) {
+    size_t eol = input.find('\n');
+    std::string_view line = input.substr(0, eol);
+    input.remove_prefix(eol == std::string_view::npos ? input.size() : eol + 1);
+
+    if (parser.Parse(line, msg) != AisVdmResult::kComplete) continue;
+    if (msg.payload_len < 0 || msg.payload_len >= AIS_MAX_MESSAGE_LEN)
+      __builtin_trap();
+    for (int i = 0; i < msg.payload_len; i++)
+      if (msg.payload[i] > 0x3f) __builtin_trap();
+    AisBitstring bits(msg.payload, msg.payload_len);
+    bits.GetInt(1, 6);
+    bits.GetInt(9, 30);
+  }
+  return 0;
+}
@@ -0,0 +1,90 @@
+#include "config.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <wx/event.h>
+
+#include <gtest/gtest.h>
+
+#include "model/comm_navmsg.h"
+
+#include "observable.h"
+#include "ocpn_plugin.h"
+#include "N2KParser.h"
+
+// Replacing the global allocator affects every test in the executable, so
+// these tests do not share one with the others.
+
+void* g_pi_manager = reinterpret_cast<void*>(1L);
+
+static auto shared_navaddr_none = std::make_shared<NavAddr>();
+
+//  Counts heap allocations, for tests checking a path does not allocate
+static std::atomic<size_t> s_alloc_count(0);
+
+void* operator new(size_t size) {
+  s_alloc_count++;
+  void* p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static size_t N2000PayloadAllocs(ObservedEvt ev) {
+  size_t before = s_alloc_count;
+  auto msg = UnpackEvtPointer<Nmea2000Msg>(ev);
+  return s_alloc_count - before;
+}
+
+TEST(PluginApi, N2000PayloadView) {
+  // PGN 129025 position rapid update, 59.3N 18.1E
+  std::vector<unsigned char> payload = {0x93, 0x13, 2, 0x01, 0xf8, 0x01,
+                                        255,  1,    0, 0,    0,    0, 8};
+  for (int32_t value : {593000000, 181000000}) {
+    for (int i = 0; i < 4; i++) payload.push_back((value >> (8 * i)) & 0xff);
+  }
+  payload.push_back(0);  // crc
+
+  const wxEventTypeTag<ObservedEvt> EvtTest(wxNewEventType());
+  ObservedEvt ev(EvtTest);
+  ev.SetSharedPtr(std::make_shared<const Nmea2000Msg>(
+      static_cast<uint64_t>(129025), payload, shared_navaddr_none));
+  NMEA2000Id id(129025);
+
+  // The event is passed by value as in the plugin API
+  size_t baseline = N2000PayloadAllocs(ev);
+  size_t before = s_alloc_count;
+  { auto copy = GetN2000Payload(id, ev); }
+  size_t copy_allocs = s_alloc_count - before;
+  before = s_alloc_count;
+  N2000PayloadView view = GetN2000PayloadView(id, ev);
+  size_t view_allocs = s_alloc_count - before;
+  EXPECT_EQ(view_allocs, baseline);
+  EXPECT_EQ(copy_allocs, baseline + 1);
+
+  // Parsing from the shared payload does not allocate
+  double lat = 0, lon = 0;
+  before = s_alloc_count;
+  bool ok = ParseN2kPGN129025(view.vector(), lat, lon);
+  EXPECT_EQ(s_alloc_count - before, 0u);
+  EXPECT_TRUE(ok);
+  EXPECT_NEAR(lat, 59.3, 1e-6);
+  EXPECT_NEAR(lon, 18.1, 1e-6);
+
+  // The view keeps the message alive
+  ev.SetSharedPtr(std::shared_ptr<const void>());
+  ASSERT_EQ(view.size(), payload.size());
+  EXPECT_TRUE(std::equal(view.begin(), view.end(), payload.begin()));
+  EXPECT_EQ(view[3], 0x01);
+
+  // Truncated payloads are rejected, not read past the end
+  std::vector<unsigned char> truncated(payload.begin(), payload.begin() + 8);
+  EXPECT_FALSE(ParseN2kPGN129025(truncated, lat, lon));
+  EXPECT_TRUE(N2000PayloadView().empty());
+}
@@ -0,0 +1,94 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if (defined(__clang_major__) && (__clang_major__ < 15))   // MacOS 1.13
+#include <ghc/filesystem.hpp>
+namespace fs = ghc::filesystem;
+#else
+#include <filesystem>
+#include <utility>
+namespace fs = std::filesystem;
+#endif
+
+#include <gtest/gtest.h>
+
+#include "chartdldr_pipeline.h"
+
+using namespace std::literals::chrono_literals;
+
+TEST(ChartDldrPipeline, LocalServer) {
+  // A directory of archives stands in for the chart server, the charts are
+  // fetched from it as through file:// urls.
+  fs::path root = fs::path(CMAKE_BINARY_DIR) / "chartdldr-test";
+  fs::remove_all(root);
+  fs::create_directories(root / "server");
+  fs::create_directories(root / "charts");
+  const int n = 24;
+  for (int i = 0; i < n; i++) {
+    std::ofstream archive(root / "server" / ("chart" + std::to_string(i)));
+    archive << "chart " << i;
+  }
+  auto chart_path = [&](int i) {
+    return root / "charts" / ("chart" + std::to_string(i) + ".000");
+  };
+
+  std::atomic<int> extracting(0);
+  ChartDldrPipeline pipeline(
+      [](ChartDldrPipeline::Job& job) {
+        fs::copy_file(job.source.ToStdString(), job.archive.ToStdString());
+        job.bytes = fs::file_size(job.archive.ToStdString());
+        return true;
+      },
+      [&](ChartDldrPipeline::Job& job) {
+        extracting++;
+        std::this_thread::sleep_for(2ms);
+        fs::copy_file(job.archive.ToStdString(), chart_path(job.index));
+        fs::remove(job.archive.ToStdString());
+        extracting--;
+        return true;
+      },
+      2, 4, 8);
+  for (int i = 0; i < n; i++) {
+    ChartDldrPipeline::Job job;
+    job.index = i;
+    job.source = (root / "server" / ("chart" + std::to_string(i))).string();
+    job.archive = (root / "charts" / ("chart" + std::to_string(i))).string();
+    job.target_dir = (root / "charts").string();
+    pipeline.Fetch(job);
+  }
+
+  // As while the chart database is updated: no extraction runs until
+  // the pipeline is resumed.
+  pipeline.PauseExtraction(true);
+  while (pipeline.IsExtracting()) std::this_thread::sleep_for(1ms);
+  EXPECT_EQ(extracting, 0);
+  auto count_charts = [&] {
+    int count = 0;
+    for (int i = 0; i < n; i++) count += fs::exists(chart_path(i));
+    return count;
+  };
+  int paused_count = count_charts();
+  std::this_thread::sleep_for(20ms);
+  EXPECT_FALSE(pipeline.IsExtracting());
+  EXPECT_EQ(count_charts(), paused_count);
+  pipeline.PauseExtraction(false);
+
+  while (!pipeline.IsIdle()) std::this_thread::sleep_for(1ms);
+  std::vector<ChartDldrPipeline::Job> done;
+  EXPECT_EQ(pipeline.TakeFinished(done), static_cast<size_t>(n));
+  for (auto& job : done) EXPECT_TRUE(job.ok);
+  EXPECT_EQ(count_charts(), n);
+  std::ifstream chart(chart_path(7));
+  std::string text;
+  std::getline(chart, text);
+  EXPECT_EQ(text, "chart 7");
+  EXPECT_EQ(pipeline.GetStats(ChartDldrPipeline::STAGE_FETCH).done,
+            static_cast<size_t>(n));
+  EXPECT_EQ(pipeline.GetStats(ChartDldrPipeline::STAGE_EXTRACT).done,
+            static_cast<size_t>(n));
+  fs::remove_all(root);
+}
@@ -6,6 +6,8 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <stdexcept>
 #include <thread>
 
 
@@ -13,14 +15,17 @@
 #include <wx/event.h>
 #include <wx/evtloop.h>
 #include <wx/fileconf.h>
+#include <wx/jsonreader.h>
 #include <wx/jsonval.h>
 #include <wx/timer.h>
+#include <wx/tokenzr.h>
 
 #include <gtest/gtest.h>
 
 #include "model/ais_decoder.h"
 #include "model/ais_defs.h"
 #include "model/ais_state_vars.h"
+#include "model/ais_vdm_parser.h"
 #include "model/cli_platform.h"
 #include "model/comm_ais.h"
 #include "model/comm_appmsg_bus.h"
@@ -28,21 +33,33 @@
 #include "model/comm_drv_file.h"
 #include "model/comm_drv_registry.h"
 #include "model/comm_navmsg_bus.h"
+#include "model/comm_util.h"
 #include "model/config_vars.h"
+#include "model/georef.h"
 #include "model/ipc_api.h"
+#include "model/list_index.h"
 #include "model/logger.h"
 #include "model/multiplexer.h"
 #include "model/navutil_base.h"
+#include "model/nmea_subscriptions.h"
 #include "model/ocpn_types.h"
 #include "model/ocpn_utils.h"
 #include "model/own_ship.h"
 #include "model/routeman.h"
 #include "model/select.h"
+#include "model/startup_tasks.h"
+#include "model/station_index.h"
+#include "model/tex_cache_store.h"
 #include "model/std_instance_chk.h"
 #include "model/wait_continue.h"
 #include "model/wx_instance_chk.h"
+#include "gdal/ogr_feature.h"
+#include "iso8211.h"
 #include "observable_confvar.h"
 #include "ocpn_plugin.h"
+#include "rapidjson/document.h"
+#include "TextDeclutter.h"
+#include "TriRaster.h"
 
 // Macos up to 10.13
 #if defined(__clang_major__) && (__clang_major__ < 15)
@@ -954,3 +971,1020 @@ TEST(FormatTime, Basic) {
   s = formatTimeDelta(wxLongLong(110.0));
   EXPECT_EQ(s, " 1M 50S");
 }
+
+TEST(Georef, BatchProjection) {
+  using namespace std::chrono;
+  const int n = 100000;
+  std::vector<double> lat(n), lon(n), x(n), y(n);
+  for (int i = 0; i < n; i++) {
+    lat[i] = -80.0 + 160.0 * ((i * 7919) % n) / n;
+    lon[i] = -180.0 + 360.0 * ((i * 104729) % n) / n;
+  }
+  const double lat0 = 42.5, lon0 = -70.25;
+  double sin_phi0, cos_phi0;
+  cache_phi0(lat0, &sin_phi0, &cos_phi0);
+
+  auto check = [&](const char* name, auto scalar, auto batch) {
+    auto t0 = high_resolution_clock::now();
+    batch();
+    auto t1 = high_resolution_clock::now();
+    double sx, sy;
+    for (int i = 0; i < n; i++) {
+      scalar(lat[i], lon[i], &sx, &sy);
+      if (std::isnan(sx)) {
+        EXPECT_TRUE(std::isnan(x[i])) << name << " " << i;
+        continue;
+      }
+      EXPECT_NEAR(x[i], sx, 1e-6) << name << " " << i;
+      EXPECT_NEAR(y[i], sy, 1e-6) << name << " " << i;
+    }
+    auto t2 = high_resolution_clock::now();
+    double batch_s = duration<double>(t1 - t0).count();
+    double scalar_s = duration<double>(t2 - t1).count();
+    std::cout << name << ": batch " << n / batch_s / 1e6 << " Mpt/s, scalar "
+              << n / scalar_s / 1e6 << " Mpt/s\n";
+  };
+
+  check(
+      "toSM",
+      [&](double la, double lo, double* px, double* py) {
+        toSM(la, lo, lat0, lon0, px, py);
+      },
+      [&] { toSM_batch(n, &lat[0], &lon[0], lat0, lon0, &x[0], &y[0]); });
+  check(
+      "toTM",
+      [&](double la, double lo, double* px, double* py) {
+        toTM(la, lo, 0., lon0, px, py);
+      },
+      [&] { toTM_batch(n, &lat[0], &lon[0], 0., lon0, &x[0], &y[0]); });
+  check(
+      "toPOLY",
+      [&](double la, double lo, double* px, double* py) {
+        toPOLY(la, lo, 0., lon0, px, py);
+      },
+      [&] { toPOLY_batch(n, &lat[0], &lon[0], 0., lon0, &x[0], &y[0]); });
+  check(
+      "toORTHO",
+      [&](double la, double lo, double* px, double* py) {
+        toORTHO(la, lo, sin_phi0, cos_phi0, lon0, px, py);
+      },
+      [&] {
+        toORTHO_batch(n, &lat[0], &lon[0], sin_phi0, cos_phi0, lon0, &x[0],
+                      &y[0]);
+      });
+  check(
+      "toSTEREO",
+      [&](double la, double lo, double* px, double* py) {
+        toSTEREO(la, lo, sin_phi0, cos_phi0, lon0, px, py);
+      },
+      [&] {
+        toSTEREO_batch(n, &lat[0], &lon[0], sin_phi0, cos_phi0, lon0, &x[0],
+                       &y[0]);
+      });
+
+  // Round trip through the inverse Mercator batch
+  toSM_batch(n, &lat[0], &lon[0], lat0, lon0, &x[0], &y[0]);
+  std::vector<double> lat2(n), lon2(n);
+  fromSM_batch(n, &x[0], &y[0], lat0, lon0, &lat2[0], &lon2[0]);
+  for (int i = 0; i < n; i += 97) {
+    double rlat, rlon;
+    fromSM(x[i], y[i], lat0, lon0, &rlat, &rlon);
+    EXPECT_NEAR(lat2[i], rlat, 1e-9);
+    EXPECT_NEAR(lon2[i], rlon, 1e-9);
+  }
+}
+
+TEST(SelectIndex, QueryMatchesListWalk) {
+  SelectIndex index;
+  std::vector<SelectItem*> list;  // same order as the Select list
+  int track = 0;
+  srand(7);
+  auto rnd = [](float span) { return span * (rand() / (float)RAND_MAX - .5f); };
+  for (int i = 0; i < 5000; i++) {
+    auto item = new SelectItem;
+    item->m_seltype = SELTYPE_TRACKSEGMENT;
+    item->m_slat = 57.f + rnd(2.f);
+    item->m_slon = 11.f + rnd(2.f);
+    item->m_slat2 = item->m_slat + rnd(.02f);
+    // A few long segments end up outside the grid
+    item->m_slon2 = item->m_slon + rnd(i % 500 ? .02f : 30.f);
+    item->m_pData3 = &track;
+    bool at_front = i % 3 == 0;
+    index.Add(item, nullptr, at_front);
+    if (at_front)
+      list.insert(list.begin(), item);
+    else
+      list.push_back(item);
+  }
+
+  const float radius = .01f;
+  for (int q = 0; q < 200; q++) {
+    float lat = 57.f + rnd(2.f);
+    float lon = 11.f + rnd(2.f);
+    std::vector<SelectItem*> found;
+    ASSERT_TRUE(index.Query(SELTYPE_TRACKSEGMENT, lat, lon, radius, found));
+    std::vector<SelectItem*> expected;
+    for (auto item : list) {
+      if (lat >= std::min(item->m_slat, item->m_slat2) - radius &&
+          lat <= std::max(item->m_slat, item->m_slat2) + radius &&
+          lon >= std::min(item->m_slon, item->m_slon2) - radius &&
+          lon <= std::max(item->m_slon, item->m_slon2) + radius)
+        expected.push_back(item);
+    }
+    // Every box hit must be a candidate, in list order.
+    size_t j = 0;
+    for (auto item : found)
+      if (j < expected.size() && expected[j] == item) j++;
+    EXPECT_EQ(j, expected.size());
+  }
+
+  list[0]->m_slat = 10.f;
+  list[0]->m_slat2 = 10.f;
+  list[0]->m_slon = 10.f;
+  list[0]->m_slon2 = 10.f;
+  index.Move(list[0]);
+  std::vector<SelectItem*> found;
+  index.Query(SELTYPE_TRACKSEGMENT, 10.f, 10.f, radius, found);
+  EXPECT_NE(std::find(found.begin(), found.end(), list[0]), found.end());
+
+  auto owned = index.GetByOwner(&track);
+  EXPECT_EQ(owned.size(), list.size());
+  for (auto item : owned) {
+    index.Remove(item);
+    delete item;
+  }
+  EXPECT_TRUE(index.GetByType(SELTYPE_TRACKSEGMENT).empty());
+}
+
+TEST(SignalK, ParsedDocument) {
+  const char* const kDelta = R"""(
+  {
+    "context": "vessels.urn:mrn:imo:mmsi:230099999",
+    "updates": [{
+      "source": {"label": "N2K", "src": "115"},
+      "timestamp": "2023-05-01T10:00:00.000Z",
+      "values": [
+        {"path": "navigation.position",
+         "value": {"latitude": 60.1, "longitude": -24.5}},
+        {"path": "navigation.speedOverGround", "value": 3},
+        {"path": "navigation.state", "value": null},
+        {"path": "design.aisShipType", "value": {"id": 36, "name": "Sailing"}},
+        {"path": "foo", "value": [true, false, 4294967296, -1, "\u00e5"]}
+      ]
+    }]
+  }
+  )""";
+  auto doc = std::make_shared<rapidjson::Document>();
+  doc->Parse(kDelta);
+  ASSERT_FALSE(doc->HasParseError());
+
+  SignalkMsg msg("vessels.self", "vessels.urn:mrn:imo:mmsi:230099999", kDelta,
+                 "test", doc);
+  EXPECT_EQ(msg.GetDocument().get(), doc.get());
+
+  wxJSONValue from_doc;
+  SignalkToJson(*msg.GetDocument(), from_doc);
+
+  wxJSONReader reader;
+  wxJSONValue from_text;
+  ASSERT_EQ(0, reader.Parse(wxString::FromUTF8(kDelta), &from_text));
+  EXPECT_TRUE(from_doc.IsSameAs(from_text));
+  wxJSONValue& values = from_doc["updates"][0]["values"];
+  EXPECT_NEAR(values[0]["value"]["latitude"].AsDouble(), 60.1, 1e-9);
+  EXPECT_EQ(values[1]["value"].AsInt(), 3);
+  EXPECT_TRUE(values[2]["value"].IsNull());
+  EXPECT_EQ(values[4]["value"][4].AsString(), wxString::FromUTF8("\xc3\xa5"));
+
+  // Other messages are parsed on first use, once.
+  SignalkMsg unparsed("vessels.self", "vessels.self", kDelta, "test");
+  EXPECT_FALSE(unparsed.GetDocument()->HasParseError());
+  EXPECT_EQ(unparsed.GetDocument().get(), unparsed.GetDocument().get());
+}
+
+TEST(SignalK, ScanIds) {
+  std::string version, self, context;
+  EXPECT_TRUE(SignalkScanIds(
+      R"({"context": "vessels.urn:mrn:imo:mmsi:230099999",
+          "updates": [{"values": [{"path": "a", "value": {"self": "x"}}]}]})",
+      version, self, context));
+  EXPECT_EQ(context, "vessels.urn:mrn:imo:mmsi:230099999");
+  EXPECT_TRUE(self.empty());
+
+  // The context is found after the updates, nested names are skipped.
+  context.clear();
+  EXPECT_TRUE(SignalkScanIds(
+      R"({"updates": [{"context": "wrong"}], "context": "vessels.self"})",
+      version, self, context));
+  EXPECT_EQ(context, "vessels.self");
+
+  EXPECT_TRUE(SignalkScanIds(
+      R"({"name": "signalk-server", "version": "2.0.0",
+          "self": "urn:mrn:imo:mmsi:230099999", "roles": ["master"]})",
+      version, self, context));
+  EXPECT_EQ(version, "2.0.0");
+  EXPECT_EQ(self, "urn:mrn:imo:mmsi:230099999");
+
+  EXPECT_FALSE(SignalkScanIds(R"({"version": "2.0.0", )", version, self,
+                              context));
+  EXPECT_FALSE(SignalkScanIds(R"({"updates": [}, "context": "c"})", version,
+                              self, context));
+}
+
+TEST(AisVdmParser, SinglePart) {
+  AisVdmParser parser;
+  AisVdmMessage msg;
+  auto r = parser.Parse("!AIVDM,1,1,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5C\r\n",
+                        msg);
+  ASSERT_EQ(r, AisVdmResult::kComplete);
+  EXPECT_STREQ(msg.talker, "AI");
+  EXPECT_FALSE(msg.own_ship);
+  EXPECT_EQ(msg.channel, 'B');
+  AisBitstring bits(msg.payload, msg.payload_len);
+  EXPECT_EQ(bits.GetInt(1, 6), 1);
+  EXPECT_EQ(bits.GetInt(9, 30), 366053209);
+
+  r = parser.Parse("!AIVDM,1,1,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5D", msg);
+  EXPECT_EQ(r, AisVdmResult::kChecksumBad);
+  r = parser.Parse("$GPGGA,1,1,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5C", msg);
+  EXPECT_EQ(r, AisVdmResult::kNotVdm);
+}
+
+TEST(AisVdmParser, Multipart) {
+  const char* part1 =
+      "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,"
+      "0*3E";
+  const char* part2 = "!AIVDM,2,2,3,B,1@0000000000000,2*55";
+  const char* single = "!AIVDM,1,1,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5C";
+  AisVdmParser parser;
+  AisVdmMessage msg;
+
+  // A single part message in between does not disturb reassembly
+  EXPECT_EQ(parser.Parse(part1, msg), AisVdmResult::kPartial);
+  EXPECT_EQ(parser.Parse(single, msg), AisVdmResult::kComplete);
+  ASSERT_EQ(parser.Parse(part2, msg), AisVdmResult::kComplete);
+  EXPECT_EQ(msg.payload_len, 71);
+  EXPECT_EQ(msg.fill_bits, 2);
+  AisBitstring bits(msg.payload, msg.payload_len);
+  EXPECT_EQ(bits.GetInt(1, 6), 5);
+  EXPECT_EQ(bits.GetInt(9, 30), 369190000);
+
+  // Second part without the first one
+  EXPECT_EQ(parser.Parse(part2, msg), AisVdmResult::kOutOfSequence);
+}
+
+TEST(AisVdmParser, Throughput) {
+  using namespace std::chrono;
+  const char* sentences[] = {
+      "!AIVDM,1,1,,B,15M67FC000G?ufbE`FepT@3n00Sa,0*5C",
+      "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,"
+      "0*3E",
+      "!AIVDM,2,2,3,B,1@0000000000000,2*55"};
+  const int rounds = 20000;
+
+  // The wxString based front end of AisDecoder::DecodeN0183
+  auto t0 = high_resolution_clock::now();
+  int legacy_ids = 0;
+  wxString accumulator;
+  for (int i = 0; i < rounds; i++) {
+    for (const char* s : sentences) {
+      wxString str(s);
+      wxStringTokenizer tkz(str, _T(","));
+      wxString token = tkz.GetNextToken();
+      int nsentences = atoi(tkz.GetNextToken().mb_str());
+      int isentence = atoi(tkz.GetNextToken().mb_str());
+      tkz.GetNextToken();
+      tkz.GetNextToken();
+      wxString payload;
+      if (nsentences == 1) {
+        payload = tkz.GetNextToken();
+      } else {
+        if (isentence == 1)
+          accumulator = tkz.GetNextToken();
+        else
+          accumulator += tkz.GetNextToken();
+        if (isentence == nsentences) payload = accumulator;
+      }
+      if (payload.IsEmpty()) continue;
+      wxCharBuffer abuf = payload.ToUTF8();
+      AisBitstring bits(abuf.data());
+      legacy_ids += bits.GetInt(1, 6);
+    }
+  }
+  auto t1 = high_resolution_clock::now();
+
+  AisVdmParser parser;
+  AisVdmMessage msg;
+  int ids = 0;
+  for (int i = 0; i < rounds; i++) {
+    for (const char* s : sentences) {
+      if (parser.Parse(s, msg) != AisVdmResult::kComplete) continue;
+      AisBitstring bits(msg.payload, msg.payload_len);
+      ids += bits.GetInt(1, 6);
+    }
+  }
+  auto t2 = high_resolution_clock::now();
+
+  EXPECT_EQ(ids, legacy_ids);
+  const double n = rounds * 3;
+  std::cout << "AIVDM front end: wxString path "
+            << n / duration<double>(t1 - t0).count() / 1e3
+            << " ksentences/s, AisVdmParser "
+            << n / duration<double>(t2 - t1).count() / 1e3
+            << " ksentences/s\n";
+}
+
+TEST(StartupTasks, DependencyOrderAndCriticalPath) {
+  using namespace std::chrono;
+  StartupTasks tasks;
+  std::mutex mutex;
+  std::vector<std::string> order;
+  auto log = [&](const char* name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(name);
+  };
+  int a = tasks.Add("a", [&] {
+    std::this_thread::sleep_for(milliseconds(30));
+    log("a");
+  });
+  int b = tasks.Add("b", [&] { log("b"); });
+  int c = tasks.Add("c", [&] { log("c"); }, {a, b}, StartupTasks::Where::kMain);
+  tasks.Start(2);
+
+  int inline_stage = tasks.Begin("inline");
+  std::this_thread::sleep_for(milliseconds(5));
+  tasks.End(inline_stage);
+
+  tasks.Wait(c);
+  EXPECT_TRUE(tasks.IsDone(a));
+  EXPECT_TRUE(tasks.IsDone(b));
+  int after = tasks.Begin("after");
+  tasks.End(after);
+  tasks.Stop();
+
+  ASSERT_EQ(order.size(), 3u);
+  EXPECT_EQ(order.back(), "c");
+
+  // a is the slowest dependency of c, which was waited for by "after"
+  std::vector<int> path = tasks.CriticalPath();
+  std::vector<int> expected = {a, c, after};
+  EXPECT_EQ(path, expected);
+  std::vector<std::string> report = tasks.Report();
+  ASSERT_EQ(report.size(), 6u);
+  EXPECT_EQ(report.back().find("Critical path: a > c > after"), 0u);
+}
+
+TEST(StartupTasks, NoWorkers) {
+  StartupTasks tasks;
+  int n = 0;
+  int first = tasks.Add("first", [&] { n = n * 10 + 1; });
+  int second = tasks.Add("second", [&] { n = n * 10 + 2; }, {first},
+                         StartupTasks::Where::kMain);
+  tasks.Wait(second);
+  EXPECT_EQ(n, 12);
+}
+
+TEST(StartupTasks, FailureReason) {
+  StartupTasks tasks;
+  int chartdb = tasks.Add("chartdb", [] {
+    throw std::runtime_error("cannot read chart database");
+  });
+  int plugins = tasks.Add("plugins", [] { throw 42; });
+  int after = tasks.Add("after", [] {}, {chartdb, plugins});
+  tasks.Wait(after);
+  std::vector<std::string> report = tasks.Report();
+  ASSERT_GE(report.size(), 3u);
+  EXPECT_NE(report[0].find("chartdb (failed: cannot read chart database)"),
+            std::string::npos);
+  EXPECT_NE(report[1].find("plugins (failed)"), std::string::npos);
+  EXPECT_EQ(report[2].find("failed"), std::string::npos);
+}
+
+TEST(Iso8211, MappedReadMatchesStream) {
+  using namespace std::chrono;
+  std::string path = "iso8211-test.000";
+  const int n_records = 20000;
+  {
+    DDFModule module;
+    DDFFieldDefn* id = new DDFFieldDefn();
+    id->Create("0001", "Record id", "", dsc_elementary, dtc_char_string);
+    DDFFieldDefn* frid = new DDFFieldDefn();
+    frid->Create("FRID", "Feature record id", "", dsc_vector,
+                 dtc_mixed_data_type);
+    frid->AddSubfield("RCID", "b14");
+    frid->AddSubfield("NAME", "A");
+    module.AddField(id);
+    module.AddField(frid);
+    module.Initialize();
+    ASSERT_TRUE(module.Create(path.c_str()));
+    for (int i = 0; i < n_records; i++) {
+      DDFRecord record(&module);
+      record.AddField(id);
+      record.AddField(frid);
+      record.SetIntSubfield("FRID", 0, "RCID", 0, i);
+      std::string name = "feature " + std::to_string(i);
+      record.SetStringSubfield("FRID", 0, "NAME", 0, name.c_str());
+      record.Write();
+    }
+  }
+
+  auto read_all = [&](bool map, std::vector<std::string>& out) {
+    DDFModule module;
+    EXPECT_TRUE(module.Open(path.c_str(), FALSE, map));
+    EXPECT_EQ(module.IsMapped(), map);
+    DDFRecord* record;
+    while ((record = module.ReadRecord()) != NULL) {
+      std::string s(record->GetStringSubfield("FRID", 0, "NAME", 0));
+      s += "/" + std::to_string(record->GetIntSubfield("FRID", 0, "RCID", 0));
+      out.push_back(s);
+    }
+  };
+  std::vector<std::string> streamed, mapped;
+  auto t0 = high_resolution_clock::now();
+  read_all(false, streamed);
+  auto t1 = high_resolution_clock::now();
+  read_all(true, mapped);
+  auto t2 = high_resolution_clock::now();
+  ASSERT_EQ(streamed.size(), static_cast<size_t>(n_records));
+  EXPECT_EQ(streamed, mapped);
+  EXPECT_EQ(mapped[42], "feature 42/42");
+
+  // Copies may share the mapping, and are copied before being modified.
+  {
+    DDFModule module;
+    ASSERT_TRUE(module.Open(path.c_str(), FALSE, TRUE));
+    DDFRecord* copy = module.ReadRecord()->Copy(TRUE);
+    DDFRecord* clone = module.ReadRecord()->Clone();
+    EXPECT_TRUE(copy->SetIntSubfield("FRID", 0, "RCID", 0, 1000));
+    EXPECT_TRUE(copy->SetStringSubfield("FRID", 0, "NAME", 0, "renamed feature"));
+    EXPECT_EQ(copy->GetIntSubfield("FRID", 0, "RCID", 0), 1000);
+    EXPECT_STREQ(copy->GetStringSubfield("FRID", 0, "NAME", 0), "renamed feature");
+    EXPECT_EQ(clone->GetIntSubfield("FRID", 0, "RCID", 0), 1);
+    module.Rewind();
+    EXPECT_EQ(module.ReadRecord()->GetIntSubfield("FRID", 0, "RCID", 0), 0);
+    delete copy;
+  }
+  std::remove(path.c_str());
+
+  std::cout << "ISO 8211 read: stream "
+            << n_records / duration<double>(t1 - t0).count() / 1e3
+            << " krecords/s, mapped "
+            << n_records / duration<double>(t2 - t1).count() / 1e3
+            << " krecords/s\n";
+}
+
+TEST(OgrFeature, FieldAsStringFromThreads) {
+  // SENC records are encoded on several threads, and the file must come
+  // out byte for byte the same as when encoded on one.
+  OGRFeatureDefn* defn = new OGRFeatureDefn("TEST");
+  OGRFieldDefn integer("INT", OFTInteger);
+  OGRFieldDefn real("REAL", OFTReal);
+  OGRFieldDefn list("LIST", OFTIntegerList);
+  defn->AddFieldDefn(&integer);
+  defn->AddFieldDefn(&real);
+  defn->AddFieldDefn(&list);
+  defn->Reference();
+
+  const int n = 2000;
+  std::vector<std::unique_ptr<OGRFeature>> features;
+  for (int i = 0; i < n; i++) {
+    features.emplace_back(new OGRFeature(defn));
+    int values[3] = {i, -i, 7};
+    features.back()->SetField(0, i);
+    features.back()->SetField(1, i * 0.25);
+    features.back()->SetField(2, 3, values);
+  }
+  auto encode = [&](int i) {
+    std::string s;
+    for (int f = 0; f < defn->GetFieldCount(); f++)
+      s.append(features[i]->GetFieldAsString(f)).append("|");
+    return s;
+  };
+
+  std::string serial;
+  for (int i = 0; i < n; i++) serial += encode(i);
+  EXPECT_EQ(encode(12), "12|3|(3:12,-12,7)|");
+
+  const int n_threads = 4;
+  std::vector<std::vector<std::string>> buffers(n_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < n_threads; t++) {
+    threads.emplace_back([&, t] {
+      for (int i = t; i < n; i += n_threads) buffers[t].push_back(encode(i));
+    });
+  }
+  for (auto& t : threads) t.join();
+  std::string parallel;
+  for (int i = 0; i < n; i++)
+    parallel += buffers[i % n_threads][i / n_threads];
+  EXPECT_EQ(serial, parallel);
+
+  features.clear();
+  if (defn->Dereference() == 0) delete defn;
+}
+
+TEST(Logger, AsyncRotation) {
+  auto path = (fs::path(CMAKE_BINARY_DIR) / "async.log").string();
+  std::remove(path.c_str());
+  std::remove((path + ".log").c_str());
+  auto count_lines = [](const std::string& p) {
+    std::ifstream f(p);
+    std::string line;
+    int n = 0;
+    while (std::getline(f, line)) n++;
+    return n;
+  };
+  {
+    OcpnLog log(path.c_str(), 100000);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+      threads.emplace_back([&log] {
+        for (int i = 0; i < 2000; i++)
+          log.LogRecord(wxLOG_Info, "asynchronous record",
+                        wxLogRecordInfo(__FILE__, __LINE__, "", ""));
+      });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(log.GetDropped(), 0u);
+  }
+  EXPECT_LE(fs::file_size(path), 100000u);
+  EXPECT_LE(fs::file_size(path + ".log"), 100000u);
+  EXPECT_GT(count_lines(path + ".log"), 0);
+  std::remove(path.c_str());
+  std::remove((path + ".log").c_str());
+}
+
+TEST(Logger, BoundedQueue) {
+  LogQueue queue(5);  // Rounded up to 8
+  int pushed = 0;
+  for (int i = 0; i < 10; i++) pushed += queue.Push(std::to_string(i));
+  EXPECT_EQ(pushed, 8);
+  std::string line;
+  ASSERT_TRUE(queue.Pop(line));
+  EXPECT_EQ(line, "0");
+  EXPECT_TRUE(queue.Push("again"));
+
+  LogQueue shared(256);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&shared, t] {
+      for (int i = 0; i < 1000; i++) {
+        std::string s = std::to_string(t * 1000 + i);
+        while (!shared.Push(std::move(s))) std::this_thread::yield();
+      }
+    });
+  }
+  int popped = 0;
+  std::vector<int> last(4, -1);
+  while (popped < 4000) {
+    if (!shared.Pop(line)) continue;
+    popped++;
+    int n = std::stoi(line);
+    EXPECT_GT(n % 1000, last[n / 1000]);  // In order per producer
+    last[n / 1000] = n % 1000;
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_FALSE(shared.Pop(line));
+}
+
+TEST(Logger, RateLimit) {
+  LogRateLimit limit(3);
+  unsigned suppressed;
+  int allowed = 0;
+  for (int i = 0; i < 10; i++) allowed += limit.Allow(suppressed);
+  EXPECT_EQ(allowed, 3);
+  std::this_thread::sleep_for(1100ms);
+  EXPECT_TRUE(limit.Allow(suppressed));
+  EXPECT_EQ(suppressed, 7u);
+}
+
+TEST(TriRaster, ParallelBandsMatchSerial) {
+  using namespace std::chrono;
+  const int width = 1024;
+  const int height = 768;
+
+  // A jittered mesh of flat and patterned triangles, seen through a
+  // fixed set of viewports: overview, zoomed in, panned and zoomed out.
+  const int n = 64;
+  std::vector<int> mesh_x((n + 1) * (n + 1)), mesh_y((n + 1) * (n + 1));
+  unsigned seed = 42;
+  auto rnd = [&seed](int range) {
+    seed = seed * 1103515245 + 12345;
+    return static_cast<int>((seed >> 16) % range);
+  };
+  for (int j = 0; j <= n; j++) {
+    for (int i = 0; i <= n; i++) {
+      mesh_x[j * (n + 1) + i] = i * 1000 + rnd(400) - 200;
+      mesh_y[j * (n + 1) + i] = j * 1000 + rnd(400) - 200;
+    }
+  }
+  std::vector<unsigned char> patt_pix(8 * 8 * 4);
+  for (size_t i = 0; i < patt_pix.size(); i++)
+    patt_pix[i] = static_cast<unsigned char>(rnd(256));
+  TriRasterPattern pattern = {patt_pix.data(), 8 * 4, -2000000, -2000000,
+                              8, 8, true};
+
+  struct View {
+    double scale, x0, y0;
+  };
+  const View views[] = {{0.016, -10, -10},
+                        {0.1, 2000, 3000},
+                        {0.5, 20000, 20000},
+                        {0.008, -300, -200}};
+
+  auto render = [&](const View& v, int depth, unsigned threads,
+                    std::vector<unsigned char>& buf) {
+    TriRasterTarget target;
+    target.pb_pitch = width * depth / 8;
+    buf.assign(static_cast<size_t>(height) * target.pb_pitch, 0x20);
+    target.pix_buff = buf.data();
+    target.depth = depth;
+    target.x = 0;
+    target.y = 0;
+    target.width = width;
+    target.height = height;
+    target.lclip = 0;
+    target.rclip = width - 1;
+
+    TriRaster raster;
+    int patt = raster.AddPattern(pattern);
+    for (int j = 0; j < n; j++) {
+      for (int i = 0; i < n; i++) {
+        int k[4] = {j * (n + 1) + i, j * (n + 1) + i + 1,
+                    (j + 1) * (n + 1) + i + 1, (j + 1) * (n + 1) + i};
+        for (int t = 0; t < 2; t++) {
+          TriRaster::Tri tri;
+          for (int p = 0; p < 3; p++) {
+            int m = k[p ? t + p : 0];
+            tri.x[p] = static_cast<int>((mesh_x[m] - v.x0) * v.scale);
+            tri.y[p] = static_cast<int>((mesh_y[m] - v.y0) * v.scale);
+          }
+          tri.c[0] = static_cast<unsigned char>(i * 4);
+          tri.c[1] = static_cast<unsigned char>(j * 4);
+          tri.c[2] = static_cast<unsigned char>(t * 128);
+          tri.pattern = (i + j) % 7 == 0 ? patt : -1;
+          raster.Add(tri);
+        }
+      }
+    }
+    raster.Render(target, threads);
+    EXPECT_EQ(raster.GetCount(), 0u);
+  };
+
+  duration<double> serial(0), parallel(0);
+  for (int depth : {24, 32}) {
+    for (const View& v : views) {
+      std::vector<unsigned char> one, many;
+      auto t0 = high_resolution_clock::now();
+      render(v, depth, 1, one);
+      auto t1 = high_resolution_clock::now();
+      render(v, depth, 4, many);
+      auto t2 = high_resolution_clock::now();
+      serial += t1 - t0;
+      parallel += t2 - t1;
+      EXPECT_EQ(one, many) << "depth " << depth << " scale " << v.scale;
+    }
+  }
+
+  // A right triangle covers the rows above its bottom edge, left to right
+  std::vector<unsigned char> buf(16 * 16 * 4, 0);
+  TriRasterTarget target = {buf.data(), 16 * 4, 32, 0, 0, 16, 16, 0, 15};
+  TriRaster::Tri tri = {{0, 0, 8}, {0, 8, 8}, {1, 2, 3}, -1};
+  TriRaster::FillTri(tri, target, nullptr);
+  int filled = 0;
+  for (size_t i = 0; i < buf.size(); i += 4) filled += buf[i] == 1;
+  EXPECT_EQ(filled, 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8);
+  EXPECT_EQ(buf[0], 1);
+  EXPECT_EQ(buf[1], 2);
+  EXPECT_EQ(buf[2], 3);
+  EXPECT_EQ(buf[3], 0);
+
+  std::cout << "Area raster, " << 2 * sizeof(views) / sizeof(views[0])
+            << " views: 1 thread " << serial.count() * 1e3 << " ms, 4 threads "
+            << parallel.count() * 1e3 << " ms\n";
+}
+
+TEST(TextDeclutter, GridOverlapAndClear) {
+  // Only the addresses of the texts are used
+  char texts[4];
+  auto text = [&texts](int i) {
+    return reinterpret_cast<S52_TextC *>(&texts[i]);
+  };
+
+  TextDeclutterGrid grid(64);
+  EXPECT_FALSE(grid.Overlaps(wxRect(0, 0, 10, 10), nullptr));
+
+  grid.Place(text(0), wxRect(10, 10, 40, 10));
+  grid.Place(text(1), wxRect(60, 60, 100, 20));  // spans four cells
+  EXPECT_TRUE(grid.IsPlaced(text(0)));
+  EXPECT_FALSE(grid.IsPlaced(text(2)));
+
+  EXPECT_TRUE(grid.Overlaps(wxRect(45, 15, 10, 10), nullptr));
+  EXPECT_FALSE(grid.Overlaps(wxRect(55, 15, 10, 10), nullptr));
+  // A text does not overlap itself
+  EXPECT_FALSE(grid.Overlaps(wxRect(10, 10, 40, 10), text(0)));
+  // Texts in other cells are not tested, one spanning cells only once
+  size_t tests = grid.GetTestCount();
+  EXPECT_TRUE(grid.Overlaps(wxRect(100, 60, 50, 20), nullptr));
+  EXPECT_EQ(grid.GetTestCount(), tests + 1);
+  tests = grid.GetTestCount();
+  EXPECT_FALSE(grid.Overlaps(wxRect(-100, -100, 20, 20), nullptr));
+  EXPECT_EQ(grid.GetTestCount(), tests);
+
+  // A moved text is only found at its new place
+  grid.Place(text(0), wxRect(300, 300, 20, 10));
+  EXPECT_FALSE(grid.Overlaps(wxRect(10, 10, 40, 10), nullptr));
+  EXPECT_TRUE(grid.Overlaps(wxRect(310, 305, 5, 5), nullptr));
+
+  // A new frame starts empty
+  tests = grid.GetTestCount();
+  grid.Clear();
+  EXPECT_EQ(grid.GetLastFrameTestCount(), tests);
+  EXPECT_EQ(grid.GetTestCount(), 0u);
+  EXPECT_FALSE(grid.IsPlaced(text(1)));
+  EXPECT_FALSE(grid.Overlaps(wxRect(60, 60, 100, 20), nullptr));
+
+  // Cells a dense frame used are dropped once a frame does not use them
+  for (int i = 0; i < 1000; i++)
+    grid.Place(text(i % 4), wxRect(i * 64, 0, 10, 10));
+  EXPECT_GE(grid.GetCellCount(), 1000u);
+  grid.Clear();
+  grid.Place(text(2), wxRect(0, 0, 10, 10));
+  grid.Clear();
+  EXPECT_EQ(grid.GetCellCount(), 1u);
+  grid.Clear();
+  EXPECT_EQ(grid.GetCellCount(), 0u);
+}
+
+static TexCacheKey TexKey(uint64_t chart, int x, int y, int level) {
+  TexCacheKey key;
+  key.chart = chart;
+  key.x = x;
+  key.y = y;
+  key.level = level;
+  key.scheme = 0;
+  return key;
+}
+
+TEST(TexCacheStore, PutReadReopen) {
+  auto dir = fs::path(CMAKE_BINARY_DIR) / "texstore";
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+  uint64_t chart = TexCacheStore::ChartKey("charts/a.kap", 1, 2, 3, 4);
+  EXPECT_NE(chart, TexCacheStore::ChartKey("charts/a.kap", 1, 2, 3, 5));
+
+  auto check = [](TexCacheStore& store, uint64_t chart, int i) {
+    bool ok = false;
+    bool found = store.Read(TexKey(chart, i, i / 7, i % 5),
+                            [&](const unsigned char* data, uint32_t size) {
+                              ok = size == 100u + i % 50 &&
+                                   data[size - 1] == (unsigned char)i;
+                            });
+    return found && ok;
+  };
+
+  const int n = 10000;  // Grows the index twice
+  auto start = std::chrono::steady_clock::now();
+  {
+    TexCacheStore store;
+    ASSERT_TRUE(store.Open(dir.string()));
+    for (int i = 0; i < n; i++) {
+      std::vector<unsigned char> tile(100 + i % 50, (unsigned char)i);
+      ASSERT_TRUE(store.Put(TexKey(chart, i, i / 7, i % 5), tile.data(),
+                            tile.size()));
+      // Readable before it is committed
+      if (i % 97 == 0) EXPECT_TRUE(check(store, chart, i));
+    }
+    EXPECT_FALSE(store.Put(TexKey(chart, 0, 0, 0), (unsigned char*)"x", 1));
+    EXPECT_EQ(store.GetCount(), static_cast<size_t>(n));
+  }
+  auto written = std::chrono::steady_clock::now();
+
+  TexCacheStore store;
+  ASSERT_TRUE(store.Open(dir.string()));
+  EXPECT_EQ(store.GetCount(), static_cast<size_t>(n));
+  for (int i = 0; i < n; i++) ASSERT_TRUE(check(store, chart, i));
+  EXPECT_FALSE(store.Contains(TexKey(chart + 1, 0, 0, 0)));
+  auto read = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&store, t] {
+      unsigned char tile[64] = {0};
+      for (int i = 0; i < 500; i++) {
+        store.Put(TexKey(7, i, t, 0), tile, sizeof(tile));
+        store.Read(TexKey(7, i, t, 0), [](const unsigned char*, uint32_t) {});
+        store.MaybeCommit();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(store.GetCount(), static_cast<size_t>(n + 2000));
+  store.Close();
+
+  //  A torn index slot is skipped, the others are still found
+  auto index = (dir / "texstore.idx").string();
+  std::fstream f(index, std::ios::in | std::ios::out | std::ios::binary);
+  for (std::streamoff off = 64;; off += 40) {
+    uint32_t slot_check = 0;
+    f.seekg(off + 32);
+    ASSERT_TRUE(f.read(reinterpret_cast<char*>(&slot_check), 4));
+    if (!slot_check) continue;
+    f.seekp(off + 8);
+    f.put(0x7f);
+    break;
+  }
+  f.close();
+  ASSERT_TRUE(store.Open(dir.string()));
+  int found = 0;
+  for (int i = 0; i < n; i++) found += check(store, chart, i);
+  for (int t = 0; t < 4; t++) {
+    for (int i = 0; i < 500; i++) found += store.Contains(TexKey(7, i, t, 0));
+  }
+  EXPECT_EQ(found, n + 2000 - 1);
+
+  store.Clear();
+  EXPECT_FALSE(store.IsOpen());
+  EXPECT_FALSE(fs::exists(index));
+
+  using ms = std::chrono::duration<double, std::milli>;
+  std::cout << "Texture store, " << n << " tiles: write "
+            << ms(written - start).count() << " ms, read "
+            << ms(read - written).count() << " ms\n";
+}
+
+TEST(TexCacheStore, SizeLimit) {
+  auto dir = fs::path(CMAKE_BINARY_DIR) / "texstore_limit";
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+  std::vector<unsigned char> tile(1000, 0x5a);
+  {
+    TexCacheStore store;
+    store.SetMaxSize(10000);
+    ASSERT_TRUE(store.Open(dir.string()));
+    int n = 0;
+    while (store.Put(TexKey(1, n, 0, 0), tile.data(), tile.size())) n++;
+    EXPECT_EQ(n, 10);
+    EXPECT_GE(store.GetDataSize(), 10000u);
+    // Full stores still read, also past the data mapped at open
+    for (int i = 0; i < n; i++) {
+      bool ok = false;
+      EXPECT_TRUE(store.Read(TexKey(1, i, 0, 0),
+                             [&](const unsigned char* data, uint32_t size) {
+                               ok = size == tile.size() && data[0] == 0x5a;
+                             }));
+      EXPECT_TRUE(ok);
+    }
+  }
+  TexCacheStore store;
+  store.SetMaxSize(10000);
+  ASSERT_TRUE(store.Open(dir.string()));
+  EXPECT_EQ(store.GetCount(), 0u);
+  EXPECT_TRUE(store.Put(TexKey(1, 0, 0, 0), tile.data(), tile.size()));
+  store.Clear();
+}
+
+TEST(StationIndex, WriteAndMap) {
+  auto path = (fs::path(CMAKE_BINARY_DIR) / "stations.stx").string();
+  std::remove(path.c_str());
+
+  std::vector<StationIndexEntry> entries(3);
+  std::vector<std::string> names = {"Ref", "Sub, current (depth 10 ft)", ""};
+  for (size_t i = 0; i < entries.size(); i++) {
+    memset(&entries[i], 0, sizeof(StationIndexEntry));
+    entries[i].lat = 50. + i;
+    entries[i].lon = -5. - i;
+    entries[i].ref_index = 0;
+  }
+  entries[0].type = 'T';
+  entries[1].type = 'c';
+  entries[1].current_depth = 10;
+  entries[1].have_offsets = 1;
+  ASSERT_TRUE(StationIndex::Write(path, 1234, 5678, "v2.2", entries, names));
+
+  StationIndex index;
+  // Built from another version of the harmonics file
+  EXPECT_FALSE(index.Open(path, 1234, 5679));
+  EXPECT_FALSE(index.Open(path, 1235, 5678));
+  EXPECT_EQ(index.GetCount(), 0u);
+
+  ASSERT_TRUE(index.Open(path, 1234, 5678));
+  ASSERT_EQ(index.GetCount(), 3u);
+  EXPECT_EQ(index.GetIdent(), "v2.2");
+  EXPECT_STREQ(index.GetName(0), "Ref");
+  EXPECT_STREQ(index.GetName(1), "Sub, current (depth 10 ft)");
+  EXPECT_STREQ(index.GetName(2), "");
+  EXPECT_EQ(index.GetEntry(1).type, 'c');
+  EXPECT_EQ(index.GetEntry(1).current_depth, 10);
+  EXPECT_EQ(index.GetEntry(2).lat, 52.);
+  EXPECT_EQ(index.GetEntry(2).lon, -7.);
+  index.Close();
+
+  // A truncated index is not used
+  fs::resize_file(path, fs::file_size(path) - 1);
+  EXPECT_FALSE(index.Open(path, 1234, 5678));
+  std::remove(path.c_str());
+}
+
+TEST(NmeaSubscriptions, Routing) {
+  EXPECT_EQ(NmeaSubscriptions::SentenceId("$GPRMC,123519,A*6A"), "RMC");
+  EXPECT_EQ(NmeaSubscriptions::SentenceId("$IIMWV,214.8,R,0.1,K,A*28"), "MWV");
+  EXPECT_EQ(NmeaSubscriptions::SentenceId("$PGRMZ,93,f,3*21"), "PGRMZ");
+  EXPECT_EQ(NmeaSubscriptions::SentenceId("!AIVDO,1,1,,,B,4,0*05"), "VDO");
+  EXPECT_EQ(NmeaSubscriptions::SentenceId("$,1,2"), "");
+  EXPECT_EQ(NmeaSubscriptions::SentenceId("garbage"), "");
+
+  NmeaSubscriptions subs;
+  subs.Add(0, {"RMC", "GGA"});
+  subs.Add(1, {});
+  subs.Add(2, {"GGA", "GGA", "PGRMZ"});
+  subs.Add(3, {});
+
+  EXPECT_EQ(subs.Get("RMC"), std::vector<int>({0, 1, 3}));
+  EXPECT_EQ(subs.Get("GGA"), std::vector<int>({0, 1, 2, 3}));
+  EXPECT_EQ(subs.Get("PGRMZ"), std::vector<int>({1, 2, 3}));
+  EXPECT_EQ(subs.Get("VTG"), std::vector<int>({1, 3}));
+
+  subs.Clear();
+  EXPECT_TRUE(subs.Get("RMC").empty());
+}
+
+TEST(ListIndex, SortFilterSync) {
+  struct Obj {
+    std::string name;
+    double dist;
+  };
+  std::vector<Obj> objs = {{"delta", 4}, {"alpha", 3}, {"charlie", 1},
+                           {"bravo", 2}, {"alpha", 5}};
+  auto entries = [&](size_t n) {
+    std::vector<ListIndex::Entry> list;
+    for (size_t i = 0; i < n; i++) list.emplace_back(&objs[i], objs[i].name);
+    return list;
+  };
+  auto rows = [](const ListIndex& index) {
+    std::string s;
+    for (size_t i = 0; i < index.GetCount(); i++)
+      s += static_cast<const Obj*>(index.Get(i))->name.substr(0, 1);
+    return s;
+  };
+
+  ListIndex index;
+  EXPECT_TRUE(index.Sync(entries(4)));
+  EXPECT_EQ(rows(index), "abcd");
+  EXPECT_FALSE(index.Sync(entries(4)));
+
+  // Equal names keep the order added
+  index.Add(&objs[4], objs[4].name);
+  EXPECT_EQ(index.Get(0), &objs[1]);
+  EXPECT_EQ(index.Get(1), &objs[4]);
+
+  index.SetFilter("ha");
+  EXPECT_EQ(rows(index), "aac");
+  index.SetFilter("ar");
+  EXPECT_EQ(rows(index), "c");
+  EXPECT_EQ(index.Find(&objs[2]), 0);
+  EXPECT_EQ(index.Find(&objs[0]), -1);
+
+  // Added and removed objects follow the filter
+  index.Remove(&objs[2]);
+  EXPECT_EQ(index.GetCount(), 0u);
+  index.Add(&objs[2], objs[2].name);
+  EXPECT_EQ(rows(index), "c");
+  index.SetFilter("");
+
+  index.SetSort(
+      [](ListIndex::Object a, ListIndex::Object b) {
+        return static_cast<const Obj*>(a)->dist <
+               static_cast<const Obj*>(b)->dist;
+      },
+      true);
+  EXPECT_EQ(rows(index), "adabc");
+
+  // A renamed object is moved, others keep their place
+  objs[1].name = "echo";
+  auto list = entries(4);
+  EXPECT_TRUE(index.Sync(list));
+  EXPECT_EQ(index.GetSize(), 4u);
+  EXPECT_EQ(rows(index), "debc");
+  objs[2].dist = 10;
+  index.Resort();
+  EXPECT_EQ(rows(index), "cdeb");
+  EXPECT_EQ(index.Get(4), nullptr);
+
+  // Many objects are merged in, in order
+  std::vector<Obj> many(1000);
+  std::vector<ListIndex::Entry> all;
+  for (size_t i = 0; i < many.size(); i++) {
+    many[i] = {std::to_string(i), static_cast<double>((i * 7919) % 1000)};
+    all.emplace_back(&many[i], many[i].name);
+  }
+  index.Clear();
+  index.SetSort(ListIndex::Less(), false);
+  index.Sync(list);
+  all.insert(all.end(), list.begin(), list.end());
+  EXPECT_TRUE(index.Sync(all));
+  ASSERT_EQ(index.GetCount(), all.size());
+  for (size_t i = 1; i < index.GetCount(); i++) {
+    EXPECT_LE(static_cast<const Obj*>(index.Get(i - 1))->name,
+              static_cast<const Obj*>(index.Get(i))->name);
+  }
+}